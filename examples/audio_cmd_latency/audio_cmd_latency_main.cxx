@@ -0,0 +1,518 @@
+/****************************************************************************
+ * audio_cmd_latency/audio_cmd_latency_main.cxx
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <asmp/mpshm.h>
+
+#include "memutils/os_utils/chateau_osal.h"
+#include "audio/audio_high_level_api.h"
+#include "memutils/message/Message.h"
+#include "include/msgq_id.h"
+#include "include/msgq_pool.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Default number of each command to send. */
+
+#define DEF_ITERATIONS 100
+
+/* Volumes set alternately. -40.0dB and -41.0dB */
+
+#define VOLUME_A -400
+#define VOLUME_B -410
+
+/* Beep frequencies set alternately. Beep is not played. */
+
+#define BEEP_FREQ_A 1000
+#define BEEP_FREQ_B 2000
+#define BEEP_VOL    -40
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Statistics of a command (microseconds). */
+
+struct cmd_stat_s
+{
+  const char *name;
+  uint8_t     command_code;
+  uint32_t    num;
+  uint32_t    effect_min;
+  uint32_t    effect_max;
+  uint64_t    effect_sum;
+  uint32_t    result_min;
+  uint32_t    result_max;
+  uint64_t    result_sum;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* For share memory. */
+
+static mpshm_t s_shm;
+
+/* Time stamps of trace points of the command in progress. Applied point
+ * may be called in the context of AudioManager task.
+ */
+
+static volatile uint32_t s_sent_us;
+static volatile uint32_t s_applied_us;
+
+static struct cmd_stat_s s_stat[] =
+{
+  { "SetVolume",     AUDCMD_SETVOLUME },
+  { "SetVolumeMute", AUDCMD_SETVOLUMEMUTE },
+  { "SetBeepParam",  AUDCMD_SETBEEPPARAM },
+};
+
+#define STAT_NUM (sizeof(s_stat) / sizeof(s_stat[0]))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint32_t app_now_us(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (uint32_t)now.tv_sec * 1000000 + (uint32_t)now.tv_nsec / 1000;
+}
+
+static void app_trace_callback(uint8_t command_code,
+                               AsCommandTracePoint point)
+{
+  if (point == AsCommandTraceSent)
+    {
+      s_sent_us = app_now_us();
+    }
+  else
+    {
+      s_applied_us = app_now_us();
+    }
+}
+
+static bool printAudCmdResult(uint8_t command_code, AudioResult& result)
+{
+  if (AUDRLT_ERRORRESPONSE == result.header.result_code)
+    {
+      printf("Command code(0x%x): AUDRLT_ERRORRESPONSE:"
+             "Module id(0x%x): Error code(0x%x)\n",
+              command_code,
+              result.error_response_param.module_id,
+              result.error_response_param.error_code);
+      return false;
+    }
+  else if (AUDRLT_ERRORATTENTION == result.header.result_code)
+    {
+      printf("Command code(0x%x): AUDRLT_ERRORATTENTION\n", command_code);
+      return false;
+    }
+  return true;
+}
+
+static void app_attention_callback(const ErrorAttentionParam *attparam)
+{
+  printf("Attention!! %s L%d ecode %d subcode %d\n",
+          attparam->error_filename,
+          attparam->line_number,
+          attparam->error_code,
+          attparam->error_att_sub_code);
+}
+
+static bool app_create_audio_sub_system(void)
+{
+  /* Create manager of AudioSubSystem. */
+
+  AudioSubSystemIDs ids;
+  ids.app         = MSGQ_AUD_APP;
+  ids.mng         = MSGQ_AUD_MGR;
+  ids.player_main = 0xFF;
+  ids.player_sub  = 0xFF;
+  ids.mixer       = 0xFF;
+  ids.recorder    = 0xFF;
+  ids.effector    = 0xFF;
+  ids.recognizer  = 0xFF;
+
+  AS_CreateAudioManager(ids, app_attention_callback);
+
+  return true;
+}
+
+static void app_deact_audio_sub_system(void)
+{
+  AS_DeleteAudioManager();
+}
+
+static bool app_send_command(AudioCommand& command)
+{
+  AS_SendAudioCommand(&command);
+
+  AudioResult result;
+  AS_ReceiveAudioResult(&result);
+  return printAudCmdResult(command.header.command_code, result);
+}
+
+static bool app_power_on(void)
+{
+  AudioCommand command;
+  command.header.packet_length = LENGTH_POWERON;
+  command.header.command_code  = AUDCMD_POWERON;
+  command.header.sub_code      = 0x00;
+  command.power_on_param.enable_sound_effect = AS_DISABLE_SOUNDEFFECT;
+  return app_send_command(command);
+}
+
+static bool app_power_off(void)
+{
+  AudioCommand command;
+  command.header.packet_length = LENGTH_SET_POWEROFF_STATUS;
+  command.header.command_code  = AUDCMD_SETPOWEROFFSTATUS;
+  command.header.sub_code      = 0x00;
+  return app_send_command(command);
+}
+
+static bool app_set_ready(void)
+{
+  AudioCommand command;
+  command.header.packet_length = LENGTH_SET_READY_STATUS;
+  command.header.command_code  = AUDCMD_SETREADYSTATUS;
+  command.header.sub_code      = 0x00;
+  return app_send_command(command);
+}
+
+static bool app_set_through_status(void)
+{
+  AudioCommand command;
+  command.header.packet_length = LENGTH_SET_THROUGH_STATUS;
+  command.header.command_code  = AUDCMD_SETTHROUGHSTATUS;
+  command.header.sub_code      = 0x00;
+  return app_send_command(command);
+}
+
+static void app_make_command(AudioCommand& command, uint8_t command_code,
+                             uint32_t count)
+{
+  bool alt = ((count & 1) != 0);
+
+  command.header.command_code = command_code;
+  command.header.sub_code     = 0x00;
+
+  switch (command_code)
+    {
+      case AUDCMD_SETVOLUME:
+        command.header.packet_length = LENGTH_SETVOLUME;
+        command.set_volume_param.input1_db = 0;
+        command.set_volume_param.input2_db = AS_VOLUME_MUTE;
+        command.set_volume_param.master_db = alt ? VOLUME_B : VOLUME_A;
+        break;
+
+      case AUDCMD_SETVOLUMEMUTE:
+        command.header.packet_length = LENGTH_SETVOLUMEMUTE;
+        command.set_volume_mute_param.master_mute =
+          alt ? AS_VOLUMEMUTE_UNMUTE : AS_VOLUMEMUTE_MUTE;
+        command.set_volume_mute_param.input1_mute = AS_VOLUMEMUTE_HOLD;
+        command.set_volume_mute_param.input2_mute = AS_VOLUMEMUTE_HOLD;
+        break;
+
+      default:
+        command.header.packet_length = LENGTH_SETBEEPPARAM;
+        command.set_beep_param.beep_en   = AS_BEEPEN_DISABLE;
+        command.set_beep_param.beep_vol  = BEEP_VOL;
+        command.set_beep_param.beep_freq = alt ? BEEP_FREQ_B : BEEP_FREQ_A;
+        break;
+    }
+}
+
+static bool app_measure(struct cmd_stat_s *stat, uint32_t count)
+{
+  AudioCommand command;
+
+  app_make_command(command, stat->command_code, count);
+
+  s_sent_us    = 0;
+  s_applied_us = 0;
+
+  if (!app_send_command(command))
+    {
+      return false;
+    }
+
+  uint32_t result_us = app_now_us();
+
+  if ((s_sent_us == 0) || (s_applied_us == 0))
+    {
+      printf("Error: %s was not traced.\n", stat->name);
+      return false;
+    }
+
+  /* Command-to-effect is from sent to applied on driver, and result is
+   * until the application receives the result.
+   */
+
+  uint32_t effect = s_applied_us - s_sent_us;
+  uint32_t result = result_us - s_sent_us;
+
+  if (stat->num == 0)
+    {
+      stat->effect_min = effect;
+      stat->effect_max = effect;
+      stat->result_min = result;
+      stat->result_max = result;
+    }
+
+  stat->effect_min = (effect < stat->effect_min) ? effect : stat->effect_min;
+  stat->effect_max = (effect > stat->effect_max) ? effect : stat->effect_max;
+  stat->effect_sum += effect;
+  stat->result_min = (result < stat->result_min) ? result : stat->result_min;
+  stat->result_max = (result > stat->result_max) ? result : stat->result_max;
+  stat->result_sum += result;
+  stat->num++;
+
+  return true;
+}
+
+static void app_print_stat(void)
+{
+#ifdef CONFIG_AUDIOUTILS_MANAGER_FASTPATH
+  printf("Fast path: enabled\n");
+#else
+  printf("Fast path: disabled\n");
+#endif
+
+  printf("%-14s %5s %24s %24s\n", "command", "num",
+         "effect min/avg/max [us]", "result min/avg/max [us]");
+
+  for (uint32_t i = 0; i < STAT_NUM; i++)
+    {
+      struct cmd_stat_s *stat = &s_stat[i];
+
+      if (stat->num == 0)
+        {
+          continue;
+        }
+
+      printf("%-14s %5lu %8lu/%7lu/%7lu %8lu/%7lu/%7lu\n",
+             stat->name,
+             (unsigned long)stat->num,
+             (unsigned long)stat->effect_min,
+             (unsigned long)(stat->effect_sum / stat->num),
+             (unsigned long)stat->effect_max,
+             (unsigned long)stat->result_min,
+             (unsigned long)(stat->result_sum / stat->num),
+             (unsigned long)stat->result_max);
+    }
+}
+
+static bool app_init_libraries(void)
+{
+  int ret;
+  uint32_t addr = MSGQ_TOP_DRM;
+
+  /* Initialize shared memory.*/
+
+  ret = mpshm_init(&s_shm, 1, 1024 * 128);
+  if (ret < 0)
+    {
+      printf("Error: mpshm_init() failure. %d\n", ret);
+      return false;
+    }
+
+  ret = mpshm_remap(&s_shm, (void *)addr);
+  if (ret < 0)
+    {
+      printf("Error: mpshm_remap() failure. %d\n", ret);
+      return false;
+    }
+
+  /* Initalize MessageLib. */
+
+  err_t err = MsgLib::initFirst(NUM_MSGQ_POOLS, MSGQ_TOP_DRM);
+  if (err != ERR_OK)
+    {
+      printf("Error: MsgLib::initFirst() failure. 0x%x\n", err);
+      return false;
+    }
+
+  err = MsgLib::initPerCpu();
+  if (err != ERR_OK)
+    {
+      printf("Error: MsgLib::initPerCpu() failure. 0x%x\n", err);
+      return false;
+    }
+
+  return true;
+}
+
+static bool app_finalize_libraries(void)
+{
+  /* Finalize MessageLib. */
+
+  MsgLib::finalize();
+
+  /* Destroy shared memory. */
+
+  int ret;
+  ret = mpshm_detach(&s_shm);
+  if (ret < 0)
+    {
+      printf("Error: mpshm_detach() failure. %d\n", ret);
+      return false;
+    }
+
+  ret = mpshm_destroy(&s_shm);
+  if (ret < 0)
+    {
+      printf("Error: mpshm_destroy() failure. %d\n", ret);
+      return false;
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+extern "C" int main(int argc, FAR char *argv[])
+{
+  uint32_t iterations = DEF_ITERATIONS;
+  bool     success    = true;
+
+  if (argc > 1)
+    {
+      iterations = strtoul(argv[1], NULL, 10);
+    }
+
+  printf("Start AudioCmdLatency example\n");
+
+  /* First, initialize the shared memory and memory utility used by
+   * AudioSubSystem.
+   */
+
+  if (!app_init_libraries())
+    {
+      printf("Error: init_libraries() failure.\n");
+      return 1;
+    }
+
+  /* Next, Create the features used by AudioSubSystem. */
+
+  if (!app_create_audio_sub_system())
+    {
+      printf("Error: act_audiosubsystem() failure.\n");
+      return 1;
+    }
+
+  if (!app_power_on())
+    {
+      printf("Error: app_power_on() failure.\n");
+      return 1;
+    }
+
+  /* Baseband is powered on in through state, with no path. */
+
+  if (!app_set_through_status())
+    {
+      printf("Error: app_set_through_status() failure.\n");
+      return 1;
+    }
+
+  /* Time stamps are taken by trace hook while commands are measured. */
+
+  AS_SetAudioCommandTraceHook(app_trace_callback);
+
+  for (uint32_t count = 0; success && (count < iterations); count++)
+    {
+      for (uint32_t i = 0; i < STAT_NUM; i++)
+        {
+          if (!app_measure(&s_stat[i], count))
+            {
+              success = false;
+              break;
+            }
+        }
+    }
+
+  AS_SetAudioCommandTraceHook(NULL);
+
+  app_print_stat();
+
+  /* Return the state of AudioSubSystem before through operation. */
+
+  if (!app_set_ready())
+    {
+      printf("Error: app_set_ready() failure.\n");
+      return 1;
+    }
+
+  /* Change AudioSubsystem to PowerOff state. */
+
+  if (!app_power_off())
+    {
+      printf("Error: app_power_off() failure.\n");
+      return 1;
+    }
+
+  /* Deactivate the features used by AudioSubSystem. */
+
+  app_deact_audio_sub_system();
+
+  /* finalize the shared memory and memory utility used by AudioSubSystem. */
+
+  if (!app_finalize_libraries())
+    {
+      printf("Error: finalize_libraries() failure.\n");
+      return 1;
+    }
+
+  printf("Exit AudioCmdLatency example\n");
+
+  return success ? 0 : 1;
+}
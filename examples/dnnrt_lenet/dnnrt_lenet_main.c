@@ -40,6 +40,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <unistd.h>
+#include <pthread.h>
 #include <sys/time.h>
 #include <nuttx/config.h>
 #include <dnnrt/runtime.h>
@@ -54,14 +55,25 @@ typedef struct
   char *nnb_path;
   char *pgm_path;
   bool skip_norm;
+  unsigned char cpu_num;
+  unsigned int bench_num;
 } my_setting_t;
 
+typedef struct
+{
+  dnn_runtime_t *rt;
+  const void **inputs;
+  unsigned int count;
+  int ret;
+} bench_job_t;
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 #define DNN_PNM_PATH    "/mnt/sd0/0.pgm"
 #define DNN_NNB_PATH    "/mnt/sd0/lenet-5.nnb"
 #define MNIST_SIZE_PX (28*28)
+#define DNN_MAX_CPU_NUM (5)
 
 /****************************************************************************
  * Private Data
@@ -107,16 +119,27 @@ static void parse_args(int argc, char *argv[], my_setting_t * setting)
 {
   /* parse options by getopt() */
   int opt;
-  while ((opt = getopt(argc, argv, "s")) != -1)
+  while ((opt = getopt(argc, argv, "sc:n:")) != -1)
     {
       switch (opt)
         {
         case 's':              /* skip normalization */
           setting->skip_norm = true;
           break;
+        case 'c':              /* number of CPUs */
+          setting->cpu_num = (unsigned char)atoi(optarg);
+          break;
+        case 'n':              /* number of inferences to benchmark */
+          setting->bench_num = (unsigned int)atoi(optarg);
+          break;
         }
     }
 
+  if (setting->cpu_num < 1 || setting->cpu_num > DNN_MAX_CPU_NUM)
+    {
+      setting->cpu_num = 1;
+    }
+
   /* set my_setting_t::{nnb_path,pgm_path} to argv[] if necessary */
   setting->nnb_path = (optind < argc) ? argv[optind++] : DNN_NNB_PATH;
   setting->pgm_path = (optind < argc) ? argv[optind] : DNN_PNM_PATH;
@@ -132,6 +155,100 @@ static void parse_args(int argc, char *argv[], my_setting_t * setting)
     {
       printf("Image Normalization (1.0/255.0): enabled\n");
     }
+  printf("CPUs: %u\n", setting->cpu_num);
+}
+
+static void *bench_thread(void *arg)
+{
+  bench_job_t *job = (bench_job_t *) arg;
+  unsigned int i;
+
+  for (i = 0u; i < job->count && job->ret == 0; i++)
+    {
+      job->ret = dnn_runtime_forward(job->rt, job->inputs, 1);
+    }
+
+  return NULL;
+}
+
+static float elapsed_sec(struct timeval *begin, struct timeval *end)
+{
+  return (float)(end->tv_sec - begin->tv_sec) +
+    (float)(end->tv_usec - begin->tv_usec) / 1.0e6;
+}
+
+static int run_benchmark(dnn_runtime_t * rt, nn_network_t * network,
+                         const void *inputs[], my_setting_t * setting)
+{
+  int ret = 0;
+  unsigned char i, rt_num = 1, thread_num = 0;
+  dnn_runtime_t bench_rt[DNN_MAX_CPU_NUM];
+  bench_job_t job[DNN_MAX_CPU_NUM];
+  pthread_t thread[DNN_MAX_CPU_NUM];
+  struct timeval begin, end;
+  float sec;
+
+#ifdef CONFIG_DNN_RT_MP_PIPELINE
+  /* one more runtime for each core, so that consecutive inferences run
+   * on different cores in parallel */
+  for (rt_num = 1; rt_num < setting->cpu_num; rt_num++)
+    {
+      ret = dnn_runtime_initialize(&bench_rt[rt_num], network);
+      if (ret)
+        {
+          printf("dnn_runtime_initialize() failed due to %d\n", ret);
+          goto fin;
+        }
+    }
+#endif
+
+  for (i = 0u; i < rt_num; i++)
+    {
+      job[i].rt = (i == 0u) ? rt : &bench_rt[i];
+      job[i].inputs = inputs;
+      job[i].count = setting->bench_num / rt_num;
+      job[i].count += (i < setting->bench_num % rt_num) ? 1 : 0;
+      job[i].ret = 0;
+    }
+
+  printf("start benchmark: %u inferences on %u runtime(s)\n",
+         setting->bench_num, rt_num);
+  gettimeofday(&begin, 0);
+  for (thread_num = 0u; thread_num < rt_num; thread_num++)
+    {
+      ret = pthread_create(&thread[thread_num], NULL, bench_thread,
+                           &job[thread_num]);
+      if (ret)
+        {
+          printf("pthread_create() failed due to %d\n", ret);
+          break;
+        }
+    }
+  for (i = 0u; i < thread_num; i++)
+    {
+      pthread_join(thread[i], NULL);
+      if (job[i].ret && !ret)
+        {
+          ret = job[i].ret;
+        }
+    }
+  gettimeofday(&end, 0);
+  if (ret)
+    {
+      printf("benchmark failed due to %d\n", ret);
+      goto fin;
+    }
+
+  sec = elapsed_sec(&begin, &end);
+  printf("benchmark time=%.3f, inferences/sec=%.2f\n", sec,
+         (float)setting->bench_num / sec);
+
+fin:
+  for (i = 1u; i < rt_num; i++)
+    {
+      dnn_runtime_finalize(&bench_rt[i]);
+    }
+  return ret;
 }
 
 /****************************************************************************
@@ -150,6 +267,7 @@ int main(int argc, FAR char *argv[])
   struct timeval begin, end;
 
   parse_args(argc, argv, &setting);
+  config.cpu_num = setting.cpu_num;
 
   /* load an hand-written digit image into s_img_buffer,
    * and then divide the pixels by 255.0 for normalization */
@@ -214,6 +332,12 @@ int main(int argc, FAR char *argv[])
   proc_time -= (float)begin.tv_sec + (float)begin.tv_usec / 1.0e6;
   printf("inference time=%.3f\n", proc_time);
 
+  /* Step-E: measure throughput if requested */
+  if (setting.bench_num > 0u)
+    {
+      ret = run_benchmark(&rt, network, inputs, &setting);
+    }
+
 fin:
   /* Step-F: free memories allocated to dnn_runtime_t */
   dnn_runtime_finalize(&rt);
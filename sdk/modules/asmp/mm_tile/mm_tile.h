@@ -44,6 +44,7 @@
 #include <sdk/config.h>
 #include <sdk/debug.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <semaphore.h>
 
@@ -64,6 +65,21 @@
 
 #define ALIGNUP(x, a)  (((x) + ((1 << (a)) - 1)) & ~((1 << (a)) - 1))
 
+/* Allocation table is managed by array of 32 bit words */
+
+#define TILE_WORDSHIFT 5
+#define TILE_WORDBITS  (1 << TILE_WORDSHIFT)
+#define TILE_WORDMASK  (TILE_WORDBITS - 1)
+#define TILE_NWORDS(n) (((n) + TILE_WORDMASK) >> TILE_WORDSHIFT)
+
+/* Count trailing zeros, the value must not be zero. */
+
+#define TILE_CTZ(x)    __builtin_ctz(x)
+
+/* Power control is done by 128KB block */
+
+#define TILE_LOG2PWRBLOCK 17
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -75,8 +91,9 @@ struct tile_s
   uint8_t    log2tile;  /* Log base 2 of the size of one tile */
   uint16_t   ntiles;    /* The total number of (aligned) tiles in the heap */
   sem_t      exclsem;   /* For exclusive access to the AT */
+  uint16_t   nwords;    /* The number of words in the AT */
   uintptr_t  heapstart; /* The aligned start of the tile heap */
-  uint32_t   at;        /* Tile allocation table */
+  FAR uint32_t *at;     /* Tile allocation table (1 bit per tile) */
 };
 
 /****************************************************************************
@@ -108,4 +125,83 @@ extern FAR struct tile_s *g_tileinfo;
 void tile_enter_critical(FAR struct tile_s *priv);
 void tile_leave_critical(FAR struct tile_s *priv);
 
+/****************************************************************************
+ * Name: tile_bitmap_set and tile_bitmap_clear
+ *
+ * Description:
+ *   Mark tiles as used or free in the tile allocation table.
+ *
+ * Input Parameters:
+ *   priv   - Pointer to the tile state
+ *   idx    - Index of the first tile
+ *   ntiles - Number of tiles
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void tile_bitmap_set(FAR struct tile_s *priv, unsigned int idx,
+                     unsigned int ntiles);
+void tile_bitmap_clear(FAR struct tile_s *priv, unsigned int idx,
+                       unsigned int ntiles);
+
+/****************************************************************************
+ * Name: tile_bitmap_isclear
+ *
+ * Description:
+ *   Check that all of specified tiles are free.
+ *
+ * Input Parameters:
+ *   priv   - Pointer to the tile state
+ *   idx    - Index of the first tile
+ *   ntiles - Number of tiles
+ *
+ * Returned Value:
+ *   true if all tiles are free.
+ *
+ ****************************************************************************/
+
+bool tile_bitmap_isclear(FAR struct tile_s *priv, unsigned int idx,
+                         unsigned int ntiles);
+
+/****************************************************************************
+ * Name: tile_bitmap_nextfree and tile_bitmap_nextused
+ *
+ * Description:
+ *   Search the first free (or used) tile at or after the index.
+ *
+ * Input Parameters:
+ *   priv - Pointer to the tile state
+ *   idx  - Index to start search
+ *
+ * Returned Value:
+ *   Index of found tile, or priv->ntiles if not found.
+ *
+ ****************************************************************************/
+
+unsigned int tile_bitmap_nextfree(FAR struct tile_s *priv, unsigned int idx);
+unsigned int tile_bitmap_nextused(FAR struct tile_s *priv, unsigned int idx);
+
+/****************************************************************************
+ * Name: tile_bitmap_findrun
+ *
+ * Description:
+ *   Find free tiles for the allocation with best fit strategy.  The
+ *   smallest free region which can hold the requested tiles is chosen, so
+ *   the large free regions are left for the large requests.
+ *
+ * Input Parameters:
+ *   priv   - Pointer to the tile state
+ *   ntiles - Number of tiles to be allocated
+ *   align  - Alignment in number of tiles, must be a power of 2
+ *
+ * Returned Value:
+ *   Index of the first tile, or a negated errno on failure.
+ *
+ ****************************************************************************/
+
+int tile_bitmap_findrun(FAR struct tile_s *priv, unsigned int ntiles,
+                        unsigned int align);
+
 #endif /* __MODULES_ASMP_MM_MM_TILE_H */
@@ -59,11 +59,13 @@
  * Name: tile_common_alloc
  *
  * Description:
- *   Allocate memory from the tile heap.
+ *   Allocate memory from the tile heap.  The smallest free region which
+ *   can hold the requested tiles is chosen to reduce fragmentation.
  *
  * Input Parameters:
- *   priv - The tile heap state structure.
- *   size - The size of the memory region to allocate.
+ *   priv      - The tile heap state structure.
+ *   size      - The size of the memory region to allocate.
+ *   log2align - Log base 2 of the alignment, 0 for tile alignment.
  *
  * Returned Value:
  *   On success, a non-NULL pointer to the allocated memory is returned.
@@ -73,11 +75,9 @@
 static FAR void *tile_common_alloc(FAR struct tile_s *priv, size_t size,
                                    int log2align)
 {
-  uintptr_t    addr;
-  uint32_t     mask;
-  unsigned int idx;
   unsigned int ntiles;
-  unsigned int step;
+  unsigned int align;
+  int          idx;
 
   if (!priv)
     {
@@ -91,55 +91,51 @@ static FAR void *tile_common_alloc(FAR struct tile_s *priv, size_t size,
       return NULL;
     }
 
-  tile_enter_critical(priv);
+  /* Alignment in number of tiles */
 
-  if (log2align == 0)
+  if (log2align > priv->log2tile)
     {
-      step = 1;
+      align = 1 << (log2align - priv->log2tile);
     }
   else
     {
-      step = log2align - priv->log2tile + 1;
+      align = 1;
     }
 
   ntiles = ALIGNUP(size, priv->log2tile) >> priv->log2tile;
-  mask = 0xffffffff >> (32 - ntiles);
-
   if (ntiles > priv->ntiles)
     {
-      goto alloc_error;
+      return NULL;
     }
 
   tinfo("size = %u\n", size);
   tinfo("number of tiles = %d\n", ntiles);
-  tinfo("mask = %08x\n", mask);
 
-  addr = priv->heapstart;
+  tile_enter_critical(priv);
 
-  for (idx = 0; idx < (priv->ntiles - ntiles + 1); idx += step)
+  idx = tile_bitmap_findrun(priv, ntiles, align);
+  if (idx < 0)
     {
-      if ((priv->at & mask) == 0)
-        {
-          /* Found enough area to be assigned for requested size.
-           * Mark bits and return assigned memory address.
-           */
+      /* Memory couldn't assigned */
 
-          priv->at |= mask;
-          tile_leave_critical(priv);
-          return (FAR void *)addr;
-        }
+      tile_leave_critical(priv);
+      return NULL;
+    }
 
-      /* Step forward to next assign candidate address */
+  tinfo("alloc idx = %d\n", idx);
 
-      mask <<= step;
-      addr += 1 << (priv->log2tile + step - 1);
-    }
+  /* Mark tiles as used, and power on them while the AT is locked, so
+   * tile_free() never sees the tiles half initialized.
+   */
 
-  /* Memory couldn't assigned */
+  tile_bitmap_set(priv, idx, ntiles);
+  up_pmramctrl(PMCMD_RAM_ON,
+               priv->heapstart + ((uintptr_t)idx << priv->log2tile),
+               ntiles << priv->log2tile);
 
-alloc_error:
   tile_leave_critical(priv);
-  return NULL;
+
+  return (FAR void *)(priv->heapstart + ((uintptr_t)idx << priv->log2tile));
 }
 
 /****************************************************************************
@@ -162,20 +158,7 @@ alloc_error:
 
 FAR void *tile_alloc(size_t size)
 {
-  FAR struct tile_s *priv = g_tileinfo;
-  void              *addr;
-  size_t             tsize;
-
-  addr = tile_common_alloc(priv, size, 0);
-  if (addr)
-    {
-      /* Tile power on if allocated successfully. */
-
-      tsize = ALIGNUP(size, priv->log2tile);
-      up_pmramctrl(PMCMD_RAM_ON, (uintptr_t)addr, tsize);
-    }
-
-  return addr;
+  return tile_common_alloc(g_tileinfo, size, 0);
 }
 
 /****************************************************************************
@@ -184,10 +167,6 @@ FAR void *tile_alloc(size_t size)
  * Description:
  *   Allocate aligned memory from the tile heap.
  *
- *   NOTE: The current implementation also restricts the maximum allocation
- *   size to 32 tiles.  That restriction could be eliminated with some
- *   additional coding effort.
- *
  * Input Parameters:
  *   size      - The size of the memory region to allocate.
  *   log2align - Log base 2 of the alignment
@@ -199,20 +178,7 @@ FAR void *tile_alloc(size_t size)
 
 FAR void *tile_alignalloc(size_t size, uint32_t log2align)
 {
-  FAR struct tile_s *priv = g_tileinfo;
-  void              *addr;
-  size_t             tsize;
-
-  addr = tile_common_alloc(priv, size, log2align);
-  if (addr)
-    {
-      /* Tile power on if allocated successfully. */
-
-      tsize = ALIGNUP(size, priv->log2tile);
-      up_pmramctrl(PMCMD_RAM_ON, (uintptr_t)addr, tsize);
-    }
-
-  return addr;
+  return tile_common_alloc(g_tileinfo, size, log2align);
 }
 
 #endif /* CONFIG_MM_TILE */
@@ -0,0 +1,223 @@
+/****************************************************************************
+ * modules/asmp/mm_tile/mm_tilebitmap.c
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sdk/config.h>
+
+#include <assert.h>
+#include <errno.h>
+
+#include <mm/tile.h>
+
+#include "mm_tile/mm_tile.h"
+
+#ifdef CONFIG_MM_TILE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tile_bitmap_mask
+ *
+ * Description:
+ *   Make bit mask of the tiles from idx to the end of the word, limited to
+ *   ntiles bits.  The number of bits in the mask is returned by *nbits.
+ *
+ ****************************************************************************/
+
+static inline uint32_t tile_bitmap_mask(unsigned int idx, unsigned int ntiles,
+                                        FAR unsigned int *nbits)
+{
+  unsigned int bit = idx & TILE_WORDMASK;
+  unsigned int n = TILE_WORDBITS - bit;
+
+  if (n > ntiles)
+    {
+      n = ntiles;
+    }
+
+  *nbits = n;
+  return (0xffffffff >> (TILE_WORDBITS - n)) << bit;
+}
+
+/****************************************************************************
+ * Name: tile_bitmap_next
+ *
+ * Description:
+ *   Search the first bit which is matched to the value.  invert is 0 to
+ *   search a used tile and 0xffffffff to search a free tile.
+ *
+ ****************************************************************************/
+
+static unsigned int tile_bitmap_next(FAR struct tile_s *priv,
+                                     unsigned int idx, uint32_t invert)
+{
+  unsigned int w;
+  uint32_t word;
+
+  if (idx >= priv->ntiles)
+    {
+      return priv->ntiles;
+    }
+
+  w = idx >> TILE_WORDSHIFT;
+  word = (priv->at[w] ^ invert) & (0xffffffff << (idx & TILE_WORDMASK));
+
+  /* Skip whole words, then pick the lowest bit in the found word */
+
+  while (word == 0)
+    {
+      if (++w >= priv->nwords)
+        {
+          return priv->ntiles;
+        }
+
+      word = priv->at[w] ^ invert;
+    }
+
+  idx = (w << TILE_WORDSHIFT) + TILE_CTZ(word);
+  return idx < priv->ntiles ? idx : priv->ntiles;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tile_bitmap_set and tile_bitmap_clear
+ ****************************************************************************/
+
+void tile_bitmap_set(FAR struct tile_s *priv, unsigned int idx,
+                     unsigned int ntiles)
+{
+  uint32_t mask;
+  unsigned int n;
+
+  DEBUGASSERT(idx + ntiles <= priv->ntiles);
+
+  while (ntiles > 0)
+    {
+      mask = tile_bitmap_mask(idx, ntiles, &n);
+      priv->at[idx >> TILE_WORDSHIFT] |= mask;
+      ntiles -= n;
+      idx += n;
+    }
+}
+
+void tile_bitmap_clear(FAR struct tile_s *priv, unsigned int idx,
+                       unsigned int ntiles)
+{
+  uint32_t mask;
+  unsigned int n;
+
+  DEBUGASSERT(idx + ntiles <= priv->ntiles);
+
+  while (ntiles > 0)
+    {
+      mask = tile_bitmap_mask(idx, ntiles, &n);
+      DEBUGASSERT((priv->at[idx >> TILE_WORDSHIFT] & mask) == mask);
+      priv->at[idx >> TILE_WORDSHIFT] &= ~mask;
+      ntiles -= n;
+      idx += n;
+    }
+}
+
+/****************************************************************************
+ * Name: tile_bitmap_isclear
+ ****************************************************************************/
+
+bool tile_bitmap_isclear(FAR struct tile_s *priv, unsigned int idx,
+                         unsigned int ntiles)
+{
+  return tile_bitmap_nextused(priv, idx) >= idx + ntiles;
+}
+
+/****************************************************************************
+ * Name: tile_bitmap_nextfree and tile_bitmap_nextused
+ ****************************************************************************/
+
+unsigned int tile_bitmap_nextfree(FAR struct tile_s *priv, unsigned int idx)
+{
+  return tile_bitmap_next(priv, idx, 0xffffffff);
+}
+
+unsigned int tile_bitmap_nextused(FAR struct tile_s *priv, unsigned int idx)
+{
+  return tile_bitmap_next(priv, idx, 0);
+}
+
+/****************************************************************************
+ * Name: tile_bitmap_findrun
+ ****************************************************************************/
+
+int tile_bitmap_findrun(FAR struct tile_s *priv, unsigned int ntiles,
+                        unsigned int align)
+{
+  unsigned int start;
+  unsigned int end;
+  unsigned int base;
+  unsigned int bestlen = 0;
+  int best = -ENOMEM;
+
+  DEBUGASSERT(align > 0 && (align & (align - 1)) == 0);
+
+  for (start = tile_bitmap_nextfree(priv, 0); start < priv->ntiles;
+       start = tile_bitmap_nextfree(priv, end))
+    {
+      end = tile_bitmap_nextused(priv, start);
+      base = (start + align - 1) & ~(align - 1);
+
+      if (base + ntiles <= end && (bestlen == 0 || end - start < bestlen))
+        {
+          best = base;
+          bestlen = end - start;
+
+          if (bestlen == ntiles)
+            {
+              /* Exactly fitted, no better region */
+
+              break;
+            }
+        }
+    }
+
+  return best;
+}
+
+#endif /* CONFIG_MM_TILE */
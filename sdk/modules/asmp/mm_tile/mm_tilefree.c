@@ -59,11 +59,12 @@
  * Name: tile_common_free
  *
  * Description:
- *   Return memory to the tile heap.
+ *   Return memory to the tile heap, and power off the freed tiles.
  *
  * Input Parameters:
- *   handle - The handle previously returned by tile_initialize
- *   memory - A pointer to memory previoiusly allocated by tile_alloc.
+ *   priv - The tile heap state structure.
+ *   addr - A pointer to memory previoiusly allocated by tile_alloc.
+ *   size - The size of the memory region.
  *
  * Returned Value:
  *   None
@@ -75,7 +76,9 @@ static inline void tile_common_free(FAR struct tile_s *priv, void *addr,
 {
   unsigned int idx;
   unsigned int ntiles;
-  unsigned int mask;
+  unsigned int blk;
+  unsigned int blktiles;
+  unsigned int end;
   uintptr_t heapend;
 
   DEBUGASSERT(priv);
@@ -90,20 +93,43 @@ static inline void tile_common_free(FAR struct tile_s *priv, void *addr,
   /* Check addr and size are in the heap */
 
   heapend = priv->heapstart + (priv->ntiles << priv->log2tile);
-  if (heapend < ((uintptr_t)addr + size))
+  if ((uintptr_t)addr < priv->heapstart ||
+      heapend < ((uintptr_t)addr + size))
     {
       goto finish;
     }
 
   idx = ((uintptr_t)addr - priv->heapstart) >> priv->log2tile;
   ntiles = ALIGNUP(size, priv->log2tile) >> priv->log2tile;
-  mask = (0xffffffff >> (32 - ntiles)) << idx;
 
-  tinfo("free idx = %u, ntiles = %u, mask = %08x\n", idx, ntiles, mask);
+  tinfo("free idx = %u, ntiles = %u\n", idx, ntiles);
+
+  tile_bitmap_clear(priv, idx, ntiles);
 
-  DEBUGASSERT((priv->at & mask) == mask);
+  /* Power off each power block in the freed region only when all of the
+   * tiles in the block are free.  A block may be shared with the other
+   * allocation if the tile is smaller than the power block.
+   */
+
+  blktiles = 1 << (TILE_LOG2PWRBLOCK - priv->log2tile);
+  end = idx + ntiles;
+
+  for (blk = idx & ~(blktiles - 1); blk < end; blk += blktiles)
+    {
+      unsigned int n = blktiles;
 
-  priv->at &= ~mask;
+      if (blk + n > priv->ntiles)
+        {
+          n = priv->ntiles - blk;
+        }
+
+      if (tile_bitmap_isclear(priv, blk, n))
+        {
+          up_pmramctrl(PMCMD_RAM_OFF,
+                       priv->heapstart + ((uintptr_t)blk << priv->log2tile),
+                       n << priv->log2tile);
+        }
+    }
 
 finish:
   tile_leave_critical(priv);
@@ -131,7 +157,6 @@ finish:
 void tile_free(FAR void *memory, size_t size)
 {
   FAR struct tile_s *priv = g_tileinfo;
-  size_t             tsize;
 
   if (!priv)
     {
@@ -141,32 +166,6 @@ void tile_free(FAR void *memory, size_t size)
     }
 
   tile_common_free(priv, memory, size);
-
-  /* Power off free tiles */
-
-  tsize = ALIGNUP(size, priv->log2tile);
-
-  if (priv->log2tile == 17)
-    {
-      /* If block size is 128KB, just do power off */
-
-      up_pmramctrl(PMCMD_RAM_OFF, (uintptr_t)memory, tsize);
-    }
-  else
-    {
-      uintptr_t    addr = (uintptr_t)memory;
-      unsigned int idx;
-
-      /* If 64KB block size, we need to check a same tile block is
-       * still in used.
-       */
-
-      idx = ((addr - priv->heapstart) >> 17) * 2;
-      if ((priv->at & (3 << idx)) == 0)
-        {
-          up_pmramctrl(PMCMD_RAM_OFF, (uintptr_t)memory, tsize);
-        }
-    }
 }
 
 #endif /* CONFIG_MM_TILE */
@@ -0,0 +1,120 @@
+/****************************************************************************
+ * modules/asmp/mm_tile/mm_tileinfo.c
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sdk/config.h>
+
+#include <errno.h>
+
+#include <mm/tile.h>
+
+#include "mm_tile/mm_tile.h"
+
+#ifdef CONFIG_MM_TILE
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tile_getinfo
+ *
+ * Description:
+ *   Report the usage and the fragmentation of the tile heap.
+ *
+ * Input Parameters:
+ *   info - Pointer to the structure to be filled
+ *
+ * Returned Value:
+ *   0 (OK) on success, or a negated errno on failure.
+ *
+ ****************************************************************************/
+
+int tile_getinfo(FAR struct tileinfo_s *info)
+{
+  FAR struct tile_s *priv = g_tileinfo;
+  unsigned int start;
+  unsigned int end;
+  unsigned int first;
+  unsigned int len;
+
+  if (!priv || !info)
+    {
+      return -EINVAL;
+    }
+
+  info->tilesize = 1 << priv->log2tile;
+  info->ntiles   = priv->ntiles;
+  info->nfree    = 0;
+  info->nregions = 0;
+  info->maxfree  = 0;
+  info->nmoves   = 0;
+
+  tile_enter_critical(priv);
+
+  first = tile_bitmap_nextfree(priv, 0);
+
+  for (start = first; start < priv->ntiles;
+       start = tile_bitmap_nextfree(priv, end))
+    {
+      end = tile_bitmap_nextused(priv, start);
+      len = end - start;
+
+      info->nfree += len;
+      info->nregions++;
+      if (len > info->maxfree)
+        {
+          info->maxfree = len;
+        }
+    }
+
+  /* All of used tiles after the first free tile must be moved to make a
+   * single free region.
+   */
+
+  if (first < priv->ntiles)
+    {
+      info->nmoves = (priv->ntiles - first) - info->nfree;
+    }
+
+  tile_leave_critical(priv);
+
+  return OK;
+}
+
+#endif /* CONFIG_MM_TILE */
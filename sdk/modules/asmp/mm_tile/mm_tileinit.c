@@ -88,6 +88,8 @@ static inline FAR struct tile_s *
 tile_common_initialize(FAR void *heapstart, size_t heapsize, uint8_t log2tile)
 {
   FAR struct tile_s *priv;
+  unsigned int ntiles;
+  unsigned int nwords;
 
   /* Check parameters if debug is on.  Note the size of a tile is
    * limited to 2**31 bytes and that the size of the tile must be greater
@@ -109,16 +111,19 @@ tile_common_initialize(FAR void *heapstart, size_t heapsize, uint8_t log2tile)
       return NULL;
     }
 
-  /* Allocate exact size of the structure, tile allocator supports less than
-   * or equal to 32 tiles for now.
-   */
+  ntiles = ALIGNUP(heapsize, log2tile) / (1 << log2tile);
+  nwords = TILE_NWORDS(ntiles);
+
+  /* Allocate the structure and the tile allocation table at once */
 
-  priv = kmm_zalloc(sizeof(struct tile_s));
+  priv = kmm_zalloc(sizeof(struct tile_s) + nwords * sizeof(uint32_t));
   if (priv)
     {
       priv->heapstart = (uintptr_t)heapstart;
       priv->log2tile = log2tile;
-      priv->ntiles = ALIGNUP(heapsize, log2tile) / (1 << log2tile);
+      priv->ntiles = ntiles;
+      priv->nwords = nwords;
+      priv->at = (FAR uint32_t *)(priv + 1);
       sem_init(&priv->exclsem, 0, 1);
     }
 
@@ -141,9 +146,6 @@ tile_common_initialize(FAR void *heapstart, size_t heapsize, uint8_t log2tile)
  *   The actual memory allocates will be 64 byte (wasting 17 bytes) and
  *   will be aligned at least to (1 << log2align).
  *
- *   NOTE: The current implementation also restricts the maximum allocation
- *   size to 32 tiles.
- *
  * Input Parameters:
  *   heapstart - Start of the tile allocation heap
  *   heapsize  - Size of heap in bytes
@@ -151,13 +153,24 @@ tile_common_initialize(FAR void *heapstart, size_t heapsize, uint8_t log2tile)
  *               Currently, only 16 and 17 are supported.
  *
  * Returned Value:
- *   On success, a non-NULL handle is returned that may be used with other
- *   tile allocator interfaces.
+ *   OK on success.  -EINVAL if log2tile is zero or larger than the power
+ *   block (TILE_LOG2PWRBLOCK), -ENOMEM if the allocator can not be set up.
  *
  ****************************************************************************/
 
 int tile_initialize(FAR void *heapstart, size_t heapsize, uint8_t log2tile)
 {
+  /* Power control works on whole TILE_LOG2PWRBLOCK blocks, and freeing
+   * counts the tiles in one block by (1 << (TILE_LOG2PWRBLOCK - log2tile)).
+   * A tile larger than the power block would make that shift negative.
+   */
+
+  if (log2tile == 0 || log2tile > TILE_LOG2PWRBLOCK)
+    {
+      terr("Tile size must not exceed the power block size.\n");
+      return -EINVAL;
+    }
+
   g_tileinfo = tile_common_initialize(heapstart, heapsize, log2tile);
   if (!g_tileinfo)
     {
@@ -0,0 +1,804 @@
+/****************************************************************************
+ * modules/asmp/mm_tile/test/test_tile.c
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host simulation of the tile allocator.  Alloc/free traces are replayed
+ * on the tile heap and on a first fit reference, as the allocator was
+ * before the best fit search, and the fragmentation of both is reported.
+ * up_pmramctrl() keeps the power state of each 128KB RAM block, which is
+ * checked after every operation: a block is on exactly while one of its
+ * tiles is allocated, so tile_free() releases each block once its last
+ * tile is freed.
+ *
+ * A trace file has one operation per line:
+ *   a <id> <size> [log2align]   Allocate
+ *   f <id>                      Free
+ * Without a trace file, random traces of count operations are replayed.
+ *
+ * Usage: test_tile [-b] [-t trace] [count]
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sdk/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include <mm/tile.h>
+#include <arch/chip/pm.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CHECK(cond) \
+  do \
+    { \
+      if (!(cond)) \
+        { \
+          printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+          g_failed++; \
+        } \
+    } \
+  while (0)
+
+/* The heap is never accessed, only its addresses are used. */
+
+#define HEAP_START   ((uintptr_t)0x0c000000)
+#define LOG2PWRBLOCK 17
+#define PWRBLOCK     (1 << LOG2PWRBLOCK)
+
+#define MAX_TILES    128
+#define MAX_IDS      256
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct heapcfg_s
+{
+  FAR const char *name;
+  uint8_t        log2tile;
+  size_t         heapsize;
+};
+
+struct op_s
+{
+  char     type;      /* 'a' or 'f' */
+  int      id;
+  size_t   size;
+  uint32_t log2align;
+};
+
+/* First fit allocation of tiles, the reference */
+
+struct firstfit_s
+{
+  bool used[MAX_TILES];
+  int  ntiles;
+};
+
+struct frag_s
+{
+  unsigned int allocs;
+  unsigned int fails;     /* Failed while enough tiles were free */
+  unsigned long regions;  /* Sum of free regions after each operation */
+  unsigned long maxfree;  /* Sum of the largest free region */
+  unsigned int samples;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct heapcfg_s g_cfgs[] =
+{
+  { "64KB x 23 ", 16, 23 << 16 },  /* Last power block is half */
+  { "128KB x 12", 17, 12 << 17 },
+  { "64KB x 80 ", 16, 80 << 16 },  /* Three words of bitmap */
+};
+
+static int g_failed;
+
+/* Simulated state */
+
+static const struct heapcfg_s *g_cfg;
+static int          g_ntiles;
+static int          g_owner[MAX_TILES];    /* Allocation id, or -1 */
+static bool         g_pwron[MAX_TILES];    /* Power of each 128KB block */
+static unsigned int g_nblocks;
+static unsigned int g_pmcalls;
+
+static FAR void     *g_addr[MAX_IDS];
+static size_t       g_size[MAX_IDS];
+static int          g_ffidx[MAX_IDS];
+static struct firstfit_s g_ff;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_pmramctrl
+ *
+ * Description:
+ *   Stub of the RAM power control.  The range must be in the heap, and
+ *   must be whole power blocks to be powered off.
+ *
+ ****************************************************************************/
+
+int up_pmramctrl(int cmd, uintptr_t addr, size_t size)
+{
+  uintptr_t    heapend = HEAP_START + ((uintptr_t)g_ntiles << g_cfg->log2tile);
+  unsigned int blk;
+
+  g_pmcalls++;
+
+  CHECK(addr >= HEAP_START && addr + size <= heapend);
+  if (addr < HEAP_START || addr + size > heapend)
+    {
+      return -1;
+    }
+
+  if (cmd == PMCMD_RAM_OFF)
+    {
+      CHECK(((addr - HEAP_START) & (PWRBLOCK - 1)) == 0);
+      CHECK((size & (PWRBLOCK - 1)) == 0 || addr + size == heapend);
+    }
+
+  for (blk = (addr - HEAP_START) >> LOG2PWRBLOCK;
+       blk < g_nblocks && HEAP_START + ((uintptr_t)blk << LOG2PWRBLOCK) <
+       addr + size;
+       blk++)
+    {
+      g_pwron[blk] = (cmd != PMCMD_RAM_OFF);
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint64_t now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static unsigned int ntiles_of(size_t size)
+{
+  return (size + (1u << g_cfg->log2tile) - 1) >> g_cfg->log2tile;
+}
+
+static unsigned int align_of(uint32_t log2align)
+{
+  return log2align > g_cfg->log2tile ?
+         1u << (log2align - g_cfg->log2tile) : 1;
+}
+
+/****************************************************************************
+ * Name: sim_start
+ ****************************************************************************/
+
+static void sim_start(FAR const struct heapcfg_s *cfg)
+{
+  int i;
+
+  g_cfg     = cfg;
+  g_ntiles  = cfg->heapsize >> cfg->log2tile;
+  g_nblocks = (cfg->heapsize + PWRBLOCK - 1) >> LOG2PWRBLOCK;
+  g_pmcalls = 0;
+
+  for (i = 0; i < MAX_TILES; i++)
+    {
+      g_owner[i]   = -1;
+      g_pwron[i]   = true;
+      g_ff.used[i] = false;
+    }
+
+  g_ff.ntiles = g_ntiles;
+
+  for (i = 0; i < MAX_IDS; i++)
+    {
+      g_addr[i]  = NULL;
+      g_ffidx[i] = -1;
+    }
+
+  CHECK(tile_initialize((FAR void *)HEAP_START, cfg->heapsize,
+                        cfg->log2tile) == OK);
+}
+
+/****************************************************************************
+ * Name: check_state
+ *
+ * Description:
+ *   The power and the report of tile_getinfo() agree with the tiles
+ *   allocated by the trace.
+ *
+ ****************************************************************************/
+
+static void check_state(void)
+{
+  struct tileinfo_s info;
+  unsigned int      blk;
+  int               nfree    = 0;
+  int               nregions = 0;
+  int               maxfree  = 0;
+  int               run      = 0;
+  int               i;
+  int               t;
+  bool              used;
+
+  for (blk = 0; blk < g_nblocks; blk++)
+    {
+      used = false;
+      for (t = 0; t < g_ntiles; t++)
+        {
+          if (g_owner[t] >= 0 &&
+              ((unsigned int)t << g_cfg->log2tile) >> LOG2PWRBLOCK == blk)
+            {
+              used = true;
+            }
+        }
+
+      if (used != g_pwron[blk])
+        {
+          printf("block %u: %s but %s\n", blk, used ? "used" : "free",
+                 g_pwron[blk] ? "on" : "off");
+          g_failed++;
+        }
+    }
+
+  for (i = 0; i <= g_ntiles; i++)
+    {
+      if (i < g_ntiles && g_owner[i] < 0)
+        {
+          nfree++;
+          run++;
+          continue;
+        }
+
+      if (run)
+        {
+          nregions++;
+          if (run > maxfree)
+            {
+              maxfree = run;
+            }
+        }
+
+      run = 0;
+    }
+
+  CHECK(tile_getinfo(&info) == OK);
+  CHECK(info.ntiles == g_ntiles);
+  CHECK(info.nfree == nfree);
+  CHECK(info.nregions == nregions);
+  CHECK(info.maxfree == maxfree);
+}
+
+/****************************************************************************
+ * Name: ff_alloc and ff_free
+ *
+ * Description:
+ *   The reference, the lowest tiles that fit.
+ *
+ ****************************************************************************/
+
+static int ff_alloc(unsigned int ntiles, unsigned int align)
+{
+  unsigned int idx;
+  unsigned int i;
+
+  for (idx = 0; idx + ntiles <= (unsigned int)g_ff.ntiles; idx += align)
+    {
+      for (i = 0; i < ntiles && !g_ff.used[idx + i]; i++);
+      if (i == ntiles)
+        {
+          for (i = 0; i < ntiles; i++)
+            {
+              g_ff.used[idx + i] = true;
+            }
+
+          return idx;
+        }
+    }
+
+  return -1;
+}
+
+static void ff_free(int idx, unsigned int ntiles)
+{
+  unsigned int i;
+
+  for (i = 0; i < ntiles; i++)
+    {
+      g_ff.used[idx + i] = false;
+    }
+}
+
+/* Free tiles, free regions and the largest of the reference */
+
+static void ff_frag(FAR int *nfree, FAR int *nregions, FAR int *maxfree)
+{
+  int run = 0;
+  int i;
+
+  *nfree = *nregions = *maxfree = 0;
+
+  for (i = 0; i <= g_ff.ntiles; i++)
+    {
+      if (i < g_ff.ntiles && !g_ff.used[i])
+        {
+          (*nfree)++;
+          run++;
+          continue;
+        }
+
+      if (run)
+        {
+          (*nregions)++;
+          if (run > *maxfree)
+            {
+              *maxfree = run;
+            }
+        }
+
+      run = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: replay_op
+ ****************************************************************************/
+
+static void replay_op(FAR const struct op_s *op, FAR struct frag_s *tile,
+                      FAR struct frag_s *ff)
+{
+  struct tileinfo_s info;
+  unsigned int      ntiles;
+  unsigned int      align;
+  unsigned int      idx;
+  unsigned int      i;
+  FAR void          *addr;
+  int               nfree;
+  int               nregions;
+  int               maxfree;
+
+  if (op->id < 0 || op->id >= MAX_IDS)
+    {
+      return;
+    }
+
+  ntiles = ntiles_of(op->type == 'a' ? op->size : g_size[op->id]);
+
+  if (op->type == 'a')
+    {
+      if (g_addr[op->id] || g_ffidx[op->id] >= 0)
+        {
+          return;
+        }
+
+      align = align_of(op->log2align);
+      g_size[op->id] = op->size;
+
+      /* Tile allocator */
+
+      tile_getinfo(&info);
+      tile->allocs++;
+      addr = tile_alignalloc(op->size, op->log2align);
+      if (addr)
+        {
+          idx = ((uintptr_t)addr - HEAP_START) >> g_cfg->log2tile;
+          CHECK(((uintptr_t)addr - HEAP_START) %
+                ((uintptr_t)align << g_cfg->log2tile) == 0);
+          CHECK(idx + ntiles <= (unsigned int)g_ntiles);
+          for (i = 0; i < ntiles && idx + i < (unsigned int)g_ntiles; i++)
+            {
+              CHECK(g_owner[idx + i] < 0);
+              g_owner[idx + i] = op->id;
+            }
+
+          g_addr[op->id] = addr;
+        }
+      else if (info.nfree >= (int)ntiles && op->size > 0)
+        {
+          tile->fails++;
+        }
+
+      /* Reference */
+
+      ff_frag(&nfree, &nregions, &maxfree);
+      ff->allocs++;
+      g_ffidx[op->id] = ff_alloc(ntiles, align);
+      if (g_ffidx[op->id] < 0 && nfree >= (int)ntiles)
+        {
+          ff->fails++;
+        }
+    }
+  else
+    {
+      if (g_addr[op->id])
+        {
+          idx = ((uintptr_t)g_addr[op->id] - HEAP_START) >> g_cfg->log2tile;
+          tile_free(g_addr[op->id], g_size[op->id]);
+          for (i = 0; i < ntiles; i++)
+            {
+              g_owner[idx + i] = -1;
+            }
+
+          g_addr[op->id] = NULL;
+        }
+
+      if (g_ffidx[op->id] >= 0)
+        {
+          ff_free(g_ffidx[op->id], ntiles);
+          g_ffidx[op->id] = -1;
+        }
+    }
+
+  check_state();
+
+  tile_getinfo(&info);
+  tile->regions += info.nregions;
+  tile->maxfree += info.maxfree;
+  tile->samples++;
+
+  ff_frag(&nfree, &nregions, &maxfree);
+  ff->regions += nregions;
+  ff->maxfree += maxfree;
+  ff->samples++;
+}
+
+/****************************************************************************
+ * Name: replay
+ ****************************************************************************/
+
+static void replay(FAR const struct heapcfg_s *cfg, FAR const struct op_s *ops,
+                   size_t nops)
+{
+  struct frag_s tile;
+  struct frag_s ff;
+  size_t        i;
+  int           id;
+
+  memset(&tile, 0, sizeof(tile));
+  memset(&ff, 0, sizeof(ff));
+
+  sim_start(cfg);
+  check_state();
+
+  for (i = 0; i < nops; i++)
+    {
+      replay_op(&ops[i], &tile, &ff);
+    }
+
+  /* Free everything left, all blocks must be off. */
+
+  for (id = 0; id < MAX_IDS; id++)
+    {
+      if (g_addr[id] || g_ffidx[id] >= 0)
+        {
+          struct op_s op =
+          {
+            'f', id, 0, 0
+          };
+
+          replay_op(&op, &tile, &ff);
+        }
+    }
+
+  for (i = 0; i < g_nblocks; i++)
+    {
+      CHECK(!g_pwron[i]);
+    }
+
+  tile_release();
+
+  if (tile.samples)
+    {
+      printf("%s: %6u allocs, failed by fragmentation %5u / %5u, "
+             "free regions %.2f / %.2f, largest free %.1f / %.1f tiles "
+             "(best fit / first fit)\n",
+             cfg->name, tile.allocs, tile.fails, ff.fails,
+             (double)tile.regions / tile.samples,
+             (double)ff.regions / ff.samples,
+             (double)tile.maxfree / tile.samples,
+             (double)ff.maxfree / ff.samples);
+    }
+}
+
+/****************************************************************************
+ * Name: make_trace
+ *
+ * Description:
+ *   Random buffers of 1 to 4 tiles, a fifth of them aligned to the power
+ *   block, with up to 16 of them live.
+ *
+ ****************************************************************************/
+
+static size_t make_trace(FAR struct op_s *ops, size_t count)
+{
+  int    live[16];
+  int    nlive = 0;
+  int    nextid = 0;
+  size_t n;
+  int    k;
+
+  for (n = 0; n < count; n++)
+    {
+      if (nlive < 16 && (nlive == 0 || rand() % 100 < 55))
+        {
+          ops[n].type      = 'a';
+          ops[n].id        = nextid;
+          ops[n].size      = ((rand() % 4) + 1) * (64 << 10) -
+                             (rand() % (32 << 10));
+          ops[n].log2align = (rand() % 5 == 0) ? LOG2PWRBLOCK : 0;
+          live[nlive++]    = nextid;
+          nextid           = (nextid + 1) % MAX_IDS;
+        }
+      else
+        {
+          k             = rand() % nlive;
+          ops[n].type   = 'f';
+          ops[n].id     = live[k];
+          live[k]       = live[--nlive];
+        }
+    }
+
+  return n;
+}
+
+/****************************************************************************
+ * Name: load_trace
+ ****************************************************************************/
+
+static FAR struct op_s *load_trace(FAR const char *path, FAR size_t *nops)
+{
+  FAR struct op_s *ops = NULL;
+  FAR FILE        *fp;
+  char            line[128];
+  size_t          n   = 0;
+  size_t          max = 0;
+  unsigned long   size;
+  unsigned int    log2align;
+  int             id;
+
+  fp = fopen(path, "r");
+  if (!fp)
+    {
+      printf("%s: can not open\n", path);
+      return NULL;
+    }
+
+  while (fgets(line, sizeof(line), fp))
+    {
+      if (n == max)
+        {
+          max = max ? max * 2 : 256;
+          ops = realloc(ops, max * sizeof(*ops));
+        }
+
+      log2align = 0;
+      if (sscanf(line, "a %d %lu %u", &id, &size, &log2align) >= 2)
+        {
+          ops[n].type = 'a';
+          ops[n].size = size;
+        }
+      else if (sscanf(line, "f %d", &id) == 1)
+        {
+          ops[n].type = 'f';
+          ops[n].size = 0;
+        }
+      else
+        {
+          continue;
+        }
+
+      ops[n].id        = id;
+      ops[n].log2align = log2align;
+      n++;
+    }
+
+  fclose(fp);
+
+  *nops = n;
+  return ops;
+}
+
+/****************************************************************************
+ * Name: test_release
+ *
+ * Description:
+ *   Power blocks shared by two allocations of 64KB tiles are released
+ *   with the last of them, and the half block at the end of the heap.
+ *
+ ****************************************************************************/
+
+static void test_release(void)
+{
+  FAR void *a;
+  FAR void *b;
+  FAR void *c;
+
+  sim_start(&g_cfgs[0]);
+
+  CHECK(!g_pwron[0] && !g_pwron[g_nblocks - 1]);
+
+  a = tile_alloc(64 << 10);
+  b = tile_alloc(64 << 10);
+  CHECK((uintptr_t)a == HEAP_START);
+  CHECK((uintptr_t)b == HEAP_START + (64 << 10));
+  CHECK(g_pwron[0] && !g_pwron[1]);
+
+  tile_free(a, 64 << 10);
+  CHECK(g_pwron[0]);
+  tile_free(b, 64 << 10);
+  CHECK(!g_pwron[0]);
+
+  /* Only the last tile fits, a block of the heap end is half. */
+
+  a = tile_alloc(22 << 16);
+  c = tile_alloc(1);
+  CHECK((uintptr_t)c == HEAP_START + (22 << 16));
+  CHECK(g_pwron[g_nblocks - 1]);
+  tile_free(c, 1);
+  CHECK(!g_pwron[g_nblocks - 1]);
+  CHECK(g_pwron[g_nblocks - 2]);
+  tile_free(a, 22 << 16);
+  CHECK(!g_pwron[0] && !g_pwron[g_nblocks - 2]);
+
+  /* Out of the heap, ignored. */
+
+  g_pmcalls = 0;
+  tile_free((FAR void *)(HEAP_START + (23 << 16)), 64 << 10);
+  tile_free(NULL, 64 << 10);
+  CHECK(g_pmcalls == 0);
+
+  tile_release();
+}
+
+/****************************************************************************
+ * Name: bench
+ ****************************************************************************/
+
+static void bench(FAR const struct op_s *ops, size_t nops)
+{
+  FAR void *addr[MAX_IDS];
+  size_t   size[MAX_IDS];
+  uint64_t start;
+  size_t   i;
+  size_t   c;
+
+  for (c = 0; c < sizeof(g_cfgs) / sizeof(g_cfgs[0]); c++)
+    {
+      sim_start(&g_cfgs[c]);
+      memset(addr, 0, sizeof(addr));
+
+      start = now_ns();
+      for (i = 0; i < nops; i++)
+        {
+          if (ops[i].type == 'a')
+            {
+              addr[ops[i].id] = tile_alignalloc(ops[i].size,
+                                                ops[i].log2align);
+              size[ops[i].id] = ops[i].size;
+            }
+          else if (addr[ops[i].id])
+            {
+              tile_free(addr[ops[i].id], size[ops[i].id]);
+              addr[ops[i].id] = NULL;
+            }
+        }
+
+      printf("%s: %.1f ns per operation\n", g_cfgs[c].name,
+             (double)(now_ns() - start) / nops);
+
+      tile_release();
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  FAR struct op_s *ops;
+  FAR const char  *path = NULL;
+  size_t          count = 20000;
+  size_t          nops;
+  bool            dobench = false;
+  size_t          c;
+  int             i;
+
+  for (i = 1; i < argc; i++)
+    {
+      if (strcmp(argv[i], "-b") == 0)
+        {
+          dobench = true;
+        }
+      else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+          path = argv[++i];
+        }
+      else
+        {
+          count = strtoul(argv[i], NULL, 0);
+        }
+    }
+
+  srand(1);
+
+  test_release();
+
+  if (path)
+    {
+      ops = load_trace(path, &nops);
+    }
+  else
+    {
+      ops = malloc(count * sizeof(*ops));
+      nops = ops ? make_trace(ops, count) : 0;
+    }
+
+  if (!ops)
+    {
+      return 1;
+    }
+
+  for (c = 0; c < sizeof(g_cfgs) / sizeof(g_cfgs[0]); c++)
+    {
+      replay(&g_cfgs[c], ops, nops);
+    }
+
+  if (dobench)
+    {
+      bench(ops, nops);
+    }
+
+  free(ops);
+
+  printf("test_tile: %s\n", g_failed ? "FAILED" : "passed");
+  return g_failed ? 1 : 0;
+}
@@ -111,6 +111,10 @@ struct rawelf_loadinfo_s
   Elf32_Ehdr        ehdr;        /* Buffered ELF file header */
   FAR Elf32_Shdr    *shdr;       /* Buffered ELF section headers */
   uint8_t           *iobuffer;   /* File I/O buffer */
+  FAR Elf32_Sym     *symtab;     /* Buffered symbol table */
+  FAR char          *strtab;     /* Buffered symbol string table */
+  FAR uint32_t      *symhash;    /* Symbol hash table in .hash format */
+  off_t             filpos;      /* Current file position, -1 if unknown */
 
   /* Address environment.
    *
@@ -363,7 +367,8 @@ int rawelf_reallocbuffer(FAR struct rawelf_loadinfo_s *loadinfo, size_t incremen
  * Name: rawelf_getsymbolbyname
  *
  * Description:
- *   Get number of entries in symtab
+ *   Find a symbol by its name.  If the symbol table is loaded by
+ *   rawelf_loadsymtab(), the symbol is looked up in the hash table.
  *
  * Returned Value:
  *   0 (OK) is returned on success and a negated errno is returned on
@@ -375,4 +380,21 @@ int rawelf_getsymbolbyname(FAR struct rawelf_loadinfo_s *loadinfo,
                            FAR const char *name, size_t namelen,
                            FAR Elf32_Sym *sym);
 
+/****************************************************************************
+ * Name: rawelf_loadsymtab
+ *
+ * Description:
+ *   Read the whole symbol table and its string table into memory and
+ *   prepare a symbol hash table, so that rawelf_getsymbolbyname() does not
+ *   access the file.  The .hash section is used if it indexes the symbol
+ *   table, otherwise a hash table is built.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int rawelf_loadsymtab(FAR struct rawelf_loadinfo_s *loadinfo);
+
 #endif /* __ASMP_SUPERVISOR_RAWELF_RAWELF_H */
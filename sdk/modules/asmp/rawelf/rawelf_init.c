@@ -101,6 +101,10 @@ int rawelf_init(FAR struct rawelf_loadinfo_s *loadinfo)
 {
   int ret;
 
+  /* File position is unknown until the first read */
+
+  loadinfo->filpos = -1;
+
   ret = rawelf_read(loadinfo, (FAR uint8_t *)&loadinfo->ehdr, sizeof(Elf32_Ehdr), 0);
   if (ret < 0)
     {
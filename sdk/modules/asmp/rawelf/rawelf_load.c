@@ -150,6 +150,11 @@ static int rawelf_elfsize(struct rawelf_loadinfo_s *loadinfo)
  *   Read the section data into memory. Section addresses in the shdr[] are
  *   updated to point to the corresponding position in the memory.
  *
+ *   Sections which are laid out in the file in the same way as in the
+ *   memory are read by a single read, so that the file is read sequentially
+ *   with as few seeks as possible.  Alignment padding between such sections
+ *   is read together.
+ *
  * Returned Value:
  *   0 (OK) is returned on success and a negated errno is returned on
  *   failure.
@@ -159,12 +164,17 @@ static int rawelf_elfsize(struct rawelf_loadinfo_s *loadinfo)
 static inline int rawelf_loadfile(FAR struct rawelf_loadinfo_s *loadinfo)
 {
   FAR uint8_t *base, *mem;
+  FAR uint8_t *runmem = NULL;
+  off_t runoff = 0;
+  size_t runlen = 0;
+  size_t gap;
   int ret;
   int i;
 
-  /* Read each section into memory that is marked SHF_ALLOC + SHT_NOBITS */
+  /* Read each section into memory that is marked SHF_ALLOC and has data
+   * in the file.
+   */
 
-  binfo("Loaded sections:\n");
   base = (FAR uint8_t *)loadinfo->textalloc;
 
   for (i = 0; i < loadinfo->ehdr.e_shnum; i++)
@@ -172,41 +182,83 @@ static inline int rawelf_loadfile(FAR struct rawelf_loadinfo_s *loadinfo)
       FAR Elf32_Shdr *shdr = &loadinfo->shdr[i];
 
       /* SHF_ALLOC indicates that the section requires memory during
-       * execution */
+       * execution. SHT_NOBITS indicates that there is no data in the file
+       * for the section.
+       */
 
-      if ((shdr->sh_flags & SHF_ALLOC) == 0)
+      if ((shdr->sh_flags & SHF_ALLOC) == 0 || shdr->sh_type == SHT_NOBITS ||
+          shdr->sh_size == 0)
         {
           continue;
         }
 
       mem = base + shdr->sh_addr;
 
-      /* SHT_NOBITS indicates that there is no data in the file for the
-       * section.
+      /* Extend the current run if this section follows it both in the file
+       * and in the memory with the same alignment padding.
        */
 
-      if (shdr->sh_type != SHT_NOBITS)
+      if (runlen > 0 && shdr->sh_offset >= runoff + runlen)
         {
-          /* Read the section data from sh_offset to the memory region */
+          gap = shdr->sh_offset - (runoff + runlen);
+          if (mem == runmem + runlen + gap &&
+              gap < MAX(shdr->sh_addralign, 1))
+            {
+              runlen += gap + shdr->sh_size;
+              continue;
+            }
+        }
+
+      /* Otherwise, read the current run and start a new one */
 
-          ret = rawelf_read(loadinfo, mem, shdr->sh_size, shdr->sh_offset);
+      if (runlen > 0)
+        {
+          ret = rawelf_read(loadinfo, runmem, runlen, runoff);
           if (ret < 0)
             {
-              berr("ERROR: Failed to read section %d: %d\n", i, ret);
+              berr("ERROR: Failed to read sections at %lu: %d\n",
+                   (unsigned long)runoff, ret);
               return ret;
             }
         }
 
-      /* If there is no data in an allocated section, then the allocated
-       * section must be cleared.
-       */
+      runmem = mem;
+      runoff = shdr->sh_offset;
+      runlen = shdr->sh_size;
+    }
 
-      else
+  if (runlen > 0)
+    {
+      ret = rawelf_read(loadinfo, runmem, runlen, runoff);
+      if (ret < 0)
         {
-          memset(mem, 0, shdr->sh_size);
+          berr("ERROR: Failed to read sections at %lu: %d\n",
+               (unsigned long)runoff, ret);
+          return ret;
         }
+    }
 
-      /* Update sh_addr to point to copy in memory */
+  /* Clear sections without data, and update sh_addr of each allocated
+   * section to point to copy in memory
+   */
+
+  binfo("Loaded sections:\n");
+
+  for (i = 0; i < loadinfo->ehdr.e_shnum; i++)
+    {
+      FAR Elf32_Shdr *shdr = &loadinfo->shdr[i];
+
+      if ((shdr->sh_flags & SHF_ALLOC) == 0)
+        {
+          continue;
+        }
+
+      mem = base + shdr->sh_addr;
+
+      if (shdr->sh_type == SHT_NOBITS)
+        {
+          memset(mem, 0, shdr->sh_size);
+        }
 
       binfo("%d. %08lx->%08lx\n", i,
             (unsigned long)shdr->sh_addr, (unsigned long)mem);
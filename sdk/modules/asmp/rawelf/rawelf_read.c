@@ -123,15 +123,23 @@ int rawelf_read(FAR struct rawelf_loadinfo_s *loadinfo, FAR uint8_t *buffer,
 
   while (readsize > 0)
     {
-      /* Seek to the next read position */
+      /* Seek to the next read position, unless the file is already there
+       * (e.g. sequential reads of adjacent sections).
+       */
 
-      rpos = lseek(loadinfo->filfd, offset, SEEK_SET);
-      if (rpos != offset)
+      if (loadinfo->filpos != offset)
         {
-          int errval = errno;
-          berr("Failed to seek to position %lu: %d\n",
-               (unsigned long)offset, errval);
-          return -errval;
+          rpos = lseek(loadinfo->filfd, offset, SEEK_SET);
+          if (rpos != offset)
+            {
+              int errval = errno;
+              berr("Failed to seek to position %lu: %d\n",
+                   (unsigned long)offset, errval);
+              loadinfo->filpos = -1;
+              return -errval;
+            }
+
+          loadinfo->filpos = offset;
         }
 
       /* Read the file data at offset into the user buffer */
@@ -147,12 +155,14 @@ int rawelf_read(FAR struct rawelf_loadinfo_s *loadinfo, FAR uint8_t *buffer,
              {
                berr("Read from offset %lu failed: %d\n",
                     (unsigned long)offset, errval);
+               loadinfo->filpos = -1;
                return -errval;
              }
          }
        else if (nbytes == 0)
          {
            berr("Unexpected end of file\n");
+           loadinfo->filpos = -1;
            return -ENODATA;
          }
        else
@@ -160,6 +170,7 @@ int rawelf_read(FAR struct rawelf_loadinfo_s *loadinfo, FAR uint8_t *buffer,
            readsize -= nbytes;
            buffer   += nbytes;
            offset   += nbytes;
+           loadinfo->filpos = offset;
          }
     }
 
@@ -46,6 +46,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/kmalloc.h>
 #include <nuttx/symtab.h>
 
 #include "rawelf.h"
@@ -58,6 +59,19 @@
 #  define CONFIG_ELF_BUFFERINCR 32
 #endif
 
+#ifndef SHT_HASH
+#  define SHT_HASH 5
+#endif
+
+/* Layout of symbol hash table, same as .hash section:
+ * nbucket, nchain, bucket[nbucket], chain[nchain]
+ */
+
+#define RAWELF_HASH_NBUCKET(h)  ((h)[0])
+#define RAWELF_HASH_NCHAIN(h)   ((h)[1])
+#define RAWELF_HASH_BUCKET(h)   (&(h)[2])
+#define RAWELF_HASH_CHAIN(h)    (&(h)[2 + RAWELF_HASH_NBUCKET(h)])
+
 /****************************************************************************
  * Private Constant Data
  ****************************************************************************/
@@ -160,6 +174,156 @@ static int rawelf_symname(FAR struct rawelf_loadinfo_s *loadinfo,
   return OK;
 }
 
+/****************************************************************************
+ * Name: rawelf_hashname
+ *
+ * Description:
+ *   Calculate the System V ELF hash value of a symbol name, which is also
+ *   used by the .hash section.
+ *
+ ****************************************************************************/
+
+static uint32_t rawelf_hashname(FAR const char *name, size_t namelen)
+{
+  uint32_t h = 0;
+  uint32_t g;
+
+  while (namelen-- > 0 && *name != '\0')
+    {
+      h = (h << 4) + (uint8_t)*name++;
+      g = h & 0xf0000000;
+      if (g)
+        {
+          h ^= g >> 24;
+        }
+
+      h &= ~g;
+    }
+
+  return h;
+}
+
+/****************************************************************************
+ * Name: rawelf_loadhash
+ *
+ * Description:
+ *   Read the .hash section into memory if it indexes the symbol table.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ *   ENOENT - No .hash section for the symbol table
+ *
+ ****************************************************************************/
+
+static int rawelf_loadhash(FAR struct rawelf_loadinfo_s *loadinfo, int nsyms)
+{
+  FAR Elf32_Shdr *shdr;
+  int ret;
+  int i;
+
+  for (i = 1; i < loadinfo->ehdr.e_shnum; i++)
+    {
+      shdr = &loadinfo->shdr[i];
+      if (shdr->sh_type == SHT_HASH && shdr->sh_link == loadinfo->symtabidx)
+        {
+          break;
+        }
+    }
+
+  if (i >= loadinfo->ehdr.e_shnum || shdr->sh_size < 2 * sizeof(uint32_t))
+    {
+      return -ENOENT;
+    }
+
+  loadinfo->symhash = (FAR uint32_t *)kmm_malloc(shdr->sh_size);
+  if (!loadinfo->symhash)
+    {
+      return -ENOMEM;
+    }
+
+  ret = rawelf_read(loadinfo, (FAR uint8_t *)loadinfo->symhash,
+                    shdr->sh_size, shdr->sh_offset);
+
+  /* Verify that the table is consistent with the symbol table */
+
+  if (ret == OK &&
+      (RAWELF_HASH_NBUCKET(loadinfo->symhash) == 0 ||
+       RAWELF_HASH_NCHAIN(loadinfo->symhash) != nsyms ||
+       (2 + RAWELF_HASH_NBUCKET(loadinfo->symhash) + nsyms) *
+       sizeof(uint32_t) > shdr->sh_size))
+    {
+      ret = -ENOENT;
+    }
+
+  if (ret < 0)
+    {
+      kmm_free(loadinfo->symhash);
+      loadinfo->symhash = NULL;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: rawelf_buildhash
+ *
+ * Description:
+ *   Build a symbol hash table in the .hash format from the buffered symbol
+ *   table.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+static int rawelf_buildhash(FAR struct rawelf_loadinfo_s *loadinfo, int nsyms,
+                            size_t strsize)
+{
+  FAR uint32_t *bucket;
+  FAR uint32_t *chain;
+  FAR Elf32_Sym *sym;
+  uint32_t nbucket;
+  uint32_t b;
+  int i;
+
+  /* Use about a half of symbols as buckets, as ld does for .hash */
+
+  nbucket = nsyms / 2 + 1;
+
+  loadinfo->symhash = (FAR uint32_t *)
+    kmm_zalloc((2 + nbucket + nsyms) * sizeof(uint32_t));
+  if (!loadinfo->symhash)
+    {
+      return -ENOMEM;
+    }
+
+  RAWELF_HASH_NBUCKET(loadinfo->symhash) = nbucket;
+  RAWELF_HASH_NCHAIN(loadinfo->symhash)  = nsyms;
+  bucket = RAWELF_HASH_BUCKET(loadinfo->symhash);
+  chain  = RAWELF_HASH_CHAIN(loadinfo->symhash);
+
+  /* Symbol 0 is always undefined, and also terminates chains */
+
+  for (i = 1; i < nsyms; i++)
+    {
+      sym = &loadinfo->symtab[i];
+      if (sym->st_name == 0 || sym->st_name >= strsize)
+        {
+          continue;
+        }
+
+      b = rawelf_hashname(&loadinfo->strtab[sym->st_name], strsize) %
+          nbucket;
+      chain[i]  = bucket[b];
+      bucket[b] = i;
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -312,6 +476,99 @@ int rawelf_symvalue(FAR struct rawelf_loadinfo_s *loadinfo, FAR Elf32_Sym *sym)
   return OK;
 }
 
+/****************************************************************************
+ * Name: rawelf_loadsymtab
+ *
+ * Description:
+ *   Read the whole symbol table and its string table into memory and
+ *   prepare a symbol hash table, so that rawelf_getsymbolbyname() does not
+ *   access the file.  The .hash section is used if it indexes the symbol
+ *   table, otherwise a hash table is built.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int rawelf_loadsymtab(FAR struct rawelf_loadinfo_s *loadinfo)
+{
+  FAR Elf32_Shdr *symtab = &loadinfo->shdr[loadinfo->symtabidx];
+  FAR Elf32_Shdr *strtab = &loadinfo->shdr[loadinfo->strtabidx];
+  int nsyms = symtab->sh_size / sizeof(Elf32_Sym);
+  int ret;
+
+  loadinfo->symtab = (FAR Elf32_Sym *)kmm_malloc(symtab->sh_size);
+  loadinfo->strtab = (FAR char *)kmm_malloc(strtab->sh_size + 1);
+  if (!loadinfo->symtab || !loadinfo->strtab)
+    {
+      berr("Failed to allocate symbol table\n");
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  /* Read each table with a single read */
+
+  ret = rawelf_read(loadinfo, (FAR uint8_t *)loadinfo->symtab,
+                    symtab->sh_size, symtab->sh_offset);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  ret = rawelf_read(loadinfo, (FAR uint8_t *)loadinfo->strtab,
+                    strtab->sh_size, strtab->sh_offset);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  /* Make sure that the last name is terminated */
+
+  loadinfo->strtab[strtab->sh_size] = '\0';
+
+  ret = rawelf_loadhash(loadinfo, nsyms);
+  if (ret == -ENOENT)
+    {
+      ret = rawelf_buildhash(loadinfo, nsyms, strtab->sh_size);
+    }
+
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  return OK;
+
+errout:
+  if (loadinfo->symtab)
+    {
+      kmm_free(loadinfo->symtab);
+      loadinfo->symtab = NULL;
+    }
+
+  if (loadinfo->strtab)
+    {
+      kmm_free(loadinfo->strtab);
+      loadinfo->strtab = NULL;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: rawelf_getsymbolbyname
+ *
+ * Description:
+ *   Find a symbol by its name.  If the symbol table is loaded by
+ *   rawelf_loadsymtab(), the symbol is looked up in the hash table.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
 int rawelf_getsymbolbyname(struct rawelf_loadinfo_s *loadinfo,
                            FAR const char *name, size_t namelen,
                            FAR Elf32_Sym *sym)
@@ -321,6 +578,41 @@ int rawelf_getsymbolbyname(struct rawelf_loadinfo_s *loadinfo,
   int ret;
   int i;
 
+  if (loadinfo->symhash)
+    {
+      FAR uint32_t *hash = loadinfo->symhash;
+      size_t strsize = loadinfo->shdr[loadinfo->strtabidx].sh_size;
+      FAR const char *symname;
+      uint32_t nchain = RAWELF_HASH_NCHAIN(hash);
+      uint32_t idx;
+      uint32_t n;
+
+      idx = RAWELF_HASH_BUCKET(hash)[rawelf_hashname(name, namelen) %
+                                     RAWELF_HASH_NBUCKET(hash)];
+
+      /* Follow the chain, at most nchain times in case of a broken table */
+
+      for (n = 0; idx != 0 && idx < nchain && n < nchain; n++)
+        {
+          FAR Elf32_Sym *ent = &loadinfo->symtab[idx];
+
+          if (ent->st_name != 0 && ent->st_name < strsize)
+            {
+              symname = &loadinfo->strtab[ent->st_name];
+              if (strncmp(name, symname, namelen) == 0 &&
+                  symname[namelen] == '\0')
+                {
+                  *sym = *ent;
+                  return OK;
+                }
+            }
+
+          idx = RAWELF_HASH_CHAIN(hash)[idx];
+        }
+
+      return -ENOENT;
+    }
+
   for (i = 0; i < nents; i++)
     {
       ret = rawelf_readsym(loadinfo, i, sym);
@@ -123,5 +123,23 @@ int rawelf_freebuffers(struct rawelf_loadinfo_s *loadinfo)
       loadinfo->buflen    = 0;
     }
 
+  if (loadinfo->symtab)
+    {
+      kmm_free((FAR void *)loadinfo->symtab);
+      loadinfo->symtab    = NULL;
+    }
+
+  if (loadinfo->strtab)
+    {
+      kmm_free((FAR void *)loadinfo->strtab);
+      loadinfo->strtab    = NULL;
+    }
+
+  if (loadinfo->symhash)
+    {
+      kmm_free((FAR void *)loadinfo->symhash);
+      loadinfo->symhash   = NULL;
+    }
+
   return OK;
 }
@@ -93,6 +93,16 @@ static int rawelf_initsymtab(struct rawelf_loadinfo_s *loadinfo)
       return ret;
     }
 
+  /* Buffer the symbol table for fast lookup.  If there is not enough
+   * memory, symbols are read from the file one by one instead.
+   */
+
+  ret = rawelf_loadsymtab(loadinfo);
+  if (ret < 0)
+    {
+      mpinfo("Symbol table not buffered: %d\n", ret);
+    }
+
   /* Allocate an I/O buffer.  This buffer is used by elf_symname() to
    * accumulate the variable length symbol name.
    */
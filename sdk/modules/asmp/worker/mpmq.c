@@ -56,6 +56,28 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Record header in the ring buffer. Payload follows and the record is
+ * padded to 4 bytes. A record never wraps around the end of data area,
+ * MPMQ_RING_PADDING record is put to skip the rest of area instead.
+ */
+
+struct mpmq_rechdr
+{
+  uint16_t len;
+  int8_t   msgid;
+  uint8_t  reserved;
+};
+
+#define MPMQ_RING_PADDING  (-1)
+#define MPMQ_RING_ALIGN(x) (((x) + 3) & ~3)
+#define MPMQ_RING_DATA(r)  ((uint8_t *)(r) + sizeof(mpmq_ring_t))
+
+/* Ring buffer is shared with other CPU, so make sure the order of memory
+ * accesses between data and offsets.
+ */
+
+#define mpmq_ring_barrier() __sync_synchronize()
+
 union msg {
   uint32_t   word[2];
   struct {
@@ -74,6 +96,17 @@ union msg {
  * Private Functions
  ****************************************************************************/
 
+static void mpmq_ring_copy(void *dst, const void *src, size_t n)
+{
+  uint8_t *d = dst;
+  const uint8_t *s = src;
+
+  while (n--)
+    {
+      *d++ = *s++;
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -226,3 +259,213 @@ int mpmq_timedreceive(mpmq_t *mq, uint32_t *data, uint32_t ms)
   
   return m.msgid;
 }
+
+/**
+ * Initialize ring buffer for MP message queue
+ */
+
+int mpmq_ring_init(void *mem, size_t size, int8_t doorbell)
+{
+  mpmq_ring_t *ring = (mpmq_ring_t *)mem;
+  uint32_t datasize;
+
+  if (!ring || ((uintptr_t)mem & 3) || doorbell < 0 ||
+      size < MPMQ_RING_SIZE(2 * MPMQ_RING_HDRSIZE))
+    {
+      return -EINVAL;
+    }
+
+  /* Use the largest power of 2 area */
+
+  size -= sizeof(mpmq_ring_t);
+  datasize = 2 * MPMQ_RING_HDRSIZE;
+  while (datasize * 2 <= size)
+    {
+      datasize *= 2;
+    }
+
+  ring->head     = 0;
+  ring->tail     = 0;
+  ring->pending  = 0;
+  ring->size     = datasize;
+  ring->doorbell = doorbell;
+
+  mpmq_ring_barrier();
+
+  return OK;
+}
+
+/**
+ * Post message to ring buffer
+ */
+
+int mpmq_ring_post(mpmq_ring_t *ring, int8_t msgid, const void *payload,
+                   size_t len)
+{
+  struct mpmq_rechdr *hdr;
+  uint32_t head;
+  uint32_t pos;
+  uint32_t contig;
+  uint32_t reclen;
+  uint32_t need;
+
+  if (!ring || msgid < 0 || len > MPMQ_RING_MAXRECORD || (len && !payload))
+    {
+      return -EINVAL;
+    }
+
+  reclen = MPMQ_RING_HDRSIZE + MPMQ_RING_ALIGN(len);
+  if (reclen > ring->size / 2)
+    {
+      return -EINVAL;
+    }
+
+  head   = ring->head;
+  pos    = head & (ring->size - 1);
+  contig = ring->size - pos;
+
+  /* Need padding record if the record doesn't fit to the end of area */
+
+  need = contig < reclen ? contig + reclen : reclen;
+  if (ring->size - (head - ring->tail) < need)
+    {
+      return -EAGAIN;
+    }
+
+  if (contig < reclen)
+    {
+      hdr = (struct mpmq_rechdr *)(MPMQ_RING_DATA(ring) + pos);
+      hdr->len   = contig - MPMQ_RING_HDRSIZE;
+      hdr->msgid = MPMQ_RING_PADDING;
+      head += contig;
+      pos = 0;
+    }
+
+  hdr = (struct mpmq_rechdr *)(MPMQ_RING_DATA(ring) + pos);
+  hdr->len   = len;
+  hdr->msgid = msgid;
+  mpmq_ring_copy((uint8_t *)(hdr + 1), payload, len);
+
+  /* Publish the record after its contents are written */
+
+  mpmq_ring_barrier();
+  ring->head = head + reclen;
+
+  return OK;
+}
+
+/**
+ * Notify posted messages
+ */
+
+int mpmq_ring_kick(mpmq_t *mq, mpmq_ring_t *ring)
+{
+  if (!mq || !ring)
+    {
+      return -EINVAL;
+    }
+
+  /* Head must be visible before checking pending flag, or the receiver may
+   * go to sleep without reading the last messages.
+   */
+
+  mpmq_ring_barrier();
+
+  if (ring->pending)
+    {
+      return OK;
+    }
+
+  ring->pending = 1;
+
+  return mpmq_send(mq, ring->doorbell, 0);
+}
+
+/**
+ * Post and notify message
+ */
+
+int mpmq_ring_send(mpmq_t *mq, mpmq_ring_t *ring, int8_t msgid,
+                   const void *payload, size_t len)
+{
+  int ret;
+
+  ret = mpmq_ring_post(ring, msgid, payload, len);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return mpmq_ring_kick(mq, ring);
+}
+
+/**
+ * Receive message from ring buffer
+ */
+
+int mpmq_ring_receive(mpmq_ring_t *ring, void *buf, size_t bufsize,
+                      size_t *len)
+{
+  struct mpmq_rechdr *hdr;
+  uint32_t tail;
+
+  if (!ring || (bufsize && !buf))
+    {
+      return -EINVAL;
+    }
+
+  tail = ring->tail;
+
+  for (; ; )
+    {
+      if (ring->head == tail)
+        {
+          /* Clear pending flag to accept the next doorbell, and check
+           * again for the message posted while clearing.
+           */
+
+          ring->pending = 0;
+          mpmq_ring_barrier();
+
+          if (ring->head == tail)
+            {
+              return -EAGAIN;
+            }
+
+          ring->pending = 1;
+        }
+
+      /* Read the record after the head is observed */
+
+      mpmq_ring_barrier();
+
+      hdr = (struct mpmq_rechdr *)(MPMQ_RING_DATA(ring) +
+                                   (tail & (ring->size - 1)));
+      if (hdr->msgid != MPMQ_RING_PADDING)
+        {
+          break;
+        }
+
+      tail += MPMQ_RING_HDRSIZE + hdr->len;
+      ring->tail = tail;
+    }
+
+  if (len)
+    {
+      *len = hdr->len;
+    }
+
+  if (hdr->len > bufsize)
+    {
+      return -E2BIG;
+    }
+
+  mpmq_ring_copy(buf, (uint8_t *)(hdr + 1), hdr->len);
+
+  /* Release the record after its contents are read */
+
+  mpmq_ring_barrier();
+  ring->tail = tail + MPMQ_RING_HDRSIZE + MPMQ_RING_ALIGN(hdr->len);
+
+  return hdr->msgid;
+}
@@ -0,0 +1,234 @@
+/****************************************************************************
+ * modules/audio/components/customproc/micarray_component.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "micarray_component.h"
+
+S_ASSERT(MicArrayProc::CH_MAX == AS_MICARRAY_CH_MAX);
+S_ASSERT(MicArrayProc::DELAY_MAX == AS_MICARRAY_DELAY_MAX);
+
+/*--------------------------------------------------------------------
+    Class Methods
+  --------------------------------------------------------------------*/
+uint32_t MicArrayComponent::init(const InitComponentParam& param)
+{
+  uint32_t result = AS_ECODE_OK;
+
+  if (param.is_userdraw)
+    {
+      result = setParam(param.packet);
+    }
+  else
+    {
+      if (!m_proc.init(param.fixparam.ch_num,
+                       (param.fixparam.in_bitlength != AS_BITLENGTH_16)))
+        {
+          result = AS_ECODE_COMMAND_PARAM_CHANNEL_NUMBER;
+        }
+    }
+
+  ReqData req;
+
+  req.result = (result == AS_ECODE_OK);
+
+  m_req_que.push(req);
+
+  return result;
+}
+
+/*--------------------------------------------------------------------*/
+bool MicArrayComponent::exec(const ExecComponentParam& param)
+{
+  AsPcmDataParam output = param.input;
+  uint32_t sample       = param.input.sample;
+  bool result           = false;
+
+  output.mh = param.output_mh;
+
+  if (!param.output_mh.isNull() && (m_proc.get_ch_num() != 0))
+    {
+      void *in  = param.input.mh.getPa();
+      void *out = param.output_mh.getPa();
+
+      output.size = (m_mode == MicArrayPlanar) ?
+                    m_proc.planar(in, out, sample) :
+                    m_proc.beamform(in, out, sample);
+      result      = true;
+    }
+  else
+    {
+      output.size = 0;
+    }
+
+  return pushReq(output, result, ComponentExec);
+}
+
+/*--------------------------------------------------------------------*/
+bool MicArrayComponent::flush(const FlushComponentParam& param)
+{
+  AsPcmDataParam fls = { 0 };
+
+  fls.mh       = param.output_mh;
+  fls.is_valid = true;
+
+  /* Delay line starts from silence at next start. */
+
+  m_proc.reset();
+
+  return pushReq(fls, true, ComponentFlush);
+}
+
+/*--------------------------------------------------------------------*/
+bool MicArrayComponent::set(const SetComponentParam& param)
+{
+  AsPcmDataParam dummy = { 0 };
+
+  bool result = (setParam(param.packet) == AS_ECODE_OK);
+
+  pushReq(dummy, result, ComponentSet);
+
+  return result;
+}
+
+/*--------------------------------------------------------------------*/
+bool MicArrayComponent::recv_done(ComponentCmpltParam *cmplt)
+{
+  cmplt->output = m_req_que.top().pcm;
+  cmplt->result = m_req_que.top().result;
+
+  m_req_que.pop();
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+bool MicArrayComponent::recv_done(ComponentInformParam *info)
+{
+  memset(info, 0, sizeof(ComponentInformParam));
+
+  m_req_que.pop();
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+bool MicArrayComponent::recv_done(void)
+{
+  m_req_que.pop();
+
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+uint32_t MicArrayComponent::activate(ComponentCallback callback,
+                                     const char *dsp_name,
+                                     void *p_requester,
+                                     uint32_t *dsp_inf)
+{
+  m_p_requester = p_requester;
+  m_callback = callback;
+
+  return AS_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------*/
+bool MicArrayComponent::deactivate(void)
+{
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+uint32_t MicArrayComponent::setParam(const CustomProcPacket& packet)
+{
+  uint8_t ch_mask;
+
+  if (packet.addr == NULL)
+    {
+      return AS_ECODE_DSP_SET_ERROR;
+    }
+
+  if (m_mode == MicArrayPlanar)
+    {
+      if (packet.size < sizeof(AsMicFrontendPlanarParam))
+        {
+          return AS_ECODE_DSP_SET_ERROR;
+        }
+
+      ch_mask = reinterpret_cast<AsMicFrontendPlanarParam *>
+                  (packet.addr)->ch_mask;
+    }
+  else
+    {
+      if (packet.size < sizeof(AsMicFrontendBeamformParam))
+        {
+          return AS_ECODE_DSP_SET_ERROR;
+        }
+
+      AsMicFrontendBeamformParam *bf =
+        reinterpret_cast<AsMicFrontendBeamformParam *>(packet.addr);
+
+      if (!m_proc.set_delay(bf->delay))
+        {
+          return AS_ECODE_DSP_SET_ERROR;
+        }
+
+      ch_mask = bf->ch_mask;
+    }
+
+  m_proc.set_mask(ch_mask);
+
+  return AS_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------*/
+bool MicArrayComponent::pushReq(const AsPcmDataParam& pcm,
+                                bool result,
+                                ComponentEventType type)
+{
+  ReqData req;
+
+  req.pcm    = pcm;
+  req.result = result;
+
+  m_req_que.push(req);
+
+  ComponentCbParam cbpram;
+
+  cbpram.event_type = type;
+  cbpram.result     = result;
+
+  m_callback(&cbpram, m_p_requester);
+
+  return result;
+}
@@ -0,0 +1,107 @@
+/****************************************************************************
+ * modules/audio/components/customproc/micarray_component.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef _MICARRAY_COMPONENT_H_
+#define _MICARRAY_COMPONENT_H_
+
+#include "audio/audio_high_level_api.h"
+#include "audio/audio_frontend_api.h"
+#include "memutils/s_stl/queue.h"
+#include "components/component_base.h"
+#include "micarray_proc.h"
+
+__USING_WIEN2
+
+/* Pre process of mic array which runs on CPU.
+ * It converts interleaved capture data to planar, or to 1 channel by
+ * delay-and-sum beamforming. Fixed parameters (samples, channels,
+ * bit length) are given by init with is_userdraw == false, and channel
+ * selection or steering delays are given by init/set packet.
+ */
+
+class MicArrayComponent : public ComponentBase
+{
+public:
+  enum Mode
+  {
+    MicArrayPlanar = 0,
+    MicArrayBeamform,
+  };
+
+  MicArrayComponent(Mode mode)
+    : m_mode(mode)
+  {
+  }
+
+  ~MicArrayComponent() {}
+
+  virtual uint32_t init(const InitComponentParam& param);
+  virtual bool exec(const ExecComponentParam& param);
+  virtual bool flush(const FlushComponentParam& param);
+  virtual bool set(const SetComponentParam& param);
+  virtual bool recv_done(ComponentCmpltParam *cmplt);
+  virtual bool recv_done(ComponentInformParam *info);
+  virtual bool recv_done(void);
+  virtual uint32_t activate(ComponentCallback callback,
+                            const char *image_name,
+                            void *p_requester,
+                            uint32_t *dsp_inf);
+  virtual bool deactivate();
+
+private:
+  enum
+  {
+    MICARRAY_REQ_QUEUE_SIZE = 7,
+  };
+
+  struct ReqData
+  {
+    AsPcmDataParam pcm;
+    bool           result;
+  };
+
+  typedef s_std::Queue<ReqData, MICARRAY_REQ_QUEUE_SIZE> ReqQue;
+  ReqQue m_req_que;
+
+  Mode         m_mode;
+  MicArrayProc m_proc;
+
+  uint32_t setParam(const CustomProcPacket& packet);
+  bool pushReq(const AsPcmDataParam& pcm,
+               bool result,
+               ComponentEventType type);
+};
+
+#endif /* _MICARRAY_COMPONENT_H_ */
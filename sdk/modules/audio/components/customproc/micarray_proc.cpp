@@ -0,0 +1,244 @@
+/****************************************************************************
+ * modules/audio/components/customproc/micarray_proc.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <string.h>
+
+#include "micarray_proc.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+bool MicArrayProc::init(uint8_t ch_num, bool highres)
+{
+  if (ch_num > CH_MAX)
+    {
+      return false;
+    }
+
+  m_ch_num  = ch_num;
+  m_highres = highres;
+  m_ch_mask = (1 << ch_num) - 1;
+
+  memset(m_delay, 0, sizeof(m_delay));
+  reset();
+
+  return (ch_num != 0);
+}
+
+/*--------------------------------------------------------------------------*/
+void MicArrayProc::set_mask(uint8_t ch_mask)
+{
+  uint8_t all = (1 << m_ch_num) - 1;
+
+  ch_mask &= all;
+
+  m_ch_mask = (ch_mask == 0) ? all : ch_mask;
+}
+
+/*--------------------------------------------------------------------------*/
+bool MicArrayProc::set_delay(const uint16_t *delay)
+{
+  for (int ch = 0; ch < CH_MAX; ch++)
+    {
+      if (delay[ch] > DELAY_MAX)
+        {
+          return false;
+        }
+    }
+
+  memcpy(m_delay, delay, sizeof(m_delay));
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+void MicArrayProc::reset(void)
+{
+  memset(m_hist, 0, sizeof(m_hist));
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t MicArrayProc::planar(const void *in, void *out, uint32_t sample)
+{
+  if (m_highres)
+    {
+      do_planar(static_cast<const int32_t *>(in),
+                static_cast<int32_t *>(out),
+                sample);
+    }
+  else
+    {
+      do_planar(static_cast<const int16_t *>(in),
+                static_cast<int16_t *>(out),
+                sample);
+    }
+
+  return get_sel_ch_num() * sample * (m_highres ? 4 : 2);
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t MicArrayProc::beamform(const void *in, void *out, uint32_t sample)
+{
+  if (m_highres)
+    {
+      do_beamform(static_cast<const int32_t *>(in),
+                  static_cast<int32_t *>(out),
+                  sample);
+      update_hist(static_cast<const int32_t *>(in), sample);
+    }
+  else
+    {
+      do_beamform(static_cast<const int16_t *>(in),
+                  static_cast<int16_t *>(out),
+                  sample);
+      update_hist(static_cast<const int16_t *>(in), sample);
+    }
+
+  return sample * (m_highres ? 4 : 2);
+}
+
+/*--------------------------------------------------------------------------*/
+uint8_t MicArrayProc::get_sel_ch_num(void) const
+{
+  uint8_t num = 0;
+
+  for (uint8_t mask = m_ch_mask; mask != 0; mask &= mask - 1)
+    {
+      num++;
+    }
+
+  return num;
+}
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+template<typename T>
+void MicArrayProc::do_planar(const T *in, T *out, uint32_t sample)
+{
+  for (uint32_t ch = 0; ch < m_ch_num; ch++)
+    {
+      if (!(m_ch_mask & (1 << ch)))
+        {
+          continue;
+        }
+
+      const T *p_in = &in[ch];
+
+      for (uint32_t i = 0; i < sample; i++)
+        {
+          *out++ = *p_in;
+          p_in += m_ch_num;
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+template<typename T>
+void MicArrayProc::do_beamform(const T *in, T *out, uint32_t sample)
+{
+  /* Average is calculated as multiplying reciprocal of channels. */
+
+  const int64_t recip = (1 << 16) / get_sel_ch_num();
+
+  for (uint32_t top = 0; top < sample; top += BLOCK_SAMPLES)
+    {
+      uint32_t num = ((sample - top) < BLOCK_SAMPLES) ?
+                     (sample - top) : BLOCK_SAMPLES;
+      int64_t  acc[BLOCK_SAMPLES] = { 0 };
+
+      for (uint32_t ch = 0; ch < m_ch_num; ch++)
+        {
+          if (!(m_ch_mask & (1 << ch)))
+            {
+              continue;
+            }
+
+          /* Sample at (top + i - delay), which is in history if it is
+           * before the head of this frame.
+           */
+
+          int32_t pos = static_cast<int32_t>(top) - m_delay[ch];
+
+          for (uint32_t i = 0; i < num; i++, pos++)
+            {
+              acc[i] += (pos < 0) ?
+                m_hist[ch][DELAY_MAX + pos] :
+                in[pos * m_ch_num + ch];
+            }
+        }
+
+      for (uint32_t i = 0; i < num; i++)
+        {
+          out[top + i] = static_cast<T>((acc[i] * recip) >> 16);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+template<typename T>
+void MicArrayProc::update_hist(const T *in, uint32_t sample)
+{
+  /* Keep last samples of every channel for delay of next frame,
+   * including unselected ones so that selection can be changed
+   * while running.
+   */
+
+  for (uint32_t ch = 0; ch < m_ch_num; ch++)
+    {
+      int32_t *hist = m_hist[ch];
+      uint32_t keep = 0;
+
+      if (sample < DELAY_MAX)
+        {
+          keep = DELAY_MAX - sample;
+          memmove(hist, &hist[sample], keep * sizeof(int32_t));
+        }
+
+      const T *p_in = &in[(sample + keep - DELAY_MAX) * m_ch_num + ch];
+
+      for (uint32_t i = keep; i < DELAY_MAX; i++)
+        {
+          hist[i] = *p_in;
+          p_in += m_ch_num;
+        }
+    }
+}
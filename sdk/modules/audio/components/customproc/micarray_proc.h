@@ -0,0 +1,130 @@
+/****************************************************************************
+ * modules/audio/components/customproc/micarray_proc.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_AUDIO_COMPONENTS_CUSTOMPROC_MICARRAY_PROC_H
+#define __MODULES_AUDIO_COMPONENTS_CUSTOMPROC_MICARRAY_PROC_H
+
+/* Signal processing of mic array pre process.
+ *
+ * MicArrayProc converts interleaved capture data to planar, or to 1
+ * channel by delay-and-sum beamforming. It depends on nothing but
+ * standard types, so that it can be tested on host. MicArrayComponent
+ * wraps it as a component of MicFrontEnd.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+class MicArrayProc
+{
+public:
+  enum
+  {
+    CH_MAX        = 8,  /* Same as AS_MICARRAY_CH_MAX.    */
+    DELAY_MAX     = 64, /* Same as AS_MICARRAY_DELAY_MAX. */
+    BLOCK_SAMPLES = 64, /* Samples summed at once.        */
+  };
+
+  MicArrayProc()
+  {
+    init(0, false);
+  }
+
+  /* Set number of interleaved input channels, and sample width which is
+   * 32bit if highres is true, else 16bit. All channels are selected,
+   * delays are 0 and history is silence. Returns false if ch_num is
+   * out of range.
+   */
+
+  bool init(uint8_t ch_num, bool highres);
+
+  /* Select channels by bit mask (bit0 is 1st channel). Unused channels
+   * are ignored, and no selection means all channels.
+   */
+
+  void set_mask(uint8_t ch_mask);
+
+  /* Set steering delay of each channel (samples). Returns false without
+   * any change if a delay exceeds DELAY_MAX.
+   */
+
+  bool set_delay(const uint16_t *delay);
+
+  /* Clear history, so that delay line starts from silence. */
+
+  void reset(void);
+
+  /* Output selected channels in order, each of them continuous.
+   * Returns size of output (bytes).
+   */
+
+  uint32_t planar(const void *in, void *out, uint32_t sample);
+
+  /* Output average of selected channels each delayed by steering delay.
+   * Samples before the head of the frame are taken from previous frames.
+   * Returns size of output (bytes).
+   */
+
+  uint32_t beamform(const void *in, void *out, uint32_t sample);
+
+  uint8_t get_ch_num(void) const { return m_ch_num; }
+  uint8_t get_mask(void) const { return m_ch_mask; }
+  uint8_t get_sel_ch_num(void) const;
+
+private:
+  uint8_t  m_ch_num;
+  bool     m_highres;
+  uint8_t  m_ch_mask;
+  uint16_t m_delay[CH_MAX];
+  int32_t  m_hist[CH_MAX][DELAY_MAX];
+
+  template<typename T>
+  void do_planar(const T *in, T *out, uint32_t sample);
+
+  template<typename T>
+  void do_beamform(const T *in, T *out, uint32_t sample);
+
+  template<typename T>
+  void update_hist(const T *in, uint32_t sample);
+};
+
+#endif /* __MODULES_AUDIO_COMPONENTS_CUSTOMPROC_MICARRAY_PROC_H */
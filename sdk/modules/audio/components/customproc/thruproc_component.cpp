@@ -59,6 +59,7 @@ bool ThruProcComponent::exec(const ExecComponentParam& param)
   ComponentCbParam cbpram;
 
   cbpram.event_type = ComponentExec;
+  cbpram.result     = true;
 
   m_callback(&cbpram, m_p_requester);
 
@@ -82,6 +83,7 @@ bool ThruProcComponent::flush(const FlushComponentParam& param)
   ComponentCbParam cbpram;
 
   cbpram.event_type = ComponentFlush;
+  cbpram.result     = true;
 
   m_callback(&cbpram, m_p_requester);
 
@@ -98,6 +100,7 @@ bool ThruProcComponent::set(const SetComponentParam& param)
   ComponentCbParam cbpram;
 
   cbpram.event_type = ComponentSet;
+  cbpram.result     = true;
 
   m_callback(&cbpram, m_p_requester);
 
@@ -35,6 +35,73 @@
 
 #include "audio_dma_buffer.h"
 
+/* Word-wise paths assume that 1st sample is in lower halfword. */
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#  define AS_DMA_BUFFER_WORD_ACCESS
+#endif
+
+/*--------------------------------------------------------------------*/
+static void get_mic_input_hw(uint16_t sample,
+                             uint8_t channel,
+                             uint16_t *p_from,
+                             uint16_t *p_to)
+{
+  uint32_t i = 0;
+  uint8_t ch = 0;
+
+  for (i = 0; i < sample; i++)
+    {
+      for (ch = 0; ch < channel; ch++)
+        {
+          *p_to = *p_from;
+          p_to++;
+          p_from++;
+        }
+
+      p_from++;
+    }
+}
+
+#ifdef AS_DMA_BUFFER_WORD_ACCESS
+/*--------------------------------------------------------------------*/
+/* Skip dummy channel of 2 samples of (2 * K + 1) channels at once.
+ * Input is 2 * (K + 1) words and output is (2 * K + 1) words.
+ * Lower and upper halfword are packed by shift and or, which are
+ * compiled to PKHBT on Cortex-M4.
+ */
+
+template<int K>
+static uint32_t get_mic_input_word(uint16_t sample,
+                                   uint32_t *p_from,
+                                   uint32_t *p_to)
+{
+  uint32_t pairs = sample / 2;
+
+  for (uint32_t i = 0; i < pairs; i++)
+    {
+      int j;
+
+      for (j = 0; j < K; j++)
+        {
+          p_to[j] = p_from[j];
+        }
+
+      p_to[K] = (p_from[K] & 0xffff) | (p_from[K + 1] << 16);
+
+      for (j = 1; j <= K; j++)
+        {
+          p_to[K + j] = (p_from[K + j] >> 16) | (p_from[K + j + 1] << 16);
+        }
+
+      p_from += 2 * (K + 1);
+      p_to   += 2 * K + 1;
+    }
+
+  return pairs * 2;
+}
+#endif /* AS_DMA_BUFFER_WORD_ACCESS */
+
 /*--------------------------------------------------------------------*/
 /* AS_AudioDrvDmaGetMicInput is used
  * to skip invalid data when 16bit odd channel DMA.
@@ -45,22 +112,46 @@ void AS_AudioDrvDmaGetMicInput(uint16_t sample,
                                uint32_t dma_addr,
                                void *p_in_buff)
 {
-  uint32_t i = 0;
-  uint8_t ch = 0;
   uint16_t *p_from = (uint16_t *)dma_addr;
   uint16_t *p_to = (uint16_t *)p_in_buff;
+  uint32_t done = 0;
 
-  for (i = 0; i < sample; i++)
+#ifdef AS_DMA_BUFFER_WORD_ACCESS
+  if (((dma_addr | (uint32_t)(uintptr_t)p_in_buff) & 0x03) == 0)
     {
-      for (ch = 0; ch < channel; ch++)
+      uint32_t *p_from_w = (uint32_t *)p_from;
+      uint32_t *p_to_w = (uint32_t *)p_to;
+
+      switch (channel)
         {
-          *p_to = *p_from;
-          p_to++;
-          p_from++;
-        }
+          case 1:
+            done = get_mic_input_word<0>(sample, p_from_w, p_to_w);
+            break;
 
-      p_from++;
+          case 3:
+            done = get_mic_input_word<1>(sample, p_from_w, p_to_w);
+            break;
+
+          case 5:
+            done = get_mic_input_word<2>(sample, p_from_w, p_to_w);
+            break;
+
+          case 7:
+            done = get_mic_input_word<3>(sample, p_from_w, p_to_w);
+            break;
+
+          default:
+            break;
+        }
     }
+#endif /* AS_DMA_BUFFER_WORD_ACCESS */
+
+  /* Rest of samples (or all, if not aligned) by halfword. */
+
+  get_mic_input_hw(sample - done,
+                   channel,
+                   p_from + done * (channel + 1),
+                   p_to + done * channel);
 }
 
 /*--------------------------------------------------------------------*/
@@ -71,6 +162,23 @@ void AS_AudioDrvDmaGetMicInput(uint16_t sample,
 void AS_AudioDrvDmaGetSwapData(uint32_t dma_addr, uint16_t sample)
 {
   uint32_t i = 0;
+
+  if ((dma_addr & 0x03) == 0)
+    {
+      /* Lch and Rch are in one word, so that swap is rotation by 16bit
+       * (ROR on Cortex-M). It does not depend on byte order.
+       */
+
+      uint32_t *p_data = (uint32_t *)dma_addr;
+
+      for (i = 0; i < sample; i++)
+        {
+          p_data[i] = (p_data[i] >> 16) | (p_data[i] << 16);
+        }
+
+      return;
+    }
+
   uint16_t tmp_buffer;
   uint16_t *p_lch = (uint16_t *)dma_addr;
   uint16_t *p_rch = p_lch + 1;
@@ -85,4 +193,3 @@ void AS_AudioDrvDmaGetSwapData(uint32_t dma_addr, uint16_t sample)
       p_rch += 2;
     }
 }
-
@@ -65,6 +65,53 @@ static obs_AudioAttentionCb s_obs_attention_cb  = NULL;
 
 static AudioManager *s_mng = NULL;
 
+static AudioCommandTraceCb s_trace_cb = NULL;
+
+#if defined(AS_FEATURE_OUTPUTMIX_ENABLE) || defined(AS_FEATURE_PLAYER_ENABLE)
+/*
+ * Direct reply to the application for object level requests which the
+ * AudioManager did not issue itself. These must not go through the
+ * completion accounting of AudioManager.
+ */
+
+/*--------------------------------------------------------------------------*/
+static void send_direct_result(uint8_t  result_code,
+                               uint8_t  module_id,
+                               uint32_t error_code,
+                               uint32_t error_sub_code,
+                               uint8_t  instance_id)
+{
+  AudioResult packet;
+
+  packet.header.sub_code    = 0;
+  packet.header.instance_id = instance_id;
+
+  if (error_code == AS_ECODE_OK)
+    {
+      packet.header.packet_length = LENGTH_AUDRLT;
+      packet.header.result_code   = result_code;
+    }
+  else
+    {
+      packet.header.packet_length = LENGTH_AUDRLT_ERRORRESPONSE_MAX;
+      packet.header.result_code   = AUDRLT_ERRORRESPONSE;
+      packet.header.sub_code      = result_code;
+
+      packet.error_response_param.module_id      = module_id;
+      packet.error_response_param.sub_module_id  = instance_id;
+      packet.error_response_param.error_code     = error_code;
+      packet.error_response_param.error_sub_code = error_sub_code;
+    }
+
+  err_t er = MsgLib::send<AudioResult>(s_appMid,
+                                       MsgPriNormal,
+                                       MSG_AUD_MGR_RST,
+                                       s_selfMid,
+                                       packet);
+  F_ASSERT(er == ERR_OK);
+}
+#endif /* AS_FEATURE_OUTPUTMIX_ENABLE || AS_FEATURE_PLAYER_ENABLE */
+
 #ifdef AS_FEATURE_OUTPUTMIX_ENABLE
 /*
  * Callback functions from OutputMixer
@@ -86,6 +133,18 @@ static void proc_outputmixer_reply(AsOutputMixerHandle handle,
     AUDCMD_SETMPPPARAM,
   };
 
+  if (done_param->done_type == OutputMixGetClkRcvDone)
+    {
+      /* Status query is not a command of AudioManager. */
+
+      send_direct_result(AUDRLT_GETCLKRCVSTATUS_CMPLT,
+                         AS_MODULE_ID_OUTPUT_MIX_OBJ,
+                         done_param->ecode,
+                         0,
+                         handle);
+      return;
+    }
+
   AudioMngCmdCmpltResult cmplt(0,
                                0,
                                done_param->ecode,
@@ -154,6 +213,20 @@ static void send_player_reply(AsPlayerEvent event, uint8_t sub_module_id, uint32
     AUDCMD_SETGAIN,
   };
 
+  if (event == AsPlayerEventSetNext)
+    {
+      /* Next track is set by object level API, not a command of
+       * AudioManager.
+       */
+
+      send_direct_result(AUDRLT_SETNEXTPLAYER_CMPLT,
+                         AS_MODULE_ID_PLAYER_OBJ,
+                         result,
+                         sub_result,
+                         sub_module_id);
+      return;
+    }
+
   AudioMngCmdCmpltResult cmplt(cmd_code[event],
                                0,
                                result,
@@ -388,6 +461,21 @@ int AS_SendAudioCommand(FAR AudioCommand *packet)
 {
   MSG_TYPE msg_type;
 
+  if (s_trace_cb != NULL)
+    {
+      s_trace_cb(packet->getCode(), AsCommandTraceSent);
+    }
+
+#ifdef CONFIG_AUDIOUTILS_MANAGER_FASTPATH
+  /* State independent commands are applied here directly. */
+
+  if ((s_mng != NULL) && AudioManager::isFastPathCommand(packet->getCode()))
+    {
+      s_mng->execFastPath(*packet);
+      return AS_ERR_CODE_OK;
+    }
+#endif /* CONFIG_AUDIOUTILS_MANAGER_FASTPATH */
+
   switch (packet->getCode())
     {
       case AUDCMD_POWERON:
@@ -770,6 +858,14 @@ int AS_ReceiveAudioResult(FAR AudioResult *packet, uint8_t id, uint32_t tmo)
   return ret;
 }
 
+/*--------------------------------------------------------------------------*/
+int AS_SetAudioCommandTraceHook(AudioCommandTraceCb trace_cb)
+{
+  s_trace_cb = trace_cb;
+
+  return AS_ERR_CODE_OK;
+}
+
 /*--------------------------------------------------------------------------*/
 MsgQueId AS_GetSelfDtq(void)
 {
@@ -1381,8 +1477,14 @@ void AudioManager::parse(FAR MsgPacket *msg, FAR MsgQueBlock *que)
       AudioCommand cmd = msg->moveParam<AudioCommand>();
       err_code = que->pop();
       F_ASSERT(err_code == ERR_OK);
+#ifdef CONFIG_AUDIOUTILS_MANAGER_FASTPATH
+      pthread_mutex_lock(&m_lock);
+#endif /* CONFIG_AUDIOUTILS_MANAGER_FASTPATH */
       int allstate = getAllState();
       (this->*MsgProcTbl[event][allstate])(cmd);
+#ifdef CONFIG_AUDIOUTILS_MANAGER_FASTPATH
+      pthread_mutex_unlock(&m_lock);
+#endif /* CONFIG_AUDIOUTILS_MANAGER_FASTPATH */
     }
   else
     {
@@ -1394,7 +1496,13 @@ void AudioManager::parse(FAR MsgPacket *msg, FAR MsgQueBlock *que)
           const AudioMngCmdCmpltResult rst = msg->moveParam<AudioMngCmdCmpltResult>();
           err_code = que->pop();
           F_ASSERT(err_code == ERR_OK);
+#ifdef CONFIG_AUDIOUTILS_MANAGER_FASTPATH
+          pthread_mutex_lock(&m_lock);
+#endif /* CONFIG_AUDIOUTILS_MANAGER_FASTPATH */
           (this->*RstProcTbl[event][m_State])(rst);
+#ifdef CONFIG_AUDIOUTILS_MANAGER_FASTPATH
+          pthread_mutex_unlock(&m_lock);
+#endif /* CONFIG_AUDIOUTILS_MANAGER_FASTPATH */
         }
       else if (msg->getType() == MSG_AUD_MGR_CALL_ATTENTION)
         {
@@ -1420,6 +1528,57 @@ void AudioManager::parse(FAR MsgPacket *msg, FAR MsgQueBlock *que)
     }
 }
 
+#ifdef CONFIG_AUDIOUTILS_MANAGER_FASTPATH
+/*--------------------------------------------------------------------------*/
+bool AudioManager::isFastPathCommand(uint8_t command_code)
+{
+  switch (command_code)
+    {
+      case AUDCMD_SETVOLUME:
+      case AUDCMD_SETVOLUMEMUTE:
+      case AUDCMD_SETBEEPPARAM:
+        return true;
+
+      default:
+        return false;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+void AudioManager::execFastPath(AudioCommand &cmd)
+{
+  /* These commands are valid in all states except PowerOff, so only
+   * power state is checked instead of looking up state table.
+   */
+
+  pthread_mutex_lock(&m_lock);
+
+  if (m_State == AS_MNG_STATUS_POWEROFF)
+    {
+      illegal(cmd);
+    }
+  else
+    {
+      switch (cmd.getCode())
+        {
+          case AUDCMD_SETVOLUME:
+            setVolume(cmd);
+            break;
+
+          case AUDCMD_SETVOLUMEMUTE:
+            setVolumeMute(cmd);
+            break;
+
+          default:
+            setBeep(cmd);
+            break;
+        }
+    }
+
+  pthread_mutex_unlock(&m_lock);
+}
+
+#endif /* CONFIG_AUDIOUTILS_MANAGER_FASTPATH */
 /*--------------------------------------------------------------------------*/
 void AudioManager::illegal(AudioCommand &cmd)
 {
@@ -3773,6 +3932,7 @@ void AudioManager::setVolume(AudioCommand &cmd)
 
   if (error_code == CXD56_AUDIO_ECODE_OK)
     {
+      traceApplied(AUDCMD_SETVOLUME);
       sendResult(AUDRLT_SETVOLUMECMPLT, cmd.header.sub_code);
     }
   else
@@ -3898,6 +4058,7 @@ void AudioManager::setVolumeMute(AudioCommand &cmd)
         return;
     }
 
+  traceApplied(AUDCMD_SETVOLUMEMUTE);
   sendResult(AUDRLT_SETVOLUMEMUTECMPLT, cmd.header.sub_code);
 }
 
@@ -3960,6 +4121,7 @@ void AudioManager::setBeep(AudioCommand &cmd)
         }
     }
 
+  traceApplied(AUDCMD_SETBEEPPARAM);
   sendResult(AUDRLT_SETBEEPCMPLT, cmd.header.sub_code);
 }
 
@@ -4210,6 +4372,15 @@ uint32_t AudioManager::powerOffBaseBand(uint8_t power_id)
   return AS_ECODE_OK;
 }
 
+/*--------------------------------------------------------------------------*/
+void AudioManager::traceApplied(uint8_t command_code)
+{
+  if (s_trace_cb != NULL)
+    {
+      s_trace_cb(command_code, AsCommandTraceApplied);
+    }
+}
+
 /*--------------------------------------------------------------------------*/
 bool AudioManager::packetCheck(uint8_t      length,
                                uint8_t      command_code,
@@ -36,6 +36,7 @@
 #ifndef __AUDIO_MANAGER_H
 #define __AUDIO_MANAGER_H
 
+#include <pthread.h>
 #include <audio/audio_high_level_api.h>
 #include <audio/utilities/frame_samples.h>
 #include "attention.h"
@@ -80,8 +81,16 @@ public:
 
   ~AudioManager()
   {
+#ifdef CONFIG_AUDIOUTILS_MANAGER_FASTPATH
+    pthread_mutex_destroy(&m_lock);
+#endif /* CONFIG_AUDIOUTILS_MANAGER_FASTPATH */
   };
 
+#ifdef CONFIG_AUDIOUTILS_MANAGER_FASTPATH
+  static bool isFastPathCommand(uint8_t command_code);
+  void execFastPath(AudioCommand &cmd);
+#endif /* CONFIG_AUDIOUTILS_MANAGER_FASTPATH */
+
 private:
   AudioManager(MsgQueId selfDtq,
                MsgQueId playerDtq,
@@ -119,6 +128,9 @@ private:
         m_req_player_reference_bits[i] = 0;
       }
 #endif /* AS_FEATURE_PLAYER_ENABLE || AS_FEATURE_OUTPUTMIX_ENABLE */
+#ifdef CONFIG_AUDIOUTILS_MANAGER_FASTPATH
+    pthread_mutex_init(&m_lock, NULL);
+#endif /* CONFIG_AUDIOUTILS_MANAGER_FASTPATH */
   };
 
   MsgQueId m_selfDtq;
@@ -179,6 +191,12 @@ private:
   AsOutputMixDevice m_output_device;
 #endif /* AS_FEATURE_OUTPUTMIX_ENABLE */
 
+#ifdef CONFIG_AUDIOUTILS_MANAGER_FASTPATH
+  /* Serializes driver access of fast path and manager task. */
+
+  pthread_mutex_t m_lock;
+#endif /* CONFIG_AUDIOUTILS_MANAGER_FASTPATH */
+
   typedef void (AudioManager::*MsgProc)(AudioCommand &cmd);
   typedef void (AudioManager::*RstProc)(const AudioMngCmdCmpltResult &result);
   static MsgProc MsgProcTbl[AUD_MGR_MSG_NUM][MNG_ALLSTATE_NUM];
@@ -261,6 +279,7 @@ private:
                                      uint8_t  output_dev,
                                      FAR void *input_handler);
   bool packetCheck(uint8_t length, uint8_t command_code, AudioCommand &cmd);
+  void traceApplied(uint8_t command_code);
 #ifdef AS_FEATURE_FRONTEND_ENABLE
   bool sendMicFrontendCommand(MsgType msgtype, MicFrontendCommand *cmd);
   uint8_t convertMicFrontendEvent(AsMicFrontendEvent event);
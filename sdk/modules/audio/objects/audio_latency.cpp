@@ -0,0 +1,144 @@
+/****************************************************************************
+ * modules/audio/objects/audio_latency.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <string.h>
+#include <time.h>
+#include <nuttx/irq.h>
+#include "audio/audio_latency_api.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LATENCY_BIN_WIDTH  (CONFIG_AUDIOUTILS_LATENCY_TRACE_BIN_MS * 1000)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static AsLatencyHistogram s_latency[AsLatencyStageNum];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/*--------------------------------------------------------------------------*/
+uint32_t AS_GetLatencyTimestamp(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  uint32_t time = (uint32_t)now.tv_sec * 1000000 +
+                  (uint32_t)now.tv_nsec / 1000;
+
+  /* Zero is reserved for frames which have no origin. */
+
+  return (time == 0) ? 1 : time;
+}
+
+/*--------------------------------------------------------------------------*/
+void AS_RecordPipelineLatency(AsLatencyStage stage,
+                              uint32_t origin,
+                              uint32_t time)
+{
+  if ((stage >= AsLatencyStageNum) || (origin == 0))
+    {
+      return;
+    }
+
+  /* Unsigned difference is valid across wrap around of time stamp. */
+
+  uint32_t latency = time - origin;
+  uint32_t bin     = latency / LATENCY_BIN_WIDTH;
+
+  bin = (bin < AS_LATENCY_BIN_NUM) ? bin : (AS_LATENCY_BIN_NUM - 1);
+
+  /* Stages are recorded from several tasks and DMA completion. */
+
+  irqstate_t flags = enter_critical_section();
+
+  FAR AsLatencyHistogram *hist = &s_latency[stage];
+
+  if ((hist->count == 0) || (latency < hist->min))
+    {
+      hist->min = latency;
+    }
+
+  if (latency > hist->max)
+    {
+      hist->max = latency;
+    }
+
+  hist->count++;
+  hist->total += latency;
+  hist->bin[bin]++;
+
+  leave_critical_section(flags);
+}
+
+/*--------------------------------------------------------------------------*/
+bool AS_GetPipelineLatency(AsLatencyStage stage,
+                           FAR AsLatencyHistogram *hist)
+{
+  if ((stage >= AsLatencyStageNum) || (hist == NULL))
+    {
+      return false;
+    }
+
+  irqstate_t flags = enter_critical_section();
+
+  *hist = s_latency[stage];
+
+  leave_critical_section(flags);
+
+  hist->bin_width = LATENCY_BIN_WIDTH;
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+void AS_ClearPipelineLatency(void)
+{
+  irqstate_t flags = enter_critical_section();
+
+  memset(s_latency, 0, sizeof(s_latency));
+
+  leave_critical_section(flags);
+}
@@ -574,6 +574,30 @@ void MicFrontEndObject::init(MsgPacket *msg)
       m_p_preproc_instance->recv_done();
     }
 
+  /* Init mic array process by capture format. Channel selection and
+   * steering delays are set by InitPreproc command later.
+   */
+
+  if ((m_preproc_type == AsMicFrontendPreProcPlanar)
+   || (m_preproc_type == AsMicFrontendPreProcBeamform))
+    {
+      InitComponentParam init_ma_param;
+
+      init_ma_param.is_userdraw           = false;
+      init_ma_param.fixparam.samples      = cmd.init_param.samples_per_frame;
+      init_ma_param.fixparam.in_bitlength = cmd.init_param.bit_length;
+      init_ma_param.fixparam.ch_num       = cmd.init_param.channel_number;
+
+      uint32_t ret = m_p_preproc_instance->init(init_ma_param);
+      m_p_preproc_instance->recv_done();
+
+      if (ret != AS_ECODE_OK)
+        {
+          reply(AsMicFrontendEventInit, msg->getType(), ret);
+          return;
+        }
+    }
+
   /* Reply */
 
   reply(AsMicFrontendEventInit, msg->getType(), AS_ECODE_OK);
@@ -596,6 +620,18 @@ uint32_t MicFrontEndObject::loadComponent(AsMicFrontendPreProcType type, char *d
                                                 m_msgq_id.dsp);
         break;
 
+#ifdef CONFIG_AUDIOUTILS_MFE_MICARRAY
+      case AsMicFrontendPreProcPlanar:
+        m_p_preproc_instance =
+          new MicArrayComponent(MicArrayComponent::MicArrayPlanar);
+        break;
+
+      case AsMicFrontendPreProcBeamform:
+        m_p_preproc_instance =
+          new MicArrayComponent(MicArrayComponent::MicArrayBeamform);
+        break;
+#endif
+
       default:
         m_p_preproc_instance = new ThruProcComponent();
         break;
@@ -787,6 +823,7 @@ void MicFrontEndObject::initPreproc(MsgPacket *msg)
 
   InitComponentParam param;
 
+  param.is_userdraw = true;
   param.packet.addr = initparam.packet_addr;
   param.packet.size = initparam.packet_size;
 
@@ -1550,9 +1587,24 @@ bool MicFrontEndObject::execPreProc(MemMgrLite::MemHandle inmh, uint32_t sample)
         {
           /* For compatibility.
            * If null pool id is set, use same area as input.
+           * Mic array process can not work in place, so that
+           * output is allocated on input area.
            */
 
-          exec.output_mh = exec.input.mh;
+          if ((m_preproc_type == AsMicFrontendPreProcPlanar)
+           || (m_preproc_type == AsMicFrontendPreProcBeamform))
+            {
+              if (ERR_OK != exec.output_mh.allocSeg(m_pool_id.input,
+                                                    m_max_capture_size))
+                {
+                  MIC_FRONTEND_ERR(AS_ATTENTION_SUB_CODE_MEMHANDLE_ALLOC_ERROR);
+                  return false;
+                }
+            }
+          else
+            {
+              exec.output_mh = exec.input.mh;
+            }
         }
       else
         {
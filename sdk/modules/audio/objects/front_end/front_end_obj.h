@@ -52,6 +52,9 @@
 #include "components/customproc/usercustom_component.h"
 #include "components/customproc/thruproc_component.h"
 #include "components/filter/src_filter_component.h"
+#ifdef CONFIG_AUDIOUTILS_MFE_MICARRAY
+#include "components/customproc/micarray_component.h"
+#endif
 
 __WIEN2_BEGIN_NAMESPACE
 
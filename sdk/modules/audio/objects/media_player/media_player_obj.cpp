@@ -46,6 +46,11 @@
 #include "memutils/os_utils/os_wrapper.h"
 #include "memutils/common_utils/common_assert.h"
 #include "media_player_obj.h"
+#include "player_gapless_info.h"
+#include "player_decode_batch.h"
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+#include "audio/audio_latency_api.h"
+#endif
 #include "components/decoder/decoder_component.h"
 #include "dsp_driver/include/dsp_drv.h"
 #include "debug/dbg_log.h"
@@ -64,6 +69,21 @@ using namespace MemMgrLite;
 #  define NUM_OF_AU 1
 #endif /* SUPPORT_SBC_PLAYER */
 
+/* Max number of ES frames gathered into one decode request. */
+
+#ifndef CONFIG_AUDIOUTILS_PLAYER_DECODE_BATCH
+#  define CONFIG_AUDIOUTILS_PLAYER_DECODE_BATCH 1
+#endif
+
+/* Worst case size of one ES frame, used to reserve the space of the
+ * next frame when gathering frames into one ES buffer.
+ *  MP3 : 144 * 320kbps / 32kHz + padding
+ *  AAC : 6144bit * 2ch + ADTS header
+ */
+
+#define MP3_MAX_FRAME_SIZE 1441
+#define AAC_MAX_FRAME_SIZE 1545
+
 /* Definition when not using Memory pool. */
 
 #define SRC_WORK_BUF_SIZE 8192 /* 1024sample * 2ch * 4bytes */
@@ -126,6 +146,7 @@ static bool decoder_comp_done_callback(void *p_response, FAR void *p_requester)
         {
           cmplt.exec_dec_cmplt.input_buffer   = packet->exec_dec_cmd.input_buffer;
           cmplt.exec_dec_cmplt.output_buffer  = packet->exec_dec_cmd.output_buffer;
+          cmplt.exec_dec_cmplt.num_of_au      = packet->exec_dec_cmd.num_of_au;
           cmplt.exec_dec_cmplt.is_valid_frame =
             ((packet->result.exec_result == Apu::ApuExecOK) ? true : false);
 
@@ -214,10 +235,13 @@ PlayerObj::PlayerObj(AsPlayerMsgQueId_t msgq_id, AsPlayerPoolId_t pool_id, AsPla
   m_player_id(player_id),
   m_input_device_handler(NULL),
   m_codec_type(InvalidCodecType),
+  m_es_au_num(0),
+  m_pcm_au_size(0),
   m_src_work_buf(NULL),
   m_callback(NULL),
   m_pcm_path(AsPcmDataReply)
 {
+  resetTrack();
 }
 
 /*--------------------------------------------------------------------------*/
@@ -320,6 +344,18 @@ PlayerObj::MsgProc PlayerObj::MsgProcTbl[AUD_PLY_MSG_NUM][PlayerStateNum] =
     &PlayerObj::setGain,             /*   WaitEsEndState.     */
     &PlayerObj::setGain,             /*   UnderflowState.     */
     &PlayerObj::setGain,             /*   WaitStopState.      */
+  },
+
+  /* Message type: MSG_AUD_PLY_CMD_SETNEXT */
+  {                                  /* Player status:        */
+    &PlayerObj::illegalEvt,          /*   BootedState.        */
+    &PlayerObj::setNextOnReady,      /*   ReadyState.         */
+    &PlayerObj::parseSubState,       /*   PrePlayParentState. */
+    &PlayerObj::setNextOnPlay,       /*   PlayState.          */
+    &PlayerObj::illegalEvt,          /*   StoppingState.      */
+    &PlayerObj::illegalEvt,          /*   WaitEsEndState.     */
+    &PlayerObj::illegalEvt,          /*   UnderflowState.     */
+    &PlayerObj::illegalEvt,          /*   WaitStopState.      */
   }
 };
 
@@ -378,6 +414,15 @@ PlayerObj::MsgProc PlayerObj::PlayerSubStateTbl[AUD_PLY_MSG_NUM][SubStateNum] =
     &PlayerObj::setGain,                   /*   SubStatePrePlayStopping.  */
     &PlayerObj::setGain,                   /*   SubStatePrePlayWaitEsEnd. */
     &PlayerObj::setGain,                   /*   SubStatePrePlayUnderflow. */
+  },
+
+  /* Message type: MSG_AUD_PLY_CMD_SETNEXT. */
+
+  {                                        /* Player sub status:          */
+    &PlayerObj::setNextOnPlay,             /*   SubStatePrePlay.          */
+    &PlayerObj::illegalEvt,                /*   SubStatePrePlayStopping.  */
+    &PlayerObj::illegalEvt,                /*   SubStatePrePlayWaitEsEnd. */
+    &PlayerObj::illegalEvt,                /*   SubStatePrePlayUnderflow. */
   }
 };
 
@@ -515,7 +560,8 @@ void PlayerObj::illegalEvt(MsgPacket *msg)
     AsPlayerEventPlay,
     AsPlayerEventStop,
     AsPlayerEventDeact,
-    AsPlayerEventSetGain
+    AsPlayerEventSetGain,
+    AsPlayerEventSetNext
   };
 
   reply(table[idx], (MsgType)msgtype, AS_ECODE_STATE_VIOLATION);
@@ -616,6 +662,10 @@ void PlayerObj::init(MsgPacket *msg)
   bool is_multi_core_cur = judgeMultiCore(param.sampling_rate,
                                          param.bit_length);
 
+  /* New track, information of the track is set by AS_SetNextPlayer. */
+
+  resetTrack();
+
   result = m_input_device_handler->setParam(param);
 
   if (result == AS_ECODE_OK)
@@ -845,32 +895,7 @@ void PlayerObj::nextReqOnPlay(MsgPacket *msg)
       return;
     }
 
-  if ((MemMgrLite::Manager::getPoolNumAvailSegs(m_pool_id.es) > 0) &&
-        (MemMgrLite::Manager::getPoolNumAvailSegs(m_pool_id.pcm) > 1))
-    {
-      /* Do next decoding process. */
-
-      uint32_t es_size = m_max_es_buff_size;
-      void* es_addr = getEs(&es_size);
-
-      if (es_addr != NULL)
-        {
-          decode(es_addr, es_size);
-        }
-      else
-        {
-          stopPlay();
-          if (m_state == PlayState)
-            {
-              m_state = UnderflowState;
-              MEDIA_PLAYER_WARN(AS_ATTENTION_SUB_CODE_SIMPLE_FIFO_UNDERFLOW);
-            }
-          else
-            {
-              m_state = StoppingState;
-            }
-        }
-    }
+  decodeNext();
 }
 
 /*--------------------------------------------------------------------------*/
@@ -950,6 +975,8 @@ void PlayerObj::decDoneOnPlay(MsgPacket *msg)
   DecCmpltParam cmplt = msg->moveParam<DecCmpltParam>();
 
   AS_decode_recv_done(m_p_dec_instance);
+
+  uint8_t track = m_es_track_que.top();
   freeEsBuf();
 
   AsPcmDataParam data;
@@ -960,38 +987,21 @@ void PlayerObj::decDoneOnPlay(MsgPacket *msg)
   data.is_valid  = ((data.size == 0) ?
                     false : cmplt.exec_dec_cmplt.is_valid_frame);
 
-  sendPcmToOwner(data);
-
-  freePcmBuf();
-
-  if ((MemMgrLite::Manager::getPoolNumAvailSegs(m_pool_id.es) > 0) &&
-        (MemMgrLite::Manager::getPoolNumAvailSegs(m_pool_id.pcm) > 1))
+  if (data.is_valid)
     {
-      /* Do next decoding process. */
+      updatePcmAuSize(data.size, cmplt.exec_dec_cmplt.num_of_au);
+      splicePcm(data, track);
+    }
 
-      uint32_t es_size = m_max_es_buff_size;
-      void    *es_addr = getEs(&es_size);
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+  stampPcm(data);
+#endif
 
-    if (es_addr != NULL)
-      {
-        decode(es_addr, es_size);
-      }
-    else
-      {
-        /* There is no stream data. */
+  sendPcmToOwner(data);
 
-        stopPlay();
-        if (m_state == PlayState)
-          {
-            m_state = UnderflowState;
-            MEDIA_PLAYER_WARN(AS_ATTENTION_SUB_CODE_SIMPLE_FIFO_UNDERFLOW);
-          }
-        else
-          {
-            m_state = StoppingState;
-          }
-      }
-    }
+  freePcmBuf();
+
+  decodeNext();
 }
 
 /*--------------------------------------------------------------------------*/
@@ -1013,18 +1023,32 @@ void PlayerObj::decDoneOnWaitStop(MsgPacket *msg)
 
   if (Apu::ExecEvent == cmplt.event_type)
     {
+      uint8_t track = m_es_track_que.top();
       freeEsBuf();
 
       data.size      = cmplt.exec_dec_cmplt.output_buffer.size;
       data.is_valid  = ((data.size == 0) ?
                        false : cmplt.exec_dec_cmplt.is_valid_frame);
       data.is_end = false;
+
+      if (data.is_valid)
+        {
+          splicePcm(data, track);
+        }
+
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+      stampPcm(data);
+#endif
     }
   else if (Apu::FlushEvent == cmplt.event_type)
     {
       data.size      = cmplt.stop_dec_cmplt.output_buffer.size;
       data.is_valid  = cmplt.stop_dec_cmplt.is_valid_frame;
       data.is_end = true;
+
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+      data.timestamp = 0;
+#endif
     }
 
   sendPcmToOwner(data);
@@ -1038,6 +1062,8 @@ void PlayerObj::decDoneOnPrePlay(MsgPacket *msg)
   DecCmpltParam cmplt = msg->moveParam<DecCmpltParam>();
 
   AS_decode_recv_done(m_p_dec_instance);
+
+  uint8_t track = m_es_track_que.top();
   freeEsBuf();
 
   AsPcmDataParam data;
@@ -1048,6 +1074,16 @@ void PlayerObj::decDoneOnPrePlay(MsgPacket *msg)
   data.is_valid  = ((data.size == 0) ?
                    false : cmplt.exec_dec_cmplt.is_valid_frame);
 
+  if (data.is_valid)
+    {
+      updatePcmAuSize(data.size, cmplt.exec_dec_cmplt.num_of_au);
+      splicePcm(data, track);
+    }
+
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+  stampPcm(data);
+#endif
+
   if (!m_decoded_pcm_mh_que.push(data))
     {
       MEDIA_PLAYER_ERR(AS_ATTENTION_SUB_CODE_QUEUE_PUSH_ERROR);
@@ -1271,6 +1307,81 @@ void PlayerObj::setGain(MsgPacket *msg)
   /* Response is sent after decoder_component done */
 }
 
+/*--------------------------------------------------------------------------*/
+void PlayerObj::setNextOnReady(MsgPacket *msg)
+{
+  AsSetNextPlayerParam param = msg->moveParam<PlayerCommand>().next_param;
+
+  /* Information of the track which is started by play. */
+
+  m_track[m_in_track].es_size       = param.es_size;
+  m_track[m_in_track].head_skip     = param.head_skip;
+  m_track[m_in_track].valid_samples = param.valid_samples;
+
+  reply(AsPlayerEventSetNext, msg->getType(), AS_ECODE_OK);
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerObj::setNextOnPlay(MsgPacket *msg)
+{
+  AsSetNextPlayerParam param = msg->moveParam<PlayerCommand>().next_param;
+
+  /* Decoder is kept, so the format must be same as the current one. */
+
+  AudioCodec next_codec =
+    (param.init_param.codec_type == AS_CODECTYPE_MEDIA) ?
+      AudCodecAAC : static_cast<AudioCodec>(param.init_param.codec_type);
+
+  uint32_t result = AS_ECODE_OK;
+
+  if (next_codec != m_codec_type)
+    {
+      result = AS_ECODE_COMMAND_PARAM_CODEC_TYPE;
+    }
+  else if (param.init_param.channel_number !=
+           m_input_device_handler->getChannelNum())
+    {
+      result = AS_ECODE_COMMAND_PARAM_CHANNEL_NUMBER;
+    }
+  else if (param.init_param.bit_length !=
+           m_input_device_handler->getBitLen())
+    {
+      result = AS_ECODE_COMMAND_PARAM_BIT_LENGTH;
+    }
+  else if ((param.init_param.sampling_rate != AS_SAMPLINGRATE_AUTO) &&
+           (param.init_param.sampling_rate !=
+            m_input_device_handler->getSamplingRate()))
+    {
+      result = AS_ECODE_COMMAND_PARAM_SAMPLING_RATE;
+    }
+  else if (m_track[m_in_track].es_size == 0)
+    {
+      /* Boundary of the current track is unknown. */
+
+      result = AS_ECODE_COMMAND_NOT_SUPPOT;
+    }
+  else if (m_has_next || (m_out_track != m_in_track))
+    {
+      /* Only one track can be queued, and the slot of the previous track
+       * is used until its PCM is output.
+       */
+
+      result = AS_ECODE_QUEUE_OPERATION_ERROR;
+    }
+
+  if (result == AS_ECODE_OK)
+    {
+      TrackInfo& next = m_track[m_in_track ^ 1];
+
+      next.es_size       = param.es_size;
+      next.head_skip     = param.head_skip;
+      next.valid_samples = param.valid_samples;
+      m_has_next         = true;
+    }
+
+  reply(AsPlayerEventSetNext, msg->getType(), result);
+}
+
 /*--------------------------------------------------------------------------*/
 void PlayerObj::parseSubState(MsgPacket *msg)
 {
@@ -1406,6 +1517,15 @@ uint32_t PlayerObj::startPlay(uint32_t* dsp_inf)
       return AS_ECODE_QUEUE_OPERATION_ERROR;
     }
 
+  /* PCM size of one frame is not known until the first decoding. */
+
+  m_pcm_au_size = 0;
+
+  /* Start reading and output of the current track. */
+
+  m_track_read_size = 0;
+  startTrackOutput(m_in_track);
+
   /* Get ES data. */
 
   uint32_t es_size = m_max_es_buff_size;
@@ -1482,7 +1602,7 @@ void PlayerObj::decode(void* p_es, uint32_t es_size)
   param.input_buffer.size      = es_size;
   param.output_buffer.p_buffer = reinterpret_cast<unsigned long *>(p_pcm);
   param.output_buffer.size     = m_max_pcm_buff_size;
-  param.num_of_au              = NUM_OF_AU;
+  param.num_of_au              = NUM_OF_AU * m_es_au_num;
 
   if (AS_decode_exec(&param, m_p_dec_instance) == false)
     {
@@ -1490,6 +1610,188 @@ void PlayerObj::decode(void* p_es, uint32_t es_size)
     }
 }
 
+/*--------------------------------------------------------------------------*/
+void PlayerObj::decodeNext(void)
+{
+  /* Keep decode requests in flight up to the pipeline depth, so that
+   * the DSP does not wait for the next request after each completion.
+   * With the SRC slave DSP, decoding of the next frame overlaps SRC of
+   * the previous one.
+   *
+   * Depth 0 issues one request per event, limited by segments and by
+   * the ES queue.  A burst of NEXT_REQ beyond the queue is caught up by
+   * the following completions.
+   */
+
+  const bool per_event = (CONFIG_AUDIOUTILS_PLAYER_DECODE_DEPTH == 0);
+
+  while ((per_event ||
+          (m_es_buf_mh_que.size() < CONFIG_AUDIOUTILS_PLAYER_DECODE_DEPTH)) &&
+         (m_es_buf_mh_que.size() <= MAX_EXEC_COUNT) &&
+         (MemMgrLite::Manager::getPoolNumAvailSegs(m_pool_id.es) > 0) &&
+         (MemMgrLite::Manager::getPoolNumAvailSegs(m_pool_id.pcm) > 1))
+    {
+      uint32_t es_size = m_max_es_buff_size;
+      void    *es_addr = getEs(&es_size);
+
+      if (es_addr != NULL)
+        {
+          decode(es_addr, es_size);
+
+          if (per_event)
+            {
+              break;
+            }
+
+          continue;
+        }
+
+      /* There is no stream data. With pipelining, underflow only when no
+       * request is in flight, otherwise retry at the next completion.
+       */
+
+      if (per_event || m_es_buf_mh_que.empty())
+        {
+          stopPlay();
+          if (m_state == PlayState)
+            {
+              m_state = UnderflowState;
+              MEDIA_PLAYER_WARN(AS_ATTENTION_SUB_CODE_SIMPLE_FIFO_UNDERFLOW);
+            }
+          else
+            {
+              m_state = StoppingState;
+            }
+        }
+
+      break;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t PlayerObj::getMaxEsFrameSize(void)
+{
+  /* Only codecs which frame size is bounded can be gathered. */
+
+  switch (m_codec_type)
+    {
+      case AudCodecMP3:
+        return MP3_MAX_FRAME_SIZE;
+
+      case AudCodecAAC:
+        return AAC_MAX_FRAME_SIZE;
+
+      default:
+        break;
+    }
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+uint8_t PlayerObj::getBatchCount(void)
+{
+  DecodeBatchParam param;
+
+  param.max_batch     = CONFIG_AUDIOUTILS_PLAYER_DECODE_BATCH;
+  param.pre_play      = (m_sub_state != InvalidSubState);
+  param.pcm_used      = 0;
+  param.es_buf_size   = m_max_es_buff_size;
+  param.es_frame_size = getMaxEsFrameSize();
+  param.pcm_buf_size  = m_max_pcm_buff_size;
+  param.pcm_au_size   = m_pcm_au_size;
+
+  /* Depth of downstream is the number of PCM segments in use. */
+
+  if (CONFIG_AUDIOUTILS_PLAYER_DECODE_BATCH > 1)
+    {
+      param.pcm_used = MemMgrLite::Manager::getPoolNumSegs(m_pool_id.pcm) -
+        MemMgrLite::Manager::getPoolNumAvailSegs(m_pool_id.pcm);
+    }
+
+  return static_cast<uint8_t>(decode_batch_count(&param));
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerObj::updatePcmAuSize(uint32_t pcm_size, uint8_t num_of_au)
+{
+  uint8_t au_num = num_of_au / NUM_OF_AU;
+
+  if (au_num > 0)
+    {
+      uint32_t au_size = pcm_size / au_num;
+
+      m_pcm_au_size = (au_size > m_pcm_au_size) ? au_size : m_pcm_au_size;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerObj::resetTrack(void)
+{
+  memset(m_track, 0, sizeof(m_track));
+
+  m_in_track        = 0;
+  m_has_next        = false;
+  m_track_read_size = 0;
+  m_out_track       = 0;
+  m_out_skip        = 0;
+  m_out_remain      = GAPLESS_NO_LIMIT;
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerObj::startTrackOutput(uint8_t track)
+{
+  m_out_track  = track;
+  m_out_skip   = toOutSamples(m_track[track].head_skip);
+  m_out_remain = (m_track[track].valid_samples == 0) ?
+                   GAPLESS_NO_LIMIT :
+                   toOutSamples(m_track[track].valid_samples);
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t PlayerObj::toOutSamples(uint32_t samples)
+{
+  /* Decoder outputs at 48kHz, or 192kHz for high resolution. */
+
+  uint32_t in_fs  = m_input_device_handler->getSamplingRate();
+  uint32_t out_fs = (in_fs > AS_SAMPLINGRATE_48000) ?
+                      AS_SAMPLINGRATE_192000 : AS_SAMPLINGRATE_48000;
+
+  return gapless_out_samples(samples, in_fs, out_fs);
+}
+
+/*--------------------------------------------------------------------------*/
+void PlayerObj::splicePcm(AsPcmDataParam& data, uint8_t track)
+{
+  /* PCM of a new track arrived, the previous track is finished. */
+
+  if (track != m_out_track)
+    {
+      startTrackOutput(track);
+    }
+
+  if ((m_out_skip == 0) && (m_out_remain == GAPLESS_NO_LIMIT))
+    {
+      return;
+    }
+
+  /* Decoded PCM is always 2ch. */
+
+  uint32_t unit = 2 * ((m_input_device_handler->getBitLen() ==
+                        AS_BITLENGTH_16) ? 2 : 4);
+
+  data.size = gapless_splice_pcm(static_cast<uint8_t *>(data.mh.getVa()),
+                                 data.size,
+                                 unit,
+                                 &m_out_skip,
+                                 &m_out_remain);
+
+  if (data.size == 0)
+    {
+      data.is_valid = false;
+    }
+}
+
 /*--------------------------------------------------------------------------*/
 void* PlayerObj::allocPcmBuf(uint32_t size)
 {
@@ -1519,19 +1821,89 @@ void* PlayerObj::getEs(uint32_t* size)
       return NULL;
     }
 
-  if (m_input_device_handler->getEs(mh.getVa(), size))
+  /* Gather frames into one ES buffer while the space for the worst case
+   * frame remains, so that they are decoded by one DSP request.
+   */
+
+  uint8_t  batch      = getBatchCount();
+  uint32_t frame_size = getMaxEsFrameSize();
+  uint8_t *p_es       = static_cast<uint8_t *>(mh.getVa());
+  uint32_t total      = 0;
+
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+  uint32_t es_time    = AS_GetLatencyTimestamp();
+#endif
+
+  for (m_es_au_num = 0; m_es_au_num < batch; m_es_au_num++)
+    {
+      /* Move to the queued track at the boundary of the current track.
+       * Frames of one decode request belong to one track.
+       */
+
+      if (m_has_next &&
+          (m_track_read_size >= m_track[m_in_track].es_size))
+        {
+          if (m_es_au_num > 0)
+            {
+              break;
+            }
+
+          m_in_track ^= 1;
+          m_has_next = false;
+          m_track_read_size = 0;
+        }
+
+      uint32_t es_size = *size - total;
+
+      if ((m_es_au_num > 0) && (es_size < frame_size))
+        {
+          break;
+        }
+
+      if (!m_input_device_handler->getEs(p_es + total, &es_size))
+        {
+          break;
+        }
+
+      total += es_size;
+      m_track_read_size += es_size;
+    }
+
+  if (m_es_au_num > 0)
     {
       if (!m_es_buf_mh_que.push(mh))
         {
           MEDIA_PLAYER_ERR(AS_ATTENTION_SUB_CODE_QUEUE_PUSH_ERROR);
           return NULL;
         }
-    return mh.getPa();
-  }
+
+      m_es_track_que.push(m_in_track);
+
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+      m_es_time_que.push(es_time);
+#endif
+
+      *size = total;
+      return mh.getPa();
+    }
 
   return NULL;
 }
 
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+/*--------------------------------------------------------------------------*/
+void PlayerObj::stampPcm(AsPcmDataParam& data)
+{
+  /* Decoded PCM takes over time stamp of ES which it is decoded from. */
+
+  data.timestamp = m_dec_es_time;
+
+  AS_RecordPipelineLatency(AsLatencyStageDecode,
+                           data.timestamp,
+                           AS_GetLatencyTimestamp());
+}
+
+#endif
 /*--------------------------------------------------------------------------*/
 void* PlayerObj::allocSrcWorkBuf(uint32_t size)
 {
@@ -1567,6 +1939,14 @@ void* PlayerObj::allocSrcWorkBuf(uint32_t size)
 /*--------------------------------------------------------------------------*/
 void PlayerObj::finalize()
 {
+  /* Queued next track is not played after stop. */
+
+  m_es_track_que.clear();
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+  m_es_time_que.clear();
+#endif
+  m_has_next = false;
+
   /* Note:
    *   This queues should be EMPTY. If not, there exist any bug.
    *   (error debug log will be showed as following)
@@ -1665,6 +2045,17 @@ bool PlayerObj::judgeMultiCore(uint32_t sampling_rate, uint8_t bit_length)
       return true;
     }
 
+#ifdef CONFIG_AUDIOUTILS_PLAYER_SRC_OFFLOAD
+  /* Convert 44.1kHz to 48kHz on the slave DSP too, so that the decoder
+   * DSP is free for heavier codecs.
+   */
+
+  if (sampling_rate == AS_SAMPLINGRATE_44100)
+    {
+      return true;
+    }
+#endif
+
   return false;
 }
 
@@ -2009,6 +2400,76 @@ bool AS_SetPlayerGain(AsPlayerId id, FAR AsSetGainParam *gainparam)
   return true;
 }
 
+/*--------------------------------------------------------------------------*/
+bool AS_SetNextPlayer(AsPlayerId id, FAR AsSetNextPlayerParam *nextparam)
+{
+  /* Parameter check */
+
+  if (nextparam == NULL)
+    {
+      return false;
+    }
+
+  /* Set next track */
+
+  MsgQueId msgq_id = (id == AS_PLAYER_ID_0) ? s_msgq_id.player : s_sub_msgq_id.player;
+
+  PlayerCommand cmd;
+
+  cmd.player_id  = id;
+  cmd.next_param = *nextparam;
+
+  err_t er = MsgLib::send<PlayerCommand>(msgq_id,
+                                         MsgPriNormal,
+                                         MSG_AUD_PLY_CMD_SETNEXT,
+                                         s_msgq_id.mng,
+                                         cmd);
+  F_ASSERT(er == ERR_OK);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+bool AS_GetPlayerGaplessInfo(FAR const uint8_t *header,
+                             uint32_t size,
+                             FAR AsSetNextPlayerParam *nextparam)
+{
+  if ((header == NULL) || (nextparam == NULL))
+    {
+      return false;
+    }
+
+  nextparam->head_skip     = 0;
+  nextparam->valid_samples = 0;
+
+  switch (nextparam->init_param.codec_type)
+    {
+      case AS_CODECTYPE_MP3:
+        if (gapless_parse_lame(header,
+                               size,
+                               &nextparam->head_skip,
+                               &nextparam->valid_samples))
+          {
+            return true;
+          }
+        break;
+
+      case AS_CODECTYPE_AAC:
+      case AS_CODECTYPE_MEDIA:
+        break;
+
+      default:
+        return false;
+    }
+
+  /* iTunes writes delay and padding to comment of ID3 tag. */
+
+  return gapless_parse_itunsmpb(header,
+                                size,
+                                &nextparam->head_skip,
+                                &nextparam->valid_samples);
+}
+
 /*--------------------------------------------------------------------------*/
 bool AS_RequestNextPlayerProcess(AsPlayerId id, FAR AsRequestNextParam *nextparam)
 {
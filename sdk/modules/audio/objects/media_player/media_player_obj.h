@@ -128,6 +128,27 @@ private:
   uint32_t  m_max_pcm_buff_size;
   uint32_t  m_max_src_work_buff_size;
   AudioCodec  m_codec_type;
+  uint8_t   m_es_au_num;   /* Number of ES frames gathered by last getEs. */
+  uint32_t  m_pcm_au_size; /* Max PCM size of one decoded frame. */
+
+  /* Tracks for gapless playback. The track which ES is read and the
+   * queued next track are held in two slots, switched at the boundary.
+   */
+
+  struct TrackInfo
+  {
+    uint32_t es_size;
+    uint32_t head_skip;
+    uint32_t valid_samples;
+  };
+
+  TrackInfo m_track[2];
+  uint8_t   m_in_track;        /* Slot of the track which ES is read. */
+  bool      m_has_next;        /* Next track is queued. */
+  uint32_t  m_track_read_size; /* ES size read of the current track. */
+  uint8_t   m_out_track;       /* Slot of the track which PCM is output. */
+  uint32_t  m_out_skip;        /* Output samples left to skip. */
+  uint32_t  m_out_remain;      /* Output samples left to be valid. */
 
   #define  MAX_EXEC_COUNT    2   /* Number of audio frames to be prior introduced. */
   #define  MAX_OUT_BUFF_NUM  10  /* Number of PCM buffer. */
@@ -136,6 +157,15 @@ private:
   typedef s_std::Queue<MemMgrLite::MemHandle, MAX_EXEC_COUNT + 1> EsMhQueue;
   EsMhQueue m_es_buf_mh_que;
 
+  typedef s_std::Queue<uint8_t, MAX_EXEC_COUNT + 1> EsTrackQueue;
+  EsTrackQueue m_es_track_que; /* Track slot of each decode request. */
+
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+  typedef s_std::Queue<uint32_t, MAX_EXEC_COUNT + 1> EsTimeQueue;
+  EsTimeQueue m_es_time_que;   /* Time stamp of each decode request. */
+  uint32_t    m_dec_es_time;   /* Time stamp of the last decoded request. */
+#endif
+
   typedef s_std::Queue<MemMgrLite::MemHandle, MAX_OUT_BUFF_NUM> PcmMhQueue;
   PcmMhQueue m_pcm_buf_mh_que;
 
@@ -200,6 +230,9 @@ private:
 
   void setGain(MsgPacket *);
 
+  void setNextOnReady(MsgPacket *);
+  void setNextOnPlay(MsgPacket *);
+
   uint32_t loadCodec(AudioCodec codec,
                      AsInitPlayerParam *param,
                      uint32_t* dsp_inf);
@@ -211,6 +244,14 @@ private:
   void sendPcmToOwner(AsPcmDataParam& data);
 
   void decode(void* p_es, uint32_t es_size);
+  uint32_t getMaxEsFrameSize(void);
+  uint8_t  getBatchCount(void);
+  void updatePcmAuSize(uint32_t pcm_size, uint8_t num_of_au);
+
+  void resetTrack(void);
+  void startTrackOutput(uint8_t track);
+  uint32_t toOutSamples(uint32_t samples);
+  void splicePcm(AsPcmDataParam& data, uint8_t track);
 
   void *allocPcmBuf(uint32_t size);
   bool  freePcmBuf() {
@@ -222,9 +263,20 @@ private:
     return true;
   }
 
+  void  decodeNext(void);
   void *getEs(uint32_t* size);
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+  void stampPcm(AsPcmDataParam& data);
+#endif
   bool freeEsBuf()
     {
+      m_es_track_que.pop();
+
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+      m_dec_es_time = m_es_time_que.top();
+      m_es_time_que.pop();
+#endif
+
       if (!m_es_buf_mh_que.pop())
         {
         MEDIA_PLAYER_ERR(AS_ATTENTION_SUB_CODE_MEMHANDLE_FREE_ERROR);
@@ -0,0 +1,80 @@
+/****************************************************************************
+ * modules/audio/objects/media_player/player_decode_batch.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_AUDIO_OBJECTS_MEDIA_PLAYER_PLAYER_DECODE_BATCH_H
+#define __MODULES_AUDIO_OBJECTS_MEDIA_PLAYER_PLAYER_DECODE_BATCH_H
+
+/* Number of ES frames gathered into one decode request of media player.
+ * It depends on nothing but standard types, so that its bounds can be
+ * tested on host.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+typedef struct
+{
+  uint32_t max_batch;     /* CONFIG_AUDIOUTILS_PLAYER_DECODE_BATCH      */
+  bool     pre_play;      /* In pre-play, or not playing yet            */
+  uint32_t pcm_used;      /* PCM segments held by downstream            */
+  uint32_t es_buf_size;   /* Size of an ES segment (bytes)              */
+  uint32_t es_frame_size; /* Worst case ES frame size, 0 if unknown     */
+  uint32_t pcm_buf_size;  /* Size of a PCM segment (bytes)              */
+  uint32_t pcm_au_size;   /* PCM size of a decoded frame, 0 if unknown  */
+} DecodeBatchParam;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* Returns number of frames of next decode request, which is at least 1.
+ * Frames are decoded one by one during pre-play and until sizes of a
+ * frame are known. Then the more PCM is buffered at downstream, the more
+ * frames are gathered, within max_batch and so that all of them fit in
+ * an ES segment and a PCM segment.
+ */
+
+uint32_t decode_batch_count(FAR const DecodeBatchParam *param);
+
+#endif /* __MODULES_AUDIO_OBJECTS_MEDIA_PLAYER_PLAYER_DECODE_BATCH_H */
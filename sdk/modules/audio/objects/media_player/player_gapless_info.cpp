@@ -0,0 +1,284 @@
+/****************************************************************************
+ * modules/audio/objects/media_player/player_gapless_info.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <string.h>
+#include "player_gapless_info.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Delay of MP3 decoder (filterbank), which LAME delay does not include. */
+
+#define MP3_DECODER_DELAY   529
+
+#define ID3V2_HEADER_SIZE   10
+#define LAME_DELAY_OFFSET   21
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint32_t read_be32(FAR const uint8_t *p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8)  | (uint32_t)p[3];
+}
+
+/*--------------------------------------------------------------------------*/
+static uint32_t skip_id3v2(FAR const uint8_t *header, uint32_t size)
+{
+  if ((size < ID3V2_HEADER_SIZE) || (memcmp(header, "ID3", 3) != 0))
+    {
+      return 0;
+    }
+
+  /* Size is sync-safe integer, 7 bits per byte. Footer is same size as
+   * header.
+   */
+
+  uint32_t tag_size = ((uint32_t)(header[6] & 0x7f) << 21) |
+                      ((uint32_t)(header[7] & 0x7f) << 14) |
+                      ((uint32_t)(header[8] & 0x7f) << 7)  |
+                      (uint32_t)(header[9] & 0x7f);
+
+  tag_size += ID3V2_HEADER_SIZE;
+  if (header[5] & 0x10)
+    {
+      tag_size += ID3V2_HEADER_SIZE;
+    }
+
+  return tag_size;
+}
+
+/*--------------------------------------------------------------------------*/
+static int hex_digit(uint8_t c)
+{
+  if (c >= '0' && c <= '9')
+    {
+      return c - '0';
+    }
+  if (c >= 'a' && c <= 'f')
+    {
+      return c - 'a' + 10;
+    }
+  if (c >= 'A' && c <= 'F')
+    {
+      return c - 'A' + 10;
+    }
+  return -1;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+bool gapless_parse_itunsmpb(FAR const uint8_t *header,
+                            uint32_t size,
+                            FAR uint32_t *head_skip,
+                            FAR uint32_t *valid_samples)
+{
+  static const char name[] = "iTunSMPB";
+  const uint32_t name_len = sizeof(name) - 1;
+  uint32_t pos;
+
+  for (pos = 0; pos + name_len <= size; pos++)
+    {
+      if (memcmp(&header[pos], name, name_len) == 0)
+        {
+          break;
+        }
+    }
+
+  if (pos + name_len > size)
+    {
+      return false;
+    }
+
+  /* Value is hex fields separated by space, as
+   * " 00000000 00000840 000001CA 00000000003A2DE6 ...",
+   * which are reserved, delay, padding and original sample count.
+   */
+
+  uint64_t field[4];
+  int      num = 0;
+
+  pos += name_len;
+
+  while ((pos < size) && (num < 4))
+    {
+      if (hex_digit(header[pos]) < 0)
+        {
+          pos++;
+          continue;
+        }
+
+      field[num] = 0;
+      while ((pos < size) && (hex_digit(header[pos]) >= 0))
+        {
+          field[num] = (field[num] << 4) | hex_digit(header[pos]);
+          pos++;
+        }
+      num++;
+    }
+
+  if ((num < 4) || (field[3] > UINT32_MAX))
+    {
+      return false;
+    }
+
+  *head_skip     = (uint32_t)field[1];
+  *valid_samples = (uint32_t)field[3];
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+bool gapless_parse_lame(FAR const uint8_t *header,
+                        uint32_t size,
+                        FAR uint32_t *head_skip,
+                        FAR uint32_t *valid_samples)
+{
+  uint32_t pos = skip_id3v2(header, size);
+
+  if ((pos + 4 > size) ||
+      (header[pos] != 0xff) || ((header[pos + 1] & 0xe0) != 0xe0))
+    {
+      return false;
+    }
+
+  /* Xing/Info tag is placed after side information of the first frame. */
+
+  bool     mpeg1 = (((header[pos + 1] >> 3) & 0x03) == 0x03);
+  bool     mono  = (((header[pos + 3] >> 6) & 0x03) == 0x03);
+  uint32_t spf   = mpeg1 ? 1152 : 576;
+
+  pos += 4 + (mpeg1 ? (mono ? 17 : 32) : (mono ? 9 : 17));
+
+  if ((pos + 8 > size) ||
+      ((memcmp(&header[pos], "Xing", 4) != 0) &&
+       (memcmp(&header[pos], "Info", 4) != 0)))
+    {
+      return false;
+    }
+
+  uint32_t flags  = read_be32(&header[pos + 4]);
+  uint32_t frames = 0;
+
+  pos += 8;
+
+  if (flags & 0x01)
+    {
+      if (pos + 4 > size)
+        {
+          return false;
+        }
+      frames = read_be32(&header[pos]);
+      pos += 4;
+    }
+
+  pos += (flags & 0x02) ? 4 : 0;   /* Bytes */
+  pos += (flags & 0x04) ? 100 : 0; /* TOC */
+  pos += (flags & 0x08) ? 4 : 0;   /* Quality */
+
+  /* The tag frame itself is decoded as a silent frame. */
+
+  *head_skip     = spf;
+  *valid_samples = 0;
+
+  /* LAME extension has 12 bits each of encoder delay and padding. */
+
+  if (pos + LAME_DELAY_OFFSET + 3 <= size)
+    {
+      FAR const uint8_t *p = &header[pos + LAME_DELAY_OFFSET];
+      uint32_t delay   = ((uint32_t)p[0] << 4) | (p[1] >> 4);
+      uint32_t padding = ((uint32_t)(p[1] & 0x0f) << 8) | p[2];
+
+      *head_skip += delay + MP3_DECODER_DELAY;
+
+      if (frames * spf > delay + padding)
+        {
+          *valid_samples = frames * spf - delay - padding;
+        }
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t gapless_out_samples(uint32_t samples, uint32_t in_fs, uint32_t out_fs)
+{
+  if (in_fs == 0)
+    {
+      return samples;
+    }
+
+  return (uint32_t)(((uint64_t)samples * out_fs + in_fs / 2) / in_fs);
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t gapless_splice_pcm(FAR uint8_t *pcm,
+                            uint32_t size,
+                            uint32_t unit,
+                            FAR uint32_t *skip,
+                            FAR uint32_t *remain)
+{
+  uint32_t samples = size / unit;
+  uint32_t head    = (*skip < samples) ? *skip : samples;
+
+  /* Drop encoder delay at the head. */
+
+  *skip   -= head;
+  samples -= head;
+
+  if ((head > 0) && (samples > 0))
+    {
+      memmove(pcm, pcm + head * unit, samples * unit);
+    }
+
+  /* Drop encoder padding at the tail. */
+
+  if (*remain != GAPLESS_NO_LIMIT)
+    {
+      samples = (samples < *remain) ? samples : *remain;
+      *remain -= samples;
+    }
+
+  return samples * unit;
+}
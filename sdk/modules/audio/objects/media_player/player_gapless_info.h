@@ -0,0 +1,98 @@
+/****************************************************************************
+ * modules/audio/objects/media_player/player_gapless_info.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_AUDIO_OBJECTS_MEDIA_PLAYER_PLAYER_GAPLESS_INFO_H
+#define __MODULES_AUDIO_OBJECTS_MEDIA_PLAYER_PLAYER_GAPLESS_INFO_H
+
+/* Gapless playback helpers of media player.
+ *
+ * Parsers of encoder delay and padding in head of a track, and trimming
+ * of decoded PCM at track boundary. They depend on nothing but standard
+ * types, so that joining of tracks can be tested on host.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Remaining samples of a track whose length is unknown. */
+
+#define GAPLESS_NO_LIMIT  UINT32_MAX
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* Parse LAME/Xing tag of MP3. head_skip includes the tag frame and delay
+ * of decoder. valid_samples is 0 if the tag has no frame count.
+ */
+
+bool gapless_parse_lame(FAR const uint8_t *header,
+                        uint32_t size,
+                        FAR uint32_t *head_skip,
+                        FAR uint32_t *valid_samples);
+
+/* Parse iTunSMPB comment, which is written by iTunes for MP3 and AAC. */
+
+bool gapless_parse_itunsmpb(FAR const uint8_t *header,
+                            uint32_t size,
+                            FAR uint32_t *head_skip,
+                            FAR uint32_t *valid_samples);
+
+/* Convert samples of source rate to samples of decoder output rate. */
+
+uint32_t gapless_out_samples(uint32_t samples, uint32_t in_fs, uint32_t out_fs);
+
+/* Trim decoded PCM of a track. skip is samples left to drop at the head,
+ * remain is samples left to be valid, or GAPLESS_NO_LIMIT. Both are
+ * updated. unit is byte size of a sample of all channels. Returns byte
+ * size of PCM left at the top of pcm.
+ */
+
+uint32_t gapless_splice_pcm(FAR uint8_t *pcm,
+                            uint32_t size,
+                            uint32_t unit,
+                            FAR uint32_t *skip,
+                            FAR uint32_t *remain);
+
+#endif /* __MODULES_AUDIO_OBJECTS_MEDIA_PLAYER_PLAYER_GAPLESS_INFO_H */
@@ -0,0 +1,358 @@
+/****************************************************************************
+ * modules/audio/objects/output_mixer/clock_recovery.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include "clock_recovery.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PPM_TO_Q32(ppm)  (((int64_t)(ppm) << 32) / 1000000)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline void store_sample(int16_t *p, int64_t val)
+{
+  *p = (val > INT16_MAX) ? INT16_MAX :
+       (val < INT16_MIN) ? INT16_MIN : static_cast<int16_t>(val);
+}
+
+/*--------------------------------------------------------------------------*/
+static inline void store_sample(int32_t *p, int64_t val)
+{
+  *p = (val > INT32_MAX) ? INT32_MAX :
+       (val < INT32_MIN) ? INT32_MIN : static_cast<int32_t>(val);
+}
+
+/*--------------------------------------------------------------------------*/
+static inline int32_t clip_ppm(int32_t ppm, int32_t max_ppm)
+{
+  return (ppm > max_ppm) ? max_ppm : (ppm < -max_ppm) ? -max_ppm : ppm;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/*--------------------------------------------------------------------------*/
+/* Methods of ClockRecoveryController class */
+/*--------------------------------------------------------------------------*/
+void ClockRecoveryController::reset(uint32_t target, int32_t max_ppm)
+{
+  m_target     = target;
+  m_max_ppm    = max_ppm;
+  m_locked     = false;
+  m_settle_cnt = 0;
+  m_avg        = 0;
+  m_integ      = 0;
+  m_ratio_ppm  = 0;
+  m_depth      = 0;
+  m_min_depth  = UINT32_MAX;
+  m_max_depth  = 0;
+}
+
+/*--------------------------------------------------------------------------*/
+int32_t ClockRecoveryController::update(uint32_t depth, uint32_t frames)
+{
+  int32_t depth_fix = static_cast<int32_t>(depth << AVG_FRAC);
+
+  m_depth     = depth;
+  m_min_depth = (depth < m_min_depth) ? depth : m_min_depth;
+  m_max_depth = (depth > m_max_depth) ? depth : m_max_depth;
+
+  /* Depth is quantized by period size and jitters by timing of render
+   * done, so that control uses moving average of it.
+   */
+
+  if (m_settle_cnt == 0)
+    {
+      m_avg = depth_fix;
+    }
+  else
+    {
+      m_avg += (depth_fix - m_avg) >> AVG_SHIFT;
+    }
+
+  if (!m_locked)
+    {
+      if (++m_settle_cnt < SETTLE_PERIODS)
+        {
+          return 0;
+        }
+
+      if (m_target == 0)
+        {
+          m_target = static_cast<uint32_t>(m_avg) >> AVG_FRAC;
+        }
+
+      m_locked = true;
+    }
+
+  /* PI control. Integral term is estimation of clock drift, and
+   * it is weighted by elapsed time (frames).
+   */
+
+  int32_t err = m_avg - static_cast<int32_t>(m_target << AVG_FRAC);
+  int64_t integ_max = static_cast<int64_t>(m_max_ppm) << INTEG_SHIFT;
+
+  m_integ += (static_cast<int64_t>(err) * frames) >> KI_SHIFT;
+  m_integ = (m_integ > integ_max) ? integ_max :
+            (m_integ < -integ_max) ? -integ_max : m_integ;
+
+  int32_t ppm = (err >> KP_SHIFT) + get_drift_ppm();
+
+  m_ratio_ppm = clip_ppm(ppm, m_max_ppm);
+
+  return m_ratio_ppm;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Methods of ClockRecoveryResampler class */
+/*--------------------------------------------------------------------------*/
+ClockRecoveryResampler::ClockRecoveryResampler()
+{
+  /* Cubic (Catmull-Rom) interpolation coefficients of each phase. */
+
+  const int32_t one = 1 << COEF_BITS;
+
+  for (int p = 0; p < PHASES; p++)
+    {
+      int32_t t  = p << (COEF_BITS - PHASE_BITS);
+      int32_t t2 = (t * t) >> COEF_BITS;
+      int32_t t3 = (t2 * t) >> COEF_BITS;
+
+      int32_t c0 = (-t3 + 2 * t2 - t) / 2;
+      int32_t c2 = (-3 * t3 + 4 * t2 + t) / 2;
+      int32_t c3 = (t3 - t2) / 2;
+
+      m_coef[p][0] = static_cast<int16_t>(c0);
+      m_coef[p][1] = static_cast<int16_t>(one - c0 - c2 - c3);
+      m_coef[p][2] = static_cast<int16_t>(c2);
+      m_coef[p][3] = static_cast<int16_t>(c3);
+    }
+
+  reset();
+}
+
+/*--------------------------------------------------------------------------*/
+void ClockRecoveryResampler::reset(void)
+{
+  for (int i = 0; i < TAPS - 1; i++)
+    {
+      for (int ch = 0; ch < CH_NUM; ch++)
+        {
+          m_hist[i][ch] = 0;
+        }
+    }
+
+  /* Start interpolation from the first input sample. */
+
+  m_pos       = static_cast<int64_t>(TAPS - 2) << 32;
+  m_step      = static_cast<int64_t>(1) << 32;
+  m_carry_num = 0;
+  m_dropped   = 0;
+}
+
+/*--------------------------------------------------------------------------*/
+void ClockRecoveryResampler::set_ratio(int32_t ppm)
+{
+  m_step = (static_cast<int64_t>(1) << 32) + PPM_TO_Q32(ppm);
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t ClockRecoveryResampler::exec(const void *in,
+                                      uint32_t in_frames,
+                                      void *out,
+                                      uint32_t out_frames,
+                                      bool highres)
+{
+  if (highres)
+    {
+      return filter<int32_t>(static_cast<const int32_t *>(in),
+                             in_frames,
+                             static_cast<int32_t *>(out),
+                             out_frames);
+    }
+
+  return filter<int16_t>(static_cast<const int16_t *>(in),
+                         in_frames,
+                         static_cast<int16_t *>(out),
+                         out_frames);
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t ClockRecoveryResampler::flush(void *out,
+                                       uint32_t out_frames,
+                                       bool highres)
+{
+  if (highres)
+    {
+      return drain<int32_t>(static_cast<int32_t *>(out), out_frames);
+    }
+
+  return drain<int16_t>(static_cast<int16_t *>(out), out_frames);
+}
+
+/*--------------------------------------------------------------------------*/
+template<typename T>
+uint32_t ClockRecoveryResampler::drain(T *out, uint32_t out_frames)
+{
+  uint32_t num = (m_carry_num < out_frames) ? m_carry_num : out_frames;
+
+  for (uint32_t i = 0; i < num; i++)
+    {
+      for (uint32_t ch = 0; ch < CH_NUM; ch++)
+        {
+          out[i * CH_NUM + ch] = static_cast<T>(m_carry[i][ch]);
+        }
+    }
+
+  for (uint32_t i = num; i < m_carry_num; i++)
+    {
+      for (uint32_t ch = 0; ch < CH_NUM; ch++)
+        {
+          m_carry[i - num][ch] = m_carry[i][ch];
+        }
+    }
+
+  m_carry_num -= num;
+
+  return num;
+}
+
+/*--------------------------------------------------------------------------*/
+template<typename T>
+uint32_t ClockRecoveryResampler::filter(const T *in,
+                                        uint32_t in_frames,
+                                        T *out,
+                                        uint32_t out_frames)
+{
+  /* Samples are addressed in sequence of history and input. Output frame
+   * at position i + t (0 <= t < 1) is interpolated between i+1 and i+2,
+   * using i to i+3.
+   */
+
+  const int64_t end = static_cast<int64_t>(in_frames) << 32;
+
+  /* Frames which did not fit in output of previous period go first. */
+
+  uint32_t written = drain(out, out_frames);
+
+  while (m_pos < end)
+    {
+      uint32_t idx   = static_cast<uint32_t>(m_pos >> 32);
+      uint32_t phase = static_cast<uint32_t>(m_pos) >> (32 - PHASE_BITS);
+      int64_t  acc[CH_NUM] = { 0, 0 };
+
+      for (uint32_t k = 0; k < TAPS; k++)
+        {
+          uint32_t pos = idx + k;
+
+          for (uint32_t ch = 0; ch < CH_NUM; ch++)
+            {
+              int32_t smp = (pos < TAPS - 1) ?
+                m_hist[pos][ch] : in[(pos - (TAPS - 1)) * CH_NUM + ch];
+
+              acc[ch] += static_cast<int64_t>(m_coef[phase][k]) * smp;
+            }
+        }
+
+      T smp[CH_NUM];
+
+      for (uint32_t ch = 0; ch < CH_NUM; ch++)
+        {
+          store_sample(&smp[ch],
+                       (acc[ch] + (1 << (COEF_BITS - 1))) >> COEF_BITS);
+        }
+
+      if ((written < out_frames) && (m_carry_num == 0))
+        {
+          for (uint32_t ch = 0; ch < CH_NUM; ch++)
+            {
+              out[written * CH_NUM + ch] = smp[ch];
+            }
+
+          written++;
+        }
+      else if (m_carry_num < CARRY_MAX)
+        {
+          for (uint32_t ch = 0; ch < CH_NUM; ch++)
+            {
+              m_carry[m_carry_num][ch] = smp[ch];
+            }
+
+          m_carry_num++;
+        }
+      else
+        {
+          m_dropped++;
+        }
+
+      m_pos += m_step;
+    }
+
+  m_pos -= end;
+
+  /* Keep tail of sequence as history of next period. */
+
+  int32_t hist[TAPS - 1][CH_NUM];
+
+  for (uint32_t i = 0; i < TAPS - 1; i++)
+    {
+      uint32_t pos = in_frames + i;
+
+      for (uint32_t ch = 0; ch < CH_NUM; ch++)
+        {
+          hist[i][ch] = (pos < TAPS - 1) ?
+            m_hist[pos][ch] : in[(pos - (TAPS - 1)) * CH_NUM + ch];
+        }
+    }
+
+  for (uint32_t i = 0; i < TAPS - 1; i++)
+    {
+      for (uint32_t ch = 0; ch < CH_NUM; ch++)
+        {
+          m_hist[i][ch] = hist[i][ch];
+        }
+    }
+
+  return written;
+}
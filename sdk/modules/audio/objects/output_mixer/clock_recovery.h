@@ -0,0 +1,178 @@
+/****************************************************************************
+ * modules/audio/objects/output_mixer/clock_recovery.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_AUDIO_OBJECTS_OUTPUT_MIXER_CLOCK_RECOVERY_H
+#define __MODULES_AUDIO_OBJECTS_OUTPUT_MIXER_CLOCK_RECOVERY_H
+
+/* Automatic clock recovery of output mixer.
+ *
+ * ClockRecoveryController watches depth of renderer queue and calculates
+ * conversion ratio by PI control. ClockRecoveryResampler converts sampling
+ * rate of PCM with fractional ratio by polyphase interpolation.
+ * Both of them depend on nothing but standard types, so that they can be
+ * tested on host with synthetic clock drift.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+class ClockRecoveryController
+{
+public:
+  ClockRecoveryController()
+  {
+    reset(0, 0);
+  }
+
+  /* Start control. If target is 0, depth of settled queue is used as
+   * target. Correction is limited within +/- max_ppm.
+   */
+
+  void reset(uint32_t target, int32_t max_ppm);
+
+  /* Input depth of queue (frames) and size of next period (frames),
+   * then returns ratio of conversion (ppm). Positive value means
+   * to consume input faster than output clock.
+   */
+
+  int32_t update(uint32_t depth, uint32_t frames);
+
+  int32_t get_ratio_ppm(void) const { return m_ratio_ppm; }
+  int32_t get_drift_ppm(void) const
+    {
+      return static_cast<int32_t>(m_integ >> INTEG_SHIFT);
+    }
+  uint32_t get_target(void) const { return m_target; }
+  uint32_t get_depth(void) const { return m_depth; }
+  uint32_t get_min_depth(void) const { return m_min_depth; }
+  uint32_t get_max_depth(void) const { return m_max_depth; }
+  bool is_locked(void) const { return m_locked; }
+
+private:
+  enum
+  {
+    SETTLE_PERIODS = 32, /* Periods to wait before control starts. */
+    AVG_SHIFT      = 5,  /* Time constant of depth average.         */
+    AVG_FRAC       = 8,  /* Fraction bits of average depth.         */
+    KP_SHIFT       = 9,  /* Proportional gain, 0.5 ppm per frame.   */
+    KI_SHIFT       = 15, /* Integral gain per frame x period.       */
+    INTEG_SHIFT    = 16, /* Fraction bits of integral term.         */
+  };
+
+  uint32_t m_target;
+  int32_t  m_max_ppm;
+  bool     m_locked;
+  uint32_t m_settle_cnt;
+  int32_t  m_avg;
+  int64_t  m_integ;
+  int32_t  m_ratio_ppm;
+  uint32_t m_depth;
+  uint32_t m_min_depth;
+  uint32_t m_max_depth;
+};
+
+class ClockRecoveryResampler
+{
+public:
+  ClockRecoveryResampler();
+
+  void reset(void);
+
+  /* Set ratio of conversion. Positive ppm reduces output samples. */
+
+  void set_ratio(int32_t ppm);
+
+  /* Convert interleaved 2ch PCM. Samples are 16bit, or 32bit if highres
+   * is true. Returns number of frames written to output. If output is
+   * full, rest of frames are carried and written first in next period.
+   * Only frames beyond the carry buffer are dropped and counted.
+   */
+
+  uint32_t exec(const void *in,
+                uint32_t in_frames,
+                void *out,
+                uint32_t out_frames,
+                bool highres);
+
+  /* Write carried frames to output, to send them without waiting for
+   * next period. Returns number of frames written.
+   */
+
+  uint32_t flush(void *out, uint32_t out_frames, bool highres);
+
+  uint32_t get_dropped(void) const { return m_dropped; }
+  uint32_t get_carried(void) const { return m_carry_num; }
+
+private:
+  enum
+  {
+    TAPS       = 4,
+    PHASE_BITS = 6,
+    PHASES     = (1 << PHASE_BITS),
+    COEF_BITS  = 14,
+    CH_NUM     = 2,
+    CARRY_MAX  = 256, /* Frames kept when output of a period is full,
+                       * more than minimum transfer of DMA.
+                       */
+  };
+
+  int16_t  m_coef[PHASES][TAPS];
+  int32_t  m_hist[TAPS - 1][CH_NUM];
+  int64_t  m_pos;  /* Q32 position in history + input */
+  int64_t  m_step; /* Q32 increment per output frame  */
+  int32_t  m_carry[CARRY_MAX][CH_NUM];
+  uint32_t m_carry_num;
+  uint32_t m_dropped;
+
+  template<typename T>
+  uint32_t drain(T *out, uint32_t out_frames);
+
+  template<typename T>
+  uint32_t filter(const T *in, uint32_t in_frames,
+                  T *out, uint32_t out_frames);
+};
+
+#endif /* __MODULES_AUDIO_OBJECTS_OUTPUT_MIXER_CLOCK_RECOVERY_H */
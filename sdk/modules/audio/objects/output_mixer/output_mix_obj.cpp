@@ -103,6 +103,7 @@ int OutputMixObjectTask::getHandle(MsgPacket* msg)
       case MSG_AUD_MIX_CMD_CLKRECOVERY:
       case MSG_AUD_MIX_CMD_INITMPP:
       case MSG_AUD_MIX_CMD_SETMPP:
+      case MSG_AUD_MIX_CMD_GETCLKRCV:
         handle = msg->peekParam<OutputMixerCommand>().handle;
         break;
 
@@ -523,6 +524,33 @@ bool AS_FrameTermFineControlOutputMixer(uint8_t handle, FAR AsFrameTermFineContr
   return true;
 }
 
+/*--------------------------------------------------------------------------*/
+bool AS_GetClkRecoveryStatusOutputMixer(uint8_t handle, FAR AsClkRecoveryStatus *status)
+{
+  /* Parameter check */
+
+  if (status == NULL)
+    {
+      return false;
+    }
+
+  /* Get clock recovery status */
+
+  OutputMixerCommand cmd;
+
+  cmd.handle                     = handle;
+  cmd.clkrcv_status_param.status = status;
+
+  err_t er = MsgLib::send<OutputMixerCommand>(s_msgq_id.mixer,
+                                              MsgPriNormal,
+                                              MSG_AUD_MIX_CMD_GETCLKRCV,
+                                              s_msgq_id.mng,
+                                              cmd);
+  F_ASSERT(er == ERR_OK);
+
+  return true;
+}
+
 /*--------------------------------------------------------------------------*/
 bool AS_InitPostprocOutputMixer(uint8_t handle, FAR AsInitPostProc *initppparam)
 {
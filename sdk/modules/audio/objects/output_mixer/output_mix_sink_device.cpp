@@ -38,6 +38,9 @@
  ****************************************************************************/
 
 #include "output_mix_sink_device.h"
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+#include "audio/audio_latency_api.h"
+#endif
 #include "debug/dbg_log.h"
 
 __WIEN2_BEGIN_NAMESPACE
@@ -71,6 +74,9 @@ static void send_renderer(RenderComponentHandler handle,
                           bool is_valid,
                           uint8_t bit_length);
 static bool check_sample(AsPcmDataParam* data);
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIXER_AUTO_CLKRECOVERY
+static void carried_done_callback(int32_t identifier, bool is_end);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -114,6 +120,9 @@ static void render_done_callback(FAR AudioDrvDmaResult *p_param,
     (static_cast<OutputMixToHPI2S*>(p_requester))->m_self_handle;
   outmix_param.renderdone_param.end_flag = p_param->endflg;
   outmix_param.renderdone_param.error_flag = false;
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+  outmix_param.renderdone_param.done_time = AS_GetLatencyTimestamp();
+#endif
 
   er = MsgLib::send<OutputMixObjParam>((static_cast<OutputMixToHPI2S*>
                                         (p_requester))->m_self_msgq_id,
@@ -216,6 +225,15 @@ OutputMixToHPI2S::MsgProc OutputMixToHPI2S::MsgProcTbl[AUD_MIX_MSG_NUM][StateNum
     &OutputMixToHPI2S::set_postproc,          /*  Stopping               */
     &OutputMixToHPI2S::set_postproc,          /*  Underflow              */
   },
+
+  /* Message type: GET ClkRecovery Status */
+  {                                           /* OutputMixToHPI2S State: */
+    &OutputMixToHPI2S::illegal,               /*  Booted                 */
+    &OutputMixToHPI2S::get_clkrcv_status,     /*  Ready                  */
+    &OutputMixToHPI2S::get_clkrcv_status,     /*  Active                 */
+    &OutputMixToHPI2S::get_clkrcv_status,     /*  Stopping               */
+    &OutputMixToHPI2S::get_clkrcv_status,     /*  Underflow              */
+  },
 };
 
 OutputMixToHPI2S::MsgProc OutputMixToHPI2S::MsgRsltTbl[AUD_MIX_RST_MSG_NUM][StateNum] =
@@ -304,6 +322,7 @@ void OutputMixToHPI2S::illegal(MsgPacket* msg)
       case MSG_AUD_MIX_CMD_CLKRECOVERY:
       case MSG_AUD_MIX_CMD_INITMPP:
       case MSG_AUD_MIX_CMD_SETMPP:
+      case MSG_AUD_MIX_CMD_GETCLKRCV:
         msg->moveParam<OutputMixerCommand>();
         break;
 
@@ -594,6 +613,12 @@ void OutputMixToHPI2S::input_data_on_ready(MsgPacket* msg)
   AsPcmDataParam input =
     msg->moveParam<AsPcmDataParam>();
 
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+  AS_RecordPipelineLatency(AsLatencyStageMixerIn,
+                           input.timestamp,
+                           AS_GetLatencyTimestamp());
+#endif
+
   /* Exec postfilter */
 
   ExecComponentParam exec;
@@ -617,6 +642,15 @@ void OutputMixToHPI2S::input_data_on_ready(MsgPacket* msg)
       return;
     }
 
+  m_underflow_cnt = 0;
+
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIXER_AUTO_CLKRECOVERY
+  if (m_adjust_direction == OutputMixAutoAdjust)
+    {
+      start_auto_adjustment();
+    }
+#endif
+
   m_state = Active;
 }
 
@@ -626,6 +660,12 @@ void OutputMixToHPI2S::input_data_on_active(MsgPacket* msg)
   AsPcmDataParam input =
     msg->moveParam<AsPcmDataParam>();
 
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+  AS_RecordPipelineLatency(AsLatencyStageMixerIn,
+                           input.timestamp,
+                           AS_GetLatencyTimestamp());
+#endif
+
   /* Exec postfilter */
 
   ExecComponentParam exec;
@@ -690,6 +730,19 @@ void OutputMixToHPI2S::postdone_on_active(MsgPacket* msg)
 
   if (check_sample(&cmplt.output) && cmplt.result)
     {
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+      AS_RecordPipelineLatency(AsLatencyStagePostProc,
+                               cmplt.output.timestamp,
+                               AS_GetLatencyTimestamp());
+#endif
+
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIXER_AUTO_CLKRECOVERY
+      if (m_adjust_direction == OutputMixAutoAdjust)
+        {
+          auto_adjustment(&cmplt.output);
+        }
+#endif
+
       send_renderer(m_render_comp_handler,
                     cmplt.output.mh.getPa(),
                     cmplt.output.size,
@@ -702,6 +755,13 @@ void OutputMixToHPI2S::postdone_on_active(MsgPacket* msg)
           OUTPUT_MIX_ERR(AS_ATTENTION_SUB_CODE_QUEUE_PUSH_ERROR);
           return;
         }
+
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIXER_AUTO_CLKRECOVERY
+      if (m_adjust_direction == OutputMixAutoAdjust)
+        {
+          send_carried(cmplt.output);
+        }
+#endif
     }
 
   /* If flust event done, stop renderer */
@@ -778,6 +838,7 @@ void OutputMixToHPI2S::done_on_active(MsgPacket* msg)
 
   if (param.renderdone_param.error_flag)
     {
+      m_underflow_cnt++;
       m_error_callback(m_self_handle);
       m_state = Underflow;
       return;
@@ -795,6 +856,12 @@ void OutputMixToHPI2S::done_on_active(MsgPacket* msg)
       return;
     }
 
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+  AS_RecordPipelineLatency(AsLatencyStageDmaDone,
+                           m_render_data_queue.top().timestamp,
+                           param.renderdone_param.done_time);
+#endif
+
   /* Reply */
 
   m_render_data_queue.top().callback(m_self_handle,
@@ -818,6 +885,15 @@ void OutputMixToHPI2S::done_on_stopping(MsgPacket* msg)
       return;
     }
 
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+  if (!param.renderdone_param.error_flag)
+    {
+      AS_RecordPipelineLatency(AsLatencyStageDmaDone,
+                               m_render_data_queue.top().timestamp,
+                               param.renderdone_param.done_time);
+    }
+#endif
+
   /* Reply */
 
   m_render_data_queue.top().callback(m_self_handle,
@@ -853,16 +929,36 @@ void OutputMixToHPI2S::clock_recovery(MsgPacket* msg)
 
   /* Check Paramete. */
 
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIXER_AUTO_CLKRECOVERY
+  if (cmd.fterm_param.direction == OutputMixAutoAdjust)
+    {
+      /* Target depth is given instead of term. Period adjustment
+       * is not used together.
+       */
+
+      m_adjust_direction = OutputMixAutoAdjust;
+      m_adjustment_times = 0;
+      m_auto_target      = cmd.fterm_param.times;
+
+      if (m_state.get() == Active)
+        {
+          start_auto_adjustment();
+        }
+    }
+  else
+#endif
   if (cmd.fterm_param.direction < OutputMixAdvance
    || OutputMixDelay < cmd.fterm_param.direction)
     {
       return;
     }
+  else
+    {
+      /* Set recovery parameters. */
 
-  /* Set recovery parameters. */
-
-  m_adjust_direction = cmd.fterm_param.direction;
-  m_adjustment_times = cmd.fterm_param.times;
+      m_adjust_direction = cmd.fterm_param.direction;
+      m_adjustment_times = cmd.fterm_param.times;
+    }
 
   AsOutputMixDoneParam done_param;
 
@@ -876,6 +972,50 @@ void OutputMixToHPI2S::clock_recovery(MsgPacket* msg)
   return;
 }
 
+/*--------------------------------------------------------------------------*/
+void OutputMixToHPI2S::get_clkrcv_status(MsgPacket* msg)
+{
+  OutputMixerCommand cmd =
+    msg->moveParam<OutputMixerCommand>();
+
+  AsClkRecoveryStatus *status = cmd.clkrcv_status_param.status;
+
+  memset(status, 0, sizeof(AsClkRecoveryStatus));
+
+  status->underflow_count = m_underflow_cnt;
+
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIXER_AUTO_CLKRECOVERY
+  if (m_adjust_direction == OutputMixAutoAdjust)
+    {
+      status->auto_adjust     = true;
+      status->drift_ppm       = m_clk_controller.get_drift_ppm();
+      status->ratio_ppm       = m_clk_controller.get_ratio_ppm();
+      status->target_depth    = m_clk_controller.get_target();
+      status->current_depth   = m_clk_controller.get_depth();
+      status->dropped_samples = m_clk_resampler.get_dropped();
+      status->skipped_periods = m_skipped_periods;
+
+      /* Min and max are not valid until the first period is measured. */
+
+      if (m_clk_controller.get_min_depth() <=
+          m_clk_controller.get_max_depth())
+        {
+          status->min_depth = m_clk_controller.get_min_depth();
+          status->max_depth = m_clk_controller.get_max_depth();
+        }
+    }
+#endif
+
+  AsOutputMixDoneParam done_param;
+
+  done_param.handle    = cmd.handle;
+  done_param.done_type = OutputMixGetClkRcvDone;
+  done_param.result    = true;
+  done_param.ecode     = AS_ECODE_OK;
+
+  reply(m_requester_msgq_id, MSG_AUD_MIX_CMD_GETCLKRCV, &done_param);
+}
+
 /*--------------------------------------------------------------------------*/
 int8_t OutputMixToHPI2S::get_period_adjustment(void)
 {
@@ -919,6 +1059,129 @@ int8_t OutputMixToHPI2S::get_period_adjustment(void)
   return adjust_sample;
 }
 
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIXER_AUTO_CLKRECOVERY
+/*--------------------------------------------------------------------------*/
+void OutputMixToHPI2S::start_auto_adjustment(void)
+{
+  m_clk_controller.reset(m_auto_target,
+                         CONFIG_AUDIOUTILS_OUTPUTMIXER_CLKRECOVERY_MAX_PPM);
+  m_clk_resampler.reset();
+
+  m_skipped_periods = 0;
+}
+
+/*--------------------------------------------------------------------------*/
+uint32_t OutputMixToHPI2S::get_render_depth(void)
+{
+  uint32_t depth = 0;
+
+  for (int i = 0; i < m_render_data_queue.size(); i++)
+    {
+      const AsPcmDataParam& pcm = m_render_data_queue.at(i);
+
+      depth += pcm.size / ((pcm.bit_length == AS_BITLENGTH_16) ?
+                           BYTE_SIZE_PER_SAMPLE :
+                           BYTE_SIZE_PER_SAMPLE_HIGHRES);
+    }
+
+  return depth;
+}
+
+/*--------------------------------------------------------------------------*/
+void OutputMixToHPI2S::auto_adjustment(AsPcmDataParam *pcm)
+{
+  bool highres = (pcm->bit_length != AS_BITLENGTH_16);
+  uint32_t byte_size_per_sample = (highres ?
+                                   BYTE_SIZE_PER_SAMPLE_HIGHRES :
+                                   BYTE_SIZE_PER_SAMPLE);
+  uint32_t frames = pcm->size / byte_size_per_sample;
+
+  /* Update ratio by depth of samples which are not rendered yet,
+   * including frames carried by resampler.
+   */
+
+  uint32_t depth = get_render_depth() + m_clk_resampler.get_carried();
+
+  m_clk_resampler.set_ratio(m_clk_controller.update(depth, frames));
+
+  /* Number of samples changes, so that converted data is stored
+   * to other segment. If no segment is available, send as it is.
+   * Frames beyond the segment are carried to the next period.
+   */
+
+  MemMgrLite::MemHandle mh;
+
+  if (ERR_OK != mh.allocSeg(m_pcm_pool_id, m_max_pcm_buff_size))
+    {
+      m_skipped_periods++;
+      return;
+    }
+
+  uint32_t out_frames =
+    m_clk_resampler.exec(pcm->mh.getPa(),
+                         frames,
+                         mh.getPa(),
+                         m_max_pcm_buff_size / byte_size_per_sample,
+                         highres);
+
+  pcm->mh   = mh;
+  pcm->size = out_frames * byte_size_per_sample;
+}
+
+/*--------------------------------------------------------------------------*/
+void OutputMixToHPI2S::send_carried(const AsPcmDataParam &pcm)
+{
+  /* When output clock is faster, converted data of a period can be larger
+   * than a segment. Surplus frames are carried by resampler and written
+   * at top of next period, but if segments are always filled, they only
+   * pile up. So send them as an extra transfer when they are enough for
+   * DMA. The source is not notified of its completion.
+   */
+
+  if (m_clk_resampler.get_carried() < DMA_MIN_SAMPLE)
+    {
+      return;
+    }
+
+  bool highres = (pcm.bit_length != AS_BITLENGTH_16);
+  uint32_t byte_size_per_sample = (highres ?
+                                   BYTE_SIZE_PER_SAMPLE_HIGHRES :
+                                   BYTE_SIZE_PER_SAMPLE);
+
+  MemMgrLite::MemHandle mh;
+
+  if (ERR_OK != mh.allocSeg(m_pcm_pool_id, m_max_pcm_buff_size))
+    {
+      return;
+    }
+
+  uint32_t frames =
+    m_clk_resampler.flush(mh.getPa(),
+                          m_max_pcm_buff_size / byte_size_per_sample,
+                          highres);
+
+  AsPcmDataParam extra = pcm;
+
+  extra.callback = carried_done_callback;
+  extra.mh       = mh;
+  extra.size     = frames * byte_size_per_sample;
+  extra.is_end   = false;
+  extra.is_valid = true;
+
+  send_renderer(m_render_comp_handler,
+                extra.mh.getPa(),
+                extra.size,
+                0,
+                extra.is_valid,
+                extra.bit_length);
+
+  if (!m_render_data_queue.push(extra))
+    {
+      OUTPUT_MIX_ERR(AS_ATTENTION_SUB_CODE_QUEUE_PUSH_ERROR);
+    }
+}
+#endif
+
 /*--------------------------------------------------------------------------*/
 void OutputMixToHPI2S::init_postproc(MsgPacket* msg)
 {
@@ -1060,6 +1323,14 @@ static bool check_sample(AsPcmDataParam *data)
   return res;
 }
 
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIXER_AUTO_CLKRECOVERY
+/*--------------------------------------------------------------------------*/
+static void carried_done_callback(int32_t identifier, bool is_end)
+{
+  /* Frames carried by clock recovery have no source to notify. */
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -56,6 +56,9 @@
 #include "components/customproc/thruproc_component.h"
 #include "objects/stream_parser/ram_lpcm_data_source.h"
 #include "objects/stream_parser/mp3_stream_mng.h"
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIXER_AUTO_CLKRECOVERY
+#include "clock_recovery.h"
+#endif
 
 __WIEN2_BEGIN_NAMESPACE
 
@@ -81,6 +84,9 @@ struct OutputMixObjRenderDoneCmd
 {
   bool end_flag;
   bool error_flag;
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+  uint32_t done_time;
+#endif
 };
 
 /**< OutputMixer self internal message structure */
@@ -115,6 +121,11 @@ public:
     , m_callback(NULL)
     , m_adjust_direction(OutputMixNoAdjust)
     , m_adjustment_times(0)
+    , m_underflow_cnt(0)
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIXER_AUTO_CLKRECOVERY
+    , m_auto_target(0)
+    , m_skipped_periods(0)
+#endif
   {
     memset(m_dsp_path, 0, sizeof(m_dsp_path));
   }
@@ -167,6 +178,14 @@ private:
 
   int8_t m_adjust_direction;
   int32_t m_adjustment_times;
+  uint32_t m_underflow_cnt;
+
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIXER_AUTO_CLKRECOVERY
+  uint32_t m_auto_target;
+  uint32_t m_skipped_periods;
+  ClockRecoveryController m_clk_controller;
+  ClockRecoveryResampler m_clk_resampler;
+#endif
 
   uint32_t m_max_pcm_buff_size;
   uint32_t m_apucmd_pcm_buff_size;
@@ -196,6 +215,7 @@ private:
   void done_on_stopping(MsgPacket *msg);
 
   void clock_recovery(MsgPacket *msg);
+  void get_clkrcv_status(MsgPacket *msg);
 
   void init_postproc(MsgPacket* msg);
   void set_postproc(MsgPacket* msg);
@@ -203,6 +223,12 @@ private:
   void parseOutputMixRst(MsgPacket *msg);
 
   int8_t get_period_adjustment(void);
+#ifdef CONFIG_AUDIOUTILS_OUTPUTMIXER_AUTO_CLKRECOVERY
+  void start_auto_adjustment(void);
+  uint32_t get_render_depth(void);
+  void auto_adjustment(AsPcmDataParam *pcm);
+  void send_carried(const AsPcmDataParam &pcm);
+#endif
   bool checkMemPool(void);
 };
 
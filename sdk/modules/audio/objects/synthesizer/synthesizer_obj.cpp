@@ -849,6 +849,9 @@ void SynthesizerObject::sendPcmToOwner(MemHandle mh, bool is_end)
   data.size       = m_pcm_buff_size;
   data.mh         = mh;
   data.is_end     = is_end;
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+  data.timestamp  = 0;
+#endif
 
   if (m_data_path == AsSynthesizerDataPathCallback)
     {
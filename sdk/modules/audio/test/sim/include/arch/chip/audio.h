@@ -0,0 +1,216 @@
+/****************************************************************************
+ * modules/audio/test/sim/include/arch/chip/audio.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_AUDIO_TEST_SIM_INCLUDE_ARCH_CHIP_AUDIO_H
+#define __MODULES_AUDIO_TEST_SIM_INCLUDE_ARCH_CHIP_AUDIO_H
+
+/* Host stand-in of the audio driver header.  Only the types and functions
+ * used by the objects, the components and the DMA driver are declared.
+ * The functions are implemented by sim_audio_drv.cpp.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* On the target syslog() reaches the audio sources through the chip
+ * headers.
+ */
+
+#include <syslog.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CXD56_AUDIO_ECODE uint32_t
+
+#define CXD56_AUDIO_ECODE_OK         0x0000
+#define CXD56_AUDIO_ECODE_DMA_CMPLT  0x0101
+#define CXD56_AUDIO_ECODE_DMA_CMB    0x0102
+#define CXD56_AUDIO_ECODE_DMA_BUSY   0x0103
+#define CXD56_AUDIO_ECODE_DMA_HANDLE 0x0104
+#define CXD56_AUDIO_ECODE_DMA_PATH   0x0105
+
+#define CXD56_AUDIO_MIC_CH_MAX       8
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+typedef enum
+{
+  CXD56_AUDIO_DMAC_MIC = 0,
+  CXD56_AUDIO_DMAC_I2S0_DOWN,
+  CXD56_AUDIO_DMAC_I2S1_DOWN,
+  CXD56_AUDIO_DMAC_MAX
+} cxd56_audio_dma_t;
+
+typedef enum
+{
+  CXD56_AUDIO_DMA_PATH_MIC_TO_MEM = 0,
+  CXD56_AUDIO_DMA_PATH_MEM_TO_BUSIF1,
+  CXD56_AUDIO_DMA_PATH_MEM_TO_BUSIF2
+} cxd56_audio_dma_path_t;
+
+typedef enum
+{
+  CXD56_AUDIO_SAMP_FMT_24 = 0,
+  CXD56_AUDIO_SAMP_FMT_16
+} cxd56_audio_samp_fmt_t;
+
+typedef enum
+{
+  CXD56_AUDIO_DMA_FMT_LR = 0,
+  CXD56_AUDIO_DMA_FMT_RL
+} cxd56_audio_dmafmt_t;
+
+typedef enum
+{
+  CXD56_AUDIO_DSR_1STEP = 0,
+  CXD56_AUDIO_DSR_2STEP,
+  CXD56_AUDIO_DSR_4STEP,
+  CXD56_AUDIO_DSR_8STEP,
+  CXD56_AUDIO_DSR_16STEP,
+  CXD56_AUDIO_DSR_32STEP,
+  CXD56_AUDIO_DSR_64STEP,
+  CXD56_AUDIO_DSR_128STEP
+} cxd56_audio_dsr_rate_t;
+
+typedef enum
+{
+  CXD56_AUDIO_VOLID_MIXER_IN1 = 0,
+  CXD56_AUDIO_VOLID_MIXER_IN2,
+  CXD56_AUDIO_VOLID_MIXER_OUT
+} cxd56_audio_volid_t;
+
+typedef enum
+{
+  CXD56_AUDIO_CLKMODE_NORMAL = 0,
+  CXD56_AUDIO_CLKMODE_HIRES
+} cxd56_audio_clkmode_t;
+
+typedef enum
+{
+  CXD56_AUDIO_SIG_MIC1 = 0,
+  CXD56_AUDIO_SIG_MIC2,
+  CXD56_AUDIO_SIG_MIC3,
+  CXD56_AUDIO_SIG_MIC4,
+  CXD56_AUDIO_SIG_I2S0,
+  CXD56_AUDIO_SIG_I2S1,
+  CXD56_AUDIO_SIG_BUSIF1,
+  CXD56_AUDIO_SIG_BUSIF2,
+  CXD56_AUDIO_SIG_MIX
+} cxd56_audio_signal_t;
+
+typedef enum
+{
+  CXD56_AUDIO_MIC_DEV_NONE = 0,
+  CXD56_AUDIO_MIC_DEV_ANALOG,
+  CXD56_AUDIO_MIC_DEV_DIGITAL,
+  CXD56_AUDIO_MIC_DEV_ANADIG
+} cxd56_audio_micdev_t;
+
+typedef struct
+{
+  bool au_dat_sel1;
+  bool au_dat_sel2;
+  bool cod_insel2;
+  bool cod_insel3;
+  bool src1in_sel;
+  bool src2in_sel;
+} cxd56_audio_sel_t;
+
+typedef struct
+{
+  int32_t gain[CXD56_AUDIO_MIC_CH_MAX];
+} cxd56_audio_mic_gain_t;
+
+typedef void (*cxd56_audio_dma_cb_t)(cxd56_audio_dma_t handle,
+                                     uint32_t code);
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+CXD56_AUDIO_ECODE cxd56_audio_en_output(void);
+CXD56_AUDIO_ECODE cxd56_audio_dis_output(void);
+CXD56_AUDIO_ECODE cxd56_audio_set_spout(bool sp_out_en);
+CXD56_AUDIO_ECODE cxd56_audio_en_i2s_io(void);
+CXD56_AUDIO_ECODE cxd56_audio_dis_i2s_io(void);
+CXD56_AUDIO_ECODE cxd56_audio_set_datapath(cxd56_audio_signal_t sig,
+                                           cxd56_audio_sel_t sel);
+CXD56_AUDIO_ECODE cxd56_audio_get_dmahandle(cxd56_audio_dma_path_t path,
+                                            cxd56_audio_dma_t *handle);
+CXD56_AUDIO_ECODE cxd56_audio_free_dmahandle(cxd56_audio_dma_t handle);
+CXD56_AUDIO_ECODE cxd56_audio_set_dmacb(cxd56_audio_dma_t handle,
+                                        cxd56_audio_dma_cb_t cb);
+CXD56_AUDIO_ECODE cxd56_audio_set_micgain(cxd56_audio_mic_gain_t *gain);
+cxd56_audio_micdev_t cxd56_audio_get_micdev(void);
+CXD56_AUDIO_ECODE cxd56_audio_init_dma(cxd56_audio_dma_t handle,
+                                       cxd56_audio_samp_fmt_t fmt,
+                                       uint8_t *ch_num);
+CXD56_AUDIO_ECODE cxd56_audio_start_dma(cxd56_audio_dma_t handle,
+                                        uint32_t addr,
+                                        uint32_t sample);
+CXD56_AUDIO_ECODE cxd56_audio_stop_dma(cxd56_audio_dma_t handle);
+CXD56_AUDIO_ECODE cxd56_audio_en_dmaint(void);
+CXD56_AUDIO_ECODE cxd56_audio_dis_dmaint(void);
+CXD56_AUDIO_ECODE cxd56_audio_clear_dmaerrint(cxd56_audio_dma_t handle);
+CXD56_AUDIO_ECODE cxd56_audio_mask_dmaerrint(cxd56_audio_dma_t handle);
+CXD56_AUDIO_ECODE cxd56_audio_unmask_dmaerrint(cxd56_audio_dma_t handle);
+cxd56_audio_dmafmt_t cxd56_audio_get_dmafmt(void);
+CXD56_AUDIO_ECODE cxd56_audio_en_digsft(cxd56_audio_dsr_rate_t rate);
+CXD56_AUDIO_ECODE cxd56_audio_dis_digsft(void);
+CXD56_AUDIO_ECODE cxd56_audio_mute_vol_fade(cxd56_audio_volid_t id,
+                                            bool wait);
+CXD56_AUDIO_ECODE cxd56_audio_unmute_vol_fade(cxd56_audio_volid_t id,
+                                              bool wait);
+cxd56_audio_clkmode_t cxd56_audio_get_clkmode(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MODULES_AUDIO_TEST_SIM_INCLUDE_ARCH_CHIP_AUDIO_H */
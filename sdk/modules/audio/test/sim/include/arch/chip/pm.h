@@ -0,0 +1,87 @@
+/****************************************************************************
+ * modules/audio/test/sim/include/arch/chip/pm.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_AUDIO_TEST_SIM_INCLUDE_ARCH_CHIP_PM_H
+#define __MODULES_AUDIO_TEST_SIM_INCLUDE_ARCH_CHIP_PM_H
+
+/* Host stand-in of the CPU frequency lock.  The host runs at one
+ * frequency, the locks are counted only.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PM_CPUFREQLOCK_FLAG_HV   (0x0001)
+#define PM_CPUFREQLOCK_FLAG_LV   (0x4000)
+
+#define PM_CPUFREQLOCK_TAG(prefix1, prefix2, num) \
+  (((prefix1) << 24) + ((prefix2) << 16) + (num))
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct pm_cpu_freqlock_s
+{
+  int      count;
+  uint32_t info;
+  int      flag;
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void up_pm_acquire_freqlock(struct pm_cpu_freqlock_s *lock);
+void up_pm_release_freqlock(struct pm_cpu_freqlock_s *lock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MODULES_AUDIO_TEST_SIM_INCLUDE_ARCH_CHIP_PM_H */
@@ -0,0 +1,90 @@
+/****************************************************************************
+ * modules/audio/test/sim/include/nuttx/config.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_AUDIO_TEST_SIM_INCLUDE_NUTTX_CONFIG_H
+#define __MODULES_AUDIO_TEST_SIM_INCLUDE_NUTTX_CONFIG_H
+
+/* Host stand-in of the generated NuttX configuration for the simulation
+ * build of the audio objects.  The options match a board configuration
+ * with the player, the output mixer, the front end and the recorder.
+ */
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define FAR
+#define NEAR
+#define CODE
+
+#define OK    0
+#define ERROR -1
+
+#define CONFIG_ASMP                                   1
+#define CONFIG_SDK_AUDIO                              1
+
+#define CONFIG_MEMUTILS                               1
+#define CONFIG_MEMUTILS_MESSAGE                       1
+#define CONFIG_MEMUTILS_MEMORY_MANAGER                1
+#define CONFIG_MEMUTILS_MEMORY_MANAGER_USE_FENCE      1
+#define CONFIG_MEMUTILS_MEMORY_MANAGER_NUM_FIXED_AREA_FENCES 0
+#define CONFIG_MEMUTILS_SIMPLE_FIFO                   1
+
+#define CONFIG_AUDIOUTILS_PLAYER                      1
+#define CONFIG_AUDIOUTILS_PLAYER_CODEC_PCM            1
+#define CONFIG_AUDIOUTILS_PLAYER_DECODE_BATCH         1
+#define CONFIG_AUDIOUTILS_PLAYER_DECODE_DEPTH         0
+#define CONFIG_AUDIOUTILS_OUTPUTMIXER                 1
+#define CONFIG_AUDIOUTILS_OUTPUTMIXER_AUTO_CLKRECOVERY 1
+#define CONFIG_AUDIOUTILS_OUTPUTMIXER_CLKRECOVERY_MAX_PPM 1000
+#define CONFIG_AUDIOUTILS_RECORDER                    1
+#define CONFIG_AUDIOUTILS_MFE                         1
+
+#define CONFIG_AUDIOUTILS_RENDERER                    1
+#define CONFIG_AUDIOUTILS_RENDERER_CH_NUM             2
+#define CONFIG_AUDIOUTILS_CAPTURE                     1
+#define CONFIG_AUDIOUTILS_CAPTURE_CH_NUM              2
+#define CONFIG_AUDIOUTILS_DECODER                     1
+#define CONFIG_AUDIOUTILS_ENCODER                     1
+#define CONFIG_AUDIOUTILS_FILTER                      1
+#define CONFIG_AUDIOUTILS_CUSTOMPROC                  1
+#define CONFIG_AUDIOUTILS_COMPONENT_COMMON            1
+#define CONFIG_AUDIOUTILS_DSP_DRIVER                  1
+#define CONFIG_AUDIOUTILS_DSP_MOUNTPT                 "/sim/BIN"
+
+#define CONFIG_AUDIOUTILS_LATENCY_TRACE               1
+#define CONFIG_AUDIOUTILS_LATENCY_TRACE_BIN_MS        2
+
+#endif /* __MODULES_AUDIO_TEST_SIM_INCLUDE_NUTTX_CONFIG_H */
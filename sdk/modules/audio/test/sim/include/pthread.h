@@ -0,0 +1,102 @@
+/****************************************************************************
+ * modules/audio/test/sim/include/pthread.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_AUDIO_TEST_SIM_INCLUDE_PTHREAD_H
+#define __MODULES_AUDIO_TEST_SIM_INCLUDE_PTHREAD_H
+
+/* Host stand-in of the NuttX pthread interfaces.  The audio objects set
+ * the stack size in the NuttX attribute structure directly, so the host
+ * attribute is wrapped in a structure which has it.  Stack size and
+ * priority are ignored, all threads run with the host defaults.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <signal.h>
+#include <sched.h>
+#include <time.h>
+#include_next <pthread.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+typedef void *pthread_addr_t;
+typedef pthread_addr_t (*pthread_startroutine_t)(pthread_addr_t);
+
+typedef struct sim_pthread_attr_s
+{
+  size_t             stacksize;
+  struct sched_param param;
+} sim_pthread_attr_t;
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef SIM_PTHREAD_IMPL
+#  define pthread_attr_t             sim_pthread_attr_t
+#  define pthread_attr_init          sim_pthread_attr_init
+#  define pthread_attr_destroy       sim_pthread_attr_destroy
+#  define pthread_attr_setschedparam sim_pthread_attr_setschedparam
+#  define pthread_attr_setstacksize  sim_pthread_attr_setstacksize
+#  define pthread_create             sim_pthread_create
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+int sim_pthread_attr_init(sim_pthread_attr_t *attr);
+int sim_pthread_attr_destroy(sim_pthread_attr_t *attr);
+int sim_pthread_attr_setschedparam(sim_pthread_attr_t *attr,
+                                   const struct sched_param *param);
+int sim_pthread_attr_setstacksize(sim_pthread_attr_t *attr,
+                                  size_t stacksize);
+int sim_pthread_create(pthread_t *thread, const sim_pthread_attr_t *attr,
+                       pthread_startroutine_t entry, pthread_addr_t arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MODULES_AUDIO_TEST_SIM_INCLUDE_PTHREAD_H */
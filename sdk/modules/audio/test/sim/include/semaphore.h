@@ -0,0 +1,103 @@
+/****************************************************************************
+ * modules/audio/test/sim/include/semaphore.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_AUDIO_TEST_SIM_INCLUDE_SEMAPHORE_H
+#define __MODULES_AUDIO_TEST_SIM_INCLUDE_SEMAPHORE_H
+
+/* Host stand-in of the NuttX semaphore.  The message library initializes
+ * the NuttX specific semcount field directly, so the host semaphore is
+ * wrapped in a structure which has it.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include_next <semaphore.h>
+#include <stdint.h>
+
+/* The components reach the pthread interfaces through the NuttX task
+ * headers which <semaphore.h> pulls in on the target.
+ */
+
+#include <pthread.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+typedef struct sim_sem_s
+{
+  sem_t   sem;
+  int16_t semcount;
+} sim_sem_t;
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef SIM_SEMAPHORE_IMPL
+#  define sem_t         sim_sem_t
+#  define sem_init      sim_sem_init
+#  define sem_destroy   sim_sem_destroy
+#  define sem_wait      sim_sem_wait
+#  define sem_timedwait sim_sem_timedwait
+#  define sem_trywait   sim_sem_trywait
+#  define sem_post      sim_sem_post
+#  define sem_getvalue  sim_sem_getvalue
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+int sim_sem_init(sim_sem_t *sem, int pshared, unsigned int value);
+int sim_sem_destroy(sim_sem_t *sem);
+int sim_sem_wait(sim_sem_t *sem);
+int sim_sem_timedwait(sim_sem_t *sem, const struct timespec *abstime);
+int sim_sem_trywait(sim_sem_t *sem);
+int sim_sem_post(sim_sem_t *sem);
+int sim_sem_getvalue(sim_sem_t *sem, int *sval);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MODULES_AUDIO_TEST_SIM_INCLUDE_SEMAPHORE_H */
@@ -0,0 +1,248 @@
+/* This file is generated automatically. */
+/****************************************************************************
+ * ../layout/mem_layout.h
+ *
+ *   Copyright 2026 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef MEM_LAYOUT_H_INCLUDED
+#define MEM_LAYOUT_H_INCLUDED
+
+/*
+ * Memory devices
+ */
+
+/* AUD_SRAM: type=RAM, use=0x000ff400, remainder=0x00000c00 */
+
+#define AUD_SRAM_ADDR  0x40000000
+#define AUD_SRAM_SIZE  0x00100000
+
+/*
+ * Fixed areas
+ */
+
+#define AUDIO_WORK_AREA_ALIGN   0x00000008
+#define AUDIO_WORK_AREA_ADDR    0x40000000
+#define AUDIO_WORK_AREA_DRM     0x40000000 /* _DRM is obsolete macro. to use _ADDR */
+#define AUDIO_WORK_AREA_SIZE    0x000f8000
+
+#define MSG_QUE_AREA_ALIGN   0x00000008
+#define MSG_QUE_AREA_ADDR    0x400f8000
+#define MSG_QUE_AREA_DRM     0x400f8000 /* _DRM is obsolete macro. to use _ADDR */
+#define MSG_QUE_AREA_SIZE    0x00006000
+
+#define MEMMGR_WORK_AREA_ALIGN   0x00000008
+#define MEMMGR_WORK_AREA_ADDR    0x400fe000
+#define MEMMGR_WORK_AREA_DRM     0x400fe000 /* _DRM is obsolete macro. to use _ADDR */
+#define MEMMGR_WORK_AREA_SIZE    0x00001000
+
+#define MEMMGR_DATA_AREA_ALIGN   0x00000008
+#define MEMMGR_DATA_AREA_ADDR    0x400ff000
+#define MEMMGR_DATA_AREA_DRM     0x400ff000 /* _DRM is obsolete macro. to use _ADDR */
+#define MEMMGR_DATA_AREA_SIZE    0x00000400
+
+/*
+ * Memory Manager max work area size
+ */
+
+#define S0_MEMMGR_WORK_AREA_ADDR  MEMMGR_WORK_AREA_ADDR
+#define S0_MEMMGR_WORK_AREA_SIZE  0x000001a4
+
+/*
+ * Section IDs
+ */
+
+#define SECTION_NO0       0
+
+/*
+ * Supports named section IDs
+ */
+
+#define AUDIO_SECTION     SECTION_NO0
+
+/*
+ * Number of sections
+ */
+
+#define NUM_MEM_SECTIONS  1
+
+/*
+ * Pool IDs
+ */
+
+const MemMgrLite::PoolId S0_NULL_POOL                = { 0, SECTION_NO0};  /*  0 */
+const MemMgrLite::PoolId S0_DEC_ES_MAIN_BUF_POOL     = { 1, SECTION_NO0};  /*  1 */
+const MemMgrLite::PoolId S0_REND_PCM_BUF_POOL        = { 2, SECTION_NO0};  /*  2 */
+const MemMgrLite::PoolId S0_DEC_APU_CMD_POOL         = { 3, SECTION_NO0};  /*  3 */
+const MemMgrLite::PoolId S0_SRC_WORK_BUF_POOL        = { 4, SECTION_NO0};  /*  4 */
+const MemMgrLite::PoolId S0_PF0_PCM_BUF_POOL         = { 5, SECTION_NO0};  /*  5 */
+const MemMgrLite::PoolId S0_PF1_PCM_BUF_POOL         = { 6, SECTION_NO0};  /*  6 */
+const MemMgrLite::PoolId S0_PF0_APU_CMD_POOL         = { 7, SECTION_NO0};  /*  7 */
+const MemMgrLite::PoolId S0_PF1_APU_CMD_POOL         = { 8, SECTION_NO0};  /*  8 */
+const MemMgrLite::PoolId S0_ES_BUF_POOL              = { 9, SECTION_NO0};  /*  9 */
+const MemMgrLite::PoolId S0_PREPROC_BUF_POOL         = {10, SECTION_NO0};  /* 10 */
+const MemMgrLite::PoolId S0_INPUT_BUF_POOL           = {11, SECTION_NO0};  /* 11 */
+const MemMgrLite::PoolId S0_ENC_APU_CMD_POOL         = {12, SECTION_NO0};  /* 12 */
+const MemMgrLite::PoolId S0_SRC_APU_CMD_POOL         = {13, SECTION_NO0};  /* 13 */
+const MemMgrLite::PoolId S0_PRE_APU_CMD_POOL         = {14, SECTION_NO0};  /* 14 */
+
+#define NUM_MEM_S0_LAYOUTS   1
+#define NUM_MEM_S0_POOLS    15
+
+#define NUM_MEM_LAYOUTS      1
+#define NUM_MEM_POOLS       15
+
+/*
+ * Pool areas
+ */
+
+/* Section0 Layout0: */
+
+#define MEMMGR_S0_L0_WORK_SIZE   0x000001a4
+
+/* Skip 0x0004 bytes for alignment. */
+
+#define S0_L0_DEC_ES_MAIN_BUF_POOL_ALIGN    0x00000008
+#define S0_L0_DEC_ES_MAIN_BUF_POOL_L_FENCE  0x40000004
+#define S0_L0_DEC_ES_MAIN_BUF_POOL_ADDR     0x40000008
+#define S0_L0_DEC_ES_MAIN_BUF_POOL_SIZE     0x00006000
+#define S0_L0_DEC_ES_MAIN_BUF_POOL_U_FENCE  0x40006008
+#define S0_L0_DEC_ES_MAIN_BUF_POOL_NUM_SEG  0x00000004
+#define S0_L0_DEC_ES_MAIN_BUF_POOL_SEG_SIZE 0x00001800
+
+#define S0_L0_REND_PCM_BUF_POOL_ALIGN    0x00000008
+#define S0_L0_REND_PCM_BUF_POOL_L_FENCE  0x4000600c
+#define S0_L0_REND_PCM_BUF_POOL_ADDR     0x40006010
+#define S0_L0_REND_PCM_BUF_POOL_SIZE     0x00012048
+#define S0_L0_REND_PCM_BUF_POOL_U_FENCE  0x40018058
+#define S0_L0_REND_PCM_BUF_POOL_NUM_SEG  0x00000009
+#define S0_L0_REND_PCM_BUF_POOL_SEG_SIZE 0x00002008
+
+#define S0_L0_DEC_APU_CMD_POOL_ALIGN    0x00000008
+#define S0_L0_DEC_APU_CMD_POOL_L_FENCE  0x4001805c
+#define S0_L0_DEC_APU_CMD_POOL_ADDR     0x40018060
+#define S0_L0_DEC_APU_CMD_POOL_SIZE     0x00000640
+#define S0_L0_DEC_APU_CMD_POOL_U_FENCE  0x400186a0
+#define S0_L0_DEC_APU_CMD_POOL_NUM_SEG  0x0000000a
+#define S0_L0_DEC_APU_CMD_POOL_SEG_SIZE 0x000000a0
+
+#define S0_L0_SRC_WORK_BUF_POOL_ALIGN    0x00000008
+#define S0_L0_SRC_WORK_BUF_POOL_L_FENCE  0x400186a4
+#define S0_L0_SRC_WORK_BUF_POOL_ADDR     0x400186a8
+#define S0_L0_SRC_WORK_BUF_POOL_SIZE     0x00002000
+#define S0_L0_SRC_WORK_BUF_POOL_U_FENCE  0x4001a6a8
+#define S0_L0_SRC_WORK_BUF_POOL_NUM_SEG  0x00000001
+#define S0_L0_SRC_WORK_BUF_POOL_SEG_SIZE 0x00002000
+
+#define S0_L0_PF0_PCM_BUF_POOL_ALIGN    0x00000008
+#define S0_L0_PF0_PCM_BUF_POOL_L_FENCE  0x4001a6ac
+#define S0_L0_PF0_PCM_BUF_POOL_ADDR     0x4001a6b0
+#define S0_L0_PF0_PCM_BUF_POOL_SIZE     0x00002008
+#define S0_L0_PF0_PCM_BUF_POOL_U_FENCE  0x4001c6b8
+#define S0_L0_PF0_PCM_BUF_POOL_NUM_SEG  0x00000001
+#define S0_L0_PF0_PCM_BUF_POOL_SEG_SIZE 0x00002008
+
+#define S0_L0_PF1_PCM_BUF_POOL_ALIGN    0x00000008
+#define S0_L0_PF1_PCM_BUF_POOL_L_FENCE  0x4001c6bc
+#define S0_L0_PF1_PCM_BUF_POOL_ADDR     0x4001c6c0
+#define S0_L0_PF1_PCM_BUF_POOL_SIZE     0x00002008
+#define S0_L0_PF1_PCM_BUF_POOL_U_FENCE  0x4001e6c8
+#define S0_L0_PF1_PCM_BUF_POOL_NUM_SEG  0x00000001
+#define S0_L0_PF1_PCM_BUF_POOL_SEG_SIZE 0x00002008
+
+#define S0_L0_PF0_APU_CMD_POOL_ALIGN    0x00000008
+#define S0_L0_PF0_APU_CMD_POOL_L_FENCE  0x4001e6cc
+#define S0_L0_PF0_APU_CMD_POOL_ADDR     0x4001e6d0
+#define S0_L0_PF0_APU_CMD_POOL_SIZE     0x00000640
+#define S0_L0_PF0_APU_CMD_POOL_U_FENCE  0x4001ed10
+#define S0_L0_PF0_APU_CMD_POOL_NUM_SEG  0x0000000a
+#define S0_L0_PF0_APU_CMD_POOL_SEG_SIZE 0x000000a0
+
+#define S0_L0_PF1_APU_CMD_POOL_ALIGN    0x00000008
+#define S0_L0_PF1_APU_CMD_POOL_L_FENCE  0x4001ed14
+#define S0_L0_PF1_APU_CMD_POOL_ADDR     0x4001ed18
+#define S0_L0_PF1_APU_CMD_POOL_SIZE     0x00000640
+#define S0_L0_PF1_APU_CMD_POOL_U_FENCE  0x4001f358
+#define S0_L0_PF1_APU_CMD_POOL_NUM_SEG  0x0000000a
+#define S0_L0_PF1_APU_CMD_POOL_SEG_SIZE 0x000000a0
+
+#define S0_L0_ES_BUF_POOL_ALIGN    0x00000008
+#define S0_L0_ES_BUF_POOL_L_FENCE  0x4001f35c
+#define S0_L0_ES_BUF_POOL_ADDR     0x4001f360
+#define S0_L0_ES_BUF_POOL_SIZE     0x0000f000
+#define S0_L0_ES_BUF_POOL_U_FENCE  0x4002e360
+#define S0_L0_ES_BUF_POOL_NUM_SEG  0x00000005
+#define S0_L0_ES_BUF_POOL_SEG_SIZE 0x00003000
+
+#define S0_L0_PREPROC_BUF_POOL_ALIGN    0x00000008
+#define S0_L0_PREPROC_BUF_POOL_L_FENCE  0x4002e364
+#define S0_L0_PREPROC_BUF_POOL_ADDR     0x4002e368
+#define S0_L0_PREPROC_BUF_POOL_SIZE     0x0000f000
+#define S0_L0_PREPROC_BUF_POOL_U_FENCE  0x4003d368
+#define S0_L0_PREPROC_BUF_POOL_NUM_SEG  0x00000005
+#define S0_L0_PREPROC_BUF_POOL_SEG_SIZE 0x00003000
+
+#define S0_L0_INPUT_BUF_POOL_ALIGN    0x00000008
+#define S0_L0_INPUT_BUF_POOL_L_FENCE  0x4003d36c
+#define S0_L0_INPUT_BUF_POOL_ADDR     0x4003d370
+#define S0_L0_INPUT_BUF_POOL_SIZE     0x0000f000
+#define S0_L0_INPUT_BUF_POOL_U_FENCE  0x4004c370
+#define S0_L0_INPUT_BUF_POOL_NUM_SEG  0x00000005
+#define S0_L0_INPUT_BUF_POOL_SEG_SIZE 0x00003000
+
+#define S0_L0_ENC_APU_CMD_POOL_ALIGN    0x00000008
+#define S0_L0_ENC_APU_CMD_POOL_L_FENCE  0x4004c374
+#define S0_L0_ENC_APU_CMD_POOL_ADDR     0x4004c378
+#define S0_L0_ENC_APU_CMD_POOL_SIZE     0x00000640
+#define S0_L0_ENC_APU_CMD_POOL_U_FENCE  0x4004c9b8
+#define S0_L0_ENC_APU_CMD_POOL_NUM_SEG  0x0000000a
+#define S0_L0_ENC_APU_CMD_POOL_SEG_SIZE 0x000000a0
+
+#define S0_L0_SRC_APU_CMD_POOL_ALIGN    0x00000008
+#define S0_L0_SRC_APU_CMD_POOL_L_FENCE  0x4004c9bc
+#define S0_L0_SRC_APU_CMD_POOL_ADDR     0x4004c9c0
+#define S0_L0_SRC_APU_CMD_POOL_SIZE     0x00000640
+#define S0_L0_SRC_APU_CMD_POOL_U_FENCE  0x4004d000
+#define S0_L0_SRC_APU_CMD_POOL_NUM_SEG  0x0000000a
+#define S0_L0_SRC_APU_CMD_POOL_SEG_SIZE 0x000000a0
+
+#define S0_L0_PRE_APU_CMD_POOL_ALIGN    0x00000008
+#define S0_L0_PRE_APU_CMD_POOL_L_FENCE  0x4004d004
+#define S0_L0_PRE_APU_CMD_POOL_ADDR     0x4004d008
+#define S0_L0_PRE_APU_CMD_POOL_SIZE     0x00000640
+#define S0_L0_PRE_APU_CMD_POOL_U_FENCE  0x4004d648
+#define S0_L0_PRE_APU_CMD_POOL_NUM_SEG  0x0000000a
+#define S0_L0_PRE_APU_CMD_POOL_SEG_SIZE 0x000000a0
+
+/* Remainder AUDIO_WORK_AREA=0x000aa9b4 */
+
+#endif /* MEM_LAYOUT_H_INCLUDED */
@@ -0,0 +1,113 @@
+/****************************************************************************
+ * modules/audio/test/sim/sim.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_AUDIO_TEST_SIM_SIM_H
+#define __MODULES_AUDIO_TEST_SIM_SIM_H
+
+/* Host simulation of the audio sub system.
+ *
+ * The objects, the components and the DMA driver are built from their
+ * sources.  Below them, sim_os.cpp stands in for NuttX, sim_dsp_drv.cpp
+ * for the DSP driver and sim_audio_drv.cpp for the audio baseband, whose
+ * DMA transfers are clocked by a thread per DMA controller.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <arch/chip/audio.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Sampling rate of the virtual audio baseband in normal clock mode. */
+
+#define SIM_AUDIO_FS  48000
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Called from the virtual audio baseband when a DMA transfer completes.
+ * On output paths data holds the transferred PCM, on the MIC path it is to
+ * be filled with the captured PCM.
+ */
+
+typedef void (*sim_audio_data_cb_t)(cxd56_audio_dma_t handle,
+                                    void *data,
+                                    uint32_t size);
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* Map the audio SRAM, initialize the message and memory libraries with the
+ * layout of sim/layout and start the virtual audio baseband.
+ */
+
+bool sim_initialize(void);
+void sim_finalize(void);
+
+/* Wait for the reply of an object to the manager queue, as the objif
+ * examples do.
+ */
+
+bool sim_receive_reply(uint32_t id);
+
+/* Output PCM sink and MIC PCM source of the virtual audio baseband.
+ * Without a source, silence is captured.
+ */
+
+void sim_audio_set_sink(sim_audio_data_cb_t sink);
+void sim_audio_set_source(sim_audio_data_cb_t source);
+
+/* Pace of the DMA transfers as a multiple of real time, 1 by default.
+ * The pipeline has to keep up with the pace, as with the real DMA, or the
+ * line underflows.
+ */
+
+void sim_audio_set_speed(uint32_t speed);
+
+/* Start and stop the virtual audio baseband, called by sim_initialize()
+ * and sim_finalize().
+ */
+
+bool sim_audio_initialize(void);
+void sim_audio_finalize(void);
+
+#endif /* __MODULES_AUDIO_TEST_SIM_SIM_H */
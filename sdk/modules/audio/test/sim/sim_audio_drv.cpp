@@ -0,0 +1,530 @@
+/****************************************************************************
+ * modules/audio/test/sim/sim_audio_drv.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host stand-in of the audio baseband driver.
+ *
+ * The DMA driver of dma_controller runs unchanged on top of it.  Each DMA
+ * controller is a thread which completes the started transfers in order,
+ * paced by the sampling rate, and then raises the completion interrupt by
+ * calling the registered handler with the interrupt lock held.  As on the
+ * target, a stopped DMA still completes the transfers already started.
+ * Volume and mute are not modelled, the sink receives the data as it is
+ * transferred.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+#include <nuttx/arch.h>
+#include <arch/chip/audio.h>
+
+#include "sim.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Transfers the hardware accepts at once, the running queue of the DMA
+ * driver never holds more.
+ */
+
+#define SIM_DMA_FIFO_NUM  2
+
+#define NSEC_PER_SEC      1000000000ull
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct sim_dma_xfer_s
+{
+  uint32_t addr;
+  uint32_t sample;
+};
+
+struct sim_dma_s
+{
+  pthread_t       thread;
+  pthread_mutex_t lock;
+  pthread_cond_t  cond;
+  bool            quit;
+
+  cxd56_audio_dma_cb_t cb;
+  uint32_t        byte_len;
+  uint32_t        ch_num;
+
+  struct sim_dma_xfer_s fifo[SIM_DMA_FIFO_NUM];
+  uint32_t        head;
+  uint32_t        count;
+  uint64_t        deadline;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct sim_dma_s s_dma[CXD56_AUDIO_DMAC_MAX];
+
+static sim_audio_data_cb_t s_sink;
+static sim_audio_data_cb_t s_source;
+static volatile uint32_t   s_speed = 1;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint64_t sim_now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/*--------------------------------------------------------------------------*/
+static void *sim_dma_thread(void *arg)
+{
+  struct sim_dma_s *dma = (struct sim_dma_s *)arg;
+  cxd56_audio_dma_t handle = (cxd56_audio_dma_t)(dma - s_dma);
+
+  pthread_mutex_lock(&dma->lock);
+
+  while (!dma->quit)
+    {
+      if (dma->count == 0)
+        {
+          pthread_cond_wait(&dma->cond, &dma->lock);
+          continue;
+        }
+
+      struct sim_dma_xfer_s xfer = dma->fifo[dma->head];
+
+      dma->deadline += xfer.sample * NSEC_PER_SEC /
+                       (SIM_AUDIO_FS * (uint64_t)s_speed);
+
+      struct timespec ts;
+      ts.tv_sec  = dma->deadline / NSEC_PER_SEC;
+      ts.tv_nsec = dma->deadline % NSEC_PER_SEC;
+
+      pthread_mutex_unlock(&dma->lock);
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL)
+             == EINTR);
+      pthread_mutex_lock(&dma->lock);
+
+      if (dma->quit)
+        {
+          break;
+        }
+
+      dma->head = (dma->head + 1) % SIM_DMA_FIFO_NUM;
+      dma->count--;
+
+      cxd56_audio_dma_cb_t cb = dma->cb;
+      uint32_t size = xfer.sample * dma->ch_num * dma->byte_len;
+
+      pthread_mutex_unlock(&dma->lock);
+
+      void *data = (void *)(uintptr_t)xfer.addr;
+
+      if (handle == CXD56_AUDIO_DMAC_MIC)
+        {
+          if (s_source != NULL)
+            {
+              s_source(handle, data, size);
+            }
+          else
+            {
+              memset(data, 0, size);
+            }
+        }
+      else if (s_sink != NULL)
+        {
+          s_sink(handle, data, size);
+        }
+
+      /* Completion interrupt. */
+
+      if (cb != NULL)
+        {
+          up_irq_disable();
+          cb(handle, CXD56_AUDIO_ECODE_DMA_CMPLT);
+          up_irq_enable();
+        }
+
+      pthread_mutex_lock(&dma->lock);
+    }
+
+  pthread_mutex_unlock(&dma->lock);
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+bool sim_audio_initialize(void)
+{
+  for (int i = 0; i < CXD56_AUDIO_DMAC_MAX; i++)
+    {
+      struct sim_dma_s *dma = &s_dma[i];
+
+      memset(dma, 0, sizeof(*dma));
+      pthread_mutex_init(&dma->lock, NULL);
+      pthread_cond_init(&dma->cond, NULL);
+
+      if (pthread_create(&dma->thread, NULL, sim_dma_thread, dma) != 0)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+void sim_audio_finalize(void)
+{
+  for (int i = 0; i < CXD56_AUDIO_DMAC_MAX; i++)
+    {
+      struct sim_dma_s *dma = &s_dma[i];
+
+      pthread_mutex_lock(&dma->lock);
+      dma->quit = true;
+      pthread_cond_signal(&dma->cond);
+      pthread_mutex_unlock(&dma->lock);
+
+      pthread_join(dma->thread, NULL);
+      pthread_cond_destroy(&dma->cond);
+      pthread_mutex_destroy(&dma->lock);
+    }
+
+  s_sink   = NULL;
+  s_source = NULL;
+  s_speed  = 1;
+}
+
+/*--------------------------------------------------------------------------*/
+void sim_audio_set_sink(sim_audio_data_cb_t sink)
+{
+  s_sink = sink;
+}
+
+/*--------------------------------------------------------------------------*/
+void sim_audio_set_source(sim_audio_data_cb_t source)
+{
+  s_source = source;
+}
+
+/*--------------------------------------------------------------------------*/
+void sim_audio_set_speed(uint32_t speed)
+{
+  s_speed = (speed > 0) ? speed : 1;
+}
+
+extern "C"
+{
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_en_output(void)
+{
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_dis_output(void)
+{
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_set_spout(bool sp_out_en)
+{
+  (void)sp_out_en;
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_en_i2s_io(void)
+{
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_dis_i2s_io(void)
+{
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_set_datapath(cxd56_audio_signal_t sig,
+                                           cxd56_audio_sel_t sel)
+{
+  (void)sig;
+  (void)sel;
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_get_dmahandle(cxd56_audio_dma_path_t path,
+                                            cxd56_audio_dma_t *handle)
+{
+  switch (path)
+    {
+      case CXD56_AUDIO_DMA_PATH_MIC_TO_MEM:
+        *handle = CXD56_AUDIO_DMAC_MIC;
+        break;
+
+      case CXD56_AUDIO_DMA_PATH_MEM_TO_BUSIF1:
+        *handle = CXD56_AUDIO_DMAC_I2S0_DOWN;
+        break;
+
+      case CXD56_AUDIO_DMA_PATH_MEM_TO_BUSIF2:
+        *handle = CXD56_AUDIO_DMAC_I2S1_DOWN;
+        break;
+
+      default:
+        return CXD56_AUDIO_ECODE_DMA_PATH;
+    }
+
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_free_dmahandle(cxd56_audio_dma_t handle)
+{
+  if (handle >= CXD56_AUDIO_DMAC_MAX)
+    {
+      return CXD56_AUDIO_ECODE_DMA_HANDLE;
+    }
+
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_set_dmacb(cxd56_audio_dma_t handle,
+                                        cxd56_audio_dma_cb_t cb)
+{
+  if (handle >= CXD56_AUDIO_DMAC_MAX)
+    {
+      return CXD56_AUDIO_ECODE_DMA_HANDLE;
+    }
+
+  pthread_mutex_lock(&s_dma[handle].lock);
+  s_dma[handle].cb = cb;
+  pthread_mutex_unlock(&s_dma[handle].lock);
+
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_set_micgain(cxd56_audio_mic_gain_t *gain)
+{
+  (void)gain;
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+cxd56_audio_micdev_t cxd56_audio_get_micdev(void)
+{
+  return CXD56_AUDIO_MIC_DEV_ANALOG;
+}
+
+/*--------------------------------------------------------------------------*/
+cxd56_audio_clkmode_t cxd56_audio_get_clkmode(void)
+{
+  return CXD56_AUDIO_CLKMODE_NORMAL;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_init_dma(cxd56_audio_dma_t handle,
+                                       cxd56_audio_samp_fmt_t fmt,
+                                       uint8_t *ch_num)
+{
+  if (handle >= CXD56_AUDIO_DMAC_MAX)
+    {
+      return CXD56_AUDIO_ECODE_DMA_HANDLE;
+    }
+
+  struct sim_dma_s *dma = &s_dma[handle];
+
+  /* Output lines are stereo, and the baseband returns the number of
+   * channels to callers which leave it unset, as the renderer does.
+   */
+
+  if (handle != CXD56_AUDIO_DMAC_MIC)
+    {
+      *ch_num = 2;
+    }
+
+  pthread_mutex_lock(&dma->lock);
+  dma->byte_len = (fmt == CXD56_AUDIO_SAMP_FMT_16) ? 2 : 4;
+  dma->ch_num   = *ch_num;
+  pthread_mutex_unlock(&dma->lock);
+
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_start_dma(cxd56_audio_dma_t handle,
+                                        uint32_t addr,
+                                        uint32_t sample)
+{
+  if (handle >= CXD56_AUDIO_DMAC_MAX)
+    {
+      return CXD56_AUDIO_ECODE_DMA_HANDLE;
+    }
+
+  struct sim_dma_s *dma = &s_dma[handle];
+  CXD56_AUDIO_ECODE ret = CXD56_AUDIO_ECODE_OK;
+
+  pthread_mutex_lock(&dma->lock);
+
+  if (dma->count == SIM_DMA_FIFO_NUM)
+    {
+      ret = CXD56_AUDIO_ECODE_DMA_BUSY;
+    }
+  else
+    {
+      /* An idle line starts clocking now. */
+
+      if (dma->count == 0)
+        {
+          dma->deadline = sim_now_ns();
+        }
+
+      uint32_t tail = (dma->head + dma->count) % SIM_DMA_FIFO_NUM;
+
+      dma->fifo[tail].addr   = addr;
+      dma->fifo[tail].sample = sample;
+      dma->count++;
+
+      pthread_cond_signal(&dma->cond);
+    }
+
+  pthread_mutex_unlock(&dma->lock);
+
+  return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_stop_dma(cxd56_audio_dma_t handle)
+{
+  if (handle >= CXD56_AUDIO_DMAC_MAX)
+    {
+      return CXD56_AUDIO_ECODE_DMA_HANDLE;
+    }
+
+  /* The transfers already started are completed, as on the target. */
+
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_en_dmaint(void)
+{
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_dis_dmaint(void)
+{
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_clear_dmaerrint(cxd56_audio_dma_t handle)
+{
+  (void)handle;
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_mask_dmaerrint(cxd56_audio_dma_t handle)
+{
+  (void)handle;
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_unmask_dmaerrint(cxd56_audio_dma_t handle)
+{
+  (void)handle;
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+cxd56_audio_dmafmt_t cxd56_audio_get_dmafmt(void)
+{
+  return CXD56_AUDIO_DMA_FMT_LR;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_en_digsft(cxd56_audio_dsr_rate_t rate)
+{
+  (void)rate;
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_dis_digsft(void)
+{
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_mute_vol_fade(cxd56_audio_volid_t id,
+                                            bool wait)
+{
+  (void)id;
+  (void)wait;
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+/*--------------------------------------------------------------------------*/
+CXD56_AUDIO_ECODE cxd56_audio_unmute_vol_fade(cxd56_audio_volid_t id,
+                                              bool wait)
+{
+  (void)id;
+  (void)wait;
+  return CXD56_AUDIO_ECODE_OK;
+}
+
+} /* extern "C" */
@@ -0,0 +1,347 @@
+/****************************************************************************
+ * modules/audio/test/sim/sim_dsp_drv.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host stand-in of the DSP driver.
+ *
+ * A loaded DSP is a host thread which receives the commands of
+ * DD_SendCommand() in order and replies through the callback of DD_Load(),
+ * as the receive thread of the target driver does.  Only WAVDEC is
+ * provided: a reference decoder which passes 16bit LPCM through and
+ * expands mono to the stereo output of the target.  Loading any other DSP
+ * fails as if its binary were missing.
+ *
+ * The DSP of the target answers a command after it has processed it, and
+ * the object task which sent it blocks meanwhile, which lets the other
+ * tasks drain their queues.  The stand-in takes a fixed time per command,
+ * without which the sender could run ahead of the other tasks on a single
+ * host CPU and overflow their queues.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+#include "wien2_common_defs.h"
+#include "apus/apu_cmd.h"
+#include "apus/dsp_audio_version.h"
+#include "dsp_driver/include/dsp_drv.h"
+
+__USING_WIEN2
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Commands in flight, more than the APU command pools of the layout. */
+
+#define SIM_DSP_QUE_NUM  16
+
+/* Processing time of a command, short against a frame. */
+
+#define SIM_DSP_CMD_NS   50000
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct sim_dsp_s
+{
+  pthread_t       thread;
+  pthread_mutex_t lock;
+  pthread_cond_t  cond;
+  bool            quit;
+
+  DspDoneCallback cb;
+  void           *parent;
+
+  DspDrvComPrm_t  que[SIM_DSP_QUE_NUM];
+  uint32_t        head;
+  uint32_t        count;
+
+  /* Decoder format, from InitEvent */
+
+  uint8_t         in_ch_num;
+  AudioPcmFormat  bit_length;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void sim_wavdec_exec(struct sim_dsp_s *dsp, Apu::ApuExecDecCmd *cmd)
+{
+  uint8_t *in   = reinterpret_cast<uint8_t *>(cmd->input_buffer.p_buffer);
+  uint8_t *out  = reinterpret_cast<uint8_t *>(cmd->output_buffer.p_buffer);
+  uint32_t size = cmd->input_buffer.size;
+
+  if (dsp->in_ch_num == 1 && dsp->bit_length == AudPcmFormatInt16)
+    {
+      int16_t *src = reinterpret_cast<int16_t *>(in);
+      int16_t *dst = reinterpret_cast<int16_t *>(out);
+      uint32_t samples = size / sizeof(int16_t);
+
+      if (samples * 2 * sizeof(int16_t) > cmd->output_buffer.size)
+        {
+          samples = cmd->output_buffer.size / (2 * sizeof(int16_t));
+        }
+
+      for (uint32_t i = 0; i < samples; i++)
+        {
+          dst[2 * i]     = src[i];
+          dst[2 * i + 1] = src[i];
+        }
+
+      cmd->output_buffer.size = samples * 2 * sizeof(int16_t);
+    }
+  else
+    {
+      if (size > cmd->output_buffer.size)
+        {
+          size = cmd->output_buffer.size;
+        }
+
+      memcpy(out, in, size);
+      cmd->output_buffer.size = size;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static void sim_wavdec(struct sim_dsp_s *dsp, Apu::Wien2ApuCmd *cmd)
+{
+  cmd->result.exec_result = Apu::ApuExecOK;
+
+  switch (cmd->header.event_type)
+    {
+      case Apu::InitEvent:
+        dsp->in_ch_num  = cmd->init_dec_cmd.channel_num;
+        dsp->bit_length = cmd->init_dec_cmd.out_pcm_param.bit_length;
+        memset(&cmd->result.internal_result[0], 0,
+               sizeof(cmd->result.internal_result[0]));
+        break;
+
+      case Apu::ExecEvent:
+        sim_wavdec_exec(dsp, &cmd->exec_dec_cmd);
+        break;
+
+      case Apu::FlushEvent:
+        cmd->flush_dec_cmd.output_buffer.size = 0;
+        break;
+
+      case Apu::SetParamEvent:
+        break;
+
+      default:
+        cmd->result.exec_result = Apu::ApuExecError;
+        break;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static void *sim_dsp_thread(void *arg)
+{
+  struct sim_dsp_s *dsp = (struct sim_dsp_s *)arg;
+
+  pthread_mutex_lock(&dsp->lock);
+
+  while (!dsp->quit)
+    {
+      if (dsp->count == 0)
+        {
+          pthread_cond_wait(&dsp->cond, &dsp->lock);
+          continue;
+        }
+
+      DspDrvComPrm_t param = dsp->que[dsp->head];
+      dsp->head = (dsp->head + 1) % SIM_DSP_QUE_NUM;
+      dsp->count--;
+
+      pthread_mutex_unlock(&dsp->lock);
+
+      if (param.type == DSP_COM_DATA_TYPE_STRUCT_ADDRESS)
+        {
+          struct timespec busy = { 0, SIM_DSP_CMD_NS };
+
+          nanosleep(&busy, NULL);
+          sim_wavdec(dsp, static_cast<Apu::Wien2ApuCmd *>(param.data.pParam));
+        }
+
+      dsp->cb(&param, dsp->parent);
+
+      pthread_mutex_lock(&dsp->lock);
+    }
+
+  pthread_mutex_unlock(&dsp->lock);
+
+  return NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+static int sim_dsp_post(struct sim_dsp_s *dsp, const DspDrvComPrm_t *param)
+{
+  int ret = DSPDRV_NOERROR;
+
+  pthread_mutex_lock(&dsp->lock);
+
+  if (dsp->count == SIM_DSP_QUE_NUM)
+    {
+      ret = DSPDRV_INVALID_VALUE;
+    }
+  else
+    {
+      dsp->que[(dsp->head + dsp->count) % SIM_DSP_QUE_NUM] = *param;
+      dsp->count++;
+      pthread_cond_signal(&dsp->cond);
+    }
+
+  pthread_mutex_unlock(&dsp->lock);
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int DD_Load(FAR const char  *filename,
+            DspDoneCallback p_cbfunc,
+            FAR void        *p_parent_instance,
+            FAR void        **dsp_handler,
+            dsp_bin_type_e  bintype)
+{
+  (void)bintype;
+
+  if (filename == NULL || filename[0] == '\0')
+    {
+      return DSPDRV_FILENAME_EMPTY;
+    }
+
+  if (p_cbfunc == NULL)
+    {
+      return DSPDRV_CALLBACK_ERROR;
+    }
+
+  const char *name = strrchr(filename, '/');
+  name = (name != NULL) ? name + 1 : filename;
+
+  if (strcmp(name, "WAVDEC") != 0)
+    {
+      return DSPDRV_INIT_MPTASK_FAIL;
+    }
+
+  struct sim_dsp_s *dsp = new sim_dsp_s;
+
+  memset(dsp, 0, sizeof(*dsp));
+  dsp->cb     = p_cbfunc;
+  dsp->parent = p_parent_instance;
+  pthread_mutex_init(&dsp->lock, NULL);
+  pthread_cond_init(&dsp->cond, NULL);
+
+  /* Boot notification with the version, as the DSP sends it first. */
+
+  DspDrvComPrm_t boot;
+
+  boot.process_mode = Apu::CommonMode;
+  boot.event_type   = Apu::BootEvent;
+  boot.type         = DSP_COM_DATA_TYPE_32BIT_VALUE;
+  boot.data.value   = DSP_WAVDEC_VERSION;
+  sim_dsp_post(dsp, &boot);
+
+  if (pthread_create(&dsp->thread, NULL, sim_dsp_thread, dsp) != 0)
+    {
+      pthread_cond_destroy(&dsp->cond);
+      pthread_mutex_destroy(&dsp->lock);
+      delete dsp;
+      return DSPDRV_INIT_PTHREAD_FAIL;
+    }
+
+  *dsp_handler = dsp;
+
+  return DSPDRV_NOERROR;
+}
+
+/*--------------------------------------------------------------------------*/
+int DD_Load_Secure(FAR const char  *filename,
+                   DspDoneCallback p_cbfunc,
+                   FAR void        *p_parent_instance,
+                   FAR void        **dsp_handler)
+{
+  return DD_Load(filename, p_cbfunc, p_parent_instance, dsp_handler,
+                 DspBinTypeSPK);
+}
+
+/*--------------------------------------------------------------------------*/
+int DD_SendCommand(FAR const void           *p_instance,
+                   FAR const DspDrvComPrm_t *p_param)
+{
+  if (p_instance == NULL || p_param == NULL)
+    {
+      return DSPDRV_INVALID_VALUE;
+    }
+
+  return sim_dsp_post((struct sim_dsp_s *)p_instance, p_param);
+}
+
+/*--------------------------------------------------------------------------*/
+int DD_Unload(FAR const void *p_instance)
+{
+  if (p_instance == NULL)
+    {
+      return DSPDRV_INVALID_VALUE;
+    }
+
+  struct sim_dsp_s *dsp = (struct sim_dsp_s *)p_instance;
+
+  pthread_mutex_lock(&dsp->lock);
+  dsp->quit = true;
+  pthread_cond_signal(&dsp->cond);
+  pthread_mutex_unlock(&dsp->lock);
+
+  pthread_join(dsp->thread, NULL);
+  pthread_cond_destroy(&dsp->cond);
+  pthread_mutex_destroy(&dsp->lock);
+  delete dsp;
+
+  return DSPDRV_NOERROR;
+}
+
+/*--------------------------------------------------------------------------*/
+int DD_force_Unload(FAR const void *p_instance)
+{
+  return DD_Unload(p_instance);
+}
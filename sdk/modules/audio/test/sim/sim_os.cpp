@@ -0,0 +1,260 @@
+/****************************************************************************
+ * modules/audio/test/sim/sim_os.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host stand-ins of the NuttX services used by the audio objects:
+ * semaphores, thread creation, interrupt and scheduler locks, the task id
+ * and the CPU frequency lock.
+ *
+ * Interrupts are emulated by the virtual audio hardware threads of
+ * sim_audio_drv.cpp.  A handler runs with the interrupt lock held, so that
+ * it excludes the code which disables interrupts as it does on the target.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#define SIM_SEMAPHORE_IMPL
+#define SIM_PTHREAD_IMPL
+
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <arch/chip/pm.h>
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static pthread_mutex_t s_irq_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+extern "C"
+{
+
+/*--------------------------------------------------------------------------*/
+int sim_sem_init(sim_sem_t *sem, int pshared, unsigned int value)
+{
+  sem->semcount = (int16_t)value;
+  return sem_init(&sem->sem, pshared, value);
+}
+
+/*--------------------------------------------------------------------------*/
+int sim_sem_destroy(sim_sem_t *sem)
+{
+  return sem_destroy(&sem->sem);
+}
+
+/*--------------------------------------------------------------------------*/
+int sim_sem_wait(sim_sem_t *sem)
+{
+  int ret;
+
+  do
+    {
+      ret = sem_wait(&sem->sem);
+    }
+  while (ret < 0 && errno == EINTR);
+
+  return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+int sim_sem_timedwait(sim_sem_t *sem, const struct timespec *abstime)
+{
+  int ret;
+
+  /* NuttX waits on CLOCK_REALTIME as glibc does. */
+
+  do
+    {
+      ret = sem_timedwait(&sem->sem, abstime);
+    }
+  while (ret < 0 && errno == EINTR);
+
+  return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+int sim_sem_trywait(sim_sem_t *sem)
+{
+  return sem_trywait(&sem->sem);
+}
+
+/*--------------------------------------------------------------------------*/
+int sim_sem_post(sim_sem_t *sem)
+{
+  return sem_post(&sem->sem);
+}
+
+/*--------------------------------------------------------------------------*/
+int sim_sem_getvalue(sim_sem_t *sem, int *sval)
+{
+  return sem_getvalue(&sem->sem, sval);
+}
+
+/*--------------------------------------------------------------------------*/
+int sim_pthread_attr_init(sim_pthread_attr_t *attr)
+{
+  attr->stacksize = 0;
+  attr->param.sched_priority = 0;
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+int sim_pthread_attr_destroy(sim_pthread_attr_t *attr)
+{
+  (void)attr;
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+int sim_pthread_attr_setschedparam(sim_pthread_attr_t *attr,
+                                   const struct sched_param *param)
+{
+  attr->param = *param;
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+int sim_pthread_attr_setstacksize(sim_pthread_attr_t *attr,
+                                  size_t stacksize)
+{
+  attr->stacksize = stacksize;
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+int sim_pthread_create(pthread_t *thread, const sim_pthread_attr_t *attr,
+                       pthread_startroutine_t entry, pthread_addr_t arg)
+{
+  /* Stack sizes of the target are too small for host code, and real-time
+   * priorities need privileges.  Threads run with the host defaults.
+   */
+
+  (void)attr;
+  return pthread_create(thread, NULL, entry, arg);
+}
+
+/*--------------------------------------------------------------------------*/
+irqstate_t up_irq_disable(void)
+{
+  pthread_mutex_lock(&s_irq_lock);
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+void up_irq_enable(void)
+{
+  pthread_mutex_unlock(&s_irq_lock);
+}
+
+/*--------------------------------------------------------------------------*/
+void up_irq_restore(irqstate_t flags)
+{
+  (void)flags;
+  pthread_mutex_unlock(&s_irq_lock);
+}
+
+/*--------------------------------------------------------------------------*/
+void up_enable_irq(int irq)
+{
+  (void)irq;
+}
+
+/*--------------------------------------------------------------------------*/
+void up_disable_irq(int irq)
+{
+  (void)irq;
+}
+
+/*--------------------------------------------------------------------------*/
+int sched_lock(void)
+{
+  /* Always paired with up_irq_disable(), which already excludes. */
+
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+int sched_unlock(void)
+{
+  return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+irqstate_t enter_critical_section(void)
+{
+  return up_irq_disable();
+}
+
+/*--------------------------------------------------------------------------*/
+void leave_critical_section(irqstate_t flags)
+{
+  up_irq_restore(flags);
+}
+
+/*--------------------------------------------------------------------------*/
+pid_t getpid(void) __THROW
+{
+  /* NuttX reads the id of the running task, the Memory Manager asks it on
+   * every lock to tell tasks from handlers.  Do not take a system call.
+   */
+
+  static pid_t pid = (pid_t)syscall(SYS_getpid);
+
+  return pid;
+}
+
+/*--------------------------------------------------------------------------*/
+void up_pm_acquire_freqlock(struct pm_cpu_freqlock_s *lock)
+{
+  lock->count++;
+}
+
+/*--------------------------------------------------------------------------*/
+void up_pm_release_freqlock(struct pm_cpu_freqlock_s *lock)
+{
+  lock->count--;
+}
+
+} /* extern "C" */
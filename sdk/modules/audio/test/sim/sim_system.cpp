@@ -0,0 +1,196 @@
+/****************************************************************************
+ * modules/audio/test/sim/sim_system.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Start up of the host simulation, following app_init_libraries() and
+ * app_finalize_libraries() of the objif examples.  The shared audio SRAM
+ * is an anonymous mapping at the address of the layout, so that the pool
+ * and message queue addresses of sim/layout are used as they are.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <sys/mman.h>
+
+#include "memutils/memory_manager/MemHandle.h"
+#include "memutils/message/Message.h"
+#include "audio/audio_high_level_api.h"
+
+#include "sim.h"
+#include "layout/msgq_id.h"
+#include "layout/mem_layout.h"
+#include "layout/msgq_pool.h"
+#include "layout/pool_layout.h"
+#include "layout/fixed_fence.h"
+
+using namespace MemMgrLite;
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SIM_LAYOUT_NO  0
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static void *s_aud_sram = MAP_FAILED;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+bool sim_initialize(void)
+{
+  /* The DMA and the DSP commands carry 32bit addresses, the audio SRAM
+   * has to be mapped below 4GB at its address on the target.
+   */
+
+  s_aud_sram = mmap((void *)AUD_SRAM_ADDR,
+                    AUD_SRAM_SIZE,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                    -1,
+                    0);
+  if (s_aud_sram != (void *)AUD_SRAM_ADDR)
+    {
+      printf("Error: mmap(0x%08x) failure.\n", AUD_SRAM_ADDR);
+      return false;
+    }
+
+  /* Initalize MessageLib. */
+
+  err_t err = MsgLib::initFirst(NUM_MSGQ_POOLS, MSGQ_TOP_DRM);
+  if (err != ERR_OK)
+    {
+      printf("Error: MsgLib::initFirst() failure. 0x%x\n", err);
+      return false;
+    }
+
+  err = MsgLib::initPerCpu();
+  if (err != ERR_OK)
+    {
+      printf("Error: MsgLib::initPerCpu() failure. 0x%x\n", err);
+      return false;
+    }
+
+  void* mml_data_area = translatePoolAddrToVa(MEMMGR_DATA_AREA_ADDR);
+  err = Manager::initFirst(mml_data_area, MEMMGR_DATA_AREA_SIZE);
+  if (err != ERR_OK)
+    {
+      printf("Error: Manager::initFirst() failure. 0x%x\n", err);
+      return false;
+    }
+
+  err = Manager::initPerCpu(mml_data_area, static_pools, pool_num, layout_no);
+  if (err != ERR_OK)
+    {
+      printf("Error: Manager::initPerCpu() failure. 0x%x\n", err);
+      return false;
+    }
+
+  /* The work area size of the layout is computed for the 32bit pool
+   * objects of the target, give the pools the whole fixed area.
+   */
+
+  void* work_va = translatePoolAddrToVa(MEMMGR_WORK_AREA_ADDR);
+  const PoolSectionAttr *ptr =
+    &MemoryPoolLayouts[AUDIO_SECTION][SIM_LAYOUT_NO][0];
+  err = Manager::createStaticPools(AUDIO_SECTION,
+                                   SIM_LAYOUT_NO,
+                                   work_va,
+                                   MEMMGR_WORK_AREA_SIZE,
+                                   ptr);
+  if (err != ERR_OK)
+    {
+      printf("Error: Manager::createStaticPools() failure. %d\n", err);
+      return false;
+    }
+
+  if (!sim_audio_initialize())
+    {
+      printf("Error: sim_audio_initialize() failure.\n");
+      return false;
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+void sim_finalize(void)
+{
+  sim_audio_finalize();
+
+  MsgLib::finalize();
+  Manager::destroyStaticPools(AUDIO_SECTION);
+  Manager::finalize();
+
+  if (s_aud_sram != MAP_FAILED)
+    {
+      munmap(s_aud_sram, AUD_SRAM_SIZE);
+      s_aud_sram = MAP_FAILED;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+bool sim_receive_reply(uint32_t id)
+{
+  AudioObjReply reply_info;
+  AS_ReceiveObjectReply(MSGQ_AUD_MNG, &reply_info);
+
+  if (reply_info.type != AS_OBJ_REPLY_TYPE_REQ)
+    {
+      printf("sim_receive_reply() error! type 0x%x\n", reply_info.type);
+      return false;
+    }
+
+  if (reply_info.id != id)
+    {
+      printf("sim_receive_reply() error! id 0x%x(request id 0x%x)\n",
+             reply_info.id, id);
+      return false;
+    }
+
+  if (reply_info.result != AS_ECODE_OK)
+    {
+      printf("sim_receive_reply() error! result 0x%x\n", reply_info.result);
+      return false;
+    }
+
+  return true;
+}
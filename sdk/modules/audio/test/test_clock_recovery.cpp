@@ -0,0 +1,247 @@
+/****************************************************************************
+ * modules/audio/test/test_clock_recovery.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of automatic clock recovery (clock_recovery.cpp). Output
+ * clock of DAC is simulated with drift from source clock, and renderer
+ * queue is fed the way of OutputMixToHPI2S::auto_adjustment().
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "host_test.h"
+#include "objects/output_mixer/clock_recovery.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PERIOD      1024  /* Frames of a period, same as a segment.   */
+#define PREFETCH    3     /* Periods queued before rendering starts.  */
+#define MAX_PPM     1000  /* Default of CLKRECOVERY_MAX_PPM.          */
+#define MIN_XFER    240   /* Minimum DMA transfer of OutputMixer.     */
+#define RUN_PERIODS 40000 /* About 15 minutes at 48kHz.               */
+#define TAPS_DELAY  2     /* Frames held by interpolation history.    */
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static int16_t s_in[PERIOD * 2];
+static int16_t s_out[PERIOD * 2];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void make_period(int16_t *buf, uint32_t frames, uint32_t start)
+{
+  for (uint32_t i = 0; i < frames; i++)
+    {
+      /* Triangle wave, which interpolation reproduces on its slopes. */
+
+      int32_t v = static_cast<int32_t>((start + i) % 512) - 256;
+
+      buf[i * 2]     = static_cast<int16_t>(v * 64);
+      buf[i * 2 + 1] = static_cast<int16_t>(-v * 64);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_passthrough(void)
+{
+  ClockRecoveryResampler rs;
+  int16_t ref[PERIOD * 2];
+  uint32_t total = 0;
+
+  /* Ratio 0 must not change data, only period boundary is shifted by
+   * history of interpolation.
+   */
+
+  for (uint32_t p = 0; p < 4; p++)
+    {
+      make_period(s_in, PERIOD, p * PERIOD);
+
+      uint32_t out = rs.exec(s_in, PERIOD, s_out, PERIOD, false);
+
+      TEST_CHECK(out + TAPS_DELAY >= PERIOD && out <= PERIOD);
+
+      make_period(ref, out, total);
+
+      for (uint32_t i = 0; i < out * 2; i++)
+        {
+          if (s_out[i] != ref[i])
+            {
+              TEST_CHECK_EQ(s_out[i], ref[i]);
+              break;
+            }
+        }
+
+      total += out;
+    }
+
+  TEST_CHECK_EQ(total, 4 * PERIOD - TAPS_DELAY);
+  TEST_CHECK_EQ(rs.get_carried(), 0);
+  TEST_CHECK_EQ(rs.get_dropped(), 0);
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_carry(void)
+{
+  ClockRecoveryResampler rs;
+  uint64_t produced = 0;
+
+  /* Output clock is faster by maximum correction, and output of each
+   * period has no more room than input. Surplus must be carried, and
+   * sent as extra transfer, never dropped.
+   */
+
+  rs.set_ratio(-MAX_PPM);
+
+  for (uint32_t p = 0; p < 2000; p++)
+    {
+      make_period(s_in, PERIOD, p * PERIOD);
+
+      uint32_t out = rs.exec(s_in, PERIOD, s_out, PERIOD, false);
+
+      TEST_CHECK_EQ(out, PERIOD);
+      produced += out;
+
+      if (rs.get_carried() >= MIN_XFER)
+        {
+          uint32_t num = rs.get_carried();
+
+          TEST_CHECK_EQ(rs.flush(s_out, PERIOD, false), num);
+          TEST_CHECK_EQ(rs.get_carried(), 0);
+          produced += num;
+        }
+    }
+
+  produced += rs.get_carried();
+
+  /* 1000ppm of 2048000 frames is 2048 frames. */
+
+  uint64_t expected = 2000ULL * PERIOD + 2048;
+
+  TEST_CHECK(produced + 2 >= expected && produced <= expected + 2);
+  TEST_CHECK_EQ(rs.get_dropped(), 0);
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_drift(int32_t offset_ppm)
+{
+  ClockRecoveryController ctl;
+  ClockRecoveryResampler rs;
+
+  /* DAC consumes PERIOD x (1 + offset) frames while source produces
+   * PERIOD frames. Depth is counted in frames including carried ones,
+   * as auto_adjustment() does.
+   */
+
+  int64_t queued    = PREFETCH * PERIOD;
+  int64_t min_queue = queued;
+  double  consumed  = 0;
+  int64_t err_sum   = 0;
+  uint32_t err_num  = 0;
+
+  ctl.reset(0, MAX_PPM);
+
+  for (uint32_t p = 0; p < RUN_PERIODS; p++)
+    {
+      make_period(s_in, PERIOD, p * PERIOD);
+
+      uint32_t depth = static_cast<uint32_t>(queued) + rs.get_carried();
+
+      rs.set_ratio(ctl.update(depth, PERIOD));
+
+      queued += rs.exec(s_in, PERIOD, s_out, PERIOD, false);
+
+      if (rs.get_carried() >= MIN_XFER)
+        {
+          queued += rs.flush(s_out, PERIOD, false);
+        }
+
+      consumed += PERIOD * (1.0 + offset_ppm * 1e-6);
+
+      int64_t frames = static_cast<int64_t>(consumed);
+
+      consumed -= frames;
+      queued   -= frames;
+      min_queue = (queued < min_queue) ? queued : min_queue;
+
+      if (p >= RUN_PERIODS * 3 / 4)
+        {
+          err_sum += static_cast<int64_t>(depth) - ctl.get_target();
+          err_num++;
+        }
+    }
+
+  /* Without control, depth would move by offset x 40 million frames,
+   * e.g. 8000 frames at 200ppm.
+   */
+
+  int32_t drift = ctl.get_drift_ppm();
+  int64_t err   = err_sum / err_num;
+
+  printf("drift %5d ppm: estimated %5d ppm, depth error %3lld, "
+         "min depth %lld\n",
+         offset_ppm, -drift, (long long)err, (long long)min_queue);
+
+  TEST_CHECK(ctl.is_locked());
+  TEST_CHECK(abs(drift + offset_ppm) <= abs(offset_ppm) / 10 + 5);
+  TEST_CHECK(llabs(err) <= PERIOD / 8);
+  TEST_CHECK(min_queue > PERIOD);
+  TEST_CHECK_EQ(rs.get_dropped(), 0);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(void)
+{
+  test_passthrough();
+  test_carry();
+  test_drift(200);
+  test_drift(-200);
+  test_drift(500);
+  test_drift(-500);
+
+  return TEST_RESULT("test_clock_recovery");
+}
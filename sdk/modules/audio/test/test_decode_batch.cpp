@@ -0,0 +1,207 @@
+/****************************************************************************
+ * modules/audio/test/test_decode_batch.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of decode batch count of media player
+ * (player_decode_batch.cpp). Bounds are checked over a sweep of buffer
+ * sizes and downstream depth, so that gathered frames never exceed the
+ * ES and PCM segments.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+
+#include "host_test.h"
+#include "objects/media_player/player_decode_batch.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MP3_MAX_FRAME_SIZE 1441  /* Same as media_player_obj.cpp.      */
+#define MP3_PCM_AU_SIZE    4608  /* 1152 samples x 2ch x 16bit.        */
+#define ES_BUF_SIZE        6144  /* Example sizes of player segments.  */
+#define PCM_BUF_SIZE       16384
+#define PCM_SEGS           8
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static DecodeBatchParam make_param(uint32_t max_batch, uint32_t pcm_used)
+{
+  DecodeBatchParam param;
+
+  param.max_batch     = max_batch;
+  param.pre_play      = false;
+  param.pcm_used      = pcm_used;
+  param.es_buf_size   = ES_BUF_SIZE;
+  param.es_frame_size = MP3_MAX_FRAME_SIZE;
+  param.pcm_buf_size  = PCM_BUF_SIZE;
+  param.pcm_au_size   = MP3_PCM_AU_SIZE;
+
+  return param;
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_single(void)
+{
+  DecodeBatchParam param = make_param(8, PCM_SEGS);
+
+  /* One frame per request at start-up, until sizes of a frame are known,
+   * and if batching is disabled.
+   */
+
+  param.pre_play = true;
+  TEST_CHECK_EQ(decode_batch_count(&param), 1);
+
+  param = make_param(8, PCM_SEGS);
+  param.pcm_au_size = 0;
+  TEST_CHECK_EQ(decode_batch_count(&param), 1);
+
+  param = make_param(8, PCM_SEGS);
+  param.es_frame_size = 0;
+  TEST_CHECK_EQ(decode_batch_count(&param), 1);
+
+  param = make_param(1, PCM_SEGS);
+  TEST_CHECK_EQ(decode_batch_count(&param), 1);
+
+  param = make_param(0, PCM_SEGS);
+  TEST_CHECK_EQ(decode_batch_count(&param), 1);
+
+  /* Segments smaller than a frame still decode one frame. */
+
+  param = make_param(8, PCM_SEGS);
+  param.es_buf_size = MP3_MAX_FRAME_SIZE - 1;
+  TEST_CHECK_EQ(decode_batch_count(&param), 1);
+
+  param = make_param(8, PCM_SEGS);
+  param.pcm_buf_size = MP3_PCM_AU_SIZE - 1;
+  TEST_CHECK_EQ(decode_batch_count(&param), 1);
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_adapt(void)
+{
+  /* Depth of downstream raises the count, then limits of config,
+   * ES segment (6144 / 1441 = 4) and PCM segment (16384 / 4608 = 3).
+   */
+
+  static const uint32_t expect[] = { 1, 1, 2, 2, 3, 3, 3, 3, 3 };
+
+  for (uint32_t used = 0; used <= PCM_SEGS; used++)
+    {
+      DecodeBatchParam param = make_param(8, used);
+
+      TEST_CHECK_EQ(decode_batch_count(&param), expect[used]);
+    }
+
+  DecodeBatchParam param = make_param(2, PCM_SEGS);
+
+  TEST_CHECK_EQ(decode_batch_count(&param), 2);
+
+  param = make_param(8, PCM_SEGS);
+  param.pcm_buf_size = 8 * MP3_PCM_AU_SIZE;
+  TEST_CHECK_EQ(decode_batch_count(&param), 4);
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_bounds(void)
+{
+  uint32_t cases = 0;
+
+  for (uint32_t max = 1; max <= 8; max++)
+    for (uint32_t used = 0; used <= 16; used++)
+      for (uint32_t es = 256; es <= 16384; es += 509)
+        for (uint32_t frame = 1; frame <= 2048; frame += 97)
+          for (uint32_t pcm = 1024; pcm <= 32768; pcm += 2039)
+            for (uint32_t au = 256; au <= 8192; au += 1021)
+              {
+                DecodeBatchParam param;
+
+                param.max_batch     = max;
+                param.pre_play      = false;
+                param.pcm_used      = used;
+                param.es_buf_size   = es;
+                param.es_frame_size = frame;
+                param.pcm_buf_size  = pcm;
+                param.pcm_au_size   = au;
+
+                uint32_t batch = decode_batch_count(&param);
+
+                cases++;
+
+                /* Worst case frames of a request fit in both segments,
+                 * unless it is a single frame.
+                 */
+
+                if ((batch < 1) || (batch > max) ||
+                    ((batch > 1) && ((batch * frame > es) ||
+                                     (batch * au > pcm))))
+                  {
+                    TEST_CHECK(false);
+                    printf("max %u used %u es %u/%u pcm %u/%u: %u\n",
+                           max, used, es, frame, pcm, au, batch);
+                    return;
+                  }
+
+                /* Deeper downstream never decreases the count. */
+
+                param.pcm_used = used + 1;
+
+                if (decode_batch_count(&param) < batch)
+                  {
+                    TEST_CHECK(false);
+                    return;
+                  }
+              }
+
+  printf("decode batch bounds: %u cases\n", cases);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(void)
+{
+  test_single();
+  test_adapt();
+  test_bounds();
+
+  return TEST_RESULT("test_decode_batch");
+}
@@ -0,0 +1,213 @@
+/****************************************************************************
+ * modules/audio/test/test_dma_buffer.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of DMA buffer conversion (audio_dma_buffer.cpp).  The word-wise
+ * paths are compared bit-exact with the original halfword loops for every
+ * channel count, odd and even sample counts and halfword aligned buffers.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "host_test.h"
+#include "dma_controller/audio_dma_buffer.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MAX_CH      8
+#define MAX_SAMPLE  40
+#define GUARD       8   /* Halfwords after output, must be kept */
+#define BUF_HWORDS  (MAX_SAMPLE * (MAX_CH + 1) + 2 + GUARD)
+#define AREA_SIZE   (4 * BUF_HWORDS * sizeof(uint16_t))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* Original halfword implementations, as reference. */
+
+static void ref_get_mic_input(uint16_t sample,
+                              uint8_t channel,
+                              uint16_t *p_from,
+                              uint16_t *p_to)
+{
+  for (uint32_t i = 0; i < sample; i++)
+    {
+      for (uint8_t ch = 0; ch < channel; ch++)
+        {
+          *p_to++ = *p_from++;
+        }
+
+      p_from++;
+    }
+}
+
+static void ref_get_swap_data(uint16_t *p_data, uint16_t sample)
+{
+  for (uint32_t i = 0; i < sample; i++)
+    {
+      uint16_t tmp = p_data[2 * i];
+      p_data[2 * i] = p_data[2 * i + 1];
+      p_data[2 * i + 1] = tmp;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static void fill(uint16_t *buf, uint32_t num, uint32_t seed)
+{
+  for (uint32_t i = 0; i < num; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      buf[i] = (uint16_t)(seed >> 16);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/* DMA address is 32bit, so buffers are placed in the lower 4GB. */
+
+static uint16_t *alloc_area(void)
+{
+  void *area = mmap(NULL, AREA_SIZE, PROT_READ | PROT_WRITE,
+#ifdef MAP_32BIT
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT,
+#else
+                    MAP_PRIVATE | MAP_ANONYMOUS,
+#endif
+                    -1, 0);
+
+  if ((area == MAP_FAILED) || ((uintptr_t)area > UINT32_MAX - AREA_SIZE))
+    {
+      return NULL;
+    }
+
+  return (uint16_t *)area;
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_mic_input(uint16_t *area)
+{
+  uint16_t *src  = area;
+  uint16_t *out  = area + BUF_HWORDS;
+  uint16_t *ref  = area + 2 * BUF_HWORDS;
+
+  for (uint8_t ch = 1; ch <= MAX_CH; ch++)
+    {
+      for (uint16_t sample = 0; sample < MAX_SAMPLE; sample++)
+        {
+          for (int in_ofs = 0; in_ofs < 2; in_ofs++)
+            {
+              for (int out_ofs = 0; out_ofs < 2; out_ofs++)
+                {
+                  uint32_t out_num = sample * ch + GUARD;
+
+                  fill(src, BUF_HWORDS, ch * 1000 + sample);
+                  fill(out, BUF_HWORDS, 7);
+                  fill(ref, BUF_HWORDS, 7);
+
+                  AS_AudioDrvDmaGetMicInput(sample, ch,
+                                            (uint32_t)(uintptr_t)
+                                              (src + in_ofs),
+                                            out + out_ofs);
+                  ref_get_mic_input(sample, ch, src + in_ofs,
+                                    ref + out_ofs);
+
+                  if (memcmp(out, ref,
+                             (out_ofs + out_num) * sizeof(uint16_t)) != 0)
+                    {
+                      printf("mic input mismatch: ch %d sample %d "
+                             "in +%d out +%d\n",
+                             ch, sample, in_ofs * 2, out_ofs * 2);
+                      g_test_failed++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_swap_data(uint16_t *area)
+{
+  uint16_t *out = area;
+  uint16_t *ref = area + BUF_HWORDS;
+
+  for (uint16_t sample = 0; sample < MAX_SAMPLE; sample++)
+    {
+      for (int ofs = 0; ofs < 2; ofs++)
+        {
+          fill(out, BUF_HWORDS, sample);
+          fill(ref, BUF_HWORDS, sample);
+
+          AS_AudioDrvDmaGetSwapData((uint32_t)(uintptr_t)(out + ofs),
+                                    sample);
+          ref_get_swap_data(ref + ofs, sample);
+
+          if (memcmp(out, ref, BUF_HWORDS * sizeof(uint16_t)) != 0)
+            {
+              printf("swap mismatch: sample %d +%d\n", sample, ofs * 2);
+              g_test_failed++;
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(void)
+{
+  uint16_t *area = alloc_area();
+
+  if (area == NULL)
+    {
+      printf("test_dma_buffer: skipped, no memory below 4GB\n");
+      return 0;
+    }
+
+  test_mic_input(area);
+  test_swap_data(area);
+
+  munmap(area, AREA_SIZE);
+
+  return TEST_RESULT("test_dma_buffer");
+}
@@ -0,0 +1,258 @@
+/****************************************************************************
+ * modules/audio/test/test_gapless.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of gapless playback (player_gapless_info.cpp). Decoded PCM
+ * of two tracks is simulated with encoder delay and padding, trimmed by
+ * the information parsed from their headers, and checked to be joined
+ * sample-accurately.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "objects/media_player/player_gapless_info.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SPF           1152  /* Samples per frame of MPEG1 layer3. */
+#define DECODER_DELAY 529
+#define JUNK          0x7ffffff0
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static int32_t s_joined[2 * 1024 * 1024];
+static uint32_t s_joined_num;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint32_t make_lame(uint8_t *buf, uint32_t frames,
+                          uint32_t delay, uint32_t padding)
+{
+  uint32_t pos = 0;
+
+  memset(buf, 0, 512);
+
+  /* ID3v2 tag of 20 bytes. */
+
+  memcpy(buf, "ID3\x03\x00\x00\x00\x00\x00\x14", 10);
+  pos = 10 + 20;
+
+  /* MPEG1 layer3 stereo frame, then side information of 32 bytes. */
+
+  buf[pos]     = 0xff;
+  buf[pos + 1] = 0xfb;
+  buf[pos + 2] = 0x90;
+  buf[pos + 3] = 0x00;
+  pos += 4 + 32;
+
+  memcpy(&buf[pos], "Info", 4);
+  buf[pos + 7] = 0x01;  /* Frames only */
+  buf[pos + 8]  = (uint8_t)(frames >> 24);
+  buf[pos + 9]  = (uint8_t)(frames >> 16);
+  buf[pos + 10] = (uint8_t)(frames >> 8);
+  buf[pos + 11] = (uint8_t)frames;
+  pos += 12;
+
+  memcpy(&buf[pos], "LAME3.100", 9);
+  buf[pos + 21] = (uint8_t)(delay >> 4);
+  buf[pos + 22] = (uint8_t)(((delay & 0x0f) << 4) | (padding >> 8));
+  buf[pos + 23] = (uint8_t)padding;
+
+  return pos + 36;
+}
+
+/*--------------------------------------------------------------------------*/
+static void decode_track(uint32_t total, uint32_t start, uint32_t valid,
+                         uint32_t *next, uint32_t skip, uint32_t remain,
+                         uint32_t chunk)
+{
+  static int32_t pcm[SPF * 2];
+
+  /* Decoder output has content at [start, start + valid) and junk of
+   * delay and padding around it. It is passed in chunks, as decode
+   * requests are completed.
+   */
+
+  for (uint32_t pos = 0; pos < total; pos += chunk)
+    {
+      uint32_t num = (total - pos < chunk) ? total - pos : chunk;
+
+      for (uint32_t i = 0; i < num; i++)
+        {
+          uint32_t n = pos + i;
+          bool content = (n >= start) && (n < start + valid);
+
+          pcm[i * 2]     = content ? (int32_t)(*next + n - start) : JUNK;
+          pcm[i * 2 + 1] = content ? ~(int32_t)(*next + n - start) : JUNK;
+        }
+
+      uint32_t size = gapless_splice_pcm((uint8_t *)pcm, num * 8, 8,
+                                         &skip, &remain);
+
+      memcpy(&s_joined[s_joined_num * 2], pcm, size);
+      s_joined_num += size / 8;
+    }
+
+  *next += valid;
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_parse_lame(void)
+{
+  uint8_t  buf[512];
+  uint32_t head_skip;
+  uint32_t valid;
+  uint32_t size = make_lame(buf, 100, 576, 1000);
+
+  TEST_CHECK(gapless_parse_lame(buf, size, &head_skip, &valid));
+  TEST_CHECK_EQ(head_skip, SPF + 576 + DECODER_DELAY);
+  TEST_CHECK_EQ(valid, 100 * SPF - 576 - 1000);
+
+  /* Without LAME extension, only the tag frame is skipped. */
+
+  TEST_CHECK(gapless_parse_lame(buf, size - 36 + 12, &head_skip, &valid));
+  TEST_CHECK_EQ(head_skip, SPF);
+  TEST_CHECK_EQ(valid, 0);
+
+  buf[30] = 0;
+  TEST_CHECK(!gapless_parse_lame(buf, size, &head_skip, &valid));
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_parse_itunsmpb(void)
+{
+  static const char tag[] = "....COMM....iTunSMPB\0 00000000 00000840 "
+                            "000001CA 00000000003A2DE6 00000000";
+  uint32_t head_skip;
+  uint32_t valid;
+
+  TEST_CHECK(gapless_parse_itunsmpb((const uint8_t *)tag, sizeof(tag) - 1,
+                                    &head_skip, &valid));
+  TEST_CHECK_EQ(head_skip, 0x840);
+  TEST_CHECK_EQ(valid, 0x3a2de6);
+
+  /* Truncated value, and sample count beyond 32 bits. */
+
+  TEST_CHECK(!gapless_parse_itunsmpb((const uint8_t *)tag, 40,
+                                     &head_skip, &valid));
+
+  static const char big[] = "iTunSMPB 0 840 1CA 100000000";
+
+  TEST_CHECK(!gapless_parse_itunsmpb((const uint8_t *)big, sizeof(big) - 1,
+                                     &head_skip, &valid));
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_out_samples(void)
+{
+  TEST_CHECK_EQ(gapless_out_samples(2112, 48000, 48000), 2112);
+  TEST_CHECK_EQ(gapless_out_samples(1105, 44100, 48000), 1203);
+  TEST_CHECK_EQ(gapless_out_samples(100, 0, 48000), 100);
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_join(uint32_t chunk)
+{
+  uint8_t  buf[512];
+  uint32_t next = 0;
+  uint32_t head_skip;
+  uint32_t valid;
+
+  s_joined_num = 0;
+
+  /* Track 1: MP3 with LAME tag. Tag frame decodes to silence, and the
+   * content is delayed by encoder and decoder.
+   */
+
+  uint32_t frames = 80;
+  uint32_t size   = make_lame(buf, frames, 576, 1234);
+
+  TEST_CHECK(gapless_parse_lame(buf, size, &head_skip, &valid));
+  decode_track((frames + 1) * SPF, SPF + 576 + DECODER_DELAY, valid,
+               &next, head_skip, valid, chunk);
+
+  /* Track 2: iTunSMPB, content after 2112 samples of delay. */
+
+  static const char tag[] = "iTunSMPB 00000000 00000840 000001CA "
+                            "0000000000015F90";
+
+  TEST_CHECK(gapless_parse_itunsmpb((const uint8_t *)tag, sizeof(tag) - 1,
+                                    &head_skip, &valid));
+  decode_track(0x840 + 0x15f90 + 0x1ca, 0x840, valid,
+               &next, head_skip, valid, chunk);
+
+  /* Track 3: no gapless information, all of decoded PCM is valid. */
+
+  decode_track(5 * SPF, 0, 5 * SPF, &next, 0, GAPLESS_NO_LIMIT, chunk);
+
+  TEST_CHECK_EQ(s_joined_num, next);
+
+  for (uint32_t i = 0; i < s_joined_num; i++)
+    {
+      if ((s_joined[i * 2] != (int32_t)i) ||
+          (s_joined[i * 2 + 1] != ~(int32_t)i))
+        {
+          TEST_CHECK_EQ(s_joined[i * 2], i);
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(void)
+{
+  test_parse_lame();
+  test_parse_itunsmpb();
+  test_out_samples();
+  test_join(SPF);
+  test_join(1000);
+  test_join(1);
+
+  return TEST_RESULT("test_gapless");
+}
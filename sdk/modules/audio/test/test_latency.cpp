@@ -0,0 +1,145 @@
+/****************************************************************************
+ * modules/audio/test/test_latency.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of the pipeline latency histogram (audio_latency.cpp). */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "audio/audio_latency_api.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define BIN_US  (CONFIG_AUDIOUTILS_LATENCY_TRACE_BIN_MS * 1000)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void test_histogram(void)
+{
+  AsLatencyHistogram hist;
+
+  AS_ClearPipelineLatency();
+
+  /* Frames without origin are not recorded. */
+
+  AS_RecordPipelineLatency(AsLatencyStageDecode, 0, 1000);
+
+  AS_RecordPipelineLatency(AsLatencyStageDecode, 1000, 1000 + 100);
+  AS_RecordPipelineLatency(AsLatencyStageDecode, 1000, 1000 + BIN_US);
+  AS_RecordPipelineLatency(AsLatencyStageDecode, 1000,
+                           1000 + 3 * BIN_US + 1);
+
+  TEST_CHECK(AS_GetPipelineLatency(AsLatencyStageDecode, &hist));
+  TEST_CHECK_EQ(hist.bin_width, BIN_US);
+  TEST_CHECK_EQ(hist.count, 3);
+  TEST_CHECK_EQ(hist.min, 100);
+  TEST_CHECK_EQ(hist.max, 3 * BIN_US + 1);
+  TEST_CHECK_EQ(hist.total, 100 + BIN_US + 3 * BIN_US + 1);
+  TEST_CHECK_EQ(hist.bin[0], 1);
+  TEST_CHECK_EQ(hist.bin[1], 1);
+  TEST_CHECK_EQ(hist.bin[2], 0);
+  TEST_CHECK_EQ(hist.bin[3], 1);
+
+  /* Other stages are independent. */
+
+  TEST_CHECK(AS_GetPipelineLatency(AsLatencyStageDmaDone, &hist));
+  TEST_CHECK_EQ(hist.count, 0);
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_overflow_and_wrap(void)
+{
+  AsLatencyHistogram hist;
+
+  AS_ClearPipelineLatency();
+
+  /* Latency beyond the range goes to the last bin. */
+
+  AS_RecordPipelineLatency(AsLatencyStageMixerIn, 1,
+                           1 + AS_LATENCY_BIN_NUM * BIN_US * 10);
+
+  /* Time stamp wraps around between origin and stage. */
+
+  AS_RecordPipelineLatency(AsLatencyStageMixerIn, 0xffffff00, 0x00000100);
+
+  TEST_CHECK(AS_GetPipelineLatency(AsLatencyStageMixerIn, &hist));
+  TEST_CHECK_EQ(hist.count, 2);
+  TEST_CHECK_EQ(hist.min, 0x200);
+  TEST_CHECK_EQ(hist.bin[AS_LATENCY_BIN_NUM - 1], 1);
+  TEST_CHECK_EQ(hist.bin[0], 1);
+
+  AS_ClearPipelineLatency();
+
+  TEST_CHECK(AS_GetPipelineLatency(AsLatencyStageMixerIn, &hist));
+  TEST_CHECK_EQ(hist.count, 0);
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_invalid(void)
+{
+  AsLatencyHistogram hist;
+
+  AS_ClearPipelineLatency();
+  AS_RecordPipelineLatency(AsLatencyStageNum, 1, 2);
+
+  TEST_CHECK(!AS_GetPipelineLatency(AsLatencyStageNum, &hist));
+  TEST_CHECK(!AS_GetPipelineLatency(AsLatencyStageDecode, NULL));
+
+  /* Zero is reserved for frames without origin. */
+
+  TEST_CHECK(AS_GetLatencyTimestamp() != 0);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(void)
+{
+  test_histogram();
+  test_overflow_and_wrap();
+  test_invalid();
+
+  return TEST_RESULT("test_latency");
+}
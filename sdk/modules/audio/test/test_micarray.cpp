@@ -0,0 +1,326 @@
+/****************************************************************************
+ * modules/audio/test/test_micarray.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of mic array pre process (micarray_proc.cpp). Interleaved
+ * stream is split into frames of various lengths, including ones
+ * shorter than steering delay, and each output frame is compared with
+ * the result calculated over the whole stream at once.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "components/customproc/micarray_proc.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define STREAM_SAMPLES 2048
+#define CH_MAX         MicArrayProc::CH_MAX
+#define DELAY_MAX      MicArrayProc::DELAY_MAX
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Frame lengths in turn. Shorter ones than DELAY_MAX take delayed
+ * samples from more than one previous frame.
+ */
+
+static const uint32_t s_frames[] =
+{
+  1, 7, 63, 64, 65, 200, 3, 33, 128, 17, 1024,
+};
+
+static int32_t s_in[STREAM_SAMPLES * CH_MAX];
+static int32_t s_out[STREAM_SAMPLES * CH_MAX];
+static int32_t s_ref[STREAM_SAMPLES * CH_MAX];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+template<typename T>
+static void make_stream(T *buf, uint32_t ch_num)
+{
+  for (uint32_t i = 0; i < STREAM_SAMPLES * ch_num; i++)
+    {
+      /* Full scale values, to check that sum does not overflow. */
+
+      buf[i] = (sizeof(T) == 2) ?
+               static_cast<T>(rand()) :
+               static_cast<T>((static_cast<uint32_t>(rand()) << 16) ^ rand());
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+template<typename T>
+static void ref_beamform(const T *in, T *out, uint32_t ch_num,
+                         uint8_t mask, const uint16_t *delay,
+                         uint32_t start, uint32_t sample)
+{
+  uint32_t nsel = 0;
+
+  for (uint32_t ch = 0; ch < ch_num; ch++)
+    {
+      nsel += (mask >> ch) & 1;
+    }
+
+  for (uint32_t n = start; n < start + sample; n++)
+    {
+      int64_t acc = 0;
+
+      for (uint32_t ch = 0; ch < ch_num; ch++)
+        {
+          if ((mask & (1 << ch)) && (n >= delay[ch]))
+            {
+              acc += in[(n - delay[ch]) * ch_num + ch];
+            }
+        }
+
+      out[n] = static_cast<T>((acc * ((1 << 16) / nsel)) >> 16);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+template<typename T>
+static void test_planar(uint32_t ch_num, uint8_t mask, uint8_t exp_mask)
+{
+  MicArrayProc proc;
+  T *in  = reinterpret_cast<T *>(s_in);
+  T *out = reinterpret_cast<T *>(s_out);
+
+  TEST_CHECK(proc.init(ch_num, sizeof(T) == 4));
+  make_stream(in, ch_num);
+  proc.set_mask(mask);
+  TEST_CHECK_EQ(proc.get_mask(), exp_mask);
+
+  uint32_t nsel = proc.get_sel_ch_num();
+  uint32_t pos  = 0;
+
+  for (uint32_t f = 0; f < sizeof(s_frames) / sizeof(s_frames[0]); f++)
+    {
+      uint32_t sample = s_frames[f];
+      uint32_t size   = proc.planar(&in[pos * ch_num], out, sample);
+
+      TEST_CHECK_EQ(size, nsel * sample * sizeof(T));
+
+      /* Selected channels in order, each of them continuous. */
+
+      uint32_t sel = 0;
+
+      for (uint32_t ch = 0; ch < ch_num; ch++)
+        {
+          if (!(exp_mask & (1 << ch)))
+            {
+              continue;
+            }
+
+          for (uint32_t i = 0; i < sample; i++)
+            {
+              if (out[sel * sample + i] != in[(pos + i) * ch_num + ch])
+                {
+                  TEST_CHECK_EQ(out[sel * sample + i],
+                                in[(pos + i) * ch_num + ch]);
+                  return;
+                }
+            }
+
+          sel++;
+        }
+
+      pos += sample;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+template<typename T>
+static void test_beamform(uint32_t ch_num, uint8_t mask,
+                          const uint16_t *delay)
+{
+  MicArrayProc proc;
+  T *in  = reinterpret_cast<T *>(s_in);
+  T *out = reinterpret_cast<T *>(s_out);
+  T *ref = reinterpret_cast<T *>(s_ref);
+
+  TEST_CHECK(proc.init(ch_num, sizeof(T) == 4));
+  make_stream(in, ch_num);
+  proc.set_mask(mask);
+  TEST_CHECK(proc.set_delay(delay));
+
+  uint8_t  sel = proc.get_mask();
+  uint32_t pos = 0;
+
+  ref_beamform(in, ref, ch_num, sel, delay, 0, STREAM_SAMPLES);
+
+  for (uint32_t f = 0; f < sizeof(s_frames) / sizeof(s_frames[0]); f++)
+    {
+      uint32_t sample = s_frames[f];
+      uint32_t size   = proc.beamform(&in[pos * ch_num], out, sample);
+
+      TEST_CHECK_EQ(size, sample * sizeof(T));
+
+      if (memcmp(out, &ref[pos], sample * sizeof(T)) != 0)
+        {
+          printf("beamform %uch mask %02x: mismatch in frame %u\n",
+                 ch_num, sel, f);
+          g_test_failed++;
+          return;
+        }
+
+      pos += sample;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_beamform_all(void)
+{
+  static const uint16_t zero[CH_MAX] = { 0 };
+  static const uint16_t max[CH_MAX]  =
+  {
+    DELAY_MAX, DELAY_MAX, DELAY_MAX, DELAY_MAX,
+    DELAY_MAX, DELAY_MAX, DELAY_MAX, DELAY_MAX,
+  };
+  static const uint16_t steer[CH_MAX] =
+  {
+    0, 5, 10, 64, 31, 1, 63, 2,
+  };
+
+  for (uint32_t ch_num = 1; ch_num <= CH_MAX; ch_num++)
+    {
+      test_beamform<int16_t>(ch_num, 0, zero);
+      test_beamform<int16_t>(ch_num, 0, steer);
+      test_beamform<int32_t>(ch_num, 0, steer);
+    }
+
+  test_beamform<int16_t>(4, 0x0a, steer);
+  test_beamform<int32_t>(8, 0xc1, steer);
+  test_beamform<int16_t>(8, 0, max);
+  test_beamform<int32_t>(3, 0x05, max);
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_history(void)
+{
+  static const uint16_t steer[CH_MAX] =
+  {
+    40, 0, 64, 12, 0, 0, 0, 0,
+  };
+  const uint32_t ch_num = 4;
+
+  MicArrayProc proc;
+  int16_t *in  = reinterpret_cast<int16_t *>(s_in);
+  int16_t *out = reinterpret_cast<int16_t *>(s_out);
+  int16_t *ref = reinterpret_cast<int16_t *>(s_ref);
+
+  proc.init(ch_num, false);
+  make_stream(in, ch_num);
+  proc.set_delay(steer);
+
+  /* Selection changed while running uses history of channels which
+   * were not selected before.
+   */
+
+  proc.set_mask(0x01);
+  proc.beamform(in, out, 100);
+  proc.set_mask(0x0c);
+  proc.beamform(&in[100 * ch_num], out, 30);
+  ref_beamform(in, ref, ch_num, 0x0c, steer, 100, 30);
+  TEST_CHECK(memcmp(out, &ref[100], 30 * sizeof(int16_t)) == 0);
+
+  /* After reset, delayed samples are silence, same as start of stream. */
+
+  proc.reset();
+  proc.set_mask(0);
+  proc.beamform(in, out, 50);
+  ref_beamform(in, ref, ch_num, 0x0f, steer, 0, 50);
+  TEST_CHECK(memcmp(out, ref, 50 * sizeof(int16_t)) == 0);
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_param(void)
+{
+  MicArrayProc proc;
+  uint16_t delay[CH_MAX] = { 0 };
+  int16_t  in[2]         = { 100, 300 };
+  int16_t  out[1];
+
+  TEST_CHECK(!proc.init(0, false));
+  TEST_CHECK(!proc.init(CH_MAX + 1, false));
+  TEST_CHECK(proc.init(2, false));
+
+  /* Unused channels are ignored, then no selection means all. */
+
+  proc.set_mask(0xfc);
+  TEST_CHECK_EQ(proc.get_mask(), 0x03);
+
+  /* Delay over maximum is rejected, and previous delays are kept. */
+
+  delay[1] = DELAY_MAX + 1;
+  TEST_CHECK(!proc.set_delay(delay));
+
+  proc.beamform(in, out, 1);
+  TEST_CHECK_EQ(out[0], 200);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(void)
+{
+  srand(1);
+
+  test_planar<int16_t>(1, 0, 0x01);
+  test_planar<int16_t>(2, 0x02, 0x02);
+  test_planar<int16_t>(4, 0x0a, 0x0a);
+  test_planar<int16_t>(4, 0xf0, 0x0f);
+  test_planar<int32_t>(8, 0x81, 0x81);
+  test_planar<int32_t>(8, 0, 0xff);
+  test_planar<int32_t>(3, 0x06, 0x06);
+
+  test_beamform_all();
+  test_history();
+  test_param();
+
+  return TEST_RESULT("test_micarray");
+}
@@ -0,0 +1,518 @@
+/****************************************************************************
+ * modules/audio/test/test_sim_player.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of the playback pipeline on the host simulation (sim/).
+ * PlayerObj, OutputMixObjectTask and the renderer play LPCM from a RAM
+ * FIFO through the passthrough decoder to the virtual DAC, which checks
+ * that every sample arrives in order.  The start latency is measured from
+ * AS_PlayPlayer() to the end of the first DMA transfer.  With -b, the CPU
+ * time of the whole pipeline is measured over a longer stream, as the
+ * throughput it would reach on one CPU.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "sim.h"
+#include "audio/audio_high_level_api.h"
+#include "audio/audio_message_types.h"
+#include "memutils/simple_fifo/CMN_SimpleFifo.h"
+#include "layout/msgq_id.h"
+#include "layout/mem_layout.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PLAY_CH_NUM        2
+#define PLAY_SAMPLE_BYTES  (PLAY_CH_NUM * sizeof(int16_t))
+
+/* Pattern period, prime so that it does not align with frames. */
+
+#define PATTERN_PERIOD     32749
+
+#define CHECK_SECONDS      1
+#define CHECK_SPEED        4
+#define BENCH_SECONDS      30
+#define BENCH_SPEED        16
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static CMN_SimpleFifoHandle s_fifo;
+static AsPlayerInputDeviceHdlrForRAM s_fifo_hdlr;
+static uint8_t *s_fifo_area;
+
+/* Written by the DMA thread of the virtual DAC. */
+
+static volatile uint32_t s_sink_count;
+static volatile uint32_t s_sink_errors;
+static volatile uint32_t s_sink_silence;
+static volatile uint64_t s_first_ns;
+static volatile uint32_t s_attentions;
+static volatile uint32_t s_mixer_errors;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int16_t pattern(uint32_t n)
+{
+  /* Never 0, to tell played data from silence. */
+
+  return (int16_t)(n % PATTERN_PERIOD + 1);
+}
+
+/*--------------------------------------------------------------------------*/
+static uint64_t cpu_now_ns(void)
+{
+  struct timespec ts;
+
+  /* CPU time of all threads of the pipeline. */
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/*--------------------------------------------------------------------------*/
+static void sink(cxd56_audio_dma_t handle, void *data, uint32_t size)
+{
+  const int16_t *pcm = (const int16_t *)data;
+  uint32_t num = size / sizeof(int16_t);
+
+  (void)handle;
+
+  if (s_first_ns == 0)
+    {
+      s_first_ns = test_now_ns();
+    }
+
+  for (uint32_t i = 0; i < num; i++)
+    {
+      /* Silence is rendered before the first and after the last frame. */
+
+      if (pcm[i] == 0)
+        {
+          s_sink_silence++;
+        }
+      else if (pcm[i] == pattern(s_sink_count))
+        {
+          s_sink_count++;
+        }
+      else
+        {
+          s_sink_errors++;
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static void attention_cb(const ErrorAttentionParam *attparam)
+{
+  printf("Attention!! %s L%d ecode %d subcode %d\n",
+         attparam->error_filename,
+         attparam->line_number,
+         attparam->error_code,
+         attparam->error_att_sub_code);
+
+  s_attentions++;
+}
+
+/*--------------------------------------------------------------------------*/
+static void mixer_error_cb(uint8_t handle)
+{
+  (void)handle;
+
+  printf("Output mixer error, DMA underflow.\n");
+
+  s_mixer_errors++;
+}
+
+/*--------------------------------------------------------------------------*/
+static void fifo_read_done(uint32_t size)
+{
+  (void)size;
+}
+
+/*--------------------------------------------------------------------------*/
+static void outmixer_send_callback(int32_t identifier, bool is_end)
+{
+  AsRequestNextParam next;
+
+  (void)identifier;
+
+  next.type = (!is_end) ? AsNextNormalRequest : AsNextStopResRequest;
+
+  AS_RequestNextPlayerProcess(AS_PLAYER_ID_0, &next);
+}
+
+/*--------------------------------------------------------------------------*/
+static void player_decode_done_callback(AsPcmDataParam pcm)
+{
+  AsSendDataOutputMixer data;
+
+  data.handle   = OutputMixer0;
+  data.callback = outmixer_send_callback;
+  data.pcm      = pcm;
+
+  AS_SendDataOutputMixer(&data);
+}
+
+/*--------------------------------------------------------------------------*/
+static bool create_objects(void)
+{
+  AsCreatePlayerParams_t player_create_param;
+
+  player_create_param.msgq_id.player   = MSGQ_AUD_PLY0;
+  player_create_param.msgq_id.mng      = MSGQ_AUD_MNG;
+  player_create_param.msgq_id.mixer    = MSGQ_AUD_OUTPUT_MIX;
+  player_create_param.msgq_id.dsp      = MSGQ_AUD_DSP;
+  player_create_param.pool_id.es       = S0_DEC_ES_MAIN_BUF_POOL;
+  player_create_param.pool_id.pcm      = S0_REND_PCM_BUF_POOL;
+  player_create_param.pool_id.dsp      = S0_DEC_APU_CMD_POOL;
+  player_create_param.pool_id.src_work = S0_SRC_WORK_BUF_POOL;
+
+  if (!AS_CreatePlayerMulti(AS_PLAYER_ID_0,
+                            &player_create_param,
+                            attention_cb))
+    {
+      return false;
+    }
+
+  AsCreateOutputMixParams_t output_mix_act_param;
+
+  output_mix_act_param.msgq_id.mixer = MSGQ_AUD_OUTPUT_MIX;
+  output_mix_act_param.msgq_id.mng   = MSGQ_AUD_MNG;
+  output_mix_act_param.msgq_id.render_path0_filter_dsp = MSGQ_AUD_PFDSP0;
+  output_mix_act_param.msgq_id.render_path1_filter_dsp = MSGQ_AUD_PFDSP1;
+  output_mix_act_param.pool_id.render_path0_filter_pcm = S0_PF0_PCM_BUF_POOL;
+  output_mix_act_param.pool_id.render_path1_filter_pcm = S0_PF1_PCM_BUF_POOL;
+  output_mix_act_param.pool_id.render_path0_filter_dsp = S0_PF0_APU_CMD_POOL;
+  output_mix_act_param.pool_id.render_path1_filter_dsp = S0_PF1_APU_CMD_POOL;
+
+  if (!AS_CreateOutputMixer(&output_mix_act_param, attention_cb))
+    {
+      return false;
+    }
+
+  AsCreateRendererParam_t renderer_create_param;
+
+  renderer_create_param.msgq_id.dev0_req  = MSGQ_AUD_RND_PLY0;
+  renderer_create_param.msgq_id.dev0_sync = MSGQ_AUD_RND_PLY0_SYNC;
+  renderer_create_param.msgq_id.dev1_req  = 0xFF;
+  renderer_create_param.msgq_id.dev1_sync = 0xFF;
+
+  return AS_CreateRenderer(&renderer_create_param);
+}
+
+/*--------------------------------------------------------------------------*/
+static void delete_objects(void)
+{
+  AS_DeletePlayer(AS_PLAYER_ID_0);
+  AS_DeleteOutputMix();
+  AS_DeleteRenderer();
+}
+
+/*--------------------------------------------------------------------------*/
+static bool activate(void)
+{
+  AsActivateOutputMixer mixer_act;
+
+  mixer_act.output_device = HPOutputDevice;
+  mixer_act.mixer_type    = MainOnly;
+  mixer_act.post_enable   = PostFilterDisable;
+  mixer_act.cb            = NULL;
+  mixer_act.error_cb      = mixer_error_cb;
+
+  AS_ActivateOutputMixer(OutputMixer0, &mixer_act);
+
+  if (!sim_receive_reply(MSG_AUD_MIX_CMD_ACT))
+    {
+      return false;
+    }
+
+  /* The FIFO is refilled in place by push_pattern() for each play. */
+
+  s_fifo_hdlr.simple_fifo_handler = &s_fifo;
+  s_fifo_hdlr.callback_function   = fifo_read_done;
+
+  AsActivatePlayer player_act;
+
+  player_act.param.input_device  = AS_SETPLAYER_INPUTDEVICE_RAM;
+  player_act.param.ram_handler   = &s_fifo_hdlr;
+  player_act.param.output_device = AS_SETPLAYER_OUTPUTDEVICE_SPHP;
+  player_act.cb                  = NULL;
+
+  AS_ActivatePlayer(AS_PLAYER_ID_0, &player_act);
+
+  if (!sim_receive_reply(MSG_AUD_PLY_CMD_ACT))
+    {
+      return false;
+    }
+
+  AsInitPlayerParam player_init;
+
+  player_init.codec_type     = AS_CODECTYPE_WAV;
+  player_init.bit_length     = AS_BITLENGTH_16;
+  player_init.channel_number = PLAY_CH_NUM;
+  player_init.sampling_rate  = AS_SAMPLINGRATE_48000;
+  snprintf(player_init.dsp_path, AS_AUDIO_DSP_PATH_LEN, "%s", "/sim/BIN");
+
+  AS_InitPlayer(AS_PLAYER_ID_0, &player_init);
+
+  if (!sim_receive_reply(MSG_AUD_PLY_CMD_INIT))
+    {
+      return false;
+    }
+
+  AsInitOutputMixer omix_init;
+
+  omix_init.postproc_type = AsPostprocTypeThrough;
+  snprintf(omix_init.dsp_path, sizeof(omix_init.dsp_path), "%s",
+           "/sim/BIN/POSTPROC");
+
+  AS_InitOutputMixer(OutputMixer0, &omix_init);
+
+  return sim_receive_reply(MSG_AUD_MIX_CMD_INIT);
+}
+
+/*--------------------------------------------------------------------------*/
+static bool deactivate(void)
+{
+  AsDeactivatePlayer player_deact;
+
+  AS_DeactivatePlayer(AS_PLAYER_ID_0, &player_deact);
+
+  if (!sim_receive_reply(MSG_AUD_PLY_CMD_DEACT))
+    {
+      return false;
+    }
+
+  AsDeactivateOutputMixer mixer_deact;
+
+  AS_DeactivateOutputMixer(OutputMixer0, &mixer_deact);
+
+  return sim_receive_reply(MSG_AUD_MIX_CMD_DEACT);
+}
+
+/*--------------------------------------------------------------------------*/
+static bool push_pattern(uint32_t samples)
+{
+  uint32_t size = samples * PLAY_SAMPLE_BYTES;
+
+  /* The whole stream is queued up front, so the player never waits for
+   * the application.
+   */
+
+  free(s_fifo_area);
+  s_fifo_area = (uint8_t *)malloc(size + sizeof(uint32_t));
+
+  if (s_fifo_area == NULL ||
+      CMN_SimpleFifoInitialize(&s_fifo,
+                               s_fifo_area,
+                               size + sizeof(uint32_t),
+                               NULL) != 0)
+    {
+      return false;
+    }
+
+  int16_t buf[PLAY_CH_NUM * 256];
+
+  for (uint32_t n = 0; n < samples * PLAY_CH_NUM; )
+    {
+      uint32_t num = samples * PLAY_CH_NUM - n;
+
+      if (num > sizeof(buf) / sizeof(buf[0]))
+        {
+          num = sizeof(buf) / sizeof(buf[0]);
+        }
+
+      for (uint32_t i = 0; i < num; i++, n++)
+        {
+          buf[i] = pattern(n);
+        }
+
+      if (CMN_SimpleFifoOffer(&s_fifo, buf, num * sizeof(int16_t)) == 0)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool play(uint32_t samples, uint64_t *start_ns, uint64_t *total_ns)
+{
+  s_sink_count   = 0;
+  s_sink_errors  = 0;
+  s_sink_silence = 0;
+  s_first_ns     = 0;
+
+  AsPlayPlayerParam player_play;
+
+  player_play.pcm_path          = AsPcmDataReply;
+  player_play.pcm_dest.callback = player_decode_done_callback;
+
+  uint64_t t0 = test_now_ns();
+
+  AS_PlayPlayer(AS_PLAYER_ID_0, &player_play);
+
+  if (!sim_receive_reply(MSG_AUD_PLY_CMD_PLAY))
+    {
+      return false;
+    }
+
+  /* Play to the end of the stream. */
+
+  AsStopPlayerParam player_stop;
+
+  player_stop.stop_mode = AS_STOPPLAYER_ESEND;
+
+  AS_StopPlayer(AS_PLAYER_ID_0, &player_stop);
+
+  if (!sim_receive_reply(MSG_AUD_PLY_CMD_STOP))
+    {
+      return false;
+    }
+
+  *total_ns = test_now_ns() - t0;
+  *start_ns = s_first_ns - t0;
+
+  TEST_CHECK_EQ(s_sink_count, samples * PLAY_CH_NUM);
+  TEST_CHECK_EQ(s_sink_errors, 0);
+  TEST_CHECK_EQ(s_mixer_errors, 0);
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_play(void)
+{
+  uint32_t samples = CHECK_SECONDS * SIM_AUDIO_FS;
+  uint64_t start_ns;
+  uint64_t total_ns;
+
+  sim_audio_set_speed(CHECK_SPEED);
+
+  TEST_CHECK(push_pattern(samples));
+  TEST_CHECK(play(samples, &start_ns, &total_ns));
+  TEST_CHECK_EQ(s_attentions, 0);
+
+  /* Leading and trailing silence of the renderer, in samples. */
+
+  printf("play %us at x%u: first frame out %.2f ms after play "
+         "(%.2f ms of audio), silence %u samples\n",
+         CHECK_SECONDS, CHECK_SPEED,
+         start_ns / 1e6, start_ns * CHECK_SPEED / 1e6,
+         s_sink_silence / PLAY_CH_NUM);
+}
+
+/*--------------------------------------------------------------------------*/
+static void bench_play(void)
+{
+  uint32_t samples = BENCH_SECONDS * SIM_AUDIO_FS;
+  uint64_t start_ns;
+  uint64_t total_ns;
+
+  sim_audio_set_speed(BENCH_SPEED);
+
+  TEST_CHECK(push_pattern(samples));
+
+  uint64_t cpu0 = cpu_now_ns();
+
+  TEST_CHECK(play(samples, &start_ns, &total_ns));
+
+  uint64_t cpu_ns = cpu_now_ns() - cpu0;
+
+  printf("play %us at x%u: %.1f ms, cpu %.1f ms, x%.0f realtime on one "
+         "CPU\n",
+         BENCH_SECONDS, BENCH_SPEED, total_ns / 1e6, cpu_ns / 1e6,
+         BENCH_SECONDS * 1e9 / cpu_ns);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  bool dobench = false;
+  int  i;
+
+  for (i = 1; i < argc; i++)
+    {
+      if (strcmp(argv[i], "-b") == 0)
+        {
+          dobench = true;
+        }
+    }
+
+  if (!sim_initialize())
+    {
+      return 1;
+    }
+
+  sim_audio_set_sink(sink);
+
+  if (create_objects() && activate())
+    {
+      test_play();
+
+      if (dobench)
+        {
+          bench_play();
+        }
+
+      TEST_CHECK(deactivate());
+    }
+  else
+    {
+      TEST_CHECK(false);
+    }
+
+  delete_objects();
+  sim_finalize();
+  free(s_fifo_area);
+
+  return TEST_RESULT("test_sim_player");
+}
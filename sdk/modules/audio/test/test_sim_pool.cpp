@@ -0,0 +1,218 @@
+/****************************************************************************
+ * modules/audio/test/test_sim_pool.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of the MemHandle pools of the host simulation (sim/), built
+ * from the Memory Manager Lite sources with the layout of the audio
+ * objects.  With -b, the cost of a segment allocation and of a handle
+ * copy is measured, as the pipeline takes them for every frame.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <string.h>
+
+#include "host_test.h"
+#include "sim.h"
+#include "memutils/memory_manager/MemHandle.h"
+#include "layout/mem_layout.h"
+
+using namespace MemMgrLite;
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TEST_POOL    S0_REND_PCM_BUF_POOL
+#define TEST_SEGS    S0_L0_REND_PCM_BUF_POOL_NUM_SEG
+#define TEST_SIZE    S0_L0_REND_PCM_BUF_POOL_SEG_SIZE
+
+#define BENCH_LOOPS  1000000
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void test_alloc(void)
+{
+  MemHandle mh[TEST_SEGS];
+  MemHandle over;
+  uint32_t  i;
+
+  TEST_CHECK_EQ(Manager::getPoolNumSegs(TEST_POOL), TEST_SEGS);
+  TEST_CHECK_EQ(Manager::getPoolNumAvailSegs(TEST_POOL), TEST_SEGS);
+
+  /* A segment is not given for more than its size. */
+
+  TEST_CHECK_EQ(over.allocSeg(TEST_POOL, TEST_SIZE + 1), ERR_DATA_SIZE);
+  TEST_CHECK(over.isNull());
+
+  for (i = 0; i < TEST_SEGS; i++)
+    {
+      TEST_CHECK_EQ(mh[i].allocSeg(TEST_POOL, TEST_SIZE), ERR_OK);
+      TEST_CHECK(mh[i].isAvail());
+      TEST_CHECK_EQ(mh[i].getRefCnt(), 1);
+      TEST_CHECK_EQ(mh[i].getSize(), TEST_SIZE);
+    }
+
+  TEST_CHECK_EQ(Manager::getPoolNumAvailSegs(TEST_POOL), 0);
+
+  /* The segments do not overlap and lie in the pool. */
+
+  for (i = 0; i < TEST_SEGS; i++)
+    {
+      uint32_t addr = mh[i].getAddr();
+
+      TEST_CHECK(addr >= S0_L0_REND_PCM_BUF_POOL_ADDR);
+      TEST_CHECK(addr + TEST_SIZE <=
+                 S0_L0_REND_PCM_BUF_POOL_ADDR +
+                 S0_L0_REND_PCM_BUF_POOL_SIZE);
+
+      mh[i].fill(i);
+    }
+
+  for (i = 0; i < TEST_SEGS; i++)
+    {
+      uint8_t *va = static_cast<uint8_t *>(mh[i].getVa());
+
+      TEST_CHECK(va[0] == i && va[TEST_SIZE - 1] == i);
+    }
+
+  /* The pool is empty. */
+
+  TEST_CHECK_EQ(over.allocSeg(TEST_POOL, TEST_SIZE), ERR_MEM_EMPTY);
+  TEST_CHECK(over.isNull());
+
+  /* Copies share the segment, which is freed with the last of them. */
+
+  {
+    MemHandle copy(mh[0]);
+    MemHandle assigned;
+
+    assigned = mh[0];
+
+    TEST_CHECK(copy.isSame(mh[0]));
+    TEST_CHECK_EQ(mh[0].getRefCnt(), 3);
+
+    mh[0].freeSeg();
+    copy.freeSeg();
+
+    TEST_CHECK(mh[0].isNull());
+    TEST_CHECK_EQ(assigned.getRefCnt(), 1);
+    TEST_CHECK_EQ(Manager::getPoolNumAvailSegs(TEST_POOL), 0);
+  }
+
+  TEST_CHECK_EQ(Manager::getPoolNumAvailSegs(TEST_POOL), 1);
+
+  for (i = 1; i < TEST_SEGS; i++)
+    {
+      mh[i].freeSeg();
+    }
+
+  TEST_CHECK_EQ(Manager::getPoolNumAvailSegs(TEST_POOL), TEST_SEGS);
+}
+
+/*--------------------------------------------------------------------------*/
+static void bench_alloc(void)
+{
+  MemHandle mh;
+  uint64_t  t0;
+  uint64_t  alloc_ns;
+  uint64_t  copy_ns;
+  uint32_t  i;
+
+  t0 = test_now_ns();
+
+  for (i = 0; i < BENCH_LOOPS; i++)
+    {
+      mh.allocSeg(TEST_POOL, TEST_SIZE);
+      mh.freeSeg();
+    }
+
+  alloc_ns = test_now_ns() - t0;
+
+  TEST_CHECK_EQ(mh.allocSeg(TEST_POOL, TEST_SIZE), ERR_OK);
+
+  t0 = test_now_ns();
+
+  for (i = 0; i < BENCH_LOOPS; i++)
+    {
+      MemHandle copy(mh);
+    }
+
+  copy_ns = test_now_ns() - t0;
+
+  TEST_CHECK_EQ(mh.getRefCnt(), 1);
+  mh.freeSeg();
+
+  printf("pool: alloc+free %.1f ns, copy+release %.1f ns\n",
+         (double)alloc_ns / BENCH_LOOPS,
+         (double)copy_ns / BENCH_LOOPS);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  bool dobench = false;
+  int  i;
+
+  for (i = 1; i < argc; i++)
+    {
+      if (strcmp(argv[i], "-b") == 0)
+        {
+          dobench = true;
+        }
+    }
+
+  if (!sim_initialize())
+    {
+      return 1;
+    }
+
+  test_alloc();
+
+  if (dobench)
+    {
+      bench_alloc();
+    }
+
+  sim_finalize();
+
+  return TEST_RESULT("test_sim_pool");
+}
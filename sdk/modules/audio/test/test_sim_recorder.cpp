@@ -0,0 +1,486 @@
+/****************************************************************************
+ * modules/audio/test/test_sim_recorder.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of the recording pipeline on the host simulation (sim/).
+ * The capture of MicFrontendObject and MediaRecorderObjectTask record LPCM
+ * from the virtual MIC into a RAM FIFO, which is checked to hold the
+ * captured samples in order.  With -b, the CPU time of the whole pipeline
+ * is measured over a longer recording, as the throughput it would reach
+ * on one CPU.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "host_test.h"
+#include "sim.h"
+#include "audio/audio_high_level_api.h"
+#include "audio/audio_message_types.h"
+#include "audio/utilities/frame_samples.h"
+#include "memutils/simple_fifo/CMN_SimpleFifo.h"
+#include "layout/msgq_id.h"
+#include "layout/mem_layout.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define REC_CH_NUM         2
+#define REC_SAMPLE_BYTES   (REC_CH_NUM * sizeof(int16_t))
+
+/* Pattern period, prime so that it does not align with frames. */
+
+#define PATTERN_PERIOD     32749
+
+#define CHECK_SECONDS      1
+#define CHECK_SPEED        4
+#define BENCH_SECONDS      30
+#define BENCH_SPEED        16
+
+/* Recorded data is kept until the end of each recording, with room for
+ * the frames captured while stopping.
+ */
+
+#define FIFO_MARGIN_SECONDS  1
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static CMN_SimpleFifoHandle s_fifo;
+static AsRecorderOutputDeviceHdlr s_fifo_hdlr;
+static uint8_t *s_fifo_area;
+
+/* Written by the DMA thread of the virtual MIC. */
+
+static volatile uint32_t s_source_count;
+static volatile uint32_t s_attentions;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int16_t pattern(uint32_t n)
+{
+  return (int16_t)(n % PATTERN_PERIOD + 1);
+}
+
+/*--------------------------------------------------------------------------*/
+static uint64_t cpu_now_ns(void)
+{
+  struct timespec ts;
+
+  /* CPU time of all threads of the pipeline. */
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/*--------------------------------------------------------------------------*/
+static void source(cxd56_audio_dma_t handle, void *data, uint32_t size)
+{
+  int16_t *pcm = (int16_t *)data;
+  uint32_t num = size / sizeof(int16_t);
+
+  (void)handle;
+
+  for (uint32_t i = 0; i < num; i++)
+    {
+      pcm[i] = pattern(s_source_count++);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+static void attention_cb(const ErrorAttentionParam *attparam)
+{
+  printf("Attention!! %s L%d ecode %d subcode %d\n",
+         attparam->error_filename,
+         attparam->line_number,
+         attparam->error_code,
+         attparam->error_att_sub_code);
+
+  s_attentions++;
+}
+
+/*--------------------------------------------------------------------------*/
+static void fifo_write_done(uint32_t size)
+{
+  (void)size;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool create_objects(void)
+{
+  AsCreateMicFrontendParams_t frontend_create_param;
+
+  frontend_create_param.msgq_id.micfrontend = MSGQ_AUD_FRONTEND;
+  frontend_create_param.msgq_id.mng         = MSGQ_AUD_MNG;
+  frontend_create_param.msgq_id.dsp         = MSGQ_AUD_PREDSP;
+  frontend_create_param.pool_id.input       = S0_INPUT_BUF_POOL;
+  frontend_create_param.pool_id.output      = S0_NULL_POOL;
+  frontend_create_param.pool_id.dsp         = S0_PRE_APU_CMD_POOL;
+
+  if (!AS_CreateMicFrontend(&frontend_create_param, attention_cb))
+    {
+      return false;
+    }
+
+  AsCreateRecorderParams_t recorder_create_param;
+
+  recorder_create_param.msgq_id.recorder = MSGQ_AUD_RECORDER;
+  recorder_create_param.msgq_id.mng      = MSGQ_AUD_MNG;
+  recorder_create_param.msgq_id.dsp      = MSGQ_AUD_DSP;
+  recorder_create_param.pool_id.input    = S0_INPUT_BUF_POOL;
+  recorder_create_param.pool_id.output   = S0_ES_BUF_POOL;
+  recorder_create_param.pool_id.dsp      = S0_ENC_APU_CMD_POOL;
+
+  if (!AS_CreateMediaRecorder(&recorder_create_param, attention_cb))
+    {
+      return false;
+    }
+
+  AsCreateCaptureParam_t capture_create_param;
+
+  capture_create_param.msgq_id.dev0_req  = MSGQ_AUD_CAP;
+  capture_create_param.msgq_id.dev0_sync = MSGQ_AUD_CAP_SYNC;
+  capture_create_param.msgq_id.dev1_req  = 0xFF;
+  capture_create_param.msgq_id.dev1_sync = 0xFF;
+
+  return AS_CreateCapture(&capture_create_param);
+}
+
+/*--------------------------------------------------------------------------*/
+static void delete_objects(void)
+{
+  AS_DeleteMediaRecorder();
+  AS_DeleteMicFrontend();
+  AS_DeleteCapture();
+}
+
+/*--------------------------------------------------------------------------*/
+static bool activate(void)
+{
+  AsActivateMicFrontend frontend_act;
+
+  frontend_act.param.input_device = AS_SETRECDR_STS_INPUTDEVICE_MIC;
+  frontend_act.cb                 = NULL;
+
+  AS_ActivateMicFrontend(&frontend_act);
+
+  if (!sim_receive_reply(MSG_AUD_MFE_CMD_ACT))
+    {
+      return false;
+    }
+
+  /* The FIFO is initialized again by init_fifo() for each recording. */
+
+  s_fifo_hdlr.simple_fifo_handler = &s_fifo;
+  s_fifo_hdlr.callback_function   = fifo_write_done;
+
+  AsActivateRecorder recorder_act;
+
+  recorder_act.param.input_device          = AS_SETRECDR_STS_INPUTDEVICE_MIC;
+  recorder_act.param.input_device_handler  = 0x00;
+  recorder_act.param.output_device         = AS_SETRECDR_STS_OUTPUTDEVICE_RAM;
+  recorder_act.param.output_device_handler = &s_fifo_hdlr;
+  recorder_act.cb                          = NULL;
+
+  AS_ActivateMediaRecorder(&recorder_act);
+
+  if (!sim_receive_reply(MSG_AUD_MRC_CMD_ACTIVATE))
+    {
+      return false;
+    }
+
+  AsInitMicFrontendParam frontend_init;
+
+  frontend_init.channel_number    = REC_CH_NUM;
+  frontend_init.bit_length        = AS_BITLENGTH_16;
+  frontend_init.samples_per_frame =
+    getCapSampleNumPerFrame(AS_CODECTYPE_LPCM, AS_SAMPLINGRATE_48000);
+  frontend_init.data_path         = AsDataPathMessage;
+  frontend_init.dest.msg.msgqid   = MSGQ_AUD_RECORDER;
+  frontend_init.dest.msg.msgtype  = MSG_AUD_MRC_CMD_ENCODE;
+  frontend_init.preproc_type      = AsMicFrontendPreProcThrough;
+
+  AS_InitMicFrontend(&frontend_init);
+
+  if (!sim_receive_reply(MSG_AUD_MFE_CMD_INIT))
+    {
+      return false;
+    }
+
+  AsInitRecorderParam recorder_init;
+
+  recorder_init.codec_type     = AS_CODECTYPE_LPCM;
+  recorder_init.sampling_rate  = AS_SAMPLINGRATE_48000;
+  recorder_init.channel_number = REC_CH_NUM;
+  recorder_init.bit_length     = AS_BITLENGTH_16;
+  snprintf(recorder_init.dsp_path, AS_AUDIO_DSP_PATH_LEN, "%s", "/sim/BIN");
+
+  AS_InitMediaRecorder(&recorder_init);
+
+  return sim_receive_reply(MSG_AUD_MRC_CMD_INIT);
+}
+
+/*--------------------------------------------------------------------------*/
+static bool deactivate(void)
+{
+  AsDeactivateMicFrontendParam frontend_deact;
+
+  AS_DeactivateMicFrontend(&frontend_deact);
+
+  if (!sim_receive_reply(MSG_AUD_MFE_CMD_DEACT))
+    {
+      return false;
+    }
+
+  AS_DeactivateMediaRecorder();
+
+  return sim_receive_reply(MSG_AUD_MRC_CMD_DEACTIVATE);
+}
+
+/*--------------------------------------------------------------------------*/
+static bool init_fifo(uint32_t seconds)
+{
+  uint32_t size = (seconds + FIFO_MARGIN_SECONDS) * SIM_AUDIO_FS *
+                  REC_SAMPLE_BYTES;
+
+  free(s_fifo_area);
+  s_fifo_area = (uint8_t *)malloc(size);
+
+  return (s_fifo_area != NULL) &&
+         (CMN_SimpleFifoInitialize(&s_fifo, s_fifo_area, size, NULL) == 0);
+}
+
+/*--------------------------------------------------------------------------*/
+static uint32_t check_fifo(void)
+{
+  /* The frames captured before the recorder starts are dropped, the
+   * recording holds all the samples from its first one until it stops.
+   */
+
+  uint32_t first  = 0;
+  uint32_t count  = 0;
+  uint32_t errors = 0;
+  int16_t  buf[REC_CH_NUM * 256];
+  size_t   size;
+
+  while ((size = CMN_SimpleFifoGetOccupiedSize(&s_fifo)) > 0)
+    {
+      if (size > sizeof(buf))
+        {
+          size = sizeof(buf);
+        }
+
+      if (CMN_SimpleFifoPoll(&s_fifo, buf, size) == 0)
+        {
+          TEST_CHECK(false);
+          break;
+        }
+
+      if (count == 0)
+        {
+          first = buf[0] - 1;
+        }
+
+      for (uint32_t i = 0; i < size / sizeof(int16_t); i++, count++)
+        {
+          if (buf[i] != pattern(first + count))
+            {
+              errors++;
+            }
+        }
+    }
+
+  /* Fewer samples than the pattern period are dropped, the first one
+   * recorded is the first of a frame.
+   */
+
+  TEST_CHECK(first % REC_CH_NUM == 0);
+  TEST_CHECK_EQ(errors, 0);
+
+  return count;
+}
+
+/*--------------------------------------------------------------------------*/
+static bool record(uint32_t seconds, uint32_t speed, uint32_t *samples)
+{
+  TEST_CHECK(init_fifo(seconds));
+
+  s_source_count = 0;
+  sim_audio_set_speed(speed);
+
+  AsStartMicFrontendParam frontend_start;
+
+  AS_StartMicFrontend(&frontend_start);
+
+  if (!sim_receive_reply(MSG_AUD_MFE_CMD_START))
+    {
+      return false;
+    }
+
+  AS_StartMediaRecorder();
+
+  if (!sim_receive_reply(MSG_AUD_MRC_CMD_START))
+    {
+      return false;
+    }
+
+  /* Wait for the MIC to capture the whole length, with time to spare for
+   * a loaded host.
+   */
+
+  uint32_t length   = seconds * SIM_AUDIO_FS * REC_CH_NUM;
+  uint64_t deadline = test_now_ns() + (uint64_t)seconds * 1000000000u;
+
+  while (s_source_count < length && test_now_ns() < deadline)
+    {
+      usleep(1000);
+    }
+
+  TEST_CHECK(s_source_count >= length);
+
+  AsStopMicFrontendParam frontend_stop;
+
+  frontend_stop.stop_mode = 0;
+
+  AS_StopMicFrontend(&frontend_stop);
+
+  if (!sim_receive_reply(MSG_AUD_MFE_CMD_STOP))
+    {
+      return false;
+    }
+
+  AS_StopMediaRecorder();
+
+  if (!sim_receive_reply(MSG_AUD_MRC_CMD_STOP))
+    {
+      return false;
+    }
+
+  /* Every sample is recorded, except those captured before the recorder
+   * starts to accept frames.
+   */
+
+  uint32_t count = check_fifo();
+
+  TEST_CHECK(count > 0);
+  TEST_CHECK(count <= s_source_count);
+
+  *samples = count / REC_CH_NUM;
+
+  return true;
+}
+
+/*--------------------------------------------------------------------------*/
+static void test_record(void)
+{
+  uint32_t samples;
+
+  TEST_CHECK(record(CHECK_SECONDS, CHECK_SPEED, &samples));
+  TEST_CHECK_EQ(s_attentions, 0);
+
+  printf("record %us at x%u: %u of %u samples\n",
+         CHECK_SECONDS, CHECK_SPEED, samples, s_source_count / REC_CH_NUM);
+}
+
+/*--------------------------------------------------------------------------*/
+static void bench_record(void)
+{
+  uint32_t samples;
+  uint64_t cpu0 = cpu_now_ns();
+
+  TEST_CHECK(record(BENCH_SECONDS, BENCH_SPEED, &samples));
+
+  uint64_t cpu_ns = cpu_now_ns() - cpu0;
+
+  printf("record %us at x%u: cpu %.1f ms, x%.0f realtime on one CPU\n",
+         BENCH_SECONDS, BENCH_SPEED, cpu_ns / 1e6,
+         (double)samples / SIM_AUDIO_FS * 1e9 / cpu_ns);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  bool dobench = false;
+  int  i;
+
+  for (i = 1; i < argc; i++)
+    {
+      if (strcmp(argv[i], "-b") == 0)
+        {
+          dobench = true;
+        }
+    }
+
+  if (!sim_initialize())
+    {
+      return 1;
+    }
+
+  sim_audio_set_source(source);
+
+  if (create_objects() && activate())
+    {
+      test_record();
+
+      if (dobench)
+        {
+          bench_record();
+        }
+
+      TEST_CHECK(deactivate());
+    }
+  else
+    {
+      TEST_CHECK(false);
+    }
+
+  delete_objects();
+  sim_finalize();
+  free(s_fifo_area);
+
+  return TEST_RESULT("test_sim_recorder");
+}
@@ -33,25 +33,67 @@
  ****************************************************************************/
 
 #include <stdio.h>
+#include <stdarg.h>
+#include <stdbool.h>
 #include <string.h>
+#include <assert.h>
 #include <limits.h>
+#include <semaphore.h>
 #include "runtime_client.h"
 
 #define DNNRT_BINCLONE_WORKER_IMAGE "dnnrt-mp"
 
+#ifdef CONFIG_DNN_RT_MP_PIPELINE
+#  define MAX_MP_INSTANCE MAX_MP_CORE
+#  define MAX_MP_RUNTIME CONFIG_DNN_RT_MP_PIPELINE_RUNTIMES
+#else
+#  define MAX_MP_INSTANCE (1)
+#endif
+
 typedef struct dnn_mptask
 {
   mpmq_t mq;                    /* between nuttx core and target ASMP core */
   int8_t in_use;
+  cpuid_t cpu;                  /* ASMP core assigned to this task */
 } dnn_mptask_t;
 
-typedef struct lib_global_context
+/* An instance of the worker image. Without CONFIG_DNN_RT_MP_PIPELINE,
+ * a single instance runs on all cores and splits forward propagation
+ * among them. With it, each core runs its own single-core instance, and
+ * each dnn_runtime_t is bound to one of them so that forward propagation
+ * of different runtimes (e.g. consecutive frames) runs in parallel.
+ */
+
+typedef struct dnn_mpinst
 {
   mptask_t bin_clone_task;
-  dnn_mptask_t mptask[MAX_MP_CORE];
+  int first_task;               /* index of the master in mptask[] */
+  int task_num;                 /* number of cores running this instance */
+  int rt_num;                   /* number of runtimes bound to this instance */
+  sem_t call_lock;              /* serializes API calls to this instance */
   mp_message_buffer_t msg_buf;  /* messages send from master to library must be 
                                  * placed on Nuttx memory, * so reallocate
                                  * buffer here */
+} dnn_mpinst_t;
+
+#ifdef CONFIG_DNN_RT_MP_PIPELINE
+typedef struct dnn_mprtmap
+{
+  dnn_runtime_t *rt;
+  int inst;
+} dnn_mprtmap_t;
+#endif
+
+typedef struct lib_global_context
+{
+  dnn_mpinst_t inst[MAX_MP_INSTANCE];
+  int inst_num;
+  dnn_mptask_t mptask[MAX_MP_CORE];
+#ifdef CONFIG_DNN_RT_MP_PIPELINE
+  dnn_mprtmap_t rt_map[MAX_MP_RUNTIME];
+#endif
+  sem_t lock;                   /* protects rt_map[] */
+  bool lock_valid;
 } lib_global_context_t;
 
 static lib_global_context_t s_mp_gctx;
@@ -61,6 +103,19 @@ static lib_global_context_t *dnn_mpmgr_global_context(void)
   return &s_mp_gctx;
 }
 
+static void dnn_mpmgr_lock(sem_t * sem)
+{
+  while (sem_wait(sem) < 0)
+    {
+      DEBUGASSERT(errno == EINTR);
+    }
+}
+
+static void dnn_mpmgr_unlock(sem_t * sem)
+{
+  sem_post(sem);
+}
+
 static int dnn_mpmgr_post_msg(dnn_mptask_t * task, int8_t msgid, void *data)
 {
   return mpmq_send(&task->mq, msgid, (uint32_t) data);
@@ -144,18 +199,17 @@ dnn_mpmgr_send_msg(dnn_mptask_t * task, int8_t msgid, void *data, uint32_t ms)
   return 0;
 }
 
-int dnn_mpmgr_call_api(int api, int num_args, ...)
+static int
+dnn_mpmgr_vcall(dnn_mpinst_t * inst, int api, int num_args, va_list vl)
 {
   int i, ret;
   mp_api_call_t api_call;
   lib_global_context_t *ctx = dnn_mpmgr_global_context();
-  dnn_mptask_t *master = &ctx->mptask[0];
-  va_list vl;
+  dnn_mptask_t *master = &ctx->mptask[inst->first_task];
 
   if (!master->in_use)
     {
-      ret = -EPERM;
-      goto bye;
+      return -EPERM;
     }
 
   int max_args = _S(api_call.arg);
@@ -166,59 +220,248 @@ int dnn_mpmgr_call_api(int api, int num_args, ...)
 
   memset(&api_call, 0, sizeof(api_call));
   api_call.api = api;
-  va_start(vl, num_args);
   for (i = 0; i < num_args; ++i)
     {
       api_call.arg[i] = va_arg(vl, int);
     }
 
+  dnn_mpmgr_lock(&inst->call_lock);
+
   ret = dnn_mpmgr_send_msg(master, MP_MSG_CALL_API, &api_call, 0);
-  if (ret)
+  if (ret == 0)
     {
-      goto bye;
+      ret = api_call.ret;
     }
-  ret = api_call.ret;
-bye:
+
+  dnn_mpmgr_unlock(&inst->call_lock);
+
   return ret;
 }
 
-static int dnn_mpmgr_start_task(lib_global_context_t * ctx, int slave_num)
+int dnn_mpmgr_call_api(int api, int num_args, ...)
 {
+  int ret;
+  va_list vl;
+  lib_global_context_t *ctx = dnn_mpmgr_global_context();
+
+  va_start(vl, num_args);
+  ret = dnn_mpmgr_vcall(&ctx->inst[0], api, num_args, vl);
+  va_end(vl);
+
+  return ret;
+}
+
+int dnn_mpmgr_call_api_all(int api, int num_args, ...)
+{
+  int i, ret;
+  va_list vl;
+  lib_global_context_t *ctx = dnn_mpmgr_global_context();
+
+  if (ctx->inst_num == 0)
+    {
+      return -EPERM;
+    }
+
+  for (i = 0; i < ctx->inst_num; ++i)
+    {
+      va_start(vl, num_args);
+      ret = dnn_mpmgr_vcall(&ctx->inst[i], api, num_args, vl);
+      va_end(vl);
+      if (ret != 0)
+        {
+          break;
+        }
+    }
+
+  return ret;
+}
+
+int dnn_mpmgr_instance_num(void)
+{
+  return dnn_mpmgr_global_context()->inst_num;
+}
+
+int dnn_mpmgr_call_api_on(int index, int api, int num_args, ...)
+{
+  int ret;
+  va_list vl;
+  lib_global_context_t *ctx = dnn_mpmgr_global_context();
+
+  if (index < 0 || index >= ctx->inst_num)
+    {
+      return -EINVAL;
+    }
+
+  va_start(vl, num_args);
+  ret = dnn_mpmgr_vcall(&ctx->inst[index], api, num_args, vl);
+  va_end(vl);
+
+  return ret;
+}
+
+#ifdef CONFIG_DNN_RT_MP_PIPELINE
+static dnn_mprtmap_t *dnn_mpmgr_find_rt(lib_global_context_t * ctx,
+                                        dnn_runtime_t * rt)
+{
+  int i;
+
+  for (i = 0; i < MAX_MP_RUNTIME; ++i)
+    {
+      if (ctx->rt_map[i].rt == rt)
+        {
+          return &ctx->rt_map[i];
+        }
+    }
+
+  return NULL;
+}
+#endif
+
+static dnn_mpinst_t *dnn_mpmgr_rt_instance(dnn_runtime_t * rt)
+{
+  lib_global_context_t *ctx = dnn_mpmgr_global_context();
+#ifdef CONFIG_DNN_RT_MP_PIPELINE
+  dnn_mprtmap_t *map;
+  dnn_mpinst_t *inst = NULL;
+
+  dnn_mpmgr_lock(&ctx->lock);
+  map = dnn_mpmgr_find_rt(ctx, rt);
+  if (map)
+    {
+      inst = &ctx->inst[map->inst];
+    }
+  dnn_mpmgr_unlock(&ctx->lock);
+
+  return inst;
+#else
+  return &ctx->inst[0];
+#endif
+}
+
+int dnn_mpmgr_bind_rt(dnn_runtime_t * rt)
+{
+#ifdef CONFIG_DNN_RT_MP_PIPELINE
   int i, ret = 0;
-  cpu_set_t cpu_set;
+  lib_global_context_t *ctx = dnn_mpmgr_global_context();
+  dnn_mprtmap_t *map;
 
-  /* already initialized? */
-  if (ctx->mptask[0].in_use)
+  if (ctx->inst_num == 0)
     {
-      ret = -EPERM;
+      return -EPERM;
+    }
+
+  dnn_mpmgr_lock(&ctx->lock);
+
+  if (dnn_mpmgr_find_rt(ctx, rt))
+    {
+      ret = -EBUSY;
+      goto bye;
+    }
+
+  map = dnn_mpmgr_find_rt(ctx, NULL);
+  if (!map)
+    {
+      ret = -ENOMEM;
       goto bye;
     }
 
+  /* the instance with the fewest runtimes takes the new one */
+  map->rt = rt;
+  map->inst = 0;
+  for (i = 1; i < ctx->inst_num; ++i)
+    {
+      if (ctx->inst[i].rt_num < ctx->inst[map->inst].rt_num)
+        {
+          map->inst = i;
+        }
+    }
+  ctx->inst[map->inst].rt_num++;
+
+bye:
+  dnn_mpmgr_unlock(&ctx->lock);
+  return ret;
+#else
+  return 0;
+#endif
+}
+
+void dnn_mpmgr_unbind_rt(dnn_runtime_t * rt)
+{
+#ifdef CONFIG_DNN_RT_MP_PIPELINE
+  lib_global_context_t *ctx = dnn_mpmgr_global_context();
+  dnn_mprtmap_t *map;
+
+  if (rt == NULL || ctx->inst_num == 0)
+    {
+      return;
+    }
+
+  dnn_mpmgr_lock(&ctx->lock);
+  map = dnn_mpmgr_find_rt(ctx, rt);
+  if (map)
+    {
+      ctx->inst[map->inst].rt_num--;
+      map->rt = NULL;
+    }
+  dnn_mpmgr_unlock(&ctx->lock);
+#endif
+}
+
+int dnn_mpmgr_call_rt_api(dnn_runtime_t * rt, int api, int num_args, ...)
+{
+  int ret;
+  va_list vl;
+  dnn_mpinst_t *inst = dnn_mpmgr_rt_instance(rt);
+
+  if (!inst)
+    {
+      return -EINVAL;
+    }
+
+  va_start(vl, num_args);
+  ret = dnn_mpmgr_vcall(inst, api, num_args, vl);
+  va_end(vl);
+
+  return ret;
+}
+
+static int
+dnn_mpmgr_start_inst(lib_global_context_t * ctx, dnn_mpinst_t * inst,
+                     int first_task, int core_num)
+{
+  int i, ret = 0;
+  cpu_set_t cpu_set;
+
+  inst->first_task = first_task;
+  inst->task_num = core_num;
+  sem_init(&inst->call_lock, 0, 1);
+
   /* init mptask and message queue */
-  ret = mptask_init_secure(&ctx->bin_clone_task, DNNRT_BINCLONE_WORKER_IMAGE);
+  ret = mptask_init_secure(&inst->bin_clone_task, DNNRT_BINCLONE_WORKER_IMAGE);
   if (ret < 0)
     {
       goto bye;
     }
 
-  ret = mptask_assign_cpus(&ctx->bin_clone_task, slave_num + 1);
+  ret = mptask_assign_cpus(&inst->bin_clone_task, core_num);
   if (ret < 0)
     {
       goto bye;
     }
 
-  ret = mptask_getcpuidset(&ctx->bin_clone_task, &cpu_set);
+  ret = mptask_getcpuidset(&inst->bin_clone_task, &cpu_set);
   if (ret < 0)
     {
       goto bye;
     }
 
-  int task_idx = 0;
+  int task_idx = first_task;
   int cpuid;
   for (cpuid = 0; cpuid < MP_CPUID_MAX; ++cpuid)
     {
       if ((1 << cpuid) & cpu_set)
         {
+          ctx->mptask[task_idx].cpu = cpuid;
           ret = mpmq_init(&ctx->mptask[task_idx++].mq, MP_MQ_KEY, cpuid);
           if (ret < 0)
             {
@@ -227,31 +470,31 @@ static int dnn_mpmgr_start_task(lib_global_context_t * ctx, int slave_num)
         }
     }
 
-  ret = mptask_exec(&ctx->bin_clone_task);
+  ret = mptask_exec(&inst->bin_clone_task);
   if (ret < 0)
     {
       goto bye;
     }
 
   /* initialize each worker */
-  for (i = 0; i < (slave_num + 1); ++i)
+  for (i = 0; i < core_num; ++i)
     {
-      dnn_mptask_t *task = &ctx->mptask[i];
+      dnn_mptask_t *task = &ctx->mptask[first_task + i];
 
       mp_task_init_t init = {
         .cpu_set = cpu_set,
         .load_addr = 0,
-        .msg_buf = &ctx->msg_buf,
+        .msg_buf = &inst->msg_buf,
         .ret = 0,
       };
 
-      if (slave_num == 0)
+      if (core_num == 1)
         {
-          init.load_addr = (void *)ctx->bin_clone_task.loadaddr;
+          init.load_addr = (void *)inst->bin_clone_task.loadaddr;
         }
       else
         {
-          init.load_addr = (void *)ctx->bin_clone_task.bin[i].loadaddr;
+          init.load_addr = (void *)inst->bin_clone_task.bin[i].loadaddr;
         }
 
       ret = dnn_mpmgr_send_msg(task, MP_MSG_INIT, &init, 0);
@@ -265,6 +508,46 @@ static int dnn_mpmgr_start_task(lib_global_context_t * ctx, int slave_num)
         }
       task->in_use = true;
     }
+
+bye:
+  return ret;
+}
+
+static int dnn_mpmgr_start_task(lib_global_context_t * ctx, int slave_num)
+{
+  int ret = 0;
+
+  /* already initialized? */
+  if (ctx->inst_num > 0)
+    {
+      ret = -EPERM;
+      goto bye;
+    }
+
+  sem_init(&ctx->lock, 0, 1);
+  ctx->lock_valid = true;
+
+#ifdef CONFIG_DNN_RT_MP_PIPELINE
+  /* one single-core instance for each core */
+  int i;
+  for (i = 0; i < (slave_num + 1); ++i)
+    {
+      ctx->inst_num++;
+      ret = dnn_mpmgr_start_inst(ctx, &ctx->inst[i], i, 1);
+      if (ret < 0)
+        {
+          goto bye;
+        }
+    }
+#else
+  ctx->inst_num = 1;
+  ret = dnn_mpmgr_start_inst(ctx, &ctx->inst[0], 0, slave_num + 1);
+  if (ret < 0)
+    {
+      goto bye;
+    }
+#endif
+
 bye:
   return ret;
 }
@@ -274,7 +557,7 @@ int dnn_mpmgr_load(int slave_num)
   int ret;
   lib_global_context_t *ctx = dnn_mpmgr_global_context();
 
-  if (MAX_MP_CORE == 0)
+  if (MAX_MP_CORE == 0 || slave_num + 1 > MAX_MP_CORE)
     {
       ret = -ENOMEM;
       goto bye;
@@ -292,7 +575,7 @@ bye:
 
 int dnn_mpmgr_unload(void)
 {
-  int i;
+  int i, ret = 0;
   lib_global_context_t *ctx = dnn_mpmgr_global_context();
 
   for (i = 0; i < MAX_MP_CORE; ++i)
@@ -307,5 +590,29 @@ int dnn_mpmgr_unload(void)
       memset(task, 0, sizeof(*task));
     }
 
-  return mptask_destroy(&ctx->bin_clone_task, true /* force */ , 0);
+  for (i = 0; i < ctx->inst_num; ++i)
+    {
+      dnn_mpinst_t *inst = &ctx->inst[i];
+      int r = mptask_destroy(&inst->bin_clone_task, true /* force */ , 0);
+
+      if (ret == 0)
+        {
+          ret = r;
+        }
+      sem_destroy(&inst->call_lock);
+      memset(inst, 0, sizeof(*inst));
+    }
+  ctx->inst_num = 0;
+
+#ifdef CONFIG_DNN_RT_MP_PIPELINE
+  memset(ctx->rt_map, 0, sizeof(ctx->rt_map));
+#endif
+
+  if (ctx->lock_valid)
+    {
+      sem_destroy(&ctx->lock);
+      ctx->lock_valid = false;
+    }
+
+  return ret;
 }
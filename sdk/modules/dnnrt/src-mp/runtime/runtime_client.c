@@ -57,14 +57,21 @@ int dnn_initialize(dnn_config_t * config)
       return -EBUSY;
     }
 
-  return dnn_mpmgr_call_api(DNNRT_API_INIT, 1, config);
+#ifdef CONFIG_DNN_RT_MP_PIPELINE
+  /* each core runs a single-core instance */
+  cfg = *config;
+  cfg.cpu_num = 1;
+  config = &cfg;
+#endif
+
+  return dnn_mpmgr_call_api_all(DNNRT_API_INIT, 1, config);
 }
 
 int dnn_finalize(void)
 {
   int ret;
 
-  ret = dnn_mpmgr_call_api(DNNRT_API_FINI, 0);
+  ret = dnn_mpmgr_call_api_all(DNNRT_API_FINI, 0);
   if (ret != RT_RET_NOERROR)
     {
       return ret;
@@ -75,91 +82,145 @@ int dnn_finalize(void)
 
 int dnn_runtime_initialize(dnn_runtime_t * rt, const nn_network_t * network)
 {
-  return dnn_mpmgr_call_api(DNNRT_API_RT_INIT, 2, rt, network);
+  int ret;
+
+  ret = dnn_mpmgr_bind_rt(rt);
+  if (ret != RT_RET_NOERROR)
+    {
+      return ret;
+    }
+
+  ret = dnn_mpmgr_call_rt_api(rt, DNNRT_API_RT_INIT, 2, rt, network);
+  if (ret != RT_RET_NOERROR)
+    {
+      dnn_mpmgr_unbind_rt(rt);
+    }
+
+  return ret;
 }
 
 int dnn_runtime_finalize(dnn_runtime_t * rt)
 {
-  return dnn_mpmgr_call_api(DNNRT_API_RT_FINI, 1, rt);
+  int ret;
+
+  ret = dnn_mpmgr_call_rt_api(rt, DNNRT_API_RT_FINI, 1, rt);
+  dnn_mpmgr_unbind_rt(rt);
+
+  return ret;
 }
 
 int
 dnn_runtime_forward(dnn_runtime_t * rt, const void *inputs[],
                     unsigned char input_num)
 {
-  return dnn_mpmgr_call_api(DNNRT_API_RT_FOWARD, 3, rt, inputs, input_num);
+  return dnn_mpmgr_call_rt_api(rt, DNNRT_API_RT_FOWARD, 3, rt, inputs,
+                               input_num);
 }
 
 int dnn_runtime_input_num(dnn_runtime_t * rt)
 {
-  return dnn_mpmgr_call_api(DNNRT_API_RT_INPUT_NUM, 1, rt);
+  return dnn_mpmgr_call_rt_api(rt, DNNRT_API_RT_INPUT_NUM, 1, rt);
 }
 
 int dnn_runtime_input_size(dnn_runtime_t * rt, unsigned char data_index)
 {
-  return dnn_mpmgr_call_api(DNNRT_API_RT_INPUT_SIZE, 2, rt, data_index);
+  return dnn_mpmgr_call_rt_api(rt, DNNRT_API_RT_INPUT_SIZE, 2, rt,
+                               data_index);
 }
 
 int dnn_runtime_input_ndim(dnn_runtime_t * rt, unsigned char data_index)
 {
-  return dnn_mpmgr_call_api(DNNRT_API_RT_INPUT_NDIM, 2, rt, data_index);
+  return dnn_mpmgr_call_rt_api(rt, DNNRT_API_RT_INPUT_NDIM, 2, rt,
+                               data_index);
 }
 
 int
 dnn_runtime_input_shape(dnn_runtime_t * rt, unsigned char data_index,
                         unsigned char dim_index)
 {
-  return dnn_mpmgr_call_api(DNNRT_API_RT_INPUT_SHAPE, 3, rt, data_index,
-                            dim_index);
+  return dnn_mpmgr_call_rt_api(rt, DNNRT_API_RT_INPUT_SHAPE, 3, rt,
+                               data_index, dim_index);
 }
 
 nn_variable_t *dnn_runtime_input_variable(dnn_runtime_t * rt,
                                           unsigned char data_index)
 {
-  return (nn_variable_t *) dnn_mpmgr_call_api(DNNRT_API_RT_INPUT_VARIABLE, 2,
-                                              rt, data_index);
+  return (nn_variable_t *) dnn_mpmgr_call_rt_api(rt,
+                                                 DNNRT_API_RT_INPUT_VARIABLE,
+                                                 2, rt, data_index);
 }
 
 int dnn_runtime_output_num(dnn_runtime_t * rt)
 {
-  return dnn_mpmgr_call_api(DNNRT_API_RT_OUTPUT_NUM, 1, rt);
+  return dnn_mpmgr_call_rt_api(rt, DNNRT_API_RT_OUTPUT_NUM, 1, rt);
 }
 
 int dnn_runtime_output_size(dnn_runtime_t * rt, unsigned char data_index)
 {
-  return dnn_mpmgr_call_api(DNNRT_API_RT_OUTPUT_SIZE, 2, rt, data_index);
+  return dnn_mpmgr_call_rt_api(rt, DNNRT_API_RT_OUTPUT_SIZE, 2, rt,
+                               data_index);
 }
 
 int dnn_runtime_output_ndim(dnn_runtime_t * rt, unsigned char data_index)
 {
-  return dnn_mpmgr_call_api(DNNRT_API_RT_OUTPUT_NDIM, 2, rt, data_index);
+  return dnn_mpmgr_call_rt_api(rt, DNNRT_API_RT_OUTPUT_NDIM, 2, rt,
+                               data_index);
 }
 
 int
 dnn_runtime_output_shape(dnn_runtime_t * rt, unsigned char data_index,
                          unsigned char dim_index)
 {
-  return dnn_mpmgr_call_api(DNNRT_API_RT_OUTPUT_SHAPE, 3, rt, data_index,
-                            dim_index);
+  return dnn_mpmgr_call_rt_api(rt, DNNRT_API_RT_OUTPUT_SHAPE, 3, rt,
+                               data_index, dim_index);
 }
 
 void *dnn_runtime_output_buffer(dnn_runtime_t * rt, unsigned char data_index)
 {
-  return (void *)dnn_mpmgr_call_api(DNNRT_API_RT_OUTPUT_BUFFER, 2, rt,
-                                    data_index);
+  return (void *)dnn_mpmgr_call_rt_api(rt, DNNRT_API_RT_OUTPUT_BUFFER, 2, rt,
+                                       data_index);
 }
 
 nn_variable_t *dnn_runtime_output_variable(dnn_runtime_t * rt,
                                            unsigned char data_index)
 {
-  return (nn_variable_t *) dnn_mpmgr_call_api(DNNRT_API_RT_OUTPUT_VARIABLE, 2,
-                                              rt, data_index);
+  return (nn_variable_t *) dnn_mpmgr_call_rt_api(rt,
+                                                 DNNRT_API_RT_OUTPUT_VARIABLE,
+                                                 2, rt, data_index);
 }
 
 int dnn_asmp_mallinfo(unsigned char array_length, dnn_mallinfo_t * info_array)
 {
+#ifdef CONFIG_DNN_RT_MP_PIPELINE
+  int i, ret = -EPERM;
+
+  /* each instance reports its own core */
+  for (i = 0; i < array_length && i < dnn_mpmgr_instance_num(); ++i)
+    {
+      ret = dnn_mpmgr_call_api_on(i, DNNRT_API_ASMP_MALLINFO, 2, 1,
+                                  &info_array[i]);
+      if (ret != RT_RET_NOERROR)
+        {
+          break;
+        }
+    }
+
+  return ret;
+#else
   return dnn_mpmgr_call_api(DNNRT_API_ASMP_MALLINFO, 2, array_length,
                             info_array);
+#endif
+}
+
+int dnn_runtime_get_profile(dnn_runtime_t * rt, dnn_layer_profile_t * profile,
+                            unsigned short length)
+{
+  return -EPERM;
+}
+
+int dnn_runtime_dump_profile(dnn_runtime_t * rt, FILE * stream, int format)
+{
+  return -EPERM;
 }
 
 int dnn_nuttx_mallinfo(dnn_mallinfo_t * info)
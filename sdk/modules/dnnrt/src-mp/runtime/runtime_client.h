@@ -144,6 +144,17 @@ extern "C"
   int dnn_mpmgr_call_api(int api, int num_args, ...);   /* send API call *
                                                          * request */
 
+  /* With CONFIG_DNN_RT_MP_PIPELINE, each core runs its own instance of the
+   * worker image and each dnn_runtime_t is bound to one instance.
+   * Otherwise there is one instance and these go to its master.
+   */
+  int dnn_mpmgr_instance_num(void);
+  int dnn_mpmgr_call_api_all(int api, int num_args, ...);
+  int dnn_mpmgr_call_api_on(int index, int api, int num_args, ...);
+  int dnn_mpmgr_bind_rt(dnn_runtime_t * rt);
+  void dnn_mpmgr_unbind_rt(dnn_runtime_t * rt);
+  int dnn_mpmgr_call_rt_api(dnn_runtime_t * rt, int api, int num_args, ...);
+
 #  ifdef __cplusplus
 }
 #  endif
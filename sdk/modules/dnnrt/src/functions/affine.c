@@ -305,6 +305,28 @@ rt_function_error_t dnnrt_exec_affine(rt_function_t * f)
   return dnnrt_exec_affine_generic(f);
 }
 
+static rt_function_error_t dnnrt_exec_affine_relu(rt_function_t * f)
+{
+  rt_function_error_t ret = dnnrt_exec_affine(f);
+
+  if (ret == RT_FUNCTION_ERROR_NOERROR)
+    {
+      dnn_relu_variable(f->outputs[Y]);
+    }
+  return ret;
+}
+
+/* let the affine apply ReLU to its own output */
+int dnnrt_affine_fuse_relu(rt_function_t * f)
+{
+  if (f->exec_func != dnnrt_exec_affine)
+    {
+      return -EPERM;
+    }
+  f->exec_func = dnnrt_exec_affine_relu;
+  return RT_RET_NOERROR;
+}
+
 rt_return_value_t dnnrt_affine_alloc(nn_network_t * net, void *function_context)
 {
   rt_function_context_t *func = (rt_function_context_t *) function_context;
@@ -330,6 +352,6 @@ rt_return_value_t dnnrt_affine_alloc(nn_network_t * net, void *function_context)
       scratch_buf_bsize = sizeof(q15_t) * p->input_loop_size;
     }
 
-  dnn_req_scratch_buf(scratch_buf_bsize);
+  dnn_req_scratch_buf(function_context, scratch_buf_bsize);
   return RT_RET_FUNCTION_MATCH;
 }
@@ -44,6 +44,7 @@
 #include <runtime_internal.h>
 #include <utilities/shape.h>
 #include <arm_nnfunctions_nnabla.h>
+#include "convolution_kernels.h"
 
 #define _S(p) (sizeof(p) / sizeof(p[0]))
 #define X (0)                   // x input
@@ -54,6 +55,8 @@
 typedef int16_t fixed16_t;
 typedef int8_t fixed8_t;
 
+typedef rt_function_error_t(*dnnrt_exec_func_t) (rt_function_t * f);
+
 /*
  * group (g) [default 1]: If g > 1, we restrict the connectivity of each filter
  * to a subset of the input. Specifically, the input and output channels are
@@ -249,6 +252,168 @@ static rt_function_error_t dnnrt_exec_convolution_float(rt_function_t * f)
   return RT_FUNCTION_ERROR_NOERROR;
 }
 
+static inline void dnnrt_conv_get_geom(convolution_local_context_t * c,
+                                       convolution_private_t * p,
+                                       dnnrt_conv_geom_t * g)
+{
+  g->in_w = p->in_var.shape.data[W];
+  g->in_h = p->in_var.shape.data[H];
+  g->out_w = p->out_var.shape.data[W];
+  g->out_h = p->out_var.shape.data[H];
+  g->pad_x = c->pad.data[1];
+  g->pad_y = c->pad.data[0];
+  g->stride_x = c->stride.data[1];
+  g->stride_y = c->stride.data[0];
+}
+
+/* depthwise 3x3 convolution: one input and one output channel per group */
+static rt_function_error_t dnnrt_convolution_depthwise(rt_function_t * f,
+                                                       int relu)
+{
+  convolution_local_context_t *c =
+    (convolution_local_context_t *) f->local_context;
+  convolution_private_t ctx_copy;
+  ctx_copy = *(convolution_private_t *) (c->data);
+  convolution_private_t *p = &ctx_copy;
+  var_t *out_var = &p->out_var;
+  var_t *in_var = &p->in_var;
+  var_t *w_var = &p->w_var;
+  var_t *b_var = &p->b_var;
+  uint16_t out_shift =
+    in_var->v->fp_pos + w_var->v->fp_pos - out_var->v->fp_pos;
+  uint16_t bias_shift = 0;
+  nn_size_t b;
+  dnnrt_conv_geom_t g;
+
+  dnnrt_conv_get_geom(c, p, &g);
+  if (b_var->v)
+    {
+      bias_shift = in_var->v->fp_pos + w_var->v->fp_pos - b_var->v->fp_pos;
+    }
+
+  for (b = 0; b < in_var->shape.data[0]; ++b)
+    {
+      int i_pos[] = { b, 0, 0 };
+      int o_pos[] = { b, 0, 0 };
+      var_setpos(in_var, i_pos, _S(i_pos));
+      var_setpos(out_var, o_pos, _S(o_pos));
+
+      if (f->inputs[X]->type == NN_DATA_TYPE_INT16)
+        {
+          dnnrt_depthwise_conv3x3_q15((q15_t *) in_var->v->data +
+                                      in_var->offset,
+                                      in_var->stride.data[1],
+                                      (q15_t *) w_var->v->data,
+                                      b_var->v ? (q15_t *) b_var->v->data :
+                                      NULL, bias_shift, out_shift,
+                                      (q15_t *) out_var->v->data +
+                                      out_var->offset,
+                                      out_var->stride.data[1], c->group,
+                                      &g, relu);
+        }
+      else
+        {
+          dnnrt_depthwise_conv3x3_q7((q7_t *) in_var->v->data +
+                                     in_var->offset,
+                                     in_var->stride.data[1],
+                                     (q7_t *) w_var->v->data,
+                                     b_var->v ? (q7_t *) b_var->v->data :
+                                     NULL, bias_shift, out_shift,
+                                     (q7_t *) out_var->v->data +
+                                     out_var->offset,
+                                     out_var->stride.data[1], c->group,
+                                     &g, relu);
+        }
+    }
+
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+/* pointwise convolution: single group, 1x1 kernel, stride 1, no padding */
+static rt_function_error_t dnnrt_convolution_pointwise(rt_function_t * f,
+                                                       int relu)
+{
+  convolution_local_context_t *c =
+    (convolution_local_context_t *) f->local_context;
+  convolution_private_t ctx_copy;
+  ctx_copy = *(convolution_private_t *) (c->data);
+  convolution_private_t *p = &ctx_copy;
+  var_t *out_var = &p->out_var;
+  var_t *in_var = &p->in_var;
+  var_t *w_var = &p->w_var;
+  var_t *b_var = &p->b_var;
+  uint16_t out_shift =
+    in_var->v->fp_pos + w_var->v->fp_pos - out_var->v->fp_pos;
+  uint16_t bias_shift = 0;
+  int pixels = in_var->shape.data[H] * in_var->shape.data[W];
+  q31_t *acc = (q31_t *) dnn_scratch_buf();
+  nn_size_t b;
+
+  if (b_var->v)
+    {
+      bias_shift = in_var->v->fp_pos + w_var->v->fp_pos - b_var->v->fp_pos;
+    }
+
+  for (b = 0; b < in_var->shape.data[0]; ++b)
+    {
+      int i_pos[] = { b, 0, 0 };
+      int o_pos[] = { b, 0, 0 };
+      var_setpos(in_var, i_pos, _S(i_pos));
+      var_setpos(out_var, o_pos, _S(o_pos));
+
+      if (f->inputs[X]->type == NN_DATA_TYPE_INT16)
+        {
+          dnnrt_pointwise_conv_q15((q15_t *) in_var->v->data +
+                                   in_var->offset, in_var->stride.data[2],
+                                   in_var->shape.data[I],
+                                   (q15_t *) w_var->v->data,
+                                   b_var->v ? (q15_t *) b_var->v->data :
+                                   NULL, bias_shift, out_shift,
+                                   (q15_t *) out_var->v->data +
+                                   out_var->offset, out_var->stride.data[2],
+                                   out_var->shape.data[I], pixels, acc,
+                                   relu);
+        }
+      else
+        {
+          dnnrt_pointwise_conv_q7((q7_t *) in_var->v->data +
+                                  in_var->offset, in_var->stride.data[2],
+                                  in_var->shape.data[I],
+                                  (q7_t *) w_var->v->data,
+                                  b_var->v ? (q7_t *) b_var->v->data :
+                                  NULL, bias_shift, out_shift,
+                                  (q7_t *) out_var->v->data +
+                                  out_var->offset, out_var->stride.data[2],
+                                  out_var->shape.data[I], pixels, acc,
+                                  relu);
+        }
+    }
+
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+static rt_function_error_t dnnrt_exec_convolution_depthwise(rt_function_t * f)
+{
+  return dnnrt_convolution_depthwise(f, 0);
+}
+
+static rt_function_error_t
+dnnrt_exec_convolution_depthwise_relu(rt_function_t * f)
+{
+  return dnnrt_convolution_depthwise(f, 1);
+}
+
+static rt_function_error_t dnnrt_exec_convolution_pointwise(rt_function_t * f)
+{
+  return dnnrt_convolution_pointwise(f, 0);
+}
+
+static rt_function_error_t
+dnnrt_exec_convolution_pointwise_relu(rt_function_t * f)
+{
+  return dnnrt_convolution_pointwise(f, 1);
+}
+
 static int var_buf_size(rt_variable_t * var)
 {
   int elem_size = 0;
@@ -292,6 +457,43 @@ rt_function_error_t dnnrt_exec_convolution(rt_function_t * f)
     }
 }
 
+static rt_function_error_t dnnrt_exec_convolution_relu(rt_function_t * f)
+{
+  rt_function_error_t ret = dnnrt_exec_convolution(f);
+
+  if (ret == RT_FUNCTION_ERROR_NOERROR)
+    {
+      dnn_relu_variable(f->outputs[Y0]);
+    }
+  return ret;
+}
+
+/*
+ * let the convolution apply ReLU to its own output, so that a following
+ * ReLU function can be removed. The specialized kernels clamp each output
+ * element when it's stored.
+ */
+int dnnrt_convolution_fuse_relu(rt_function_t * f)
+{
+  if (f->exec_func == dnnrt_exec_convolution_depthwise)
+    {
+      f->exec_func = dnnrt_exec_convolution_depthwise_relu;
+    }
+  else if (f->exec_func == dnnrt_exec_convolution_pointwise)
+    {
+      f->exec_func = dnnrt_exec_convolution_pointwise_relu;
+    }
+  else if (f->exec_func == dnnrt_exec_convolution)
+    {
+      f->exec_func = dnnrt_exec_convolution_relu;
+    }
+  else
+    {
+      return -EPERM;
+    }
+  return RT_RET_NOERROR;
+}
+
 static inline int validate_params(rt_function_t * f, int *scratch_buf_bsize)
 {
   convolution_local_context_t *c;
@@ -338,6 +540,44 @@ static inline int validate_params(rt_function_t * f, int *scratch_buf_bsize)
   return cond1 || cond2 || cond3;
 }
 
+/*
+ * select a specialized kernel for fixed-point depthwise 3x3 and pointwise
+ * 1x1 convolutions. These kernels overwrite every output element, so they
+ * don't need the output to be cleared before execution.
+ */
+static dnnrt_exec_func_t select_exec_func(rt_function_t * f,
+                                          int *scratch_buf_bsize)
+{
+  convolution_local_context_t *c;
+  c = (convolution_local_context_t *) f->local_context;
+  convolution_private_t *p = (convolution_private_t *) (c->data);
+
+  if (f->inputs[X]->type == NN_DATA_TYPE_FLOAT)
+    {
+      return dnnrt_exec_convolution;
+    }
+
+  if (c->group > 1 && p->in_var.shape.data[I] == 1 &&
+      p->out_var.shape.data[I] == 1 &&
+      p->kernel_shape.data[0] == 3 && p->kernel_shape.data[1] == 3)
+    {
+      *scratch_buf_bsize = 0;
+      return dnnrt_exec_convolution_depthwise;
+    }
+
+  if (c->group == 1 &&
+      p->kernel_shape.data[0] == 1 && p->kernel_shape.data[1] == 1 &&
+      c->stride.data[0] == 1 && c->stride.data[1] == 1 &&
+      c->pad.data[0] == 0 && c->pad.data[1] == 0)
+    {
+      *scratch_buf_bsize = sizeof(q31_t) * p->in_var.shape.data[H] *
+        p->in_var.shape.data[W];
+      return dnnrt_exec_convolution_pointwise;
+    }
+
+  return dnnrt_exec_convolution;
+}
+
 rt_return_value_t
 dnnrt_convolution_alloc(nn_network_t * net, void *function_context)
 {
@@ -357,8 +597,8 @@ dnnrt_convolution_alloc(nn_network_t * net, void *function_context)
       return RT_RET_FUNCTION_MATCH;
     }
 
-  func->func.exec_func = dnnrt_exec_convolution;
+  func->func.exec_func = select_exec_func(&func->func, &scratch_buf_bsize);
 
-  dnn_req_scratch_buf(scratch_buf_bsize);
+  dnn_req_scratch_buf(function_context, scratch_buf_bsize);
   return RT_RET_FUNCTION_MATCH;
 }
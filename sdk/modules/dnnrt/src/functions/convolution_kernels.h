@@ -0,0 +1,203 @@
+/****************************************************************************
+ * modules/dnnrt/src/functions/convolution_kernels.h
+ *
+ *   Copyright 2018 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef CONVOLUTION_KERNELS_H
+#  define CONVOLUTION_KERNELS_H
+
+#  include <stdint.h>
+#  include <nnablart/functions.h>
+#  include <arm_nnfunctions_nnabla.h>
+
+/* The kernels below are static, convolution.c is their only user in the
+ * runtime and test/ checks them against CMSIS-NN on the host.  Results are
+ * bit-exact with arm_convolve_CHW_q7/q15_basic_nonsquare, which the generic
+ * path calls: the rounding offset is added along with the bias only.
+ */
+
+#  ifndef NN_ROUND
+#    define NN_ROUND(out_shift) ((0x1u << (out_shift)) >> 1)
+#  endif
+
+/* geometry of a single input/output channel plane */
+typedef struct dnnrt_conv_geom
+{
+  int in_w;
+  int in_h;
+  int out_w;
+  int out_h;
+  int pad_x;
+  int pad_y;
+  int stride_x;
+  int stride_y;
+} dnnrt_conv_geom_t;
+
+static inline q31_t dnnrt_conv_saturate(q31_t sum, int bits, int relu)
+{
+  q31_t max = (1 << (bits - 1)) - 1;
+  q31_t min = relu ? 0 : -max - 1;
+
+  return sum > max ? max : (sum < min ? min : sum);
+}
+
+/*
+ * depthwise 3x3 convolution on CHW layout, where each output channel is
+ * connected to the input channel of the same index only.
+ * The window is computed without bounds checks when it's entirely inside
+ * the input plane, and with zero-padding otherwise.
+ */
+#define DNNRT_DEFINE_DEPTHWISE3X3(name, type, bits)                           \
+static void name(const type * in, nn_size_t in_ch_stride,                     \
+                 const type * wt, const type * bias,                          \
+                 uint16_t bias_shift, uint16_t out_shift,                     \
+                 type * out, nn_size_t out_ch_stride, int ch,                 \
+                 const dnnrt_conv_geom_t * g, int relu)                       \
+{                                                                             \
+  int c, ox, oy, kx, ky, ix, iy;                                              \
+  q31_t sum, init;                                                            \
+                                                                              \
+  for (c = 0; c < ch; c++)                                                    \
+    {                                                                         \
+      const type *plane = in + c * in_ch_stride;                              \
+      const type *w = wt + c * 9;                                             \
+      type *dst = out + c * out_ch_stride;                                    \
+                                                                              \
+      init = 0;                                                               \
+      if (bias)                                                               \
+        {                                                                     \
+          init = ((q31_t) bias[c] << bias_shift) + NN_ROUND(out_shift);       \
+        }                                                                     \
+                                                                              \
+      for (oy = 0; oy < g->out_h; oy++)                                       \
+        {                                                                     \
+          iy = oy * g->stride_y - g->pad_y;                                   \
+          for (ox = 0; ox < g->out_w; ox++)                                   \
+            {                                                                 \
+              ix = ox * g->stride_x - g->pad_x;                               \
+              sum = init;                                                     \
+              if (ix >= 0 && iy >= 0 &&                                       \
+                  ix + 3 <= g->in_w && iy + 3 <= g->in_h)                     \
+                {                                                             \
+                  const type *r0 = plane + iy * g->in_w + ix;                 \
+                  const type *r1 = r0 + g->in_w;                              \
+                  const type *r2 = r1 + g->in_w;                              \
+                  sum += r0[0] * w[0] + r0[1] * w[1] + r0[2] * w[2];          \
+                  sum += r1[0] * w[3] + r1[1] * w[4] + r1[2] * w[5];          \
+                  sum += r2[0] * w[6] + r2[1] * w[7] + r2[2] * w[8];          \
+                }                                                             \
+              else                                                            \
+                {                                                             \
+                  for (ky = 0; ky < 3; ky++)                                  \
+                    {                                                         \
+                      if (iy + ky < 0 || iy + ky >= g->in_h)                  \
+                        {                                                     \
+                          continue;                                           \
+                        }                                                     \
+                      for (kx = 0; kx < 3; kx++)                              \
+                        {                                                     \
+                          if (ix + kx < 0 || ix + kx >= g->in_w)              \
+                            {                                                 \
+                              continue;                                       \
+                            }                                                 \
+                          sum += plane[(iy + ky) * g->in_w + ix + kx] *       \
+                            w[ky * 3 + kx];                                   \
+                        }                                                     \
+                    }                                                         \
+                }                                                             \
+              *dst++ = (type) dnnrt_conv_saturate(sum >> out_shift, bits,     \
+                                                  relu);                      \
+            }                                                                 \
+        }                                                                     \
+    }                                                                         \
+}
+
+/*
+ * pointwise (1x1, stride 1, no padding) convolution on CHW layout.
+ * Each output channel is accumulated into acc by streaming over whole input
+ * planes, so every memory access is sequential. acc must hold one q31_t
+ * per pixel of a plane.
+ */
+#define DNNRT_DEFINE_POINTWISE(name, type, bits)                              \
+static void name(const type * in, nn_size_t in_ch_stride, int in_ch,         \
+                 const type * wt, const type * bias,                          \
+                 uint16_t bias_shift, uint16_t out_shift,                     \
+                 type * out, nn_size_t out_ch_stride, int out_ch,             \
+                 int pixels, q31_t * acc, int relu)                           \
+{                                                                             \
+  int oc, ic, i;                                                              \
+  q31_t init;                                                                 \
+                                                                              \
+  for (oc = 0; oc < out_ch; oc++)                                             \
+    {                                                                         \
+      const type *w = wt + oc * in_ch;                                        \
+      type *dst = out + oc * out_ch_stride;                                   \
+                                                                              \
+      init = 0;                                                               \
+      if (bias)                                                               \
+        {                                                                     \
+          init = ((q31_t) bias[oc] << bias_shift) + NN_ROUND(out_shift);      \
+        }                                                                     \
+      for (i = 0; i < pixels; i++)                                            \
+        {                                                                     \
+          acc[i] = init;                                                      \
+        }                                                                     \
+                                                                              \
+      for (ic = 0; ic < in_ch; ic++)                                          \
+        {                                                                     \
+          const type *src = in + ic * in_ch_stride;                           \
+          q31_t wv = w[ic];                                                   \
+                                                                              \
+          if (wv == 0)                                                        \
+            {                                                                 \
+              continue;                                                       \
+            }                                                                 \
+          for (i = 0; i < pixels; i++)                                        \
+            {                                                                 \
+              acc[i] += src[i] * wv;                                          \
+            }                                                                 \
+        }                                                                     \
+                                                                              \
+      for (i = 0; i < pixels; i++)                                            \
+        {                                                                     \
+          dst[i] = (type) dnnrt_conv_saturate(acc[i] >> out_shift, bits,      \
+                                              relu);                          \
+        }                                                                     \
+    }                                                                         \
+}
+
+DNNRT_DEFINE_DEPTHWISE3X3(dnnrt_depthwise_conv3x3_q7, q7_t, 8)
+DNNRT_DEFINE_DEPTHWISE3X3(dnnrt_depthwise_conv3x3_q15, q15_t, 16)
+DNNRT_DEFINE_POINTWISE(dnnrt_pointwise_conv_q7, q7_t, 8)
+DNNRT_DEFINE_POINTWISE(dnnrt_pointwise_conv_q15, q15_t, 16)
+
+#endif /* CONVOLUTION_KERNELS_H */
@@ -0,0 +1,414 @@
+/****************************************************************************
+ * modules/dnnrt/src/runtime/fusion.c
+ *
+ *   Copyright 2018 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <dnnrt/runtime.h>
+
+#include "nnablart/runtime.h"
+#include <context.h>
+#include <runtime_internal.h>
+#include <utilities/shape.h>
+#include <arm_nnfunctions.h>
+#include "runtime_common.h"
+
+#define X (0)                   // x input
+#define WEIGHT (1)              // weight
+#define BIAS (2)                // bias
+#define BETA (1)                // BatchNormalization beta
+#define GAMMA (2)               // BatchNormalization gamma
+#define MEAN (3)                // BatchNormalization mean
+#define VARIANCE (4)            // BatchNormalization variance
+
+static inline nn_function_t *dnn_fusion_function(const nn_network_t * n,
+                                                 int func_idx)
+{
+  int *list = (int *)NN_GET(n, n->functions.list);
+  return (nn_function_t *) NN_GET(n, list[func_idx]);
+}
+
+static inline nn_variable_t *dnn_fusion_variable(const nn_network_t * n,
+                                                 int var_idx)
+{
+  int *list = (int *)NN_GET(n, n->variables.list);
+  return (nn_variable_t *) NN_GET(n, list[var_idx]);
+}
+
+static inline int dnn_fusion_first(const nn_network_t * n,
+                                   const nn_list_t * vars)
+{
+  return vars->size > 0 ? *(int *)NN_GET(n, vars->list) : -1;
+}
+
+/* count how many times a variable is referred as an input of functions
+ * or as a network output */
+static int dnn_fusion_refcount(const nn_network_t * n, int var_idx)
+{
+  nn_function_t *func;
+  int *list;
+  int i, j, count = 0;
+
+  for (i = 0; i < n->functions.size; i++)
+    {
+      func = dnn_fusion_function(n, i);
+      list = (int *)NN_GET(n, func->inputs.list);
+      for (j = 0; j < func->inputs.size; j++)
+        {
+          count += list[j] == var_idx;
+        }
+    }
+
+  list = (int *)NN_GET(n, n->outputs.list);
+  for (j = 0; j < n->outputs.size; j++)
+    {
+      count += list[j] == var_idx;
+    }
+
+  return count;
+}
+
+/* check whether any input of a function shares the variable buffer
+ * with the variable */
+static int dnn_fusion_input_aliases(const nn_network_t * n,
+                                    nn_function_t * func, int var_idx)
+{
+  int data_index = dnn_fusion_variable(n, var_idx)->data_index;
+  int *list = (int *)NN_GET(n, func->inputs.list);
+  int i;
+
+  for (i = 0; i < func->inputs.size; i++)
+    {
+      if (dnn_fusion_variable(n, list[i])->data_index == data_index)
+        {
+          return 1;
+        }
+    }
+
+  return 0;
+}
+
+static inline int dnn_fusion_is_head(nn_function_t * func)
+{
+  return (func->type == NN_FUNCTION_CONVOLUTION ||
+          func->type == NN_FUNCTION_CONVOLUTION_0 ||
+          func->type == NN_FUNCTION_AFFINE) &&
+    (int)func->impl == DNNRT_IMPLEMENT && func->outputs.size == 1;
+}
+
+/* check whether next can be fused into the chain which ends with prev */
+static int dnn_fusion_can_follow(const nn_network_t * n, nn_function_t * head,
+                                 nn_function_t * prev, nn_function_t * next,
+                                 int len)
+{
+  int prev_out = dnn_fusion_first(n, &prev->outputs);
+  int next_out = dnn_fusion_first(n, &next->outputs);
+  nn_variable_t *pv, *nv;
+
+  if (next->outputs.size != 1 || next_out < 0 ||
+      dnn_fusion_first(n, &next->inputs) != prev_out ||
+      dnn_fusion_refcount(n, prev_out) != 1)
+    {
+      return 0;
+    }
+
+  pv = dnn_fusion_variable(n, prev_out);
+  nv = dnn_fusion_variable(n, next_out);
+  if (pv->data_index >= 0 || nv->data_index >= 0 ||
+      dnn_fusion_input_aliases(n, head, next_out))
+    {
+      return 0;
+    }
+
+  if (next->type == NN_FUNCTION_BATCH_NORMALIZATION)
+    {
+      /* folded into float weights, directly after the head only */
+      return len == 1 && head->inputs.size > BIAS &&
+        pv->type == NN_DATA_TYPE_FLOAT && nv->type == NN_DATA_TYPE_FLOAT;
+    }
+
+  if (next->type == NN_FUNCTION_RELU)
+    {
+      return pv->type == nv->type && pv->fp_pos == nv->fp_pos;
+    }
+
+  return 0;
+}
+
+/*
+ * find chains of functions which can be executed as a single function:
+ * a convolution or an affine implemented by dnnrt, followed by
+ * a BatchNormalization and/or a ReLU. Each intermediate output must be
+ * consumed only by the next function in the chain, because it's never
+ * written after the fusion.
+ */
+int dnn_fusion_plan(const nn_network_t * n, dnn_fusion_info_t * fusion)
+{
+  nn_function_t *head, *prev, *next;
+  int i, len;
+
+  memset(fusion, 0, sizeof(*fusion));
+  for (i = 0; i < n->functions.size; i += len)
+    {
+      head = dnn_fusion_function(n, i);
+      len = 1;
+      if (!dnn_fusion_is_head(head))
+        {
+          continue;
+        }
+
+      for (prev = head; i + len < n->functions.size; prev = next, len++)
+        {
+          next = dnn_fusion_function(n, i + len);
+          if (!dnn_fusion_can_follow(n, head, prev, next, len))
+            {
+              break;
+            }
+        }
+
+      if (len > 1 && fusion->chain_num < MAX_FUSION_NUM)
+        {
+          fusion->chain[fusion->chain_num].head = (uint16_t) i;
+          fusion->chain[fusion->chain_num].len = (uint8_t) len;
+          fusion->chain_num++;
+        }
+    }
+
+  return RT_RET_NOERROR;
+}
+
+static rt_function_error_t dnn_exec_fused(rt_function_t * f)
+{
+  /* already executed by the head of the chain */
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+static int dnn_fusion_shared_param(rt_context_t * c, rt_variable_t * var)
+{
+  int i, j, count = 0;
+
+  for (i = 0; i < c->num_of_functions; i++)
+    {
+      rt_function_t *f = &c->functions[i].func;
+      for (j = 0; j < f->num_of_inputs; j++)
+        {
+          count += f->inputs[j] == var;
+        }
+    }
+
+  return count > 1;
+}
+
+/*
+ * fold BatchNormalization into the weight and bias of the head:
+ *   y = (x * w + b - mean) * gamma / sqrt(variance + eps) + beta
+ *     = x * (w * scale) + (b * scale + shift)
+ * The folded parameters are placed in newly allocated memory, because
+ * the network itself may be shared with other runtimes.
+ */
+static int dnn_fusion_fold_bn(dnn_global_context_t * ctx, rt_context_t * c,
+                              rt_function_t * f, rt_function_t * bn)
+{
+  batch_normalization_local_context_t *bc =
+    (batch_normalization_local_context_t *) bn->local_context;
+  rt_variable_t *weight = f->inputs[WEIGHT];
+  rt_variable_t *bias = f->inputs[BIAS];
+  dnn_fused_param_t *param;
+  float *w, *b, *beta, *gamma, *mean, *var;
+  float scale;
+  int ch, wsize, i, k;
+
+  if (bc->batch_stat || bc->axes.size != 1 || bc->axes.data[0] != 1 ||
+      bn->num_of_inputs <= VARIANCE || weight->type != NN_DATA_TYPE_FLOAT ||
+      bias->type != NN_DATA_TYPE_FLOAT)
+    {
+      return -EPERM;
+    }
+
+  ch = calc_shape_size(bn->inputs[GAMMA]->shape);
+  wsize = calc_shape_size(weight->shape);
+  if (ch == 0 || wsize % ch != 0 || calc_shape_size(bias->shape) != ch ||
+      calc_shape_size(bn->inputs[BETA]->shape) != ch ||
+      calc_shape_size(bn->inputs[MEAN]->shape) != ch ||
+      calc_shape_size(bn->inputs[VARIANCE]->shape) != ch ||
+      dnn_fusion_shared_param(c, weight) || dnn_fusion_shared_param(c, bias))
+    {
+      return -EPERM;
+    }
+
+  param = (dnn_fused_param_t *) malloc(sizeof(dnn_fused_param_t) +
+                                       sizeof(float) * (wsize + ch));
+  if (param == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  w = (float *)(param + 1);
+  b = w + wsize;
+  beta = (float *)bn->inputs[BETA]->data;
+  gamma = (float *)bn->inputs[GAMMA]->data;
+  mean = (float *)bn->inputs[MEAN]->data;
+  var = (float *)bn->inputs[VARIANCE]->data;
+
+  /* weights of both convolution and affine are laid out per output */
+  for (i = 0; i < ch; i++)
+    {
+      const float *src = (const float *)weight->data + i * (wsize / ch);
+      float *dst = w + i * (wsize / ch);
+
+      scale = gamma[i] / sqrtf(var[i] + bc->eps);
+      for (k = 0; k < wsize / ch; k++)
+        {
+          dst[k] = src[k] * scale;
+        }
+      b[i] = (((float *)bias->data)[i] - mean[i]) * scale + beta[i];
+    }
+
+  param->owner = c;
+  param->next = ctx->fused_params;
+  ctx->fused_params = param;
+
+  weight->data = w;
+  bias->data = b;
+  return RT_RET_NOERROR;
+}
+
+static int dnn_fusion_relu(rt_function_context_t * head)
+{
+  if (head->info->type == NN_FUNCTION_AFFINE)
+    {
+      return dnnrt_affine_fuse_relu(&head->func);
+    }
+  return dnnrt_convolution_fuse_relu(&head->func);
+}
+
+/*
+ * rewrite the function list of rt_context according to the chains found
+ * by dnn_fusion_plan(). The head of each chain writes directly into the
+ * output of the last fused function, and the fused functions are replaced
+ * with no-op. If a function can't be fused at runtime (e.g. the head isn't
+ * executed by a dnnrt kernel), the chain is cut before it.
+ */
+void dnn_fusion_apply(dnn_global_context_t * ctx, rt_context_pointer rt_ctx,
+                      const dnn_fusion_info_t * fusion)
+{
+  rt_context_t *c = (rt_context_t *) rt_ctx;
+  rt_function_context_t *head, *fc;
+  rt_variable_t *out;
+  int i, j, err;
+
+  for (i = 0; i < fusion->chain_num; i++)
+    {
+      head = &c->functions[fusion->chain[i].head];
+      out = head->func.outputs[0];
+
+      for (j = 1; j < fusion->chain[i].len; j++)
+        {
+          fc = head + j;
+          if (fc->info->type == NN_FUNCTION_BATCH_NORMALIZATION)
+            {
+              err = dnn_fusion_fold_bn(ctx, c, &head->func, &fc->func);
+            }
+          else
+            {
+              err = dnn_fusion_relu(head);
+            }
+
+          if (err != RT_RET_NOERROR)
+            {
+              break;
+            }
+
+          fc->func.exec_func = dnn_exec_fused;
+          out = fc->func.outputs[0];
+        }
+
+      head->func.outputs[0]->data = out->data;
+      dnn_info("fused %d function(s) into function %d\n", j - 1,
+               fusion->chain[i].head);
+    }
+}
+
+/* free parameters rewritten by dnn_fusion_apply() for the rt_context */
+void dnn_fusion_release(dnn_global_context_t * ctx, rt_context_pointer rt_ctx)
+{
+  dnn_fused_param_t *pre = NULL;
+  dnn_fused_param_t *param = ctx->fused_params;
+  dnn_fused_param_t *next;
+
+  for (; param; param = next)
+    {
+      next = param->next;
+      if (param->owner == rt_ctx)
+        {
+          if (pre)
+            {
+              pre->next = next;
+            }
+          else
+            {
+              ctx->fused_params = next;
+            }
+
+          free(param);
+        }
+      else
+        {
+          pre = param;
+        }
+    }
+}
+
+void dnn_relu_variable(rt_variable_t * var)
+{
+  int size = calc_shape_size(var->shape);
+  int i;
+
+  if (var->type == NN_DATA_TYPE_INT8)
+    {
+      arm_relu_q7((q7_t *) var->data, size);
+    }
+  else if (var->type == NN_DATA_TYPE_INT16)
+    {
+      arm_relu_q15((q15_t *) var->data, size);
+    }
+  else
+    {
+      float *data = (float *)var->data;
+      for (i = 0; i < size; i++)
+        {
+          data[i] = data[i] < 0.0f ? 0.0f : data[i];
+        }
+    }
+}
@@ -0,0 +1,317 @@
+/****************************************************************************
+ * modules/dnnrt/src/runtime/profile.c
+ *
+ *   Copyright 2018 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dnnrt/runtime.h>
+
+#include "nnablart/runtime.h"
+#include <context.h>
+#include <runtime_internal.h>
+#include <utilities/shape.h>
+#include "runtime_common.h"
+
+#ifdef __arm__
+#  define DWT_CTRL     (*(volatile uint32_t *)0xe0001000)
+#  define DWT_CYCCNT   (*(volatile uint32_t *)0xe0001004)
+#  define DEMCR        (*(volatile uint32_t *)0xe000edfc)
+#  define DEMCR_TRCENA (1u << 24)
+#  define DWT_CTRL_CYCCNTENA (1u << 0)
+#  define COUNTS_PER_US CONFIG_DNN_RT_PROFILE_CYCLES_PER_US
+#else
+#  define COUNTS_PER_US (1000u)
+#endif
+
+static inline void dnn_profile_counter_enable(void)
+{
+#ifdef __arm__
+  DEMCR |= DEMCR_TRCENA;
+  DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+#endif
+}
+
+static inline uint32_t dnn_profile_counter(void)
+{
+#ifdef __arm__
+  return DWT_CYCCNT;
+#else
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t) ts.tv_sec * 1000000000u + (uint32_t) ts.tv_nsec;
+#endif
+}
+
+static int dnn_profile_index(dnn_profile_t * prof, rt_function_t * f)
+{
+  rt_context_t *c = (rt_context_t *) prof->owner;
+  rt_function_context_t *fc = (rt_function_context_t *)
+    ((uint8_t *) f - offsetof(rt_function_context_t, func));
+  int idx = (int)(fc - c->functions);
+
+  return (idx >= 0 && idx < prof->layer_num) ? idx : -1;
+}
+
+static unsigned long dnn_profile_var_bsize(rt_variable_t ** vars, int num)
+{
+  unsigned long bsize = 0u;
+  int i, elem_size;
+
+  for (i = 0; i < num; i++)
+    {
+      switch (vars[i]->type)
+        {
+        case NN_DATA_TYPE_INT8:
+          elem_size = sizeof(int8_t);
+          break;
+
+        case NN_DATA_TYPE_INT16:
+          elem_size = sizeof(int16_t);
+          break;
+
+        default:
+          elem_size = sizeof(float);
+          break;
+        }
+
+      bsize += elem_size * calc_shape_size(vars[i]->shape);
+    }
+
+  return bsize;
+}
+
+static rt_function_error_t dnn_profile_exec(rt_function_t * f)
+{
+  dnn_profile_t *prof = dnn_get_global_context()->cur_profile;
+  dnn_layer_profile_t *layer;
+  rt_function_error_t ret;
+  uint32_t start, cycles;
+  int idx = dnn_profile_index(prof, f);
+
+  if (idx < 0)
+    {
+      return RT_FUNCTION_ERROR_UNIMPLEMENTED;
+    }
+
+  layer = &prof->layer[idx];
+  start = dnn_profile_counter();
+  ret = prof->exec_list[idx] (f);
+  cycles = dnn_profile_counter() - start;
+
+  layer->calls++;
+  layer->last_start = start - prof->forward_start;
+  layer->last_cycles = cycles;
+  layer->total_cycles += cycles;
+  if (cycles > layer->max_cycles)
+    {
+      layer->max_cycles = cycles;
+    }
+
+  return ret;
+}
+
+/*
+ * create a profile for rt_context before rt_initialize_context(),
+ * so that scratch buffer requests from function callbacks are recorded.
+ */
+dnn_profile_t *dnn_profile_create(dnn_global_context_t * ctx,
+                                  rt_context_pointer rt_ctx,
+                                  const nn_network_t * net)
+{
+  int *list = (int *)NN_GET(net, net->functions.list);
+  int num = net->functions.size;
+  dnn_profile_t *prof;
+  nn_function_t *func;
+  int i;
+
+  prof = (dnn_profile_t *) calloc(1, sizeof(dnn_profile_t) +
+                                  num * (sizeof(dnn_layer_profile_t) +
+                                         sizeof(prof->exec_list[0])));
+  if (prof == NULL)
+    {
+      return NULL;
+    }
+
+  prof->owner = rt_ctx;
+  prof->layer_num = num;
+  prof->layer = (dnn_layer_profile_t *) (prof + 1);
+  prof->exec_list = (void *)(prof->layer + num);
+  for (i = 0; i < num; i++)
+    {
+      func = (nn_function_t *) NN_GET(net, list[i]);
+      prof->layer[i].function_type = func->type;
+    }
+
+  prof->next = ctx->profiles;
+  ctx->profiles = prof;
+  dnn_profile_counter_enable();
+  return prof;
+}
+
+void dnn_profile_scratch(dnn_profile_t * prof, void *function_context,
+                         int size)
+{
+  rt_function_context_t *fc = (rt_function_context_t *) function_context;
+  int idx = dnn_profile_index(prof, &fc->func);
+
+  if (idx >= 0)
+    {
+      prof->layer[idx].scratch_bytes = size;
+    }
+}
+
+/*
+ * replace exec_func of each function with dnn_profile_exec(), which
+ * measures the original exec_func. Call this after all the rewrites of
+ * exec_func (e.g. fusion) are done.
+ */
+void dnn_profile_attach(dnn_profile_t * prof)
+{
+  rt_context_t *c = (rt_context_t *) prof->owner;
+  rt_function_t *f;
+  int i;
+
+  for (i = 0; i < prof->layer_num && i < c->num_of_functions; i++)
+    {
+      f = &c->functions[i].func;
+      prof->exec_list[i] = f->exec_func;
+      prof->layer[i].input_bytes =
+        dnn_profile_var_bsize(f->inputs, f->num_of_inputs);
+      prof->layer[i].output_bytes =
+        dnn_profile_var_bsize(f->outputs, f->num_of_outputs);
+      f->exec_func = dnn_profile_exec;
+    }
+}
+
+dnn_profile_t *dnn_profile_find(dnn_global_context_t * ctx,
+                                rt_context_pointer rt_ctx)
+{
+  dnn_profile_t *prof;
+
+  for (prof = ctx->profiles; prof; prof = prof->next)
+    {
+      if (prof->owner == rt_ctx)
+        {
+          break;
+        }
+    }
+
+  return prof;
+}
+
+void dnn_profile_begin(dnn_profile_t * prof)
+{
+  prof->forward_start = dnn_profile_counter();
+}
+
+int dnn_profile_dump(dnn_profile_t * prof, FILE * stream, int format)
+{
+  dnn_layer_profile_t *layer;
+  int i;
+
+  if (format == DNN_PROFILE_FORMAT_CSV)
+    {
+      fprintf(stream, "index,function_type,calls,last_cycles,max_cycles,"
+              "avg_cycles,input_bytes,output_bytes,scratch_bytes\n");
+      for (i = 0; i < prof->layer_num; i++)
+        {
+          layer = &prof->layer[i];
+          fprintf(stream, "%d,%u,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n", i,
+                  layer->function_type, layer->calls, layer->last_cycles,
+                  layer->max_cycles, layer->calls ?
+                  (unsigned long)(layer->total_cycles / layer->calls) : 0ul,
+                  layer->input_bytes, layer->output_bytes,
+                  layer->scratch_bytes);
+        }
+    }
+  else if (format == DNN_PROFILE_FORMAT_CHROME_TRACE)
+    {
+      fprintf(stream, "{\"traceEvents\":[");
+      for (i = 0; i < prof->layer_num; i++)
+        {
+          layer = &prof->layer[i];
+          fprintf(stream, "%s\n{\"name\":\"function %d\",\"ph\":\"X\","
+                  "\"pid\":0,\"tid\":0,\"ts\":%lu,\"dur\":%lu,"
+                  "\"args\":{\"function_type\":%u,\"input_bytes\":%lu,"
+                  "\"output_bytes\":%lu,\"scratch_bytes\":%lu}}",
+                  i ? "," : "", i, layer->last_start / COUNTS_PER_US,
+                  layer->last_cycles / COUNTS_PER_US, layer->function_type,
+                  layer->input_bytes, layer->output_bytes,
+                  layer->scratch_bytes);
+        }
+      fprintf(stream, "\n]}\n");
+    }
+  else
+    {
+      return -EINVAL;
+    }
+
+  return RT_RET_NOERROR;
+}
+
+void dnn_profile_release(dnn_global_context_t * ctx,
+                         rt_context_pointer rt_ctx)
+{
+  dnn_profile_t *pre = NULL;
+  dnn_profile_t *prof = ctx->profiles;
+  dnn_profile_t *next;
+
+  for (; prof; prof = next)
+    {
+      next = prof->next;
+      if (prof->owner == rt_ctx)
+        {
+          if (pre)
+            {
+              pre->next = next;
+            }
+          else
+            {
+              ctx->profiles = next;
+            }
+
+          if (ctx->cur_profile == prof)
+            {
+              ctx->cur_profile = NULL;
+            }
+          free(prof);
+        }
+      else
+        {
+          pre = prof;
+        }
+    }
+}
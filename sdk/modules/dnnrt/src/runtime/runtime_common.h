@@ -36,8 +36,10 @@
 #  define RUNTIME_COMMON_H
 
 #  include <nuttx/config.h>
+#  include <stdio.h>
 #  include <errno.h>
 #  include <debug.h>
+#  include <dnnrt/runtime.h>
 #  include <nnablart/functions.h>
 #  include <nnablart/runtime.h>
 
@@ -85,10 +87,59 @@ extern "C"
     size_t bsize_list[MAX_VBUFFER_NUM]; /* size of each variable buffer in bytes */
     void *addr_list[MAX_VBUFFER_NUM];   /* address of pre-allocated buffer */
     size_t vbuffer_num;         /* length of bsize_list/addr_list */
+    size_t offset_list[MAX_VBUFFER_NUM];        /* offset of each variable
+                                                 * buffer in the planned
+                                                 * arena */
+    size_t planned_bsize;       /* peak footprint of the planned arena,
+                                 * 0 if no plan is available */
+    size_t total_bsize;         /* sum of all the variable buffer sizes */
     uint8_t actual_alloc_count; /* how many times to allocate a shared_chunk to
                                  * variable buffers in rt_initialize_context() */
   };
 
+/* dnnrt does NOT fuse more than MAX_FUSION_NUM function chains
+   in a network */
+#  define MAX_FUSION_NUM  (16)
+
+  /* structure to hold function chains which are executed as a single
+   * function. Each chain is composed of a convolution or an affine at
+   * dnn_fusion_info_t::chain[]::head, and the following BatchNormalization
+   * and/or ReLU functions. */
+  typedef struct dnn_fusion_info dnn_fusion_info_t;
+  struct dnn_fusion_info
+  {
+    struct
+    {
+      uint16_t head;            /* index of the first function in the chain */
+      uint8_t len;              /* number of functions in the chain */
+    } chain[MAX_FUSION_NUM];
+    uint8_t chain_num;          /* length of chain */
+  };
+
+  /* structure to hold parameters rewritten by the fusion, such as weights
+   * into which BatchNormalization is folded */
+  struct dnn_fused_param;
+  typedef struct dnn_fused_param dnn_fused_param_t;
+  struct dnn_fused_param
+  {
+    void *owner;                /* rt_context_pointer using this parameter */
+    dnn_fused_param_t *next;    /* point to next parameter in linked-list */
+  };
+
+  /* structure to hold profile of functions in a rt_context */
+  struct dnn_profile;
+  typedef struct dnn_profile dnn_profile_t;
+  struct dnn_profile
+  {
+    void *owner;                /* rt_context_pointer profiled */
+    dnn_profile_t *next;        /* point to next profile in linked-list */
+    uint32_t forward_start;     /* counter at start of dnn_runtime_forward() */
+    int layer_num;              /* length of layer/exec_list */
+    dnn_layer_profile_t *layer; /* profile of each function */
+    rt_function_error_t(**exec_list) (rt_function_t * f);     /* original
+                                                                 * exec_func */
+  };
+
   typedef struct dnn_global_context
   {
     int rt_count;
@@ -96,6 +147,10 @@ extern "C"
     int scratch_buf_bsize;
     void *scratch_buf;
     dnn_shared_chunk_t *chunks;
+    dnn_fused_param_t *fused_params;
+    dnn_profile_t *profiles;
+    dnn_profile_t *cur_profile; /* profile of rt_context being initialized
+                                 * or forwarded */
     dnn_vbuffer_alloc_info_t *alloc_info;       /* allocation info of current
                                                  * network. the alloc_info is
                                                  * placed on stack of
@@ -113,12 +168,17 @@ extern "C"
                                        void *function_context);
   rt_return_value_t dnnrt_convolution_alloc(nn_network_t * net,
                                             void *function_context);
+  int dnnrt_affine_fuse_relu(rt_function_t * f);
+  int dnnrt_convolution_fuse_relu(rt_function_t * f);
 
-  void dnn_req_scratch_buf(int size);
+  void dnn_req_scratch_buf(void *function_context, int size);
   void *dnn_scratch_buf(void);
 
   int dnn_peek_vbuffers(const nn_network_t * net,
                         dnn_vbuffer_alloc_info_t * alloc_info);
+  int dnn_plan_vbuffers(const nn_network_t * net,
+                        const dnn_fusion_info_t * fusion,
+                        dnn_vbuffer_alloc_info_t * alloc_info);
   void dnn_reset_chunk_usage(dnn_global_context_t * ctx);
   int dnn_preallocate_chunks(dnn_global_context_t * ctx,
                              dnn_vbuffer_alloc_info_t * alloc_info);
@@ -128,6 +188,26 @@ extern "C"
   void *dnn_variable_malloc(size_t size);
   void dnn_variable_free(void *p);
 
+  int dnn_fusion_plan(const nn_network_t * net, dnn_fusion_info_t * fusion);
+  void dnn_fusion_apply(dnn_global_context_t * ctx, rt_context_pointer rt_ctx,
+                        const dnn_fusion_info_t * fusion);
+  void dnn_fusion_release(dnn_global_context_t * ctx,
+                          rt_context_pointer rt_ctx);
+  void dnn_relu_variable(rt_variable_t * var);
+
+  dnn_profile_t *dnn_profile_create(dnn_global_context_t * ctx,
+                                    rt_context_pointer rt_ctx,
+                                    const nn_network_t * net);
+  void dnn_profile_scratch(dnn_profile_t * prof, void *function_context,
+                           int size);
+  void dnn_profile_attach(dnn_profile_t * prof);
+  dnn_profile_t *dnn_profile_find(dnn_global_context_t * ctx,
+                                  rt_context_pointer rt_ctx);
+  void dnn_profile_begin(dnn_profile_t * prof);
+  int dnn_profile_dump(dnn_profile_t * prof, FILE * stream, int format);
+  void dnn_profile_release(dnn_global_context_t * ctx,
+                           rt_context_pointer rt_ctx);
+
 #  ifdef __cplusplus
 }
 #  endif
@@ -69,6 +69,9 @@ int dnn_runtime_initialize(dnn_runtime_t * rt, const nn_network_t * network)
   DNN_CHECK_NULL_RET(network, -EINVAL);
   void *tmp_buf;
   dnn_vbuffer_alloc_info_t alloc_info = { 0 };
+#ifdef CONFIG_DNN_RT_FUSION
+  dnn_fusion_info_t fusion;
+#endif
   int err;
 
   /* for memory saving a stack varible alloc_info is used */
@@ -81,6 +84,24 @@ int dnn_runtime_initialize(dnn_runtime_t * rt, const nn_network_t * network)
     {
       goto peek_err;
     }
+#ifdef CONFIG_DNN_RT_FUSION
+  err = dnn_fusion_plan(network, &fusion);
+  if (err != RT_RET_NOERROR)
+    {
+      goto peek_err;
+    }
+#endif
+#ifdef CONFIG_DNN_RT_MEMORY_PLANNER
+#  ifdef CONFIG_DNN_RT_FUSION
+  err = dnn_plan_vbuffers(network, &fusion, &alloc_info);
+#  else
+  err = dnn_plan_vbuffers(network, NULL, &alloc_info);
+#  endif
+  if (err != RT_RET_NOERROR)
+    {
+      goto peek_err;
+    }
+#endif
   dnn_reset_chunk_usage(&s_dnn_gctx);
   err = dnn_preallocate_chunks(&s_dnn_gctx, &alloc_info);
   if (err != RT_RET_NOERROR)
@@ -97,6 +118,14 @@ int dnn_runtime_initialize(dnn_runtime_t * rt, const nn_network_t * network)
   rt_set_variable_malloc(dnn_variable_malloc);
   rt_set_variable_free(dnn_variable_free);
   rt_context_pointer ctx = (rt_context_pointer) (rt->impl_ctx);
+#ifdef CONFIG_DNN_RT_PROFILE
+  s_dnn_gctx.cur_profile = dnn_profile_create(&s_dnn_gctx, ctx, network);
+  if (s_dnn_gctx.cur_profile == NULL)
+    {
+      err = -ENOMEM;
+      goto rt_init_err;
+    }
+#endif
   err =
     (int)rt_add_callback(ctx, NN_FUNCTION_CONVOLUTION, dnnrt_convolution_alloc);
   if (err != RT_RET_NOERROR)
@@ -137,12 +166,24 @@ int dnn_runtime_initialize(dnn_runtime_t * rt, const nn_network_t * network)
       s_dnn_gctx.scratch_buf = tmp_buf;
       s_dnn_gctx.scratch_buf_bsize = s_dnn_gctx.req_scratch_buf_bsize;
     }
+#ifdef CONFIG_DNN_RT_FUSION
+
+  /* execute BatchNormalization and ReLU within the preceding function */
+  dnn_fusion_apply(&s_dnn_gctx, ctx, &fusion);
+#endif
+#ifdef CONFIG_DNN_RT_PROFILE
+  dnn_profile_attach(s_dnn_gctx.cur_profile);
+  s_dnn_gctx.cur_profile = NULL;
+#endif
   ++s_dnn_gctx.rt_count;
 
   return RT_RET_NOERROR;
 
 scratch_buf_err:
 rt_init_err:
+#ifdef CONFIG_DNN_RT_PROFILE
+  dnn_profile_release(&s_dnn_gctx, ctx);
+#endif
   dnn_deallocate_chunks(&s_dnn_gctx, &alloc_info);
   rt_free_context(&rt->impl_ctx);
 rt_alloc_err:
@@ -164,6 +205,10 @@ int dnn_runtime_finalize(dnn_runtime_t * rt)
       s_dnn_gctx.req_scratch_buf_bsize = 0;
     }
 
+  dnn_fusion_release(&s_dnn_gctx, (rt_context_pointer) rt->impl_ctx);
+#ifdef CONFIG_DNN_RT_PROFILE
+  dnn_profile_release(&s_dnn_gctx, (rt_context_pointer) rt->impl_ctx);
+#endif
   return (int)rt_free_context((rt_context_pointer *) & (rt->impl_ctx));
 }
 
@@ -183,6 +228,10 @@ int dnn_runtime_forward(dnn_runtime_t * rt, const void *inputs[],
       c->variables[c->input_variable_ids[i]].data = (void *)inputs[i];
     }
 
+#ifdef CONFIG_DNN_RT_PROFILE
+  s_dnn_gctx.cur_profile = dnn_profile_find(&s_dnn_gctx, ctx);
+  dnn_profile_begin(s_dnn_gctx.cur_profile);
+#endif
   return (int)rt_forward(ctx);
 }
 
@@ -270,8 +319,15 @@ dnn_global_context_t *dnn_get_global_context(void)
   return &s_dnn_gctx;
 }
 
-void dnn_req_scratch_buf(int size)
+void dnn_req_scratch_buf(void *function_context, int size)
 {
+#ifdef CONFIG_DNN_RT_PROFILE
+  if (s_dnn_gctx.cur_profile)
+    {
+      dnn_profile_scratch(s_dnn_gctx.cur_profile, function_context, size);
+    }
+#endif
+
   if (size > s_dnn_gctx.req_scratch_buf_bsize)
     {
       s_dnn_gctx.req_scratch_buf_bsize = size;
@@ -288,6 +344,40 @@ int dnn_asmp_mallinfo(unsigned char array_length, dnn_mallinfo_t * info_array)
   return -EPERM;
 }
 
+int dnn_runtime_get_profile(dnn_runtime_t * rt, dnn_layer_profile_t * profile,
+                            unsigned short length)
+{
+#ifdef CONFIG_DNN_RT_PROFILE
+  DNN_CHECK_NULL_RET(rt, -EINVAL);
+  DNN_CHECK_NULL_RET(profile, -EINVAL);
+  dnn_profile_t *prof = dnn_profile_find(&s_dnn_gctx, rt->impl_ctx);
+  DNN_CHECK_NULL_RET(prof, -EINVAL);
+
+  if (length > prof->layer_num)
+    {
+      length = prof->layer_num;
+    }
+  memcpy(profile, prof->layer, sizeof(dnn_layer_profile_t) * length);
+  return prof->layer_num;
+#else
+  return -EPERM;
+#endif
+}
+
+int dnn_runtime_dump_profile(dnn_runtime_t * rt, FILE * stream, int format)
+{
+#ifdef CONFIG_DNN_RT_PROFILE
+  DNN_CHECK_NULL_RET(rt, -EINVAL);
+  DNN_CHECK_NULL_RET(stream, -EINVAL);
+  dnn_profile_t *prof = dnn_profile_find(&s_dnn_gctx, rt->impl_ctx);
+  DNN_CHECK_NULL_RET(prof, -EINVAL);
+
+  return dnn_profile_dump(prof, stream, format);
+#else
+  return -EPERM;
+#endif
+}
+
 int dnn_nuttx_mallinfo(dnn_mallinfo_t * info)
 {
   DNN_CHECK_NULL_RET(info, -EINVAL);
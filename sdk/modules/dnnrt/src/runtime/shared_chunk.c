@@ -36,6 +36,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <dnnrt/runtime.h>
 
 #include "nnablart/runtime.h"
@@ -145,11 +146,187 @@ int dnn_peek_vbuffers(const nn_network_t * n,
         {
           alloc_info->bsize_list[i] = *(list + i) * sizeof(float);
         }
+      alloc_info->total_bsize += round_up(alloc_info->bsize_list[i], 4u);
     }
 
   return RT_RET_NOERROR;
 }
 
+#ifdef CONFIG_DNN_RT_MEMORY_PLANNER
+/* return the variable buffer index of a variable, or -1 if the variable
+ * is not backed by a variable buffer (e.g. parameters) */
+static int dnn_variable_vbuffer_index(const nn_network_t * n, int var_idx)
+{
+  int *list = (int *)NN_GET(n, n->variables.list);
+  nn_variable_t *var;
+
+  if (var_idx < 0 || var_idx >= n->variables.size)
+    {
+      return -1;
+    }
+
+  var = (nn_variable_t *) NN_GET(n, list[var_idx]);
+  return var->data_index < 0 ? -1 - var->data_index : -1;
+}
+
+static void dnn_vbuffer_extend_lifetime(const nn_network_t * n,
+                                        const nn_list_t * vars,
+                                        int begin, int end,
+                                        int *first, int *last)
+{
+  int *list = (int *)NN_GET(n, vars->list);
+  int i, buf_idx;
+
+  for (i = 0; i < vars->size; i++)
+    {
+      buf_idx = dnn_variable_vbuffer_index(n, list[i]);
+      if (buf_idx < 0 || buf_idx >= n->buffers.size)
+        {
+          continue;
+        }
+
+      if (begin < first[buf_idx])
+        {
+          first[buf_idx] = begin;
+        }
+
+      if (end > last[buf_idx])
+        {
+          last[buf_idx] = end;
+        }
+    }
+}
+
+/*
+ * determine the offset of each variable buffer in a single arena, so that
+ * buffers which are never alive at the same time share the same memory.
+ * The lifetime of a variable buffer is the range of functions, in execution
+ * order, which read or write it. Buffers of network inputs and outputs are
+ * kept alive during the whole forward propagation, because users access
+ * them before and after dnn_runtime_forward(). Outputs of functions fused
+ * by dnn_fusion_plan() are alive from the head of the chain.
+ * The buffers are placed by the greedy-by-size algorithm: the largest buffer
+ * first, each at the lowest offset which doesn't overlap any already placed
+ * buffer whose lifetime intersects with it.
+ * The result is stored into dnn_vbuffer_alloc_info_t::offset_list and
+ * dnn_vbuffer_alloc_info_t::planned_bsize. planned_bsize is left 0 if
+ * the plan doesn't save any memory.
+ */
+int dnn_plan_vbuffers(const nn_network_t * n,
+                      const dnn_fusion_info_t * fusion,
+                      dnn_vbuffer_alloc_info_t * alloc_info)
+{
+  int first[MAX_VBUFFER_NUM];
+  int last[MAX_VBUFFER_NUM];
+  uint8_t order[MAX_VBUFFER_NUM];
+  int *funcs = (int *)NN_GET(n, n->functions.list);
+  int func_num = n->functions.size;
+  int num = (int)alloc_info->vbuffer_num;
+  nn_function_t *func;
+  size_t bsize, offset, peak = 0u;
+  int i, j, k, moved;
+
+  alloc_info->planned_bsize = 0u;
+  if (num == 0 || num > MAX_VBUFFER_NUM)
+    {
+      return RT_RET_NOERROR;
+    }
+
+  for (i = 0; i < num; i++)
+    {
+      first[i] = INT_MAX;
+      last[i] = -1;
+    }
+
+  /* compute lifetime of each variable buffer */
+  for (i = 0; i < func_num; i++)
+    {
+      func = (nn_function_t *) NN_GET(n, funcs[i]);
+      dnn_vbuffer_extend_lifetime(n, &func->inputs, i, i, first, last);
+      dnn_vbuffer_extend_lifetime(n, &func->outputs, i, i, first, last);
+    }
+
+  /* functions in a fused chain write their outputs at the head of it */
+  for (i = 0; fusion != NULL && i < fusion->chain_num; i++)
+    {
+      for (j = 1; j < fusion->chain[i].len; j++)
+        {
+          func = (nn_function_t *) NN_GET(n, funcs[fusion->chain[i].head + j]);
+          dnn_vbuffer_extend_lifetime(n, &func->outputs,
+                                      fusion->chain[i].head,
+                                      fusion->chain[i].head, first, last);
+        }
+    }
+
+  dnn_vbuffer_extend_lifetime(n, &n->inputs, 0, func_num, first, last);
+  dnn_vbuffer_extend_lifetime(n, &n->outputs, 0, func_num, first, last);
+
+  /* be conservative about buffers which no function refers */
+  for (i = 0; i < num; i++)
+    {
+      if (first[i] > last[i])
+        {
+          first[i] = 0;
+          last[i] = func_num;
+        }
+    }
+
+  /* sort buffer indices by size in descending order */
+  for (i = 0; i < num; i++)
+    {
+      for (j = i; j > 0 &&
+           alloc_info->bsize_list[order[j - 1]] < alloc_info->bsize_list[i];
+           j--)
+        {
+          order[j] = order[j - 1];
+        }
+      order[j] = (uint8_t) i;
+    }
+
+  /* place each buffer at the lowest offset free during its lifetime */
+  for (k = 0; k < num; k++)
+    {
+      i = order[k];
+      bsize = round_up(alloc_info->bsize_list[i], 4u);
+      offset = 0u;
+      do
+        {
+          moved = 0;
+          for (j = 0; j < k; j++)
+            {
+              int p = order[j];
+              size_t p_end = alloc_info->offset_list[p] +
+                round_up(alloc_info->bsize_list[p], 4u);
+
+              if (first[i] <= last[p] && first[p] <= last[i] &&
+                  offset < p_end && alloc_info->offset_list[p] < offset + bsize)
+                {
+                  offset = p_end;
+                  moved = 1;
+                }
+            }
+        }
+      while (moved);
+
+      alloc_info->offset_list[i] = offset;
+      if (offset + bsize > peak)
+        {
+          peak = offset + bsize;
+        }
+    }
+
+  dnn_info("variable buffers: %u bytes planned, %u bytes without planning\n",
+           (unsigned int)peak, (unsigned int)alloc_info->total_bsize);
+
+  if (peak < alloc_info->total_bsize)
+    {
+      alloc_info->planned_bsize = peak;
+    }
+
+  return RT_RET_NOERROR;
+}
+#endif
+
 static int dnn_shared_chunk_accommodate(dnn_shared_chunk_t * self,
                                         size_t vbuffer_bsize)
 {
@@ -194,13 +371,13 @@ static
 
 static inline
   dnn_shared_chunk_t * dnn_create_chunk(dnn_global_context_t * ctx,
-                                        dnn_vbuffer_alloc_info_t * alloc_info)
+                                        size_t data_bsize)
 {
   /* reserve memory for new_chunk */
   dnn_shared_chunk_t *new_chunk = NULL, *last;
   size_t chunk_bsize = 0u;
   chunk_bsize += sizeof(dnn_shared_chunk_t);
-  chunk_bsize += dnn_vbuffer_alloc_info_remaining_bsize(alloc_info);
+  chunk_bsize += data_bsize;
   chunk_bsize += (4u - 1u);     // padding to 4-byte align new_chunk->data
   new_chunk = (dnn_shared_chunk_t *) malloc(chunk_bsize);
   if (new_chunk != NULL)
@@ -247,6 +424,43 @@ void dnn_deallocate_chunks(dnn_global_context_t * ctx,
     }
 }
 
+/*
+ * place the arena planned by dnn_plan_vbuffers() in the first shared_chunk
+ * large enough to hold it, or in a new shared_chunk if there is none.
+ */
+static int dnn_preallocate_arena(dnn_global_context_t * ctx,
+                                 dnn_vbuffer_alloc_info_t * alloc_info)
+{
+  dnn_shared_chunk_t *chunk;
+
+  for (chunk = ctx->chunks; chunk != NULL; chunk = chunk->next)
+    {
+      if (dnn_shared_chunk_accommodate(chunk, alloc_info->planned_bsize))
+        {
+          break;
+        }
+    }
+
+  if (chunk == NULL)
+    {
+      chunk = dnn_create_chunk(ctx, alloc_info->planned_bsize);
+      if (chunk == NULL)
+        {
+          dnn_err("no enough memory to create variable buffer\n");
+          return -ENOMEM;
+        }
+    }
+
+  for (uint8_t idx = 0; idx < alloc_info->vbuffer_num; idx++)
+    {
+      alloc_info->addr_list[idx] = chunk->data + chunk->used_bsize +
+        alloc_info->offset_list[idx];
+    }
+  chunk->used_bsize += alloc_info->planned_bsize;
+
+  return RT_RET_NOERROR;
+}
+
 /*
  * determine how to allocate shared_chunk to variable buffers (preallocate),
  * and store the result into dnn_vbuffer_alloc_info_t::addr_list.
@@ -257,6 +471,8 @@ void dnn_deallocate_chunks(dnn_global_context_t * ctx,
  *     which didn't fit in existing shared_chunk in 1.
  *  3. slice the new single shared_chunk and allocate sliced pieces to
  *     variable buffers which didn't fit in existing shared_chunk in 1
+ * If the buffers are planned by dnn_plan_vbuffers(), the planned arena is
+ * allocated as a whole instead.
  */
 int dnn_preallocate_chunks(dnn_global_context_t * ctx,
                            dnn_vbuffer_alloc_info_t * alloc_info)
@@ -264,6 +480,11 @@ int dnn_preallocate_chunks(dnn_global_context_t * ctx,
   int ret = RT_RET_NOERROR;
   dnn_shared_chunk_t *chunk, *new_chunk;
 
+  if (alloc_info->planned_bsize != 0u)
+    {
+      return dnn_preallocate_arena(ctx, alloc_info);
+    }
+
   // step 1
   for (uint8_t idx = 0; idx < alloc_info->vbuffer_num; idx++)
     {
@@ -280,7 +501,9 @@ int dnn_preallocate_chunks(dnn_global_context_t * ctx,
   /* count the total size of variable buffers that preallocation is NOT done */
   if (dnn_vbuffer_alloc_info_remaining_bsize(alloc_info) != 0u)
     {
-      new_chunk = dnn_create_chunk(ctx, alloc_info);    // step 2
+      new_chunk = dnn_create_chunk(ctx,
+                                   dnn_vbuffer_alloc_info_remaining_bsize
+                                   (alloc_info));       // step 2
       if (new_chunk != NULL)
         {
           // step 3
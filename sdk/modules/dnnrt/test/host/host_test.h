@@ -0,0 +1,102 @@
+/****************************************************************************
+ * modules/dnnrt/test/host/host_test.h
+ *
+ *   Copyright 2018 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_DNNRT_TEST_HOST_HOST_TEST_H
+#define __MODULES_DNNRT_TEST_HOST_HOST_TEST_H
+
+/* Minimal checks for host tests.  A failed check is reported with its
+ * location and the test goes on, then main() returns TEST_RESULT().
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TEST_CHECK(cond) \
+  do \
+    { \
+      if (!(cond)) \
+        { \
+          printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+          g_test_failed++; \
+        } \
+    } \
+  while (0)
+
+#define TEST_CHECK_EQ(a, b) \
+  do \
+    { \
+      long long a_ = (long long)(a); \
+      long long b_ = (long long)(b); \
+      if (a_ != b_) \
+        { \
+          printf("%s:%d: check failed: %s == %s (%lld != %lld)\n", \
+                 __FILE__, __LINE__, #a, #b, a_, b_); \
+          g_test_failed++; \
+        } \
+    } \
+  while (0)
+
+#define TEST_RESULT(name) \
+  (printf("%s: %s\n", (name), g_test_failed ? "FAILED" : "passed"), \
+   (g_test_failed ? 1 : 0))
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+static int g_test_failed;
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+static inline uint64_t test_now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+#endif /* __MODULES_DNNRT_TEST_HOST_HOST_TEST_H */
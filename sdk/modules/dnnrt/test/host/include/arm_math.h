@@ -0,0 +1,167 @@
+/****************************************************************************
+ * modules/dnnrt/test/host/include/arm_math.h
+ *
+ *   Copyright 2018 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_DNNRT_TEST_HOST_INCLUDE_ARM_MATH_H
+#define __MODULES_DNNRT_TEST_HOST_INCLUDE_ARM_MATH_H
+
+/* Host stand-in for the CMSIS-DSP header.  Only the types and the DSP
+ * intrinsics used by the CMSIS-NN convolution sources are provided, each
+ * one written in C with the semantics of the Cortex-M4 instruction, so that
+ * the reference functions run their ARM_MATH_DSP path on the host.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define ARM_MATH_DSP
+
+#define __STATIC_FORCEINLINE static inline
+
+/* Unaligned 32-bit access through a q7_t/q15_t pointer, build with
+ * -fno-strict-aliasing.
+ */
+
+#define __SIMD32(addr) (*(int32_t **)&(addr))
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+typedef int8_t  q7_t;
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+typedef int64_t q63_t;
+typedef float   float32_t;
+
+typedef enum
+{
+  ARM_MATH_SUCCESS = 0,
+  ARM_MATH_ARGUMENT_ERROR = -1,
+  ARM_MATH_LENGTH_ERROR = -2,
+  ARM_MATH_SIZE_MISMATCH = -3,
+  ARM_MATH_NANINF = -4,
+  ARM_MATH_SINGULAR = -5,
+  ARM_MATH_TEST_FAILURE = -6
+} arm_status;
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/* Dual 16-bit multiply with 32-bit accumulate, wrapping on overflow */
+
+static inline q31_t __SMLAD(q31_t x, q31_t y, q31_t sum)
+{
+  int32_t p1 = (int32_t)(int16_t)x * (int16_t)y;
+  int32_t p2 = (int32_t)(int16_t)(x >> 16) * (int16_t)(y >> 16);
+
+  return (q31_t)((uint32_t)sum + (uint32_t)p1 + (uint32_t)p2);
+}
+
+static inline q31_t __SSAT(q31_t val, uint32_t sat)
+{
+  q31_t max = (1 << (sat - 1)) - 1;
+  q31_t min = -max - 1;
+
+  return val > max ? max : (val < min ? min : val);
+}
+
+static inline uint32_t __ROR(uint32_t op1, uint32_t op2)
+{
+  op2 %= 32;
+
+  return op2 == 0 ? op1 : (op1 >> op2) | (op1 << (32 - op2));
+}
+
+/* Sign extend bytes 0 and 2 into the two halfwords */
+
+static inline q31_t __SXTB16(uint32_t op1)
+{
+  uint32_t lo = (uint16_t)(int16_t)(int8_t)(op1 & 0xff);
+  uint32_t hi = (uint16_t)(int16_t)(int8_t)((op1 >> 16) & 0xff);
+
+  return (q31_t)(lo | (hi << 16));
+}
+
+/* Per byte and per halfword saturating subtraction */
+
+static inline uint32_t __QSUB8(uint32_t x, uint32_t y)
+{
+  uint32_t r = 0;
+  int32_t d;
+  int i;
+
+  for (i = 0; i < 32; i += 8)
+    {
+      d = (int8_t)(x >> i) - (int8_t)(y >> i);
+      d = d > 127 ? 127 : (d < -128 ? -128 : d);
+      r |= (uint32_t)(uint8_t)d << i;
+    }
+
+  return r;
+}
+
+static inline uint32_t __QSUB16(uint32_t x, uint32_t y)
+{
+  uint32_t r = 0;
+  int32_t d;
+  int i;
+
+  for (i = 0; i < 32; i += 16)
+    {
+      d = (int16_t)(x >> i) - (int16_t)(y >> i);
+      d = d > 32767 ? 32767 : (d < -32768 ? -32768 : d);
+      r |= (uint32_t)(uint16_t)d << i;
+    }
+
+  return r;
+}
+
+#define __PKHBT(a, b, s) \
+  ((q31_t)(((uint32_t)(a) & 0x0000ffffu) | \
+           (((uint32_t)(b) << (s)) & 0xffff0000u)))
+
+#define __PKHTB(a, b, s) \
+  ((q31_t)(((uint32_t)(a) & 0xffff0000u) | \
+           (((uint32_t)(b) >> (s)) & 0x0000ffffu)))
+
+#endif /* __MODULES_DNNRT_TEST_HOST_INCLUDE_ARM_MATH_H */
@@ -0,0 +1,119 @@
+/****************************************************************************
+ * modules/dnnrt/test/host/include/dnnrt/nnablart/network.h
+ *
+ *   Copyright 2018 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_DNNRT_TEST_HOST_INCLUDE_DNNRT_NNABLART_NETWORK_H
+#define __MODULES_DNNRT_TEST_HOST_INCLUDE_DNNRT_NNABLART_NETWORK_H
+
+/* Host stand-in for the network format of the nnabla-c-runtime, which the
+ * dnnrt build copies here.  Only the members read by dnnrt are declared,
+ * and the enum values are not the ones of the .nnb format: the tests build
+ * their networks in memory.  As in the real format, each list and each
+ * element is referred by its byte offset from the top of nn_network_t.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define NN_GET(N, X) ((void *)((uint8_t *)(N) + (X)))
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+typedef int nn_list_index_t;
+
+typedef struct
+{
+  int size;
+  nn_list_index_t list;
+} nn_list_t;
+
+typedef enum
+{
+  NN_DATA_TYPE_FLOAT,
+  NN_DATA_TYPE_INT16,
+  NN_DATA_TYPE_INT8,
+  NN_DATA_TYPE_SIGN
+} nn_data_type_t;
+
+typedef enum
+{
+  NN_FUNCTION_AFFINE,
+  NN_FUNCTION_CONVOLUTION,
+  NN_FUNCTION_CONVOLUTION_0,
+  NN_FUNCTION_RELU,
+  NN_FUNCTION_BATCH_NORMALIZATION,
+  NN_FUNCTION_ADD2
+} nn_function_type_t;
+
+/* A negative data_index is a variable buffer, -1 - data_index, otherwise
+ * the data is a parameter of the network.
+ */
+
+typedef struct
+{
+  nn_list_t shape;
+  unsigned int type : 4;
+  unsigned int fp_pos : 4;
+  int data_index : 24;
+} nn_variable_t;
+
+typedef struct
+{
+  unsigned int type : 16;
+  unsigned int impl : 16;
+  nn_list_t inputs;
+  nn_list_t outputs;
+} nn_function_t;
+
+typedef struct
+{
+  int magic;
+  int version;
+  int api_level;
+  nn_list_t buffers;
+  nn_list_t variables;
+  nn_list_t functions;
+  nn_list_t inputs;
+  nn_list_t outputs;
+} nn_network_t;
+
+#endif /* __MODULES_DNNRT_TEST_HOST_INCLUDE_DNNRT_NNABLART_NETWORK_H */
@@ -0,0 +1,94 @@
+/****************************************************************************
+ * modules/dnnrt/test/host/include/nnablart/functions.h
+ *
+ *   Copyright 2018 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_DNNRT_TEST_HOST_INCLUDE_NNABLART_FUNCTIONS_H
+#define __MODULES_DNNRT_TEST_HOST_INCLUDE_NNABLART_FUNCTIONS_H
+
+/* Host stand-in for the nnabla-c-runtime header, with only the types and
+ * members dnnrt uses.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dnnrt/nnablart/network.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+typedef int nn_size_t;
+
+typedef struct
+{
+  int size;
+  int *data;
+} rt_list_t;
+
+typedef enum
+{
+  RT_FUNCTION_ERROR_ERROR = -1,
+  RT_FUNCTION_ERROR_NOERROR = 0
+} rt_function_error_t;
+
+typedef struct
+{
+  rt_list_t shape;
+  nn_data_type_t type;
+  float coefficient;
+  int fp_pos;
+  void *data;
+} rt_variable_t;
+
+typedef struct rt_function_s
+{
+  unsigned int num_of_inputs;
+  rt_variable_t **inputs;
+  unsigned int num_of_outputs;
+  rt_variable_t **outputs;
+  rt_function_error_t (*exec_func)(struct rt_function_s *f);
+  void *local_context;
+} rt_function_t;
+
+typedef struct
+{
+  rt_list_t axes;
+  float decay_rate;
+  float eps;
+  uint8_t batch_stat;
+  void *data;
+} batch_normalization_local_context_t;
+
+#endif /* __MODULES_DNNRT_TEST_HOST_INCLUDE_NNABLART_FUNCTIONS_H */
@@ -0,0 +1,470 @@
+/****************************************************************************
+ * modules/dnnrt/test/test_conv.c
+ *
+ *   Copyright 2018 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of the depthwise 3x3 and pointwise convolution kernels.  Random
+ * shapes are run through the kernels and through the CMSIS-NN CHW
+ * convolution, which the runtime calls for any other convolution, and the
+ * outputs must be bit-exact for q7 and q15.  The depthwise reference is
+ * called per channel, as the generic path does for each group.  With -b,
+ * both are timed on a MobileNet sized layer.
+ *
+ * Usage: test_conv [-b] [count]
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "convolution_kernels.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MAX_DIM     (24)
+#define MAX_CH      (16)
+#define MAX_PIXELS  (MAX_DIM * MAX_DIM)
+
+/* Padding by 2 makes the output larger than the input */
+
+#define MAX_OUT     ((MAX_DIM + 2) * (MAX_DIM + 2))
+
+/* q15 operands are kept small enough that no sum overflows a q31_t */
+
+#define Q15_RANGE   (4096)
+
+#define BENCH_DIM   (48)
+#define BENCH_CH    (32)
+#define BENCH_OCH   (64)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static uint32_t g_seed = 1;
+
+/* im2col buffer of the reference, two columns of q15_t */
+
+static q15_t g_bufa[2 * 9 * BENCH_OCH];
+static q31_t g_acc[BENCH_DIM * BENCH_DIM];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int rnd(int min, int max)
+{
+  g_seed = g_seed * 1103515245u + 12345u;
+
+  return min + (int)((g_seed >> 8) % (uint32_t)(max - min + 1));
+}
+
+static void fill_q7(q7_t *buf, int n)
+{
+  while (n--)
+    {
+      *buf++ = (q7_t)rnd(-128, 127);
+    }
+}
+
+static void fill_q15(q15_t *buf, int n)
+{
+  while (n--)
+    {
+      *buf++ = (q15_t)rnd(-Q15_RANGE, Q15_RANGE);
+    }
+}
+
+/* The fused activation of the kernels, applied to the reference output */
+
+static void relu_q7(q7_t *buf, int n)
+{
+  for (; n > 0; n--, buf++)
+    {
+      *buf = *buf < 0 ? 0 : *buf;
+    }
+}
+
+static void relu_q15(q15_t *buf, int n)
+{
+  for (; n > 0; n--, buf++)
+    {
+      *buf = *buf < 0 ? 0 : *buf;
+    }
+}
+
+static void rnd_geom(dnnrt_conv_geom_t *g)
+{
+  do
+    {
+      g->in_w = rnd(1, MAX_DIM);
+      g->in_h = rnd(1, MAX_DIM);
+      g->pad_x = rnd(0, 2);
+      g->pad_y = rnd(0, 2);
+      g->stride_x = rnd(1, 2);
+      g->stride_y = rnd(1, 2);
+    }
+  while (g->in_w + 2 * g->pad_x < 3 || g->in_h + 2 * g->pad_y < 3);
+
+  g->out_w = (g->in_w + 2 * g->pad_x - 3) / g->stride_x + 1;
+  g->out_h = (g->in_h + 2 * g->pad_y - 3) / g->stride_y + 1;
+}
+
+static void check_depthwise_q7(bool relu)
+{
+  static q7_t in[MAX_CH * MAX_PIXELS];
+  static q7_t out[MAX_CH * MAX_OUT];
+  static q7_t ref[MAX_CH * MAX_OUT];
+  q7_t wt[MAX_CH * 9];
+  q7_t bias[MAX_CH];
+  dnnrt_conv_geom_t g;
+  int ch = rnd(1, MAX_CH);
+  int in_px;
+  int out_px;
+  uint16_t bias_shift = rnd(0, 6);
+  uint16_t out_shift = rnd(1, 10);
+  int c;
+
+  rnd_geom(&g);
+  in_px = g.in_w * g.in_h;
+  out_px = g.out_w * g.out_h;
+
+  fill_q7(in, ch * in_px);
+  fill_q7(wt, ch * 9);
+  fill_q7(bias, ch);
+
+  /* arm_convolve_CHW_q7_basic_nonsquare always reads the bias */
+
+  for (c = 0; c < ch; c++)
+    {
+      arm_convolve_CHW_q7_basic_nonsquare(in + c * in_px, g.in_w, g.in_h, 1,
+                                          wt + c * 9, 1, 3, 3,
+                                          g.pad_x, g.pad_y,
+                                          g.stride_x, g.stride_y,
+                                          bias + c, bias_shift, out_shift,
+                                          ref + c * out_px,
+                                          g.out_w, g.out_h, g_bufa, NULL);
+    }
+
+  if (relu)
+    {
+      relu_q7(ref, ch * out_px);
+    }
+
+  memset(out, 0x55, sizeof(out));
+  dnnrt_depthwise_conv3x3_q7(in, in_px, wt, bias, bias_shift, out_shift,
+                             out, out_px, ch, &g, relu);
+
+  if (memcmp(out, ref, ch * out_px) != 0)
+    {
+      printf("depthwise q7 %dx%d ch %d pad %d,%d stride %d,%d relu %d\n",
+             g.in_w, g.in_h, ch, g.pad_x, g.pad_y, g.stride_x, g.stride_y,
+             relu);
+      TEST_CHECK(memcmp(out, ref, ch * out_px) == 0);
+    }
+}
+
+static void check_depthwise_q15(bool usebias, bool relu)
+{
+  static q15_t in[MAX_CH * MAX_PIXELS];
+  static q15_t out[MAX_CH * MAX_OUT];
+  static q15_t ref[MAX_CH * MAX_OUT];
+  q15_t wt[MAX_CH * 9];
+  q15_t bias[MAX_CH];
+  dnnrt_conv_geom_t g;
+  int ch = rnd(1, MAX_CH);
+  int in_px;
+  int out_px;
+  uint16_t bias_shift = rnd(0, 6);
+  uint16_t out_shift = rnd(1, 16);
+  int c;
+
+  rnd_geom(&g);
+  in_px = g.in_w * g.in_h;
+  out_px = g.out_w * g.out_h;
+
+  fill_q15(in, ch * in_px);
+  fill_q15(wt, ch * 9);
+  fill_q15(bias, ch);
+
+  for (c = 0; c < ch; c++)
+    {
+      arm_convolve_CHW_q15_basic_nonsquare(in + c * in_px, g.in_w, g.in_h, 1,
+                                           wt + c * 9, 1, 3, 3,
+                                           g.pad_x, g.pad_y,
+                                           g.stride_x, g.stride_y,
+                                           usebias ? bias + c : NULL,
+                                           bias_shift, out_shift,
+                                           ref + c * out_px,
+                                           g.out_w, g.out_h, g_bufa, NULL);
+    }
+
+  if (relu)
+    {
+      relu_q15(ref, ch * out_px);
+    }
+
+  memset(out, 0x55, sizeof(out));
+  dnnrt_depthwise_conv3x3_q15(in, in_px, wt, usebias ? bias : NULL,
+                              bias_shift, out_shift, out, out_px, ch, &g,
+                              relu);
+
+  if (memcmp(out, ref, ch * out_px * sizeof(q15_t)) != 0)
+    {
+      printf("depthwise q15 %dx%d ch %d pad %d,%d stride %d,%d "
+             "bias %d relu %d\n", g.in_w, g.in_h, ch, g.pad_x, g.pad_y,
+             g.stride_x, g.stride_y, usebias, relu);
+      TEST_CHECK(memcmp(out, ref, ch * out_px * sizeof(q15_t)) == 0);
+    }
+}
+
+static void check_pointwise_q7(bool relu)
+{
+  static q7_t in[MAX_CH * MAX_PIXELS];
+  static q7_t out[MAX_CH * MAX_PIXELS];
+  static q7_t ref[MAX_CH * MAX_PIXELS];
+  q7_t wt[MAX_CH * MAX_CH];
+  q7_t bias[MAX_CH];
+  int w = rnd(1, MAX_DIM);
+  int h = rnd(1, MAX_DIM);
+  int in_ch = rnd(1, MAX_CH);
+  int out_ch = rnd(1, MAX_CH);
+  int px = w * h;
+  uint16_t bias_shift = rnd(0, 6);
+  uint16_t out_shift = rnd(1, 10);
+
+  fill_q7(in, in_ch * px);
+  fill_q7(wt, in_ch * out_ch);
+  fill_q7(bias, out_ch);
+
+  /* Pruned weights take the kernel's skip path */
+
+  wt[rnd(0, in_ch * out_ch - 1)] = 0;
+
+  arm_convolve_CHW_q7_basic_nonsquare(in, w, h, in_ch, wt, out_ch, 1, 1,
+                                      0, 0, 1, 1, bias, bias_shift,
+                                      out_shift, ref, w, h, g_bufa, NULL);
+  if (relu)
+    {
+      relu_q7(ref, out_ch * px);
+    }
+
+  memset(out, 0x55, sizeof(out));
+  dnnrt_pointwise_conv_q7(in, px, in_ch, wt, bias, bias_shift, out_shift,
+                          out, px, out_ch, px, g_acc, relu);
+
+  if (memcmp(out, ref, out_ch * px) != 0)
+    {
+      printf("pointwise q7 %dx%d ch %d->%d relu %d\n",
+             w, h, in_ch, out_ch, relu);
+      TEST_CHECK(memcmp(out, ref, out_ch * px) == 0);
+    }
+}
+
+static void check_pointwise_q15(bool usebias, bool relu)
+{
+  static q15_t in[MAX_CH * MAX_PIXELS];
+  static q15_t out[MAX_CH * MAX_PIXELS];
+  static q15_t ref[MAX_CH * MAX_PIXELS];
+  q15_t wt[MAX_CH * MAX_CH];
+  q15_t bias[MAX_CH];
+  int w = rnd(1, MAX_DIM);
+  int h = rnd(1, MAX_DIM);
+  int in_ch = rnd(1, MAX_CH);
+  int out_ch = rnd(1, MAX_CH);
+  int px = w * h;
+  uint16_t bias_shift = rnd(0, 6);
+  uint16_t out_shift = rnd(1, 16);
+
+  fill_q15(in, in_ch * px);
+  fill_q15(wt, in_ch * out_ch);
+  fill_q15(bias, out_ch);
+  wt[rnd(0, in_ch * out_ch - 1)] = 0;
+
+  arm_convolve_CHW_q15_basic_nonsquare(in, w, h, in_ch, wt, out_ch, 1, 1,
+                                       0, 0, 1, 1, usebias ? bias : NULL,
+                                       bias_shift, out_shift, ref, w, h,
+                                       g_bufa, NULL);
+  if (relu)
+    {
+      relu_q15(ref, out_ch * px);
+    }
+
+  memset(out, 0x55, sizeof(out));
+  dnnrt_pointwise_conv_q15(in, px, in_ch, wt, usebias ? bias : NULL,
+                           bias_shift, out_shift, out, px, out_ch, px,
+                           g_acc, relu);
+
+  if (memcmp(out, ref, out_ch * px * sizeof(q15_t)) != 0)
+    {
+      printf("pointwise q15 %dx%d ch %d->%d bias %d relu %d\n",
+             w, h, in_ch, out_ch, usebias, relu);
+      TEST_CHECK(memcmp(out, ref, out_ch * px * sizeof(q15_t)) == 0);
+    }
+}
+
+static void test_depthwise(uint32_t count)
+{
+  uint32_t i;
+
+  for (i = 0; i < count; i++)
+    {
+      check_depthwise_q7(i & 1);
+      check_depthwise_q15(i & 2, i & 1);
+    }
+}
+
+static void test_pointwise(uint32_t count)
+{
+  uint32_t i;
+
+  for (i = 0; i < count; i++)
+    {
+      check_pointwise_q7(i & 1);
+      check_pointwise_q15(i & 2, i & 1);
+    }
+}
+
+/* Time per layer, in microseconds, of both ways on BENCH_DIM x BENCH_DIM
+ * planes: a BENCH_CH channel depthwise 3x3 with padding 1, then a
+ * BENCH_CH to BENCH_OCH pointwise.
+ */
+
+static void bench(uint32_t count)
+{
+  static q7_t in[BENCH_CH * BENCH_DIM * BENCH_DIM];
+  static q7_t out[BENCH_OCH * BENCH_DIM * BENCH_DIM];
+  static q7_t wt[BENCH_CH * BENCH_OCH];
+  static q7_t bias[BENCH_OCH];
+  dnnrt_conv_geom_t g =
+    {
+      BENCH_DIM, BENCH_DIM, BENCH_DIM, BENCH_DIM, 1, 1, 1, 1
+    };
+
+  int px = BENCH_DIM * BENCH_DIM;
+  uint64_t t0;
+  uint64_t t1;
+  uint64_t t2;
+  uint64_t t3;
+  uint32_t n;
+  int c;
+
+  fill_q7(in, BENCH_CH * px);
+  fill_q7(wt, BENCH_CH * BENCH_OCH);
+  fill_q7(bias, BENCH_OCH);
+
+  t0 = test_now_ns();
+  for (n = 0; n < count; n++)
+    {
+      for (c = 0; c < BENCH_CH; c++)
+        {
+          arm_convolve_CHW_q7_basic_nonsquare(in + c * px, BENCH_DIM,
+                                              BENCH_DIM, 1, wt + c * 9, 1,
+                                              3, 3, 1, 1, 1, 1, bias + c,
+                                              0, 7, out + c * px, BENCH_DIM,
+                                              BENCH_DIM, g_bufa, NULL);
+        }
+    }
+
+  t1 = test_now_ns();
+  for (n = 0; n < count; n++)
+    {
+      dnnrt_depthwise_conv3x3_q7(in, px, wt, bias, 0, 7, out, px,
+                                 BENCH_CH, &g, 0);
+    }
+
+  t2 = test_now_ns();
+  for (n = 0; n < count; n++)
+    {
+      arm_convolve_CHW_q7_basic_nonsquare(in, BENCH_DIM, BENCH_DIM,
+                                          BENCH_CH, wt, BENCH_OCH, 1, 1,
+                                          0, 0, 1, 1, bias, 0, 7, out,
+                                          BENCH_DIM, BENCH_DIM, g_bufa,
+                                          NULL);
+    }
+
+  t3 = test_now_ns();
+  printf("depthwise q7 %dx%dx%d: cmsis %.1f us, kernel %.1f us\n",
+         BENCH_DIM, BENCH_DIM, BENCH_CH,
+         (t1 - t0) / 1000.0 / count, (t2 - t1) / 1000.0 / count);
+
+  t0 = test_now_ns();
+  for (n = 0; n < count; n++)
+    {
+      dnnrt_pointwise_conv_q7(in, px, BENCH_CH, wt, bias, 0, 7, out, px,
+                              BENCH_OCH, px, g_acc, 0);
+    }
+
+  t1 = test_now_ns();
+  printf("pointwise q7 %dx%dx%d->%d: cmsis %.1f us, kernel %.1f us\n",
+         BENCH_DIM, BENCH_DIM, BENCH_CH, BENCH_OCH,
+         (t3 - t2) / 1000.0 / count, (t1 - t0) / 1000.0 / count);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+  uint32_t count = 2000;
+  bool     dobench = false;
+  int      i;
+
+  for (i = 1; i < argc; i++)
+    {
+      if (strcmp(argv[i], "-b") == 0)
+        {
+          dobench = true;
+        }
+      else
+        {
+          count = (uint32_t)strtoul(argv[i], NULL, 0);
+        }
+    }
+
+  test_depthwise(count);
+  test_pointwise(count);
+
+  if (dobench)
+    {
+      bench(count / 20 + 1);
+    }
+
+  return TEST_RESULT("test_conv");
+}
@@ -0,0 +1,650 @@
+/****************************************************************************
+ * modules/dnnrt/test/test_fusion.c
+ *
+ *   Copyright 2018 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of the BatchNormalization folding.  A float convolution or
+ * affine followed by a BatchNormalization is computed with the original
+ * parameters in double precision, then with the weight and bias folded by
+ * dnn_fusion_fold_bn() in float, and each output must agree within a
+ * tolerance relative to the magnitude of the terms summed.  The chain
+ * rewrite of dnn_fusion_apply() and the cases where folding is refused are
+ * checked as well.  With -b, the largest error seen and the time of a
+ * layer with and without the folding are reported.
+ *
+ * Usage: test_fusion [-b] [count]
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include "host_test.h"
+
+/* The folding is private, the test includes the fusion source */
+
+#include "../src/runtime/fusion.c"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MAX_CH      (16)
+#define MAX_K       (3)
+#define MAX_DIM     (8)
+#define MAX_WSIZE   (MAX_CH * MAX_CH * MAX_K * MAX_K)
+#define MAX_IN      (MAX_CH * MAX_DIM * MAX_DIM)
+
+/* Folding adds a rounding per weight and per bias, so that the error of
+ * the float output stays within a few ulps (1.2e-7) of the sum of the
+ * magnitudes of its terms.
+ */
+
+#define TOLERANCE   (1e-6)
+
+#define BENCH_CH    (16)
+#define BENCH_OCH   (32)
+#define BENCH_DIM   (24)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A convolution, or an affine if k is 0, followed by a BatchNormalization.
+ * Convolutions are run with stride 1 and no padding.
+ */
+
+struct test_layer_s
+{
+  int in_ch;
+  int out_ch;
+  int k;
+  int dim;
+  float x[MAX_IN];
+  float w[MAX_WSIZE];
+  float b[MAX_CH];
+  float beta[MAX_CH];
+  float gamma[MAX_CH];
+  float mean[MAX_CH];
+  float var[MAX_CH];
+  float eps;
+};
+
+/* The network objects of the runtime for a test_layer_s */
+
+struct test_rt_s
+{
+  int xshape[3];
+  int wshape[4];
+  int bshape[1];
+  int axes[1];
+  rt_variable_t x;
+  rt_variable_t w;
+  rt_variable_t b;
+  rt_variable_t y;
+  rt_variable_t bnparam[4];
+  rt_variable_t z;
+  rt_variable_t r;
+  rt_variable_t *f_in[3];
+  rt_variable_t *f_out[1];
+  rt_variable_t *bn_in[5];
+  rt_variable_t *bn_out[1];
+  rt_variable_t *relu_in[1];
+  rt_variable_t *relu_out[1];
+  batch_normalization_local_context_t bc;
+  nn_function_t info[3];
+  rt_function_context_t funcs[3];
+  rt_context_t c;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static uint32_t g_seed = 1;
+static dnn_global_context_t g_ctx;
+static rt_function_t *g_relu_head;
+static int g_relu_ret;
+static double g_maxerr;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static float frnd(float min, float max)
+{
+  g_seed = g_seed * 1103515245u + 12345u;
+
+  return min + (max - min) * (float)(g_seed >> 8) / (float)(1u << 24);
+}
+
+static int rnd(int min, int max)
+{
+  g_seed = g_seed * 1103515245u + 12345u;
+
+  return min + (int)((g_seed >> 8) % (uint32_t)(max - min + 1));
+}
+
+static int out_dim(const struct test_layer_s *l)
+{
+  return l->k ? l->dim - l->k + 1 : 1;
+}
+
+static int wsize(const struct test_layer_s *l)
+{
+  return l->out_ch * l->in_ch * (l->k ? l->k * l->k : 1);
+}
+
+static void gen_layer(struct test_layer_s *l, bool affine)
+{
+  int i;
+
+  l->in_ch = rnd(1, MAX_CH);
+  l->out_ch = rnd(1, MAX_CH);
+  l->k = affine ? 0 : rnd(1, MAX_K);
+  l->dim = affine ? 1 : rnd(l->k, MAX_DIM);
+  l->eps = rnd(0, 1) ? 1e-5f : 1e-3f;
+
+  for (i = 0; i < l->in_ch * l->dim * l->dim; i++)
+    {
+      l->x[i] = frnd(-4.0f, 4.0f);
+    }
+
+  for (i = 0; i < wsize(l); i++)
+    {
+      l->w[i] = frnd(-1.0f, 1.0f);
+    }
+
+  for (i = 0; i < l->out_ch; i++)
+    {
+      l->b[i] = frnd(-1.0f, 1.0f);
+      l->beta[i] = frnd(-1.0f, 1.0f);
+      l->gamma[i] = frnd(0.1f, 4.0f);
+      l->mean[i] = frnd(-2.0f, 2.0f);
+
+      /* small variances give the largest scales */
+
+      l->var[i] = rnd(0, 3) ? frnd(0.1f, 10.0f) : frnd(0.0f, 1e-3f);
+    }
+}
+
+/* Output pixel (oc, p) of the convolution, in double, and the sum of the
+ * magnitudes of its terms.
+ */
+
+static double conv_at(const struct test_layer_s *l, const float *w,
+                      const float *b, int oc, int p, double *mag)
+{
+  int od = out_dim(l);
+  int kk = l->k ? l->k : 1;
+  int oy = p / od;
+  int ox = p % od;
+  double sum = b[oc];
+  double t;
+  int ic;
+  int ky;
+  int kx;
+
+  *mag = fabs(sum);
+  for (ic = 0; ic < l->in_ch; ic++)
+    {
+      for (ky = 0; ky < kk; ky++)
+        {
+          for (kx = 0; kx < kk; kx++)
+            {
+              t = (double)w[((oc * l->in_ch + ic) * kk + ky) * kk + kx] *
+                  l->x[(ic * l->dim + oy + ky) * l->dim + ox + kx];
+              sum += t;
+              *mag += fabs(t);
+            }
+        }
+    }
+
+  return sum;
+}
+
+/* Convolution in float, as the runtime computes it */
+
+static void conv_float(const struct test_layer_s *l, const float *w,
+                       const float *b, float *y)
+{
+  int od = out_dim(l);
+  int kk = l->k ? l->k : 1;
+  int oc;
+  int ic;
+  int p;
+  int ky;
+  int kx;
+  float sum;
+
+  for (oc = 0; oc < l->out_ch; oc++)
+    {
+      for (p = 0; p < od * od; p++)
+        {
+          sum = b[oc];
+          for (ic = 0; ic < l->in_ch; ic++)
+            {
+              for (ky = 0; ky < kk; ky++)
+                {
+                  for (kx = 0; kx < kk; kx++)
+                    {
+                      sum += w[((oc * l->in_ch + ic) * kk + ky) * kk + kx] *
+                        l->x[(ic * l->dim + p / od + ky) * l->dim +
+                             p % od + kx];
+                    }
+                }
+            }
+
+          *y++ = sum;
+        }
+    }
+}
+
+static void bn_float(const struct test_layer_s *l, float *y)
+{
+  int od = out_dim(l);
+  int oc;
+  int p;
+
+  for (oc = 0; oc < l->out_ch; oc++)
+    {
+      for (p = 0; p < od * od; p++, y++)
+        {
+          *y = (*y - l->mean[oc]) * l->gamma[oc] /
+            sqrtf(l->var[oc] + l->eps) + l->beta[oc];
+        }
+    }
+}
+
+static void setup_var(rt_variable_t *v, float *data, int *shape, int ndim)
+{
+  memset(v, 0, sizeof(*v));
+  v->type = NN_DATA_TYPE_FLOAT;
+  v->shape.size = ndim;
+  v->shape.data = shape;
+  v->data = data;
+}
+
+/* Build the runtime objects of a layer: functions are the head, the
+ * BatchNormalization and a ReLU, and y, z, r are their outputs.
+ */
+
+static void setup_rt(struct test_rt_s *rt, struct test_layer_s *l,
+                     float *y, float *z, float *r)
+{
+  int i;
+
+  memset(rt, 0, sizeof(*rt));
+  rt->xshape[0] = l->in_ch;
+  rt->xshape[1] = l->dim;
+  rt->xshape[2] = l->dim;
+  rt->wshape[0] = l->out_ch;
+  rt->wshape[1] = l->in_ch;
+  rt->wshape[2] = l->k ? l->k : 1;
+  rt->wshape[3] = l->k ? l->k : 1;
+  rt->bshape[0] = l->out_ch;
+  rt->axes[0] = 1;
+
+  setup_var(&rt->x, l->x, rt->xshape, 3);
+  setup_var(&rt->w, l->w, rt->wshape, 4);
+  setup_var(&rt->b, l->b, rt->bshape, 1);
+  setup_var(&rt->y, y, rt->bshape, 1);
+  setup_var(&rt->bnparam[0], l->beta, rt->bshape, 1);
+  setup_var(&rt->bnparam[1], l->gamma, rt->bshape, 1);
+  setup_var(&rt->bnparam[2], l->mean, rt->bshape, 1);
+  setup_var(&rt->bnparam[3], l->var, rt->bshape, 1);
+  setup_var(&rt->z, z, rt->bshape, 1);
+  setup_var(&rt->r, r, rt->bshape, 1);
+
+  rt->f_in[X] = &rt->x;
+  rt->f_in[WEIGHT] = &rt->w;
+  rt->f_in[BIAS] = &rt->b;
+  rt->f_out[0] = &rt->y;
+  rt->bn_in[X] = &rt->y;
+  rt->bn_in[BETA] = &rt->bnparam[0];
+  rt->bn_in[GAMMA] = &rt->bnparam[1];
+  rt->bn_in[MEAN] = &rt->bnparam[2];
+  rt->bn_in[VARIANCE] = &rt->bnparam[3];
+  rt->bn_out[0] = &rt->z;
+  rt->relu_in[0] = &rt->z;
+  rt->relu_out[0] = &rt->r;
+
+  rt->bc.axes.size = 1;
+  rt->bc.axes.data = rt->axes;
+  rt->bc.eps = l->eps;
+
+  rt->info[0].type = l->k ? NN_FUNCTION_CONVOLUTION : NN_FUNCTION_AFFINE;
+  rt->info[1].type = NN_FUNCTION_BATCH_NORMALIZATION;
+  rt->info[2].type = NN_FUNCTION_RELU;
+
+  rt->funcs[0].func.num_of_inputs = 3;
+  rt->funcs[0].func.inputs = rt->f_in;
+  rt->funcs[0].func.num_of_outputs = 1;
+  rt->funcs[0].func.outputs = rt->f_out;
+  rt->funcs[1].func.num_of_inputs = 5;
+  rt->funcs[1].func.inputs = rt->bn_in;
+  rt->funcs[1].func.num_of_outputs = 1;
+  rt->funcs[1].func.outputs = rt->bn_out;
+  rt->funcs[1].func.local_context = &rt->bc;
+  rt->funcs[2].func.num_of_inputs = 1;
+  rt->funcs[2].func.inputs = rt->relu_in;
+  rt->funcs[2].func.num_of_outputs = 1;
+  rt->funcs[2].func.outputs = rt->relu_out;
+
+  for (i = 0; i < 3; i++)
+    {
+      rt->funcs[i].info = &rt->info[i];
+    }
+
+  rt->c.num_of_functions = 3;
+  rt->c.functions = rt->funcs;
+}
+
+/* Compare the output computed with the folded parameters against the
+ * reference computed from the original ones.
+ */
+
+static int check_output(const struct test_layer_s *l, const float *w,
+                        const float *b, bool relu)
+{
+  static float y[MAX_CH * MAX_DIM * MAX_DIM];
+  int od = out_dim(l);
+  double ref;
+  double mag;
+  double scale;
+  double err;
+  float out;
+  int errors = 0;
+  int oc;
+  int p;
+
+  conv_float(l, w, b, y);
+
+  for (oc = 0; oc < l->out_ch; oc++)
+    {
+      scale = l->gamma[oc] / sqrt((double)l->var[oc] + l->eps);
+      for (p = 0; p < od * od; p++)
+        {
+          ref = (conv_at(l, l->w, l->b, oc, p, &mag) - l->mean[oc]) *
+            scale + l->beta[oc];
+          mag = (mag + fabs(l->mean[oc])) * fabs(scale) + fabs(l->beta[oc]);
+          out = y[oc * od * od + p];
+          if (relu)
+            {
+              ref = ref < 0.0 ? 0.0 : ref;
+              out = out < 0.0f ? 0.0f : out;
+            }
+
+          err = fabs(out - ref) / mag;
+          g_maxerr = err > g_maxerr ? err : g_maxerr;
+          if (err > TOLERANCE)
+            {
+              printf("ch %d px %d: %g, expected %g\n", oc, p, out, ref);
+              errors++;
+            }
+        }
+    }
+
+  return errors;
+}
+
+static void test_fold(uint32_t count)
+{
+  static struct test_layer_s l;
+  struct test_rt_s rt;
+  float w[MAX_WSIZE];
+  float b[MAX_CH];
+  uint32_t i;
+
+  for (i = 0; i < count; i++)
+    {
+      gen_layer(&l, i & 1);
+      memcpy(w, l.w, sizeof(w));
+      memcpy(b, l.b, sizeof(b));
+      setup_rt(&rt, &l, NULL, NULL, NULL);
+
+      TEST_CHECK_EQ(dnn_fusion_fold_bn(&g_ctx, &rt.c, &rt.funcs[0].func,
+                                       &rt.funcs[1].func), RT_RET_NOERROR);
+
+      /* the parameters of the network are left as they are */
+
+      TEST_CHECK(rt.w.data != l.w && rt.b.data != l.b);
+      TEST_CHECK(memcmp(w, l.w, sizeof(w)) == 0);
+      TEST_CHECK(memcmp(b, l.b, sizeof(b)) == 0);
+
+      if (check_output(&l, rt.w.data, rt.b.data, false) != 0)
+        {
+          printf("%s %d->%d k %d eps %g\n", l.k ? "conv" : "affine",
+                 l.in_ch, l.out_ch, l.k, l.eps);
+          TEST_CHECK(0);
+        }
+
+      dnn_fusion_release(&g_ctx, &rt.c);
+      TEST_CHECK(g_ctx.fused_params == NULL);
+    }
+}
+
+static void check_refused(struct test_rt_s *rt, struct test_layer_s *l)
+{
+  TEST_CHECK_EQ(dnn_fusion_fold_bn(&g_ctx, &rt->c, &rt->funcs[0].func,
+                                   &rt->funcs[1].func), -EPERM);
+  TEST_CHECK(rt->w.data == l->w && rt->b.data == l->b);
+  TEST_CHECK(g_ctx.fused_params == NULL);
+}
+
+static void test_refuse(void)
+{
+  static struct test_layer_s l;
+  struct test_rt_s rt;
+  int shape[1];
+
+  gen_layer(&l, false);
+
+  setup_rt(&rt, &l, NULL, NULL, NULL);
+  rt.bc.batch_stat = 1;
+  check_refused(&rt, &l);
+
+  setup_rt(&rt, &l, NULL, NULL, NULL);
+  rt.axes[0] = 0;
+  check_refused(&rt, &l);
+
+  setup_rt(&rt, &l, NULL, NULL, NULL);
+  rt.funcs[1].func.num_of_inputs = 3;
+  check_refused(&rt, &l);
+
+  setup_rt(&rt, &l, NULL, NULL, NULL);
+  rt.w.type = NN_DATA_TYPE_INT8;
+  check_refused(&rt, &l);
+
+  /* statistics of another number of channels */
+
+  setup_rt(&rt, &l, NULL, NULL, NULL);
+  shape[0] = l.out_ch + 1;
+  rt.bnparam[3].shape.data = shape;
+  check_refused(&rt, &l);
+
+  /* weights shared with another function */
+
+  setup_rt(&rt, &l, NULL, NULL, NULL);
+  rt.relu_in[0] = &rt.w;
+  check_refused(&rt, &l);
+}
+
+static rt_function_error_t exec_dummy(rt_function_t *f)
+{
+  return RT_FUNCTION_ERROR_NOERROR;
+}
+
+/* A convolution, BatchNormalization and ReLU chain is run by the head only,
+ * which writes into the output of the ReLU.  If the ReLU can't be fused,
+ * the chain is cut after the BatchNormalization.
+ */
+
+static void test_apply(void)
+{
+  static struct test_layer_s l;
+  static float y[MAX_CH * MAX_DIM * MAX_DIM];
+  static float z[MAX_CH * MAX_DIM * MAX_DIM];
+  static float r[MAX_CH * MAX_DIM * MAX_DIM];
+  dnn_fusion_info_t fusion;
+  struct test_rt_s rt;
+  int i;
+
+  memset(&fusion, 0, sizeof(fusion));
+  fusion.chain[0].head = 0;
+  fusion.chain[0].len = 3;
+  fusion.chain_num = 1;
+
+  for (i = 0; i < 2; i++)
+    {
+      gen_layer(&l, i);
+      setup_rt(&rt, &l, y, z, r);
+      rt.funcs[1].func.exec_func = exec_dummy;
+      rt.funcs[2].func.exec_func = exec_dummy;
+      g_relu_head = NULL;
+      g_relu_ret = i ? -EPERM : 0;
+
+      dnn_fusion_apply(&g_ctx, &rt.c, &fusion);
+
+      TEST_CHECK(g_relu_head == &rt.funcs[0].func);
+      TEST_CHECK(rt.funcs[1].func.exec_func == dnn_exec_fused);
+      if (i == 0)
+        {
+          TEST_CHECK(rt.funcs[2].func.exec_func == dnn_exec_fused);
+          TEST_CHECK(rt.y.data == r);
+        }
+      else
+        {
+          TEST_CHECK(rt.funcs[2].func.exec_func == exec_dummy);
+          TEST_CHECK(rt.y.data == z);
+        }
+
+      TEST_CHECK_EQ(check_output(&l, rt.w.data, rt.b.data, i == 0), 0);
+
+      dnn_fusion_release(&g_ctx, &rt.c);
+      TEST_CHECK(g_ctx.fused_params == NULL);
+    }
+}
+
+/* Time of a BENCH_CH to BENCH_OCH 3x3 convolution followed by its
+ * BatchNormalization, and of the same convolution with folded parameters.
+ */
+
+static void bench(uint32_t count)
+{
+  static struct test_layer_s l;
+  static float y[BENCH_OCH * BENCH_DIM * BENCH_DIM];
+  struct test_rt_s rt;
+  uint64_t t0;
+  uint64_t t1;
+  uint64_t t2;
+  uint32_t n;
+
+  gen_layer(&l, false);
+  l.in_ch = BENCH_CH;
+  l.out_ch = BENCH_OCH;
+  l.k = 3;
+  l.dim = BENCH_DIM;
+  setup_rt(&rt, &l, NULL, NULL, NULL);
+
+  t0 = test_now_ns();
+  for (n = 0; n < count; n++)
+    {
+      conv_float(&l, l.w, l.b, y);
+      bn_float(&l, y);
+    }
+
+  t1 = test_now_ns();
+  dnn_fusion_fold_bn(&g_ctx, &rt.c, &rt.funcs[0].func, &rt.funcs[1].func);
+  for (n = 0; n < count; n++)
+    {
+      conv_float(&l, rt.w.data, rt.b.data, y);
+    }
+
+  t2 = test_now_ns();
+  dnn_fusion_release(&g_ctx, &rt.c);
+
+  printf("fold: max error %.2g of the terms, conv+bn %.1f us, "
+         "folded %.1f us\n", g_maxerr, (t1 - t0) / 1000.0 / count,
+         (t2 - t1) / 1000.0 / count);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int dnnrt_convolution_fuse_relu(rt_function_t *f)
+{
+  g_relu_head = f;
+  return g_relu_ret;
+}
+
+int dnnrt_affine_fuse_relu(rt_function_t *f)
+{
+  g_relu_head = f;
+  return g_relu_ret;
+}
+
+int main(int argc, char *argv[])
+{
+  uint32_t count = 2000;
+  bool     dobench = false;
+  int      i;
+
+  for (i = 1; i < argc; i++)
+    {
+      if (strcmp(argv[i], "-b") == 0)
+        {
+          dobench = true;
+        }
+      else
+        {
+          count = (uint32_t)strtoul(argv[i], NULL, 0);
+        }
+    }
+
+  test_fold(count);
+  test_refuse();
+  test_apply();
+
+  if (dobench)
+    {
+      bench(count / 20 + 1);
+    }
+
+  return TEST_RESULT("test_fusion");
+}
@@ -0,0 +1,667 @@
+/****************************************************************************
+ * modules/dnnrt/test/test_plan.c
+ *
+ *   Copyright 2018 Sony Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Corporation nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of the variable buffer planner.  Random networks are built in
+ * memory, with variable buffers shared by variables the way the converter
+ * does, and with chains fused by the rules of dnn_fusion_plan().  The
+ * buffers are placed at the offsets planned by dnn_plan_vbuffers(), then
+ * the execution is simulated: each function fills the buffer of its output
+ * with a tag, and each read checks that the tag of the variable is still
+ * there, so that any two buffers overlapping while alive are found.  With
+ * -b, the planning time and the memory saved are reported.
+ *
+ * Usage: test_plan [-b] [count]
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include "host_test.h"
+#include "runtime_common.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MAX_FUNC      (48)
+#define MAX_VAR       (3 * MAX_FUNC)
+#define MAX_ACT       (2)
+#define MAX_VSIZE     (2048)
+#define NET_BYTES     (32 * 1024)
+#define ARENA_BYTES   (MAX_VBUFFER_NUM * MAX_VSIZE)
+
+#define ROUNDUP4(x)   (((x) + 3u) & ~3u)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct test_func_s
+{
+  int in[MAX_ACT + 1];          /* activations first, then a parameter */
+  int nact;
+  int nin;
+  int out;
+};
+
+/* Description of a network, from which the nn_network_t is built */
+
+struct test_net_s
+{
+  int nfunc;
+  int nvar;
+  int nbuf;
+  struct test_func_s func[MAX_FUNC];
+  int var_buf[MAX_VAR];         /* variable buffer, -1 for a parameter */
+  int var_size[MAX_VAR];
+  int var_def[MAX_VAR];         /* function writing it, -1 for an input */
+  int var_last[MAX_VAR];        /* last function reading it */
+  int buf_size[MAX_VBUFFER_NUM];
+  int inputs[MAX_ACT];
+  int ninputs;
+  int outputs[2];
+  int noutputs;
+  dnn_fusion_info_t fusion;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static uint32_t g_seed = 1;
+
+static union
+{
+  nn_network_t net;
+  uint8_t raw[NET_BYTES];
+} g_netbuf;
+
+static int g_netused;
+static uint8_t g_arena[ARENA_BYTES];
+static dnn_global_context_t g_ctx;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int rnd(int min, int max)
+{
+  g_seed = g_seed * 1103515245u + 12345u;
+
+  return min + (int)((g_seed >> 8) % (uint32_t)(max - min + 1));
+}
+
+static int net_alloc(int bytes)
+{
+  int off = g_netused;
+
+  g_netused += ROUNDUP4(bytes);
+  if (g_netused > NET_BYTES)
+    {
+      printf("network too large\n");
+      exit(1);
+    }
+
+  memset(NN_GET(&g_netbuf.net, off), 0, bytes);
+  return off;
+}
+
+static nn_list_t net_list(const int *items, int num)
+{
+  nn_list_t l;
+
+  l.size = num;
+  l.list = net_alloc(num * sizeof(int));
+  memcpy(NN_GET(&g_netbuf.net, l.list), items, num * sizeof(int));
+
+  return l;
+}
+
+static int add_var(struct test_net_s *t, bool param, int def)
+{
+  int v = t->nvar++;
+
+  t->var_buf[v] = param ? -1 : -2;
+  t->var_size[v] = rnd(1, MAX_VSIZE);
+  t->var_def[v] = def;
+  t->var_last[v] = -1;
+
+  return v;
+}
+
+/* Pick an activation defined before function idx, which isn't the
+ * intermediate output of a chain.
+ */
+
+static int pick_act(struct test_net_s *t, const bool *usable)
+{
+  int v;
+
+  do
+    {
+      v = rnd(0, t->nvar - 1);
+    }
+  while (!usable[v]);
+
+  return v;
+}
+
+static void add_input(struct test_net_s *t, struct test_func_s *f, int v,
+                      int idx)
+{
+  f->in[f->nin++] = v;
+  if (idx > t->var_last[v])
+    {
+      t->var_last[v] = idx;
+    }
+}
+
+/* Give each activation a variable buffer, sometimes reusing a buffer once
+ * the variable in it is dead, as the converter does.  The outputs of a chain
+ * are all written when its head is executed.  Returns false if more than
+ * MAX_VBUFFER_NUM buffers are needed.
+ */
+
+static bool assign_buffers(struct test_net_s *t)
+{
+  int busy_until[MAX_VBUFFER_NUM];
+  int def;
+  int v;
+  int b;
+  int c;
+  int n;
+  int cand[MAX_VBUFFER_NUM];
+
+  t->nbuf = 0;
+  for (v = 0; v < t->nvar; v++)
+    {
+      if (t->var_buf[v] == -1)
+        {
+          continue;
+        }
+
+      def = t->var_def[v];
+      for (c = 0; c < t->fusion.chain_num; c++)
+        {
+          if (def > t->fusion.chain[c].head &&
+              def < t->fusion.chain[c].head + t->fusion.chain[c].len)
+            {
+              def = t->fusion.chain[c].head;
+            }
+        }
+
+      /* inputs and outputs of the network are never shared */
+
+      n = 0;
+      if (def >= 0 && t->var_last[v] < t->nfunc)
+        {
+          for (b = 0; b < t->nbuf; b++)
+            {
+              if (busy_until[b] < def)
+                {
+                  cand[n++] = b;
+                }
+            }
+        }
+
+      if (n > 0 && (t->nbuf == MAX_VBUFFER_NUM || rnd(0, 2) == 0))
+        {
+          b = cand[rnd(0, n - 1)];
+        }
+      else if (t->nbuf < MAX_VBUFFER_NUM)
+        {
+          b = t->nbuf++;
+          t->buf_size[b] = 0;
+        }
+      else
+        {
+          return false;
+        }
+
+      t->var_buf[v] = b;
+      busy_until[b] = t->var_def[v] < 0 || t->var_last[v] >= t->nfunc ?
+        INT_MAX : (t->var_last[v] < def ? def : t->var_last[v]);
+      if (t->var_size[v] > t->buf_size[b])
+        {
+          t->buf_size[b] = t->var_size[v];
+        }
+    }
+
+  return true;
+}
+
+static bool gen_net(struct test_net_s *t, int maxfunc)
+{
+  bool usable[MAX_VAR];
+  struct test_func_s *f;
+  int i;
+  int j;
+  int len;
+  int prev;
+
+  memset(t, 0, sizeof(*t));
+  t->nfunc = rnd(1, maxfunc);
+  t->ninputs = rnd(1, MAX_ACT);
+  for (i = 0; i < t->ninputs; i++)
+    {
+      t->inputs[i] = add_var(t, false, -1);
+      usable[t->inputs[i]] = true;
+    }
+
+  for (i = 0; i < t->nfunc; i += len)
+    {
+      len = 1;
+      if (t->fusion.chain_num < MAX_FUSION_NUM && i + 1 < t->nfunc &&
+          rnd(0, 3) == 0)
+        {
+          len = rnd(2, t->nfunc - i < 3 ? t->nfunc - i : 3);
+          t->fusion.chain[t->fusion.chain_num].head = i;
+          t->fusion.chain[t->fusion.chain_num].len = len;
+          t->fusion.chain_num++;
+        }
+
+      for (j = 0; j < len; j++)
+        {
+          f = &t->func[i + j];
+          if (j == 0)
+            {
+              f->nact = rnd(1, MAX_ACT);
+              while (f->nin < f->nact)
+                {
+                  add_input(t, f, pick_act(t, usable), i);
+                }
+            }
+          else
+            {
+              /* only the next function reads an intermediate output */
+
+              prev = t->func[i + j - 1].out;
+              f->nact = 1;
+              add_input(t, f, prev, i + j);
+              usable[prev] = false;
+            }
+
+          if (rnd(0, 1))
+            {
+              f->in[f->nin++] = add_var(t, true, i + j);
+              usable[f->in[f->nin - 1]] = false;
+            }
+
+          f->out = add_var(t, false, i + j);
+          usable[f->out] = true;
+        }
+    }
+
+  t->outputs[t->noutputs++] = t->func[t->nfunc - 1].out;
+  if (rnd(0, 1))
+    {
+      j = pick_act(t, usable);
+      if (j != t->outputs[0])
+        {
+          t->outputs[t->noutputs++] = j;
+        }
+    }
+
+  for (i = 0; i < t->noutputs; i++)
+    {
+      t->var_last[t->outputs[i]] = t->nfunc;
+    }
+
+  return assign_buffers(t);
+}
+
+static nn_network_t *build_net(const struct test_net_s *t)
+{
+  nn_network_t *n = &g_netbuf.net;
+  int items[MAX_VAR];
+  nn_variable_t *var;
+  nn_function_t *fn;
+  int i;
+
+  g_netused = 0;
+  net_alloc(sizeof(nn_network_t));
+  n->version = 3;
+  n->buffers = net_list(t->buf_size, t->nbuf);
+
+  for (i = 0; i < t->nvar; i++)
+    {
+      items[i] = net_alloc(sizeof(nn_variable_t));
+      var = (nn_variable_t *)NN_GET(n, items[i]);
+      var->type = NN_DATA_TYPE_INT8;
+      var->data_index = t->var_buf[i] < 0 ? 0 : -1 - t->var_buf[i];
+    }
+
+  n->variables = net_list(items, t->nvar);
+
+  for (i = 0; i < t->nfunc; i++)
+    {
+      items[i] = net_alloc(sizeof(nn_function_t));
+      fn = (nn_function_t *)NN_GET(n, items[i]);
+      fn->type = NN_FUNCTION_ADD2;
+      fn->inputs = net_list(t->func[i].in, t->func[i].nin);
+      fn->outputs = net_list(&t->func[i].out, 1);
+    }
+
+  n->functions = net_list(items, t->nfunc);
+  n->inputs = net_list(t->inputs, t->ninputs);
+  n->outputs = net_list(t->outputs, t->noutputs);
+
+  return n;
+}
+
+static void sim_write(const struct test_net_s *t,
+                      const dnn_vbuffer_alloc_info_t *info, int v)
+{
+  int b = t->var_buf[v];
+
+  memset(g_arena + info->offset_list[b], v + 1,
+         ROUNDUP4(info->bsize_list[b]));
+}
+
+static int sim_read(const struct test_net_s *t,
+                    const dnn_vbuffer_alloc_info_t *info, int v)
+{
+  const uint8_t *p = g_arena + info->offset_list[t->var_buf[v]];
+  int i;
+
+  for (i = 0; i < t->var_size[v]; i++)
+    {
+      if (p[i] != (uint8_t)(v + 1))
+        {
+          return -1;
+        }
+    }
+
+  return 0;
+}
+
+static int chain_of(const struct test_net_s *t, int idx)
+{
+  int c;
+
+  for (c = 0; c < t->fusion.chain_num; c++)
+    {
+      if (idx >= t->fusion.chain[c].head &&
+          idx < t->fusion.chain[c].head + t->fusion.chain[c].len)
+        {
+          return c;
+        }
+    }
+
+  return -1;
+}
+
+/* Run the network on the planned arena, returns the number of variables
+ * found overwritten when they were read.
+ */
+
+static int simulate(const struct test_net_s *t,
+                    const dnn_vbuffer_alloc_info_t *info, bool fused)
+{
+  const struct test_func_s *f;
+  int errors = 0;
+  int i;
+  int j;
+  int c;
+
+  memset(g_arena, 0, sizeof(g_arena));
+  for (i = 0; i < t->ninputs; i++)
+    {
+      sim_write(t, info, t->inputs[i]);
+    }
+
+  for (i = 0; i < t->nfunc; i++)
+    {
+      f = &t->func[i];
+      c = fused ? chain_of(t, i) : -1;
+      if (c >= 0 && t->fusion.chain[c].head != i)
+        {
+          continue;
+        }
+
+      for (j = 0; j < f->nact; j++)
+        {
+          errors += sim_read(t, info, f->in[j]) != 0;
+        }
+
+      /* the head of a chain writes the output of its last function */
+
+      if (c >= 0)
+        {
+          f = &t->func[i + t->fusion.chain[c].len - 1];
+        }
+
+      /* a kernel reads its inputs while writing the output */
+
+      sim_write(t, info, f->out);
+      f = &t->func[i];
+      for (j = 0; j < f->nact; j++)
+        {
+          errors += sim_read(t, info, f->in[j]) != 0;
+        }
+    }
+
+  for (i = 0; i < t->noutputs; i++)
+    {
+      errors += sim_read(t, info, t->outputs[i]) != 0;
+    }
+
+  return errors;
+}
+
+static int plan(const struct test_net_s *t, bool fused,
+                dnn_vbuffer_alloc_info_t *info)
+{
+  nn_network_t *n = build_net(t);
+  int ret;
+
+  ret = dnn_peek_vbuffers(n, info);
+  if (ret == RT_RET_NOERROR)
+    {
+      ret = dnn_plan_vbuffers(n, fused ? &t->fusion : NULL, info);
+    }
+
+  return ret;
+}
+
+static void check_plan(const struct test_net_s *t, bool fused)
+{
+  dnn_vbuffer_alloc_info_t info;
+  size_t peak = 0;
+  size_t end;
+  int b;
+
+  TEST_CHECK_EQ(plan(t, fused, &info), RT_RET_NOERROR);
+
+  for (b = 0; b < t->nbuf; b++)
+    {
+      TEST_CHECK_EQ(info.offset_list[b] % 4, 0);
+      end = info.offset_list[b] + ROUNDUP4(info.bsize_list[b]);
+      peak = end > peak ? end : peak;
+    }
+
+  TEST_CHECK(peak <= info.total_bsize);
+  TEST_CHECK_EQ(info.planned_bsize, peak < info.total_bsize ? peak : 0);
+
+  if (simulate(t, &info, fused) != 0)
+    {
+      printf("overlap: %d functions %d buffers %d chains fused %d\n",
+             t->nfunc, t->nbuf, t->fusion.chain_num, fused);
+      TEST_CHECK(0);
+    }
+}
+
+static void test_random(uint32_t count)
+{
+  struct test_net_s t;
+  uint32_t i;
+
+  for (i = 0; i < count; i++)
+    {
+      if (!gen_net(&t, MAX_FUNC))
+        {
+          continue;
+        }
+
+      check_plan(&t, false);
+      check_plan(&t, true);
+    }
+}
+
+/* A chain of 8 functions needs the input, the output and two of the
+ * intermediate buffers at a time.
+ */
+
+static void test_chain(void)
+{
+  dnn_vbuffer_alloc_info_t info;
+  struct test_net_s t;
+  int i;
+
+  memset(&t, 0, sizeof(t));
+  t.nfunc = 8;
+  t.ninputs = 1;
+  t.inputs[0] = 0;
+  t.nvar = 9;
+  t.nbuf = 9;
+  for (i = 0; i < t.nvar; i++)
+    {
+      t.var_buf[i] = i;
+      t.var_size[i] = 1000;
+      t.buf_size[i] = 1000;
+    }
+
+  for (i = 0; i < t.nfunc; i++)
+    {
+      t.func[i].in[0] = i;
+      t.func[i].nin = 1;
+      t.func[i].nact = 1;
+      t.func[i].out = i + 1;
+    }
+
+  t.noutputs = 1;
+  t.outputs[0] = 8;
+
+  TEST_CHECK_EQ(plan(&t, false, &info), RT_RET_NOERROR);
+  TEST_CHECK_EQ(info.total_bsize, 9000);
+  TEST_CHECK_EQ(info.planned_bsize, 4000);
+  TEST_CHECK_EQ(simulate(&t, &info, false), 0);
+
+  /* nothing to share when every buffer is an input or an output */
+
+  t.nfunc = 1;
+  t.nvar = 2;
+  t.nbuf = 2;
+  t.outputs[0] = 1;
+  TEST_CHECK_EQ(plan(&t, false, &info), RT_RET_NOERROR);
+  TEST_CHECK_EQ(info.planned_bsize, 0);
+}
+
+static void bench(uint32_t count)
+{
+  dnn_vbuffer_alloc_info_t info;
+  struct test_net_s t;
+  nn_network_t *n;
+  uint64_t total = 0;
+  uint64_t planned = 0;
+  uint64_t ns = 0;
+  uint64_t start;
+  uint32_t nets = 0;
+  uint32_t i;
+
+  for (i = 0; i < count; i++)
+    {
+      if (!gen_net(&t, MAX_FUNC))
+        {
+          continue;
+        }
+
+      n = build_net(&t);
+      dnn_peek_vbuffers(n, &info);
+      start = test_now_ns();
+      dnn_plan_vbuffers(n, &t.fusion, &info);
+      ns += test_now_ns() - start;
+
+      total += info.total_bsize;
+      planned += info.planned_bsize ? info.planned_bsize : info.total_bsize;
+      nets++;
+    }
+
+  printf("plan: %u networks, %.0f ns per plan, arena %.1f%% of "
+         "unplanned\n", nets, (double)ns / nets,
+         100.0 * planned / total);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+dnn_global_context_t *dnn_get_global_context(void)
+{
+  return &g_ctx;
+}
+
+int main(int argc, char *argv[])
+{
+  uint32_t count = 20000;
+  bool     dobench = false;
+  int      i;
+
+  for (i = 1; i < argc; i++)
+    {
+      if (strcmp(argv[i], "-b") == 0)
+        {
+          dobench = true;
+        }
+      else
+        {
+          count = (uint32_t)strtoul(argv[i], NULL, 0);
+        }
+    }
+
+  test_chain();
+  test_random(count);
+
+  if (dobench)
+    {
+      bench(count);
+    }
+
+  return TEST_RESULT("test_plan");
+}
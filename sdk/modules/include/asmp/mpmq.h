@@ -60,6 +60,15 @@
 
 #define MPMQ_NONBLOCK 0xfffffffful  /**< Non-blocking mode */
 
+/* Ring buffer definitions for mpmq_ring_*() */
+
+#define MPMQ_RING_HDRSIZE   4       /**< Size of record header in ring */
+#define MPMQ_RING_MAXRECORD 0xfffcu /**< Maximum payload size of a record */
+
+/** Required memory size for the ring buffer with @a datasize data area */
+
+#define MPMQ_RING_SIZE(datasize) (sizeof(mpmq_ring_t) + (datasize))
+
 /********************************************************************************
  * Public Type Declarations
  ********************************************************************************/
@@ -80,6 +89,23 @@ typedef struct mpmq
   uint32_t    flags;            /**< Flags */
 } mpmq_t;
 
+/**
+ * @typedef mpmq_ring_t
+ * Single producer/single consumer ring buffer placed on MP shared memory.
+ * Data area follows this header.  Offsets are free running and only the
+ * producer updates @a head, only the consumer updates @a tail.
+ */
+
+typedef struct mpmq_ring
+{
+  volatile uint32_t head;       /**< Write offset, updated by producer */
+  volatile uint32_t tail;       /**< Read offset, updated by consumer */
+  volatile uint32_t pending;    /**< Doorbell has been sent and not handled */
+  uint32_t          size;       /**< Size of data area (power of 2) */
+  int8_t            doorbell;   /**< Message ID used for doorbell */
+  uint8_t           reserved[3];
+} mpmq_ring_t;
+
 /** @} mpmq_datatypes */
 
 #ifdef __cplusplus
@@ -207,6 +233,107 @@ int mpmq_timedreceive(mpmq_t *mq, uint32_t *data, uint32_t ms);
 
 int mpmq_notify(mpmq_t *mq, int signo, void *sigdata);
 
+/**
+ * Initialize ring buffer for MP message queue
+ *
+ * mpmq_ring_init() formats @a mem as a ring buffer which carries messages with
+ * variable-length payload. @a mem is usually a part of MP shared memory
+ * attached by both of sender and receiver, and it must be initialized before
+ * the other side uses it. Data area is the largest power of 2 which fits in
+ * @a size.
+ *
+ * @param [out] mem: Memory for the ring buffer, aligned to 4 bytes
+ * @param [in] size: Size of @a mem
+ * @param [in] doorbell: Message ID (0-127) to notify new messages by
+ * mpmq_ring_kick()
+ *
+ * @return On success, mpmq_ring_init() returns 0. On error, it returns an error
+ * number.
+ * @retval -EINVAL: Invalid argument
+ */
+
+int mpmq_ring_init(void *mem, size_t size, int8_t doorbell);
+
+/**
+ * Post message to ring buffer
+ *
+ * mpmq_ring_post() copies message into the ring buffer without notifying to the
+ * receiver. Call mpmq_ring_kick() after posting a batch of messages, then
+ * the batch costs only one inter-CPU message.
+ *
+ * @param [in,out] ring: Ring buffer initialized by mpmq_ring_init()
+ * @param [in] msgid: User defined message ID (0-127)
+ * @param [in] payload: Message payload, may be NULL if @a len is zero
+ * @param [in] len: Size of @a payload
+ *
+ * @return On success, mpmq_ring_post() returns 0. On error, it returns an error
+ * number.
+ * @retval -EINVAL: Invalid argument
+ * @retval -EAGAIN: Ring buffer is full
+ */
+
+int mpmq_ring_post(mpmq_ring_t *ring, int8_t msgid, const void *payload,
+                   size_t len);
+
+/**
+ * Notify posted messages
+ *
+ * mpmq_ring_kick() sends doorbell message via @a mq. If the previous doorbell
+ * has not been handled by the receiver yet, nothing is sent because the
+ * receiver will read all of posted messages.
+ *
+ * @param [in,out] mq: MP message queue object
+ * @param [in,out] ring: Ring buffer initialized by mpmq_ring_init()
+ *
+ * @return On success, mpmq_ring_kick() returns 0. On error, it returns an error
+ * number.
+ * @retval -EINVAL: Invalid argument
+ */
+
+int mpmq_ring_kick(mpmq_t *mq, mpmq_ring_t *ring);
+
+/**
+ * Post and notify message
+ *
+ * Same as mpmq_ring_post() followed by mpmq_ring_kick().
+ *
+ * @param [in,out] mq: MP message queue object
+ * @param [in,out] ring: Ring buffer initialized by mpmq_ring_init()
+ * @param [in] msgid: User defined message ID (0-127)
+ * @param [in] payload: Message payload, may be NULL if @a len is zero
+ * @param [in] len: Size of @a payload
+ *
+ * @return On success, mpmq_ring_send() returns 0. On error, it returns an error
+ * number.
+ * @retval -EINVAL: Invalid argument
+ * @retval -EAGAIN: Ring buffer is full
+ */
+
+int mpmq_ring_send(mpmq_t *mq, mpmq_ring_t *ring, int8_t msgid,
+                   const void *payload, size_t len);
+
+/**
+ * Receive message from ring buffer
+ *
+ * mpmq_ring_receive() never blocks. Receiver should call this function until
+ * it returns -EAGAIN when the doorbell message arrived.
+ *
+ * @param [in,out] ring: Ring buffer initialized by mpmq_ring_init()
+ * @param [out] buf: Buffer for the payload
+ * @param [in] bufsize: Size of @a buf
+ * @param [out] len: Size of received payload, may be NULL
+ *
+ * @return On success, mpmq_ring_receive() returns message ID. On error, it
+ * returns an error number.
+ * @retval -EINVAL: Invalid argument
+ * @retval -EAGAIN: No message in the ring buffer
+ * @retval -E2BIG: @a buf is too small. The message is left in the ring buffer,
+ * and @a len is set to required size.
+ */
+
+int mpmq_ring_receive(mpmq_ring_t *ring, void *buf, size_t bufsize,
+                      size_t *len);
+
 /** @} mpmq_funcs */
 
 #undef EXTERN
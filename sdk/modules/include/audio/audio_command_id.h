@@ -225,6 +225,24 @@
 
 #define  AUDRLT_SENDPFCMD_CMPLT      AUDCMD_SENDPOSTCMD
 
+/*! \brief Result Code: SetNextPlayerComplete
+ *
+ * Notified on completion of AS_SetNextPlayer(). It has no corresponding
+ * command code, so it is never counted as the completion of another
+ * command.
+ */
+
+#define  AUDRLT_SETNEXTPLAYER_CMPLT  (AUDCMD_CATEGORY_PLAYER | 0x06)
+
+/*! \brief Result Code: GetClkRecoveryStatusComplete
+ *
+ * Notified on completion of AS_GetClkRecoveryStatusOutputMixer(). It has
+ * no corresponding command code, so it is never counted as the completion
+ * of another command.
+ */
+
+#define  AUDRLT_GETCLKRCVSTATUS_CMPLT (AUDCMD_CATEGORY_PLAYER | 0x07)
+
 /** @} */
 
 /*--------------------------------------------------------------------------*/
@@ -58,6 +58,8 @@
  * Included Files
  ****************************************************************************/
 
+#include <sdk/config.h>
+
 #include "memutils/memory_manager/MemHandle.h"
 
 /****************************************************************************
@@ -729,6 +731,12 @@ typedef struct
 
   uint8_t bit_length;
 
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+  /*! \brief [in] Time stamp of reading source ES, 0 if unknown. */
+
+  uint32_t timestamp;
+#endif
+
 } AsPcmDataParam;
 
 typedef struct
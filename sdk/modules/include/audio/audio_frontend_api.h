@@ -88,6 +88,14 @@
 
 #define AS_PREPROCESS_FILE_PATH_LEN 22
 
+/*! \brief Max channels of mic array pre process */
+
+#define AS_MICARRAY_CH_MAX          8
+
+/*! \brief Max steering delay of beamforming pre process (samples) */
+
+#define AS_MICARRAY_DELAY_MAX       64
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -152,6 +160,14 @@ typedef enum
 
   AsMicFrontendPreProcUserCustom,
 
+  /*! \brief Pre Process deinterleave to per-channel (planar) buffer */
+
+  AsMicFrontendPreProcPlanar,
+
+  /*! \brief Pre Process delay-and-sum beamforming to 1 channel */
+
+  AsMicFrontendPreProcBeamform,
+
   AsMicFrontendPreProcInvalid = 0xff,
 
 } AsMicFrontendPreProcType;
@@ -302,6 +318,44 @@ typedef struct
 
 } AsInitPreProcParam, AsSetPreProcParam;
 
+/** Init/Set packet of #AsMicFrontendPreProcPlanar
+ *
+ * Output is planar, which is samples of the 1st selected channel,
+ * then the 2nd one, and so on.
+ */
+
+typedef struct
+{
+  /*! \brief [in] Bit mask of channels to output (bit0 is 1st channel).
+   *              0 means all channels.
+   */
+
+  uint8_t  ch_mask;
+
+} AsMicFrontendPlanarParam;
+
+/** Init/Set packet of #AsMicFrontendPreProcBeamform
+ *
+ * Output is 1 channel, average of selected channels each delayed by
+ * steering delay.
+ */
+
+typedef struct
+{
+  /*! \brief [in] Bit mask of channels to sum (bit0 is 1st channel).
+   *              0 means all channels.
+   */
+
+  uint8_t  ch_mask;
+
+  /*! \brief [in] Steering delay of each channel (samples).
+   *              Up to #AS_MICARRAY_DELAY_MAX.
+   */
+
+  uint16_t delay[AS_MICARRAY_CH_MAX];
+
+} AsMicFrontendBeamformParam;
+
 /** Set Mic Gain Command parameter */
 
 typedef struct
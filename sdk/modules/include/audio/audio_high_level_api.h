@@ -1700,6 +1700,28 @@ typedef struct
   uint8_t recognizer;
 } AudioSubSystemIDs;
 
+/** Trace point of audio command */
+
+typedef enum
+{
+  /*! \brief Command is sent by AS_SendAudioCommand */
+
+  AsCommandTraceSent = 0,
+
+  /*! \brief Command takes effect on audio driver */
+
+  AsCommandTraceApplied,
+} AsCommandTracePoint;
+
+/** Trace callback of audio command
+ *
+ *  Called on each trace point with command code. Time stamp is
+ *  taken by callee, difference of points is command-to-effect latency.
+ */
+
+typedef void (*AudioCommandTraceCb)(uint8_t command_code,
+                                    AsCommandTracePoint point);
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -1781,6 +1803,16 @@ int AS_CreateAudioManager(AudioSubSystemIDs ids, obs_AudioAttentionCb obs_att_cb
 
 int AS_DeleteAudioManager(void);
 
+/**
+ * @brief Set trace hook of audio command
+ *
+ * @param[in] trace_cb: AudioCommandTraceCb Trace callback, NULL to disable
+ *
+ * @retval error code
+ */
+
+int AS_SetAudioCommandTraceHook(AudioCommandTraceCb trace_cb);
+
 /** @} */
 
 #endif /* __MODULES_INCLUDE_AUDIO_AUDIO_HIGH_LEVEL_API_H */
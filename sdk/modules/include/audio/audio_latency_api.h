@@ -0,0 +1,170 @@
+/****************************************************************************
+ * modules/include/audio/audio_latency_api.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_INCLUDE_AUDIO_AUDIO_LATENCY_API_H
+#define __MODULES_INCLUDE_AUDIO_AUDIO_LATENCY_API_H
+
+/**
+ * @defgroup audioutils Audio Utility
+ * @{
+ */
+
+/**
+ * @defgroup audioutils_audio_latency_api Audio Pipeline Latency API
+ * @{
+ *
+ * @file       audio_latency_api.h
+ * @brief      CXD5602 Audio Pipeline Latency API
+ * @author     CXD5602 Audio SW Team
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sdk/config.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/** Number of histogram bins. The last bin holds all overflowed latency. */
+
+#define AS_LATENCY_BIN_NUM  32
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/** Measurement point of pipeline latency.
+ *  Each latency is measured from reading of ES by player.
+ */
+
+typedef enum
+{
+  /*! \brief Decoding done */
+
+  AsLatencyStageDecode = 0,
+
+  /*! \brief Input to output mixer (OutputMixToHPI2S) */
+
+  AsLatencyStageMixerIn,
+
+  /*! \brief Post processing done */
+
+  AsLatencyStagePostProc,
+
+  /*! \brief DMA transfer to I2S done */
+
+  AsLatencyStageDmaDone,
+
+  AsLatencyStageNum,
+} AsLatencyStage;
+
+/** Latency histogram of one stage */
+
+typedef struct
+{
+  /*! \brief [out] Width of each bin in microseconds */
+
+  uint32_t bin_width;
+
+  /*! \brief [out] Number of measured frames */
+
+  uint32_t count;
+
+  /*! \brief [out] Minimum latency in microseconds */
+
+  uint32_t min;
+
+  /*! \brief [out] Maximum latency in microseconds */
+
+  uint32_t max;
+
+  /*! \brief [out] Sum of latency in microseconds, for average */
+
+  uint64_t total;
+
+  /*! \brief [out] Number of frames in each bin */
+
+  uint32_t bin[AS_LATENCY_BIN_NUM];
+} AsLatencyHistogram;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef CONFIG_AUDIOUTILS_LATENCY_TRACE
+
+/**
+ * @brief Get latency histogram of pipeline stage
+ *
+ * @param[in]  stage : AsLatencyStage Measurement point
+ * @param[out] hist  : AsLatencyHistogram* Histogram
+ *
+ * @retval     true  : success
+ * @retval     false : failure
+ */
+
+bool AS_GetPipelineLatency(AsLatencyStage stage,
+                           FAR AsLatencyHistogram *hist);
+
+/**
+ * @brief Clear latency histograms of all stages
+ */
+
+void AS_ClearPipelineLatency(void);
+
+/* For audio objects. Get current time stamp, and record latency of the
+ * frame reaching a stage at "time" from its origin time stamp.
+ */
+
+uint32_t AS_GetLatencyTimestamp(void);
+void AS_RecordPipelineLatency(AsLatencyStage stage,
+                              uint32_t origin,
+                              uint32_t time);
+
+#endif /* CONFIG_AUDIOUTILS_LATENCY_TRACE */
+
+#endif  /* __MODULES_INCLUDE_AUDIO_AUDIO_LATENCY_API_H */
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
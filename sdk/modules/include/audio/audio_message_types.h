@@ -183,8 +183,9 @@
 #define MSG_AUD_PLY_CMD_STOP            (MSG_AUD_PLY_REQ | MSG_SET_SUBTYPE(0x03))
 #define MSG_AUD_PLY_CMD_DEACT           (MSG_AUD_PLY_REQ | MSG_SET_SUBTYPE(0x04))
 #define MSG_AUD_PLY_CMD_SETGAIN         (MSG_AUD_PLY_REQ | MSG_SET_SUBTYPE(0x05))
+#define MSG_AUD_PLY_CMD_SETNEXT         (MSG_AUD_PLY_REQ | MSG_SET_SUBTYPE(0x06))
 
-#define LAST_AUD_PLY_MSG    (MSG_AUD_PLY_CMD_SETGAIN + 1)
+#define LAST_AUD_PLY_MSG    (MSG_AUD_PLY_CMD_SETNEXT + 1)
 #define AUD_PLY_MSG_NUM     (LAST_AUD_PLY_MSG & MSG_TYPE_SUBTYPE)
 
 #define MSG_AUD_PLY_CMD_NEXT_REQ        (MSG_AUD_PLY_RES | MSG_SET_SUBTYPE(0x00))
@@ -327,9 +328,10 @@
 #define MSG_AUD_MIX_CMD_CLKRECOVERY (MSG_AUD_MIX_REQ | MSG_SET_SUBTYPE(0x04))
 #define MSG_AUD_MIX_CMD_INITMPP     (MSG_AUD_MIX_REQ | MSG_SET_SUBTYPE(0x05))
 #define MSG_AUD_MIX_CMD_SETMPP      (MSG_AUD_MIX_REQ | MSG_SET_SUBTYPE(0x06))
+#define MSG_AUD_MIX_CMD_GETCLKRCV   (MSG_AUD_MIX_REQ | MSG_SET_SUBTYPE(0x07))
 
 
-#define LAST_AUD_MIX_MSG             MSG_AUD_MIX_CMD_SETMPP
+#define LAST_AUD_MIX_MSG             MSG_AUD_MIX_CMD_GETCLKRCV
 #define AUD_MIX_MSG_NUM    (MSG_GET_SUBTYPE(LAST_AUD_MIX_MSG) + 1)
 
 #define MSG_AUD_MIX_RST_PSTFLT_DONE (MSG_AUD_MIX_RES | MSG_SET_SUBTYPE(0x00))
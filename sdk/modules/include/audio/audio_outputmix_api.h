@@ -176,6 +176,10 @@ enum AsOutputMixDoneCmdType
 
   OutputMixSetPostDone,
 
+  /*! \brief Get clock recovery status done */
+
+  OutputMixGetClkRcvDone,
+
   OutputMixDoneCmdTypeNum
 };
 
@@ -194,6 +198,10 @@ typedef enum
   /*! \brief Adjust to the - direction */
 
   OutputMixDelay = 1,
+
+  /*! \brief Adjust automatically by depth of renderer queue */
+
+  OutputMixAutoAdjust = 2,
 } AsClkRecoveryDirection;
 
 /**< Postproc type */
@@ -401,12 +409,68 @@ typedef struct
 
   int8_t   direction;
 
-  /*! \brief [in] Recovery term */
+  /*! \brief [in] Recovery term
+   *
+   * If direction is #OutputMixAutoAdjust, target depth of renderer queue
+   * (samples). 0 means depth when playback settled.
+   */
 
   uint32_t times;
 
 } AsFrameTermFineControl;
 
+/** Clock recovery status */
+
+typedef struct
+{
+  /*! \brief [out] Automatic clock recovery is running */
+
+  bool     auto_adjust;
+
+  /*! \brief [out] Estimated clock drift of source (ppm) */
+
+  int32_t  drift_ppm;
+
+  /*! \brief [out] Current correction of sampling rate (ppm) */
+
+  int32_t  ratio_ppm;
+
+  /*! \brief [out] Target depth of renderer queue (samples) */
+
+  uint32_t target_depth;
+
+  /*! \brief [out] Current, minimum and maximum depth of renderer queue
+   *                (samples)
+   */
+
+  uint32_t current_depth;
+  uint32_t min_depth;
+  uint32_t max_depth;
+
+  /*! \brief [out] Number of underflow of renderer */
+
+  uint32_t underflow_count;
+
+  /*! \brief [out] Number of samples dropped by resampler */
+
+  uint32_t dropped_samples;
+
+  /*! \brief [out] Number of periods sent without resampling */
+
+  uint32_t skipped_periods;
+
+} AsClkRecoveryStatus;
+
+/** Get clock recovery status function parameter */
+
+typedef struct
+{
+  /*! \brief [in] Address to store status */
+
+  AsClkRecoveryStatus *status;
+
+} AsGetClkRecoveryStatus;
+
 /** Init postproc parameter */
 
 typedef struct
@@ -441,6 +505,7 @@ typedef struct
     AsFrameTermFineControl  fterm_param;
     AsInitPostProc          initpp_param;
     AsSetPostProc           setpp_param;
+    AsGetClkRecoveryStatus  clkrcv_status_param;
   };
 } OutputMixerCommand;
 
@@ -527,6 +592,26 @@ bool AS_SendDataOutputMixer(FAR AsSendDataOutputMixer *sendparam);
 
 bool AS_FrameTermFineControlOutputMixer(uint8_t handle, FAR AsFrameTermFineControl *ftermparam);
 
+/**
+ * @brief Get clock recovery status
+ *
+ * The status is written asynchronously by the OutputMixer task, so the
+ * caller must keep the buffer alive and must not read it until completion
+ * is reported. The completion is notified as OutputMixGetClkRcvDone to
+ * the done callback of the OutputMixer, or as
+ * AUDRLT_GETCLKRCVSTATUS_CMPLT when the OutputMixer is owned by
+ * AudioManager.
+ *
+ * @param[in]  handle: OutputMixer handle
+ * @param[out] status: clock recovery status, which is valid once the
+ *                     completion above has been received
+ *
+ * @retval     true  : success
+ * @retval     false : failure
+ */
+
+bool AS_GetClkRecoveryStatusOutputMixer(uint8_t handle, FAR AsClkRecoveryStatus *status);
+
 /**
  * @brief Init Postproces DSP
  *
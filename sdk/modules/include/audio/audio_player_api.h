@@ -149,6 +149,10 @@ typedef enum
 
   AsPlayerEventSetGain,
 
+  /*! \brief Set next track */
+
+  AsPlayerEventSetNext,
+
 } AsPlayerEvent;
 
 /** player id */
@@ -518,6 +522,42 @@ typedef struct
 
 } AsRequestNextParam;
 
+/** SetNextPlayer Command parameter */
+
+typedef struct
+{
+  /*! \brief [in] Format of the track
+   *
+   * Codec type, channel number, bit length and sampling rate must be
+   * same as the current track to be played without gap.
+   */
+
+  AsInitPlayerParam init_param;
+
+  /*! \brief [in] Byte size of ES of the track written to FIFO
+   *
+   * Audio frames only, without tags. 0 means unknown, and then no track
+   * can be queued after this track.
+   */
+
+  uint32_t es_size;
+
+  /*! \brief [in] Number of samples to skip at the head of the track
+   *
+   * Encoder delay and decoder delay, in samples of the ES sampling rate.
+   */
+
+  uint32_t head_skip;
+
+  /*! \brief [in] Number of valid samples of the track
+   *
+   * Samples after this (encoder padding) are dropped. 0 means unknown.
+   */
+
+  uint32_t valid_samples;
+
+} AsSetNextPlayerParam;
+
 /** PlayerCommand definition */
 
 typedef struct
@@ -553,6 +593,12 @@ typedef struct
   
     AsRequestNextParam req_next_param;
 
+    /*! \brief [in] for SetNextPlayer
+     * (Object Interface==AS_SetNextPlayer)
+     */
+
+    AsSetNextPlayerParam next_param;
+
     /*! \brief [in] for Adjust sound period
      * (header.command_code==#AUDCMD_CLKRECOVERY)
      */
@@ -777,6 +823,45 @@ bool AS_SetPlayerGain(AsPlayerId id, FAR AsSetGainParam *gainparam);
 
 bool AS_RequestNextPlayerProcess(AsPlayerId id, FAR AsRequestNextParam *nextparam);
 
+/**
+ * @brief Set the track to be played next without gap
+ *
+ * Called in ready state, it describes the track started by
+ * AS_PlayPlayer(). Called during play, it queues the track which ES
+ * follows the current track in the FIFO. The decoder is kept loaded, and
+ * decoded PCM is joined across the boundary with trimming of encoder
+ * delay and padding.
+ *
+ * Completion is notified as AsPlayerEventSetNext to the done callback of
+ * the player, or as AUDRLT_SETNEXTPLAYER_CMPLT when the player is owned
+ * by AudioManager.
+ *
+ * @param[in] nextparam: Parameters of the track
+ *
+ * @retval     true  : success
+ * @retval     false : failure
+ */
+
+bool AS_SetNextPlayer(AsPlayerId id, FAR AsSetNextPlayerParam *nextparam);
+
+/**
+ * @brief Get gapless information from head of the track
+ *
+ * Parse LAME/Xing tag of MP3, or iTunSMPB comment, and set head_skip and
+ * valid_samples of the parameter according to init_param.codec_type.
+ *
+ * @param[in]  header: Head of the track file
+ * @param[in]  size: Byte size of header
+ * @param[out] nextparam: Parameters of the track
+ *
+ * @retval     true  : gapless information is found
+ * @retval     false : not found, head_skip and valid_samples are set to 0
+ */
+
+bool AS_GetPlayerGaplessInfo(FAR const uint8_t *header,
+                             uint32_t size,
+                             FAR AsSetNextPlayerParam *nextparam);
+
 /**
  * @brief Deactivate (sub)player
  *
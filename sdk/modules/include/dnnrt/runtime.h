@@ -46,6 +46,7 @@
  * dnnrt is an Deep Neural Networks RunTime optimized for for CXD5602
  */
 
+#  include <stdio.h>
 #  include <asmp/types.h>
 #  include <dnnrt/nnablart/network.h>
 
@@ -59,6 +60,9 @@ extern "C"
 
 #  define DNNRT_IMPLEMENT (0)
 
+#  define DNN_PROFILE_FORMAT_CSV          (0) /**< comma-separated values */
+#  define DNN_PROFILE_FORMAT_CHROME_TRACE (1) /**< Chrome trace event JSON */
+
 /**
  * @defgroup dnnrt_datatype Data Types
  * @{
@@ -90,6 +94,25 @@ typedef struct dnn_mallinfo
   size_t largest_bytes;
 } dnn_mallinfo_t;
 
+/**
+ * @typedef dnn_layer_profile_t
+ * structure to obtain profile of a function (layer) in a network.
+ * Cycles are counted by DWT CYCCNT on target, or in nanoseconds on host.
+ */
+typedef struct dnn_layer_profile
+{
+  unsigned short function_type; /**< nn_function_type_t of this layer */
+  unsigned long calls;          /**< Number of invocations */
+  unsigned long last_start;     /**< Start of the last invocation in cycles
+                                 *   from the start of dnn_runtime_forward() */
+  unsigned long last_cycles;    /**< Cycles of the last invocation */
+  unsigned long max_cycles;     /**< Cycles of the longest invocation */
+  unsigned long long total_cycles; /**< Cycles of all the invocations */
+  unsigned long input_bytes;    /**< Total size of inputs */
+  unsigned long output_bytes;   /**< Total size of outputs */
+  unsigned long scratch_bytes;  /**< Size of scratch buffer requested */
+} dnn_layer_profile_t;
+
 /** @} dnnrt_datatype */
 
 /********************************************************************************
@@ -291,6 +314,36 @@ nn_variable_t *dnn_runtime_output_variable(dnn_runtime_t * rt,
  */
 void *dnn_runtime_output_buffer(dnn_runtime_t * rt, unsigned char output_index);
 
+/**
+ * Obtain profile of each function (layer) in a network
+ *
+ * @param [in,out] rt:      dnnrt_runtime_t object
+ * @param [out]    profile: Array to store profile of each function
+ * @param [in]     length:  Number of elements in profile
+ *
+ * @return number of functions in the network on success,
+ *         -EPERM if CONFIG_DNN_RT_PROFILE=n, otherwise -EINVAL.
+ *
+ * @note profile is stored up to length elements.
+ */
+int dnn_runtime_get_profile(dnn_runtime_t * rt, dnn_layer_profile_t * profile,
+                            unsigned short length);
+
+/**
+ * Write profile of each function (layer) in a network to a stream
+ *
+ * @param [in,out] rt:     dnnrt_runtime_t object
+ * @param [in]     stream: stream to write profile into
+ * @param [in]     format: DNN_PROFILE_FORMAT_CSV or
+ *                         DNN_PROFILE_FORMAT_CHROME_TRACE
+ *
+ * @return 0 on success, -EPERM if CONFIG_DNN_RT_PROFILE=n,
+ *         otherwise -EINVAL.
+ *
+ * @note the trace format contains the last dnn_runtime_forward() only.
+ */
+int dnn_runtime_dump_profile(dnn_runtime_t * rt, FILE * stream, int format);
+
 /**
  * Obtain information about memory allocation in the Nuttx-side heap
  *
@@ -40,8 +40,40 @@
  * Included Files
  ****************************************************************************/
 
+#include <sdk/config.h>
+
 #include "lte/lte_api.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Callback queues of the LTE library */
+
+#define ALTCOM_CBQ_API          (0) /* API callbacks */
+#define ALTCOM_CBQ_RESTART      (1) /* Restart callbacks */
+
+/* Priorities of the jobs in a callback queue */
+
+#define ALTCOM_CBQ_PRIO_NORMAL  (0)
+#define ALTCOM_CBQ_PRIO_HIGH    (1)
+#define ALTCOM_CBQ_PRIO_NUM     (2)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Statistics of a callback queue for each priority.
+ * Time values are in microseconds.
+ */
+
+struct altcom_cbqstat_s
+{
+  uint32_t jobnum[ALTCOM_CBQ_PRIO_NUM];    /* Number of jobs run */
+  uint32_t waitmax[ALTCOM_CBQ_PRIO_NUM];   /* Maximum wait in the queue */
+  uint64_t waittotal[ALTCOM_CBQ_PRIO_NUM]; /* Total wait in the queue */
+};
+
 /****************************************************************************
  * Public function prototypes
  ****************************************************************************/
@@ -57,5 +89,10 @@ int32_t altcom_deactivate_pdn_sync(uint8_t session_id);
 int32_t altcom_radio_on_sync(void);
 int32_t altcom_radio_off_sync(void);
 
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+int32_t altcom_get_cbqstat(uint8_t queue,
+                           FAR struct altcom_cbqstat_s *stat);
+#endif
+
 
 #endif /* __MODULES_INCLUDE_LTE_ALTCOM_ALTCOM_API_H */
@@ -40,7 +40,35 @@
  * Included Files
  ****************************************************************************/
 
+#include <sdk/config.h>
+
 #include "lte/lte_api.h"
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+#  include "lte/altcom/altcom_api.h"
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Per-socket statistics of the daemon.
+ * Time values are in microseconds.
+ */
+
+struct lte_daemon_sockstat_s
+{
+  uint32_t send_count;      /* Number of sendto requests */
+  uint32_t send_errors;     /* Number of failed sendto requests */
+  uint64_t send_bytes;      /* Total bytes sent */
+  uint64_t send_time_total; /* Total time spent in altcom_sendto() */
+  uint32_t send_time_max;   /* Maximum time spent in altcom_sendto() */
+  uint32_t recv_count;      /* Number of recvfrom requests */
+  uint32_t recv_errors;     /* Number of failed recvfrom requests */
+  uint64_t recv_bytes;      /* Total bytes received */
+  uint64_t recv_time_total; /* Total time spent in altcom_recvfrom() */
+  uint32_t recv_time_max;   /* Maximum time spent in altcom_recvfrom() */
+  uint32_t buf_grows;       /* Times the staging buffer was enlarged */
+};
 
 /****************************************************************************
  * Public function prototypes
@@ -53,4 +81,22 @@ int32_t lte_daemon_power_on(void);
 int32_t lte_daemon_set_cb(restart_report_cb_t restart_callback);
 int32_t lte_daemon_fin(void);
 
+#ifdef CONFIG_LTE_DAEMON_SOCKET_STATISTICS
+/* Get statistics of the socket identified by usrsock socket ID.
+ * The counters are kept until the socket ID is reused.
+ */
+
+int32_t lte_daemon_get_sockstat(int usockid,
+                                FAR struct lte_daemon_sockstat_s *stat);
+#endif
+
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+/* Get statistics of the callback queue ALTCOM_CBQ_API or
+ * ALTCOM_CBQ_RESTART, for each job priority.
+ */
+
+int32_t lte_daemon_get_cbqstat(uint8_t queue,
+                               FAR struct altcom_cbqstat_s *stat);
+#endif
+
 #endif /* __MODULES_INCLUDE_LTE_LTE_DAEMON_H */
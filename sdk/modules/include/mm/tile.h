@@ -61,6 +61,18 @@
  * Public Types
  ****************************************************************************/
 
+/* Usage and fragmentation report of the tile heap */
+
+struct tileinfo_s
+{
+  int tilesize;  /* Size of one tile in bytes */
+  int ntiles;    /* Total number of tiles */
+  int nfree;     /* Number of free tiles */
+  int nregions;  /* Number of free regions */
+  int maxfree;   /* Number of tiles in the largest free region */
+  int nmoves;    /* Number of used tiles to be moved for compaction */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -85,18 +97,15 @@ extern "C"
  *   The actual memory allocates will be 64 byte (wasting 17 bytes) and
  *   will be aligned at least to (1 << log2align).
  *
- *   NOTE: The current implementation also restricts the maximum allocation
- *   size to 32 tiles.
- *
  * Input Parameters:
  *   heapstart - Start of the tile allocation heap
  *   heapsize  - Size of heap in bytes
- *   log2tile  - Log base 2 of the size of one tile.  0->1 byte,
- *               1->2 bytes, 2->4 bytes, 3->8 bytes, etc.
+ *   log2tile  - Log base 2 of the size of one tile.  16 -> 64KB, 17 -> 128KB.
+ *               Must not be larger than the 128KB power control block.
  *
  * Returned Value:
- *   On success, a non-NULL handle is returned that may be used with other
- *   tile allocator interfaces.
+ *   OK on success.  -EINVAL if log2tile is zero or larger than the power
+ *   control block, -ENOMEM if the allocator can not be set up.
  *
  ****************************************************************************/
 
@@ -171,6 +180,25 @@ FAR void *tile_alignalloc(size_t size, uint32_t log2align);
 
 void tile_free(FAR void *memory, size_t size);
 
+/****************************************************************************
+ * Name: tile_getinfo
+ *
+ * Description:
+ *   Report the usage and the fragmentation of the tile heap.  The heap is
+ *   not fragmented if maxfree is equal to nfree.  nmoves is the number of
+ *   used tiles placed after the first free tile, that is the cost to make
+ *   all of free tiles contiguous.
+ *
+ * Input Parameters:
+ *   info - Pointer to the structure to be filled
+ *
+ * Returned Value:
+ *   0 (OK) on success, or a negated errno on failure.
+ *
+ ****************************************************************************/
+
+int tile_getinfo(FAR struct tileinfo_s *info);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
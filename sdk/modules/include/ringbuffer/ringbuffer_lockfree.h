@@ -0,0 +1,336 @@
+/****************************************************************************
+ * modules/include/ringbuffer/ringbuffer_lockfree.h
+ *
+ *   Copyright 2020 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_INCLUDE_RINGBUFFER_RINGBUFFER_LOCKFREE_H
+#define __MODULES_INCLUDE_RINGBUFFER_RINGBUFFER_LOCKFREE_H
+
+/**
+ * @defgroup rb_lockfree Library for Lock-free Ring Buffer
+ *
+ * Ring buffers which can be shared between tasks without mutex.
+ *
+ * - SPSC: Byte stream from one producer to one consumer.
+ * - MPSC: Records from multiple producers to one consumer. Producers
+ *   reserve space atomically and commit it in any order, the consumer
+ *   takes records in order of reservation.
+ *
+ * Both provide zero-copy APIs, reserve/commit for producers and
+ * peek/consume for the consumer. Buffer size must be a power of two.
+ *
+ * Control structures are aligned to RINGBUF_CACHELINE. Static and stack
+ * instances are aligned by the compiler, but malloc() and kmm_malloc()
+ * guarantee only 8 bytes. Allocate them with memalign() or kmm_memalign()
+ * and RINGBUF_CACHELINE, or init returns -EINVAL.
+ *
+ * @{
+ * @file  ringbuffer_lockfree.h
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/** Alignment to keep producer and consumer indices in separate lines */
+
+#ifdef CONFIG_RINGBUFFER_LOCKFREE_CACHELINE
+#  define RINGBUF_CACHELINE  CONFIG_RINGBUFFER_LOCKFREE_CACHELINE
+#else
+#  define RINGBUF_CACHELINE  32
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct ringbuf_spsc_s
+{
+  /** Write index, updated by the producer only */
+
+  uint32_t tail __attribute__((aligned(RINGBUF_CACHELINE)));
+
+  /** Read index, updated by the consumer only */
+
+  uint32_t head __attribute__((aligned(RINGBUF_CACHELINE)));
+
+  FAR uint8_t *buf __attribute__((aligned(RINGBUF_CACHELINE)));
+  uint32_t mask;     /**< Buffer size - 1 */
+};
+
+struct ringbuf_mpsc_s
+{
+  /** Reservation index, updated by producers with compare and swap */
+
+  uint32_t reserve __attribute__((aligned(RINGBUF_CACHELINE)));
+
+  /** Read index, updated by the consumer only */
+
+  uint32_t head __attribute__((aligned(RINGBUF_CACHELINE)));
+
+  FAR uint8_t *buf __attribute__((aligned(RINGBUF_CACHELINE)));
+  uint32_t mask;     /**< Buffer size - 1 */
+};
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/** @name SPSC Functions */
+/** @{ */
+
+/**
+ * Initialize a SPSC Ring Buffer on given memory.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer to initialize, aligned to
+ *                 RINGBUF_CACHELINE.
+ * @param [in] buf: Memory area of the buffer.
+ * @param [in] size: Size of the buffer, power of two.
+ *
+ * @return On success, 0 is returned.
+ * On failure, negative value is returned according to <errno.h>.
+ */
+
+int ringbuf_spsc_init(FAR struct ringbuf_spsc_s *rb,
+                      FAR void *buf, size_t size);
+
+/**
+ * Write to a SPSC Ring Buffer. Called by the producer.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer to write.
+ * @param [in] buf: Pointer to data to write.
+ * @param [in] count: Bytes to write.
+ *
+ * @return On success, The number of bytes written.
+ * If there is no space for all of them, -ENOSPC is returned.
+ */
+
+ssize_t ringbuf_spsc_write(FAR struct ringbuf_spsc_s *rb,
+                           FAR const void *buf, size_t count);
+
+/**
+ * Read from a SPSC Ring Buffer. Called by the consumer.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer to read.
+ * @param [in] buf: Pointer to buffer to store read data.
+ * @param [in] count: Max bytes to read.
+ *
+ * @return The number of bytes read.
+ */
+
+ssize_t ringbuf_spsc_read(FAR struct ringbuf_spsc_s *rb,
+                          FAR void *buf, size_t count);
+
+/**
+ * Reserve contiguous free space of a SPSC Ring Buffer to write directly.
+ * Called by the producer.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer.
+ * @param [out] ptr: Head of the free space.
+ *
+ * @return Contiguous free bytes, which may be less than total free
+ * bytes at the end of the buffer.
+ */
+
+size_t ringbuf_spsc_reserve(FAR struct ringbuf_spsc_s *rb, FAR void **ptr);
+
+/**
+ * Publish bytes written into reserved space to the consumer.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer.
+ * @param [in] count: Bytes written, up to the reserved bytes.
+ */
+
+void ringbuf_spsc_commit(FAR struct ringbuf_spsc_s *rb, size_t count);
+
+/**
+ * Get contiguous data of a SPSC Ring Buffer to read directly.
+ * Called by the consumer.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer.
+ * @param [out] ptr: Head of the data.
+ *
+ * @return Contiguous data bytes.
+ */
+
+size_t ringbuf_spsc_peek(FAR struct ringbuf_spsc_s *rb, FAR void **ptr);
+
+/**
+ * Release bytes read by peek to the producer.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer.
+ * @param [in] count: Bytes read, up to the peeked bytes.
+ */
+
+void ringbuf_spsc_consume(FAR struct ringbuf_spsc_s *rb, size_t count);
+
+/**
+ * Gets the number of bytes used.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer.
+ *
+ * @return The number of bytes used.
+ */
+
+size_t ringbuf_spsc_bytesused(FAR struct ringbuf_spsc_s *rb);
+
+/**
+ * Gets the number of bytes free.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer.
+ *
+ * @return The number of bytes free.
+ */
+
+size_t ringbuf_spsc_bytesavail(FAR struct ringbuf_spsc_s *rb);
+
+/** @} */
+
+/** @name MPSC Functions */
+/** @{ */
+
+/**
+ * Initialize a MPSC Ring Buffer on given memory.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer to initialize, aligned to
+ *                 RINGBUF_CACHELINE.
+ * @param [in] buf: Memory area of the buffer, 4 bytes aligned.
+ * @param [in] size: Size of the buffer, power of two and 8 or more.
+ *
+ * @return On success, 0 is returned.
+ * On failure, negative value is returned according to <errno.h>.
+ */
+
+int ringbuf_mpsc_init(FAR struct ringbuf_mpsc_s *rb,
+                      FAR void *buf, size_t size);
+
+/**
+ * Reserve space for one record of a MPSC Ring Buffer.
+ * Called by producers, may be called from multiple tasks at once.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer.
+ * @param [in] len: Bytes of the record.
+ *
+ * @return On success, pointer to write the record is returned.
+ * If there is no space, NULL is returned.
+ */
+
+FAR void *ringbuf_mpsc_reserve(FAR struct ringbuf_mpsc_s *rb, size_t len);
+
+/**
+ * Publish a reserved record to the consumer.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer.
+ * @param [in] ptr: Pointer returned by ringbuf_mpsc_reserve.
+ */
+
+void ringbuf_mpsc_commit(FAR struct ringbuf_mpsc_s *rb, FAR void *ptr);
+
+/**
+ * Write one record to a MPSC Ring Buffer.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer.
+ * @param [in] buf: Pointer to data of the record.
+ * @param [in] len: Bytes of the record.
+ *
+ * @return On success, The number of bytes written.
+ * If there is no space, -ENOSPC is returned.
+ */
+
+ssize_t ringbuf_mpsc_write(FAR struct ringbuf_mpsc_s *rb,
+                           FAR const void *buf, size_t len);
+
+/**
+ * Get the oldest record of a MPSC Ring Buffer to read directly.
+ * Called by the consumer.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer.
+ * @param [out] ptr: Head of the record.
+ *
+ * @return Bytes of the record. If there is no committed record,
+ * -EAGAIN is returned. Records committed out of order are returned
+ * after all records reserved before them are committed.
+ */
+
+ssize_t ringbuf_mpsc_peek(FAR struct ringbuf_mpsc_s *rb, FAR void **ptr);
+
+/**
+ * Release the record got by peek to producers.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer.
+ */
+
+void ringbuf_mpsc_consume(FAR struct ringbuf_mpsc_s *rb);
+
+/**
+ * Read one record from a MPSC Ring Buffer.
+ *
+ * @param [in] rb: Pointer to a Ring Buffer.
+ * @param [in] buf: Pointer to buffer to store the record.
+ * @param [in] count: Size of the buffer.
+ *
+ * @return On success, bytes of the record.
+ * If there is no record, -EAGAIN is returned. If the buffer is smaller
+ * than the record, -EMSGSIZE is returned and the record is kept.
+ */
+
+ssize_t ringbuf_mpsc_read(FAR struct ringbuf_mpsc_s *rb,
+                          FAR void *buf, size_t count);
+
+/** @} */
+
+/** @} */
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MODULES_INCLUDE_RINGBUFFER_RINGBUFFER_LOCKFREE_H */
@@ -0,0 +1,231 @@
+/****************************************************************************
+ * modules/include/sensing/logical_sensor/sensor_batch.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_SENSING_LOGICAL_SENSOR_SENSOR_BATCH_H
+#define __INCLUDE_SENSING_LOGICAL_SENSOR_SENSOR_BATCH_H
+
+/**
+ * @defgroup logical_sensor_batch Sensor Batch
+ * @{
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <semaphore.h>
+#include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
+
+#include "sensing/sensor_api.h"
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/*--------------------------------------------------------------------
+ *   Sensor Batch Class
+ *--------------------------------------------------------------------
+ */
+
+/**
+ * Accumulate samples of consecutive packets from one physical sensor into
+ * one contiguous buffer, so that a logical sensor can send them to DSP by
+ * one execution command.  The buffer is handed over by detach(), and the
+ * receiver must free() it after DSP has processed it.
+ *
+ * The owner flushes the batch when it is ready() on packet arrival, and
+ * also arms a low priority work for remaining() time, so that the last
+ * batch is not held beyond the latency when packets stop coming.
+ */
+
+class SensorBatch
+{
+public:
+
+  SensorBatch(void)
+      : m_buf(NULL),
+        m_capacity(0),
+        m_used(0),
+        m_count(0),
+        m_time(0),
+        m_fs(0),
+        m_num(0)
+  {
+  };
+
+  ~SensorBatch(void)
+  {
+    free(m_buf);
+  };
+
+  /** Check no packet is accumulated */
+
+  bool empty(void)
+  {
+    return m_count == 0;
+  }
+
+  /** Check the packet can be appended without flushing the batch */
+
+  bool fits(FAR sensor_command_data_mh_t *command, size_t sample_size)
+  {
+    return empty() ||
+           (command->fs == m_fs &&
+            m_used + command->size * sample_size <= m_capacity);
+  }
+
+  /**
+   * Copy samples of the packet.  The buffer is allocated for max_count
+   * packets of the same size when the first packet comes.
+   */
+
+  bool append(FAR sensor_command_data_mh_t *command, size_t sample_size,
+              int max_count)
+  {
+    size_t len = command->size * sample_size;
+
+    if (empty())
+      {
+        m_capacity = len * max_count;
+        m_buf = static_cast<FAR uint8_t *>(malloc(m_capacity));
+        if (m_buf == NULL)
+          {
+            return false;
+          }
+
+        m_used = 0;
+        m_num  = 0;
+        m_time = command->time;
+        m_fs   = command->fs;
+        clock_gettime(CLOCK_MONOTONIC, &m_start);
+      }
+
+    if (m_used + len > m_capacity)
+      {
+        return false;
+      }
+
+    memcpy(m_buf + m_used, command->mh.getVa(), len);
+    m_used += len;
+    m_num  += command->size;
+    m_count++;
+
+    return true;
+  }
+
+  /**
+   * Milliseconds left until the first packet of the batch has waited for
+   * latency_ms.  Zero or less means the deadline has passed.  Only valid
+   * while the batch is not empty.
+   */
+
+  long remaining(int latency_ms)
+  {
+    struct timespec now;
+    long elapsed;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    elapsed = (now.tv_sec - m_start.tv_sec) * 1000 +
+              (now.tv_nsec - m_start.tv_nsec) / 1000000;
+
+    return latency_ms - elapsed;
+  }
+
+  /**
+   * Check the batch should be flushed, either max_count packets are
+   * accumulated or the first one has waited for latency_ms.
+   */
+
+  bool ready(int max_count, int latency_ms)
+  {
+    if (m_count >= max_count)
+      {
+        return true;
+      }
+
+    return !empty() && remaining(latency_ms) <= 0;
+  }
+
+  /** Hand over the buffer, and start the next batch */
+
+  FAR void *detach(FAR uint32_t *time, FAR uint32_t *fs, FAR uint32_t *num)
+  {
+    FAR void *buf = m_buf;
+
+    *time = m_time;
+    *fs   = m_fs;
+    *num  = m_num;
+
+    m_buf      = NULL;
+    m_capacity = 0;
+    m_used     = 0;
+    m_count    = 0;
+
+    return buf;
+  }
+
+  /** Drop the accumulated samples */
+
+  void clear(void)
+  {
+    free(m_buf);
+
+    m_buf      = NULL;
+    m_capacity = 0;
+    m_used     = 0;
+    m_count    = 0;
+  }
+
+private:
+
+  FAR uint8_t     *m_buf;
+  size_t          m_capacity;
+  size_t          m_used;
+  int             m_count;
+  uint32_t        m_time;
+  uint32_t        m_fs;
+  uint32_t        m_num;
+  struct timespec m_start;
+};
+
+/**
+ * @}
+ */
+
+#endif /* __INCLUDE_SENSING_LOGICAL_SENSOR_SENSOR_BATCH_H */
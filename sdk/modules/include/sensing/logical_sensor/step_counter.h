@@ -53,6 +53,7 @@
 #include "sensing/sensor_id.h"
 #include "sensing/sensor_ecode.h"
 #include "sensing/logical_sensor/step_counter_command.h"
+#include "sensing/logical_sensor/sensor_batch.h"
 #include "memutils/s_stl/queue.h"
 
 /****************************************************************************
@@ -85,9 +86,22 @@ public:
   StepCounterClass(MemMgrLite::PoolId cmd_pool_id)
       : m_cmd_pool_id(cmd_pool_id)
   {
+#if CONFIG_SENSING_STEPCOUNTER_BATCH_COUNT > 1
+    memset(&m_batch_work, 0, sizeof(m_batch_work));
+    m_batch_pending = 0;
+    m_batch_closing = false;
+    sem_init(&m_batch_sem, 0, 1);
+    sem_init(&m_batch_done, 0, 0);
+#endif
   };
 
-  ~StepCounterClass(){};
+  ~StepCounterClass()
+  {
+#if CONFIG_SENSING_STEPCOUNTER_BATCH_COUNT > 1
+    sem_destroy(&m_batch_done);
+    sem_destroy(&m_batch_sem);
+#endif
+  };
 
 private:
 
@@ -96,8 +110,18 @@ private:
     {
       MemMgrLite::MemHandle cmd;
       MemMgrLite::MemHandle data;
+      FAR void *batch;  /* Batched samples, freed after execution */
     };
   s_std::Queue<struct exe_mh_s, MAX_EXEC_COUNT> m_exe_que;
+
+#if CONFIG_SENSING_STEPCOUNTER_BATCH_COUNT > 1
+  SensorBatch   m_acc_batch;
+  struct work_s m_batch_work;  /* Flushes the batch at its deadline */
+  sem_t         m_batch_sem;   /* Exclusive access to batch and exec queue */
+  sem_t         m_batch_done;  /* Posted by the last work run on close */
+  int           m_batch_pending; /* Queued or running m_batch_work */
+  bool          m_batch_closing; /* close() in progress, do not re-arm */
+#endif
   
   /* private members */
 
@@ -111,6 +135,14 @@ private:
   /* private methods */
 
   int sendInit(void);
+  int send_exec(struct exe_mh_s &exe_mh);
+  int write_exec(FAR sensor_command_data_mh_t *command);
+#if CONFIG_SENSING_STEPCOUNTER_BATCH_COUNT > 1
+  int write_batch(FAR sensor_command_data_mh_t *command);
+  int flush_batch(void);
+  void arm_batch_timer(void);
+  static void batch_timeout(FAR void *arg);
+#endif
 };
 
 /****************************************************************************
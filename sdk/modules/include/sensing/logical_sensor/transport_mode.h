@@ -52,6 +52,7 @@
 #include "sensing/sensor_id.h"
 #include "sensing/sensor_ecode.h"
 #include "sensing/logical_sensor/transport_mode_command.h"
+#include "sensing/logical_sensor/sensor_batch.h"
 #include "memutils/s_stl/queue.h"
 #include "memutils/memory_manager/MemHandle.h"
 
@@ -143,8 +144,8 @@ public:
   int write(FAR sensor_command_data_mh_t*);
   void send_detection_result(uint32_t pred);
   void send_notification(TramNotification notification);
-  void set_power(uint32_t subscriptions);
-  void clear_power(uint32_t subscriptions);
+  void set_power(uint64_t subscriptions);
+  void clear_power(uint64_t subscriptions);
   void receive_sync_msg(void);
   void receive_async_msg(uint32_t param);
   int receive(void);
@@ -157,9 +158,22 @@ public:
       : m_cmd_pool_id(cmd_pool_id),
         m_state(TRAM_STATE_UNINITIALIZED)
   {
+#if CONFIG_SENSING_TRAM_BATCH_COUNT > 1
+    memset(&m_batch_work, 0, sizeof(m_batch_work));
+    m_batch_pending = 0;
+    m_batch_closing = false;
+    sem_init(&m_batch_sem, 0, 1);
+    sem_init(&m_batch_done, 0, 0);
+#endif
   };
 
-  ~TramClass(){};
+  ~TramClass()
+  {
+#if CONFIG_SENSING_TRAM_BATCH_COUNT > 1
+    sem_destroy(&m_batch_done);
+    sem_destroy(&m_batch_sem);
+#endif
+  };
 
 private:
   #define MAX_EXEC_COUNT 8
@@ -167,10 +181,20 @@ private:
   struct exe_mh_s {
     MemMgrLite::MemHandle cmd;
     MemMgrLite::MemHandle data;
+    FAR void *batch;  /* Batched samples, freed after execution */
   };
 
   s_std::Queue<struct exe_mh_s, MAX_EXEC_COUNT> m_exe_que;
 
+#if CONFIG_SENSING_TRAM_BATCH_COUNT > 1
+  SensorBatch   m_batch[TramSensorBar + 1];
+  struct work_s m_batch_work;  /* Flushes batches at their deadline */
+  sem_t         m_batch_sem;   /* Exclusive access to batches and exec queue */
+  sem_t         m_batch_done;  /* Posted by the last work run on close */
+  int           m_batch_pending; /* Queued or running m_batch_work */
+  bool          m_batch_closing; /* close() in progress, do not re-arm */
+#endif
+
   /* private members */
 
   MemMgrLite::PoolId  m_cmd_pool_id;
@@ -185,6 +209,14 @@ private:
   /* private methods */
 
   int sendInit(FAR float *likelihood);
+  int send_exec(struct exe_mh_s &exe_mh);
+  int write_exec(FAR sensor_command_data_mh_t *command);
+#if CONFIG_SENSING_TRAM_BATCH_COUNT > 1
+  int write_batch(TramSensorType type, FAR sensor_command_data_mh_t *command);
+  int flush_batch(TramSensorType type);
+  void arm_batch_timer(void);
+  static void batch_timeout(FAR void *arg);
+#endif
 };
 
 /****************************************************************************
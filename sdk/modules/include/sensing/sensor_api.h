@@ -46,6 +46,7 @@
  ****************************************************************************/
 
 #include <sdk/config.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 /* MemoryManager can used only C++.
@@ -187,13 +188,16 @@ typedef void (*api_response_callback_t)(unsigned int code,
 /**
  * @struct sensor_command_register_t
  * @brief  The command of resister a sensor.
+ *
+ * subscriptions has one bit per sensor ID (0 to 63).  Build the mask with
+ * a 64 bit shift, e.g. (1ULL << id), for IDs of 32 and above.
  */
 typedef struct
 {
   sensor_command_header_t header;         /**< command header                                 */
 
   unsigned int self: 8;                   /**< sensor ID                                      */
-  unsigned int subscriptions: 24;         /**< subscription infomation                        */
+  uint64_t subscriptions;                 /**< subscription infomation                        */
   sensor_data_callback_t    callback;     /**< callback for subscription event                */
   sensor_data_mh_callback_t callback_mh;  /**< callback with MemHandle for subscription event */
 
@@ -206,7 +210,7 @@ typedef struct
       return self;
     }
 
-  unsigned int get_subscriptions(void)
+  uint64_t get_subscriptions(void)
     {
       return subscriptions;
     }
@@ -237,7 +241,7 @@ typedef struct
 {
   sensor_command_header_t header;         /**< command header             */
   unsigned int self          : 8;         /**< change sensor ID           */
-  unsigned int subscriptions : 24;        /**< subscription infomation    */
+  uint64_t     subscriptions;             /**< subscription infomation    */
   bool add;                               /**< add(true) or remode(false) */
 
   unsigned int get_self(void)
@@ -245,7 +249,7 @@ typedef struct
       return self;
     }
 
-  unsigned int get_subscriptions(void)
+  uint64_t get_subscriptions(void)
     {
       return subscriptions;
     }
@@ -281,14 +285,14 @@ typedef struct
   sensor_command_header_t header;         /**< command header                  */
 
   unsigned int self: 8;                   /**< sender sensor ID                */
-  unsigned int subscriptions: 24;         /**< subscription infomation         */
+  uint64_t subscriptions;                 /**< subscription infomation         */
 
   unsigned int get_self(void)
   {
     return self;
   }
 
-  unsigned int get_subscriptions(void)
+  uint64_t get_subscriptions(void)
   {
     return subscriptions;
   }
@@ -297,6 +301,20 @@ typedef struct
 
 #endif /* CONFIG_SENSING_MANAGER_POWERCTRL */
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @struct sensor_delivery_stats_t
+ * @brief  Delivery statistics of a subscriber.
+ */
+typedef struct
+{
+  uint32_t delivered;    /**< number of data delivered to callback         */
+  uint32_t dropped;      /**< number of data dropped since queue was full  */
+  uint32_t max_latency;  /**< max time from publish to callback [us]       */
+  uint32_t avg_latency;  /**< average time from publish to callback [us]   */
+  uint32_t max_depth;    /**< max number of data waited in delivery queue  */
+} sensor_delivery_stats_t;
+
 /*--------------------------------------------------------------------------*/
 /*--------------------------------------------------------------------
     Command(Evant) Code.
@@ -420,6 +438,16 @@ extern void SS_SendSensorRelease(FAR sensor_command_release_t *packet);
  */
 extern void SS_SendSensorChangeSubscription(FAR sensor_command_change_subscription_t *packet);
 
+/**
+ * @brief     Get delivery statistics of the subscriber.
+ * @note      Available when CONFIG_SENSING_MANAGER_ASYNC_DELIVERY is enabled.
+ * @param[in] id : sensor ID of the subscriber
+ * @param[out] stats : statistics
+ * @return    true if the subscriber has delivery task, otherwise false
+ */
+extern bool SS_GetDeliveryStats(unsigned int id,
+                                FAR sensor_delivery_stats_t *stats);
+
 #ifdef __cplusplus
 
 /**
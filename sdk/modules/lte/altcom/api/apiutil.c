@@ -44,6 +44,10 @@
 #include "osal.h"
 #include "buffpoolwrapper.h"
 #include "apiutil.h"
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+#  include "wrkrid.h"
+#  include "lte/altcom/altcom_api.h"
+#endif
 
 /****************************************************************************
  * Private Data
@@ -98,3 +102,73 @@ int32_t altcom_runjob(
 
   return 0;
 }
+
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+/****************************************************************************
+ * Name: altcom_get_cbqstat
+ *
+ * Description:
+ *  Get statistics of a callback queue.
+ *
+ * Input Parameters:
+ *  queue  ALTCOM_CBQ_API or ALTCOM_CBQ_RESTART.
+ *  stat   Buffer to store the statistics.
+ *
+ * Returned Value:
+ *   If the process succeeds, it returns 0.
+ *   Otherwise negative errno is returned.
+ *
+ ****************************************************************************/
+
+int32_t altcom_get_cbqstat(uint8_t queue,
+                           FAR struct altcom_cbqstat_s *stat)
+{
+  int32_t                ret;
+  int                    prio;
+  uint8_t                id;
+  FAR struct thrdpool_s  *pool = NULL;
+  struct thrdpool_stat_s poolstat;
+
+  if (!stat)
+    {
+      DBGIF_LOG_ERROR("NULL parameter.\n");
+      return -EINVAL;
+    }
+
+  switch (queue)
+    {
+      case ALTCOM_CBQ_API:
+        id = WRKRID_API_CALLBACK_THREAD;
+        break;
+      case ALTCOM_CBQ_RESTART:
+        id = WRKRID_RESTART_CALLBACK_THREAD;
+        break;
+      default:
+        DBGIF_LOG1_ERROR("Invalid queue %d.\n", queue);
+        return -EINVAL;
+    }
+
+  pool = thrdfctry_getwrkr(id);
+  if (!pool)
+    {
+      DBGIF_LOG_ERROR("thrdfctry_getwrkr()\n");
+      return -ENETDOWN;
+    }
+
+  ret = pool->getstat(pool, &poolstat);
+  if (0 > ret)
+    {
+      DBGIF_LOG1_ERROR("getstat() [errno=%d]\n", ret);
+      return ret;
+    }
+
+  for (prio = 0; prio < ALTCOM_CBQ_PRIO_NUM; prio++)
+    {
+      stat->jobnum[prio]    = poolstat.jobnum[prio];
+      stat->waitmax[prio]   = poolstat.waitmax[prio];
+      stat->waittotal[prio] = poolstat.waittotal[prio];
+    }
+
+  return 0;
+}
+#endif
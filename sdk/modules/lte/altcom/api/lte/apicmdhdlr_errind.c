@@ -107,5 +107,6 @@ static void errindication_job(FAR void *arg)
 
 enum evthdlrc_e apicmdhdlr_errindication(FAR uint8_t *evt, uint32_t evlen)
 {
-  return apicmdhdlrbs_do_runjob(evt, APICMDID_ERRIND, errindication_job);
+  return apicmdhdlrbs_do_runjob_prio(evt, APICMDID_ERRIND,
+    errindication_job, THRDPOOL_PRIO_HIGH);
 }
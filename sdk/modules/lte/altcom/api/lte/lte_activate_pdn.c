@@ -481,6 +481,6 @@ int32_t lte_activate_pdn(lte_apn_setting_t *apn, activate_pdn_cb_t callback)
 
 enum evthdlrc_e apicmdhdlr_activatepdn(FAR uint8_t *evt, uint32_t evlen)
 {
-  return apicmdhdlrbs_do_runjob(evt,
-    APICMDID_CONVERT_RES(APICMDID_ACTIVATE_PDN), activatepdn_job);
+  return apicmdhdlrbs_do_runjob_prio(evt,
+    APICMDID_CONVERT_RES(APICMDID_ACTIVATE_PDN), activatepdn_job, THRDPOOL_PRIO_HIGH);
 }
@@ -337,6 +337,6 @@ int32_t lte_deactivate_pdn(uint8_t session_id, deactivate_pdn_cb_t callback)
 
 enum evthdlrc_e apicmdhdlr_deactivatepdn(FAR uint8_t *evt, uint32_t evlen)
 {
-  return apicmdhdlrbs_do_runjob(evt,
-    APICMDID_CONVERT_RES(APICMDID_DEACTIVATE_PDN), deactivatepdn_job);
+  return apicmdhdlrbs_do_runjob_prio(evt,
+    APICMDID_CONVERT_RES(APICMDID_DEACTIVATE_PDN), deactivatepdn_job, THRDPOOL_PRIO_HIGH);
 }
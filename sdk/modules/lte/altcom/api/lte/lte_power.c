@@ -377,8 +377,8 @@ int32_t altcom_power_off(void)
 
 enum evthdlrc_e apicmdhdlr_power(FAR uint8_t *evt, uint32_t evlen)
 {
-  return apicmdhdlrbs_do_runjob(evt,
-    APICMDID_CONVERT_RES(APICMDID_POWER_ON), poweron_job);
+  return apicmdhdlrbs_do_runjob_prio(evt,
+    APICMDID_CONVERT_RES(APICMDID_POWER_ON), poweron_job, THRDPOOL_PRIO_HIGH);
 }
 
 /****************************************************************************
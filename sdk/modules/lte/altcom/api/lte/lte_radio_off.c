@@ -317,6 +317,6 @@ int32_t lte_radio_off(radio_off_cb_t callback)
 
 enum evthdlrc_e apicmdhdlr_radiooff(FAR uint8_t *evt, uint32_t evlen)
 {
-  return apicmdhdlrbs_do_runjob(evt,
-    APICMDID_CONVERT_RES(APICMDID_RADIO_OFF), radiooff_job);
+  return apicmdhdlrbs_do_runjob_prio(evt,
+    APICMDID_CONVERT_RES(APICMDID_RADIO_OFF), radiooff_job, THRDPOOL_PRIO_HIGH);
 }
@@ -46,6 +46,7 @@
 #include "ltebuilder.h"
 #include "hal_altmdm_spi.h"
 #include "apicmdgw.h"
+#include "apicmd.h"
 #include "altcom_callbacks.h"
 
 #include "apicmdhdlr_enterpin.h"
@@ -102,6 +103,9 @@
 
 #define BLOCKSETLIST_NUM (sizeof(g_blk_settings) / sizeof(g_blk_settings[0]))
 
+#define CMDHDLRLIST_NUM \
+  (sizeof(g_apicmdcmdhdlrs) / sizeof(g_apicmdcmdhdlrs[0]))
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -142,46 +146,63 @@ static struct buffpool_blockset_s g_blk_settings[] =
 
 static struct evtdisp_s *g_evtdips_obj;
 
-static evthdl_if_t g_apicmdhdlrs[] = 
+/* Handlers that do not depend on a single command id.
+ * These are searched linearly after the handlers in g_apicmdcmdhdlrs.
+ */
+
+static evthdl_if_t g_apicmdhdlrs[] =
 {
-  apicmdhdlr_power,
-  apicmdhdlr_ver,
-  apicmdhdlr_imei,
-  apicmdhdlr_getltime,
-  apicmdhdlr_repcellinfo,
-  apicmdhdlr_repquality,
-  apicmdhdlr_enterpin,
-  apicmdhdlr_errindication,
-  apicmdhdlr_getpinset,
-  apicmdhdlr_imsi,
-  apicmdhdlr_operator,
-  apicmdhdlr_phoneno,
-  apicmdhdlr_setpin,
-  apicmdhdlr_repevt,
-  apicmdhdlr_getedrx,
-  apicmdhdlr_setedrx,
-  apicmdhdlr_getpsm,
-  apicmdhdlr_setpsm,
-  apicmdhdlr_getce,
-  apicmdhdlr_setce,
-  apicmdhdlr_radioon,
-  apicmdhdlr_radiooff,
-  apicmdhdlr_activatepdn,
-  apicmdhdlr_deactivatepdn,
-  apicmdhdlr_dataallow,
-  apicmdhdlr_repnetinfo,
-  apicmdhdlr_getnetinfo,
-  apicmdhdlr_getimscap,
-  apicmdhdlr_getsiminfo,
-  apicmdhdlr_getdynamicedrx,
-  apicmdhdlr_getdynamicpsm,
-  apicmdhdlr_errinfo,
-  apicmdhdlr_select,
-  apicmdhdlr_getquality,
+  EVTDISP_EVTHDLLIST_TERMINATION
+};
+
+/* Handlers dispatched directly by command id. */
+
+static const struct evtdisp_cmdhdl_s g_apicmdcmdhdlrs[] =
+{
+  { APICMDID_CONVERT_RES(APICMDID_POWER_ON), apicmdhdlr_power },
+  { APICMDID_CONVERT_RES(APICMDID_GET_VERSION), apicmdhdlr_ver },
+  { APICMDID_CONVERT_RES(APICMDID_GET_IMEI), apicmdhdlr_imei },
+  { APICMDID_CONVERT_RES(APICMDID_GET_LTIME), apicmdhdlr_getltime },
+  { APICMDID_REPORT_CELLINFO, apicmdhdlr_repcellinfo },
+  { APICMDID_REPORT_QUALITY, apicmdhdlr_repquality },
+  { APICMDID_CONVERT_RES(APICMDID_ENTER_PIN), apicmdhdlr_enterpin },
+  { APICMDID_ERRIND, apicmdhdlr_errindication },
+  { APICMDID_CONVERT_RES(APICMDID_GET_PINSET), apicmdhdlr_getpinset },
+  { APICMDID_CONVERT_RES(APICMDID_GET_IMSI), apicmdhdlr_imsi },
+  { APICMDID_CONVERT_RES(APICMDID_GET_OPERATOR), apicmdhdlr_operator },
+  { APICMDID_CONVERT_RES(APICMDID_GET_PHONENO), apicmdhdlr_phoneno },
+  { APICMDID_CONVERT_RES(APICMDID_SET_PIN_LOCK), apicmdhdlr_setpin },
+  { APICMDID_CONVERT_RES(APICMDID_SET_PIN_CODE), apicmdhdlr_setpin },
+  { APICMDID_REPORT_EVT, apicmdhdlr_repevt },
+  { APICMDID_CONVERT_RES(APICMDID_GET_EDRX), apicmdhdlr_getedrx },
+  { APICMDID_CONVERT_RES(APICMDID_SET_EDRX), apicmdhdlr_setedrx },
+  { APICMDID_CONVERT_RES(APICMDID_GET_PSM), apicmdhdlr_getpsm },
+  { APICMDID_CONVERT_RES(APICMDID_SET_PSM), apicmdhdlr_setpsm },
+  { APICMDID_CONVERT_RES(APICMDID_GET_CE), apicmdhdlr_getce },
+  { APICMDID_CONVERT_RES(APICMDID_SET_CE), apicmdhdlr_setce },
+  { APICMDID_CONVERT_RES(APICMDID_RADIO_ON), apicmdhdlr_radioon },
+  { APICMDID_CONVERT_RES(APICMDID_RADIO_OFF), apicmdhdlr_radiooff },
+  { APICMDID_CONVERT_RES(APICMDID_ACTIVATE_PDN), apicmdhdlr_activatepdn },
+  { APICMDID_CONVERT_RES(APICMDID_DEACTIVATE_PDN), apicmdhdlr_deactivatepdn },
+  { APICMDID_CONVERT_RES(APICMDID_DATA_ALLOW), apicmdhdlr_dataallow },
+  { APICMDID_REPORT_NETINFO, apicmdhdlr_repnetinfo },
+  { APICMDID_CONVERT_RES(APICMDID_GET_NETINFO), apicmdhdlr_getnetinfo },
+  { APICMDID_CONVERT_RES(APICMDID_GET_IMS_CAP), apicmdhdlr_getimscap },
+  { APICMDID_CONVERT_RES(APICMDID_GET_SIMINFO), apicmdhdlr_getsiminfo },
+  {
+    APICMDID_CONVERT_RES(APICMDID_GET_DYNAMICEDRX),
+    apicmdhdlr_getdynamicedrx
+  },
+  { APICMDID_CONVERT_RES(APICMDID_GET_DYNAMICPSM), apicmdhdlr_getdynamicpsm },
+  { APICMDID_ERRINFO, apicmdhdlr_errinfo },
+  { APICMDID_CONVERT_RES(APICMDID_SOCK_SELECT), apicmdhdlr_select },
+  { APICMDID_CONVERT_RES(APICMDID_GET_QUALITY), apicmdhdlr_getquality },
 #ifdef CONFIG_LTE_NET_MBEDTLS
-  apicmdhdlr_config_verify_callback,
+  {
+    APICMDID_CONVERT_RES(APICMDID_TLS_CONFIG_VERIFY_CALLBACK),
+    apicmdhdlr_config_verify_callback
+  },
 #endif
-  EVTDISP_EVTHDLLIST_TERMINATION
 };
 
 static FAR struct hal_if_s *g_halif;
@@ -364,6 +385,7 @@ static int32_t workerthread_uninitialize(void)
 static int32_t eventdispatcher_initialize(void)
 {
   int ret = 0;
+  int i;
   struct evtdispfctry_evtdispset_s set[] =
   {
     { EVTDISPID_APICMD_DISP_ID, g_apicmdhdlrs }
@@ -384,6 +406,17 @@ static int32_t eventdispatcher_initialize(void)
       return -1;
     }
 
+  for (i = 0; i < CMDHDLRLIST_NUM; i++)
+    {
+      ret = g_evtdips_obj->addcmdhdlr(g_evtdips_obj,
+        g_apicmdcmdhdlrs[i].cmdid, g_apicmdcmdhdlrs[i].hdlr);
+      if (0 > ret)
+        {
+          DBGIF_LOG1_ERROR("addcmdhdlr() error :%d.\n", ret);
+          return -1;
+        }
+    }
+
   return 0;
 }
 
@@ -38,9 +38,11 @@
  ****************************************************************************/
 
 #include <stdlib.h>
+#include <string.h>
 #include "dbg_if.h"
 #include "buffpool.h"
 #include "evtdisp.h"
+#include "apicmdgw.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -51,6 +53,8 @@
 #define EVTDISP_BUFFPOOL_ALLOC(pool, size)(buffpool_alloc(pool, size))
 #define EVTDISP_BUFFPOOL_FREE(pool, buff)(buffpool_free(pool, buff))
 
+#define EVTDISP_CMDHDL_INDEX(cmdid) ((cmdid) & (EVTDISP_CMDHDL_MAX - 1))
+
 #define EVTDISP_DISPATCH(ret, hdlr) \
   do \
     { \
@@ -84,6 +88,8 @@ struct evtdisp_obj_s
   FAR buffpool_t             buffpool;
   FAR evthdl_if_t            *evthdllist;
   FAR struct evtdisp_exhdl_s *exhdllist;
+  uint16_t                   cmdhdlnum;
+  struct evtdisp_cmdhdl_s    cmdhdltbl[EVTDISP_CMDHDL_MAX];
 };
 
 /****************************************************************************
@@ -97,6 +103,45 @@ static int32_t evtdisp_dispatch(FAR struct evtdisp_s *thiz,
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: evtdisp_findcmdhdlr
+ *
+ * Description:
+ *  Find the handler registered for the command id.
+ *
+ * Input Parameters:
+ *  obj    EVTDISP object pointer.
+ *  cmdid  Command id.
+ *
+ * Returned Value:
+ *  Pointer to the table entry of @cmdid, or the empty entry where
+ *  @cmdid can be registered. NULL if neither is found.
+ *
+ ****************************************************************************/
+
+static FAR struct evtdisp_cmdhdl_s *evtdisp_findcmdhdlr(
+  FAR struct evtdisp_obj_s *obj, uint16_t cmdid)
+{
+  FAR struct evtdisp_cmdhdl_s *entry;
+  uint16_t                    idx = EVTDISP_CMDHDL_INDEX(cmdid);
+  uint16_t                    i;
+
+  /* Open addressing with linear probing. */
+
+  for (i = 0; i < EVTDISP_CMDHDL_MAX; i++)
+    {
+      entry = &obj->cmdhdltbl[idx];
+      if (!entry->hdlr || entry->cmdid == cmdid)
+        {
+          return entry;
+        }
+
+      idx = EVTDISP_CMDHDL_INDEX(idx + 1);
+    }
+
+  return NULL;
+}
+
 /****************************************************************************
  * Name: evtdisp_dispatch
  *
@@ -120,6 +165,7 @@ static int32_t evtdisp_dispatch(FAR struct evtdisp_s *thiz,
   FAR struct evtdisp_obj_s   *obj        = (FAR struct evtdisp_obj_s *)thiz;
   FAR evthdl_if_t            *evthandler = NULL;
   FAR struct evtdisp_exhdl_s *exhdl      = NULL;
+  FAR struct evtdisp_cmdhdl_s *cmdhdl    = NULL;
 
   if (!thiz)
     {
@@ -127,6 +173,22 @@ static int32_t evtdisp_dispatch(FAR struct evtdisp_s *thiz,
       return -EINVAL;
     }
 
+  /* Handlers registered by command id are called directly. */
+
+  if (obj->cmdhdlnum && evt)
+    {
+      cmdhdl = evtdisp_findcmdhdlr(obj, apicmdgw_get_cmdid(evt));
+      if (cmdhdl && cmdhdl->hdlr)
+        {
+          if (EVTHDLRC_STARTHANDLE == cmdhdl->hdlr(evt, evtln))
+            {
+              return 0;
+            }
+        }
+    }
+
+  /* Walk the handler lists for the legacy handlers. */
+
   evthandler = obj->evthdllist;
 
   EVTDISP_DISPATCH(ret, evthandler);
@@ -314,6 +376,62 @@ static int32_t evtdisp_rmvhdlr(FAR struct evtdisp_s *thiz, uint8_t id)
   return ret;
 }
 
+/****************************************************************************
+ * Name: evtdisp_addcmdhdlr
+ *
+ * Description:
+ *  Add event handler for the command id.
+ *  The handler is called before walking the handler lists when an event
+ *  with @cmdid is dispatched.
+ *
+ * Input Parameters:
+ *  thiz   Event dispatcher object pointer.
+ *  cmdid  Command id to be handled.
+ *  hdlr   Event handler.
+ *
+ * Returned Value:
+ *   If the process succeeds, it returns 0.
+ *   Otherwise errno is returned.
+ *
+ ****************************************************************************/
+
+static int32_t evtdisp_addcmdhdlr(FAR struct evtdisp_s *thiz,
+  uint16_t cmdid, evthdl_if_t hdlr)
+{
+  FAR struct evtdisp_obj_s    *obj   = NULL;
+  FAR struct evtdisp_cmdhdl_s *entry = NULL;
+
+  /* Check input param. */
+
+  if (!thiz || !hdlr)
+    {
+      DBGIF_LOG_ERROR("NULL parameter\n");
+      return -EINVAL;
+    }
+
+  obj = (FAR struct evtdisp_obj_s *)thiz;
+
+  entry = evtdisp_findcmdhdlr(obj, cmdid);
+  if (!entry)
+    {
+      DBGIF_LOG1_ERROR("handler table is full. cmdid 0x%04x\n", cmdid);
+      return -ENOSPC;
+    }
+
+  if (entry->hdlr)
+    {
+      DBGIF_LOG1_ERROR("handler is already registered. cmdid 0x%04x\n",
+        cmdid);
+      return -EEXIST;
+    }
+
+  entry->cmdid = cmdid;
+  entry->hdlr  = hdlr;
+  obj->cmdhdlnum++;
+
+  return 0;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -359,10 +477,13 @@ FAR struct evtdisp_s *evtdisp_create(FAR evthdl_if_t *evthdllist)
 
   obj->evthdllist         = evthdllist;
   obj->exhdllist          = NULL;
+  obj->cmdhdlnum          = 0;
+  memset(obj->cmdhdltbl, 0, sizeof(obj->cmdhdltbl));
   obj->buffpool           = pool;
   obj->evtdispif.dispatch = evtdisp_dispatch;
   obj->evtdispif.addhdlr  = evtdisp_addhdlr;
   obj->evtdispif.rmvhdlr  = evtdisp_rmvhdlr;
+  obj->evtdispif.addcmdhdlr = evtdisp_addcmdhdlr;
 
   return (FAR struct evtdisp_s *)obj;
 }
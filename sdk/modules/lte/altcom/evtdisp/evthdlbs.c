@@ -83,6 +83,29 @@
 
 int32_t evthdlbs_runjob(
   int8_t id,  CODE thrdpool_jobif_t job, FAR void *arg)
+{
+  return evthdlbs_runjob_prio(id, job, arg, THRDPOOL_PRIO_NORMAL);
+}
+
+/****************************************************************************
+ * Name: evthdlbs_runjob_prio
+ *
+ * Description:
+ *  run job to the worker with priority.
+ *
+ * Input Parameters:
+ *  id  workerid
+ *  job  working job pointer.
+ *  arg  job argument pointer.
+ *  prio  job priority.
+ *
+ * Returned Value: 
+ *  job process result.
+ *
+ ****************************************************************************/
+
+int32_t evthdlbs_runjob_prio(int8_t id, CODE thrdpool_jobif_t job,
+  FAR void *arg, enum thrdpool_prio_e prio)
 {
   int32_t               ret;
   FAR struct thrdpool_s *pool = NULL;
@@ -100,7 +123,7 @@ int32_t evthdlbs_runjob(
       return -EINVAL;
     }
 
-  ret = pool->runjob(pool, job, arg);
+  ret = pool->runjob_prio(pool, job, arg, prio);
   if (0 > ret)
     {
       DBGIF_LOG1_ERROR("runjob() [errno=%d]\n", ret);
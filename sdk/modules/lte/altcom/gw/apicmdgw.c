@@ -159,9 +159,12 @@ static uint16_t apicmdgw_createtransid(void)
  *
  * Description:
  *   Create api command checksum.
+ *   Two network order halfwords are summed per 32-bit load, so only one
+ *   byte order conversion is needed for every 4 bytes.
  *
  * Input Parameters:
  *   ptr       Pointer to calculating checksum.
+ *   len       Length of calculating checksum.
  *
  * Returned Value:
  *   Returns checksum value.
@@ -171,19 +174,64 @@ static uint16_t apicmdgw_createtransid(void)
 static uint16_t apicmdgw_createchksum(FAR uint8_t *ptr, uint16_t len)
 {
   uint32_t ret     = 0x00;
-  uint16_t calctmp = 0x00;
-  uint16_t i;
-  int      is_odd  = len & 0x01;
+  uint32_t sum0    = 0x00;
+  uint32_t sum1    = 0x00;
+  uint32_t calctmp = 0x00;
+  uint16_t halftmp = 0x00;
+  uint16_t remlen  = len;
 
-  for (i = 0; i < (len & 0xFFFE); i += sizeof(uint16_t))
+  if (((uintptr_t)ptr & 0x01) == 0)
     {
-      calctmp = *((uint16_t *)(ptr + i));
-      ret += ntohs(calctmp);
+      /* Align to 32-bit boundary. */
+
+      if (((uintptr_t)ptr & 0x02) && (remlen >= sizeof(uint16_t)))
+        {
+          ret += ntohs(*((FAR uint16_t *)ptr));
+          ptr += sizeof(uint16_t);
+          remlen -= sizeof(uint16_t);
+        }
+
+      /* Sum 8 bytes per iteration. The accumulators can not overflow
+       * since the length is limited to 16 bits.
+       */
+
+      while (remlen >= 2 * sizeof(uint32_t))
+        {
+          calctmp = ntohl(((FAR uint32_t *)ptr)[0]);
+          sum0 += calctmp >> 16;
+          sum1 += calctmp & 0xFFFF;
+          calctmp = ntohl(((FAR uint32_t *)ptr)[1]);
+          sum0 += calctmp >> 16;
+          sum1 += calctmp & 0xFFFF;
+          ptr += 2 * sizeof(uint32_t);
+          remlen -= 2 * sizeof(uint32_t);
+        }
+
+      if (remlen >= sizeof(uint32_t))
+        {
+          calctmp = ntohl(*((FAR uint32_t *)ptr));
+          sum0 += calctmp >> 16;
+          sum1 += calctmp & 0xFFFF;
+          ptr += sizeof(uint32_t);
+          remlen -= sizeof(uint32_t);
+        }
+
+      ret += sum0 + sum1;
+    }
+
+  /* Remaining halfwords, or all of them for an odd address. */
+
+  while (remlen >= sizeof(uint16_t))
+    {
+      memcpy(&halftmp, ptr, sizeof(uint16_t));
+      ret += ntohs(halftmp);
+      ptr += sizeof(uint16_t);
+      remlen -= sizeof(uint16_t);
     }
 
-  if (is_odd)
+  if (remlen)
     {
-      ret += *(ptr + i) << 8;
+      ret += *ptr << 8;
     }
 
   ret = ~((ret & 0xFFFF) + (ret >> 16));
@@ -1273,3 +1321,22 @@ bool apicmdgw_cmdid_compare(FAR uint8_t *cmd, uint16_t cmdid)
 
   return false;
 }
+
+/****************************************************************************
+ * Name: apicmdgw_get_cmdid
+ *
+ * Description:
+ *   Get command id of the received event.
+ *
+ * Input Parameters:
+ *   cmd      Receive command payload pointer.
+ *
+ * Returned Value:
+ *   Command id of @cmd.
+ *
+ ****************************************************************************/
+
+uint16_t apicmdgw_get_cmdid(FAR uint8_t *cmd)
+{
+  return APICMDGW_GET_CMDID(APICMDGW_GET_HDR_PTR(cmd));
+}
@@ -64,8 +64,8 @@ typedef void (*apicmdhdlrbs_cb_job)(FAR void *arg);
  * Inline functions
  ****************************************************************************/
 
-static inline enum evthdlrc_e apicmdhdlrbs_do_runjob(FAR uint8_t *evt,
-  uint16_t cmdid, FAR apicmdhdlrbs_cb_job job)
+static inline enum evthdlrc_e apicmdhdlrbs_do_runjob_prio(FAR uint8_t *evt,
+  uint16_t cmdid, FAR apicmdhdlrbs_cb_job job, enum thrdpool_prio_e prio)
 {
 
   if (!evt)
@@ -79,8 +79,8 @@ static inline enum evthdlrc_e apicmdhdlrbs_do_runjob(FAR uint8_t *evt,
       return EVTHDLRC_UNSUPPORTEDEVENT;
     }
 
-  if (0 > evthdlbs_runjob(WRKRID_API_CALLBACK_THREAD,
-    (CODE thrdpool_jobif_t)job, (FAR void*)evt))
+  if (0 > evthdlbs_runjob_prio(WRKRID_API_CALLBACK_THREAD,
+    (CODE thrdpool_jobif_t)job, (FAR void*)evt, prio))
     {
       altcom_free_cmd((FAR uint8_t *)evt);
       return EVTHDLRC_INTERNALERROR;
@@ -89,4 +89,10 @@ static inline enum evthdlrc_e apicmdhdlrbs_do_runjob(FAR uint8_t *evt,
   return EVTHDLRC_STARTHANDLE;
 }
 
+static inline enum evthdlrc_e apicmdhdlrbs_do_runjob(FAR uint8_t *evt,
+  uint16_t cmdid, FAR apicmdhdlrbs_cb_job job)
+{
+  return apicmdhdlrbs_do_runjob_prio(evt, cmdid, job, THRDPOOL_PRIO_NORMAL);
+}
+
 #endif /* __MODULES_LTE_ALTCOM_INCLUDE_API_LTE_APICMDHDLRBS_H */
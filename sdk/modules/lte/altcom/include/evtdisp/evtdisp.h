@@ -49,10 +49,22 @@
 
 #define EVTDISP_EVTHDLLIST_TERMINATION (NULL)
 
+/* Maximum number of handlers registered by command id.
+ * This must be a power of two.
+ */
+
+#define EVTDISP_CMDHDL_MAX             (64)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+struct evtdisp_cmdhdl_s
+{
+  uint16_t    cmdid;
+  evthdl_if_t hdlr;
+};
+
 struct evtdisp_s
 {
   CODE int32_t (*dispatch)(FAR struct evtdisp_s *thiz,
@@ -61,6 +73,8 @@ struct evtdisp_s
     FAR evthdl_if_t *hdllist);
   CODE int32_t (*rmvhdlr)(FAR struct evtdisp_s *thiz,
     uint8_t hdlrid);
+  CODE int32_t (*addcmdhdlr)(FAR struct evtdisp_s *thiz,
+    uint16_t cmdid, evthdl_if_t hdlr);
 };
 
 /****************************************************************************
@@ -67,4 +67,24 @@
 int32_t evthdlbs_runjob(
   int8_t id,  CODE thrdpool_jobif_t job, FAR void *arg);
 
+/****************************************************************************
+ * Name: evthdlbs_runjob_prio
+ *
+ * Description:
+ *  run job to the worker with priority.
+ *
+ * Input Parameters:
+ *  id  workerid
+ *  job  working job pointer.
+ *  arg  job argument pointer.
+ *  prio  job priority.
+ *
+ * Returned Value: 
+ *  job process result.
+ *
+ ****************************************************************************/
+
+int32_t evthdlbs_runjob_prio(int8_t id, CODE thrdpool_jobif_t job,
+  FAR void *arg, enum thrdpool_prio_e prio);
+
 #endif /* __MODULES_LTE_ALTCOM_INCLUDE_EVTDISP_EVTHDLBS_H */
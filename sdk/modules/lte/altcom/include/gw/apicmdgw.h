@@ -228,4 +228,20 @@ int32_t apicmdgw_freebuff(FAR uint8_t *buff);
 
 bool apicmdgw_cmdid_compare(FAR uint8_t *cmd, uint16_t cmdid);
 
+/****************************************************************************
+ * Name: apicmdgw_get_cmdid
+ *
+ * Description:
+ *   Get command id of the received event.
+ *
+ * Input Parameters:
+ *   cmd      Receive command payload pointer.
+ *
+ * Returned Value:
+ *   Command id of @cmd.
+ *
+ ****************************************************************************/
+
+uint16_t apicmdgw_get_cmdid(FAR uint8_t *cmd);
+
 #endif /* __MODULES_LTE_ALTCOM_GW_APICMDGW_H */
\ No newline at end of file
@@ -0,0 +1,74 @@
+/****************************************************************************
+ * modules/lte/altcom/test/host/include/osal_opt.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_LTE_ALTCOM_TEST_HOST_INCLUDE_OSAL_OPT_H
+#define __MODULES_LTE_ALTCOM_TEST_HOST_INCLUDE_OSAL_OPT_H
+
+/* Host port of the OS abstraction layer types, used instead of
+ * modules/lte/include/opt/osal_opt.h.  The implementation is in
+ * host/osal_host.c.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <semaphore.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <nuttx/compiler.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct host_mq_s;
+
+typedef pthread_t             sys_task_t;
+typedef sem_t                 sys_sem_t;
+typedef FAR struct host_mq_s  *sys_mq_t;
+typedef pthread_mutex_t       sys_mutex_t;
+typedef int32_t               sys_evflag_t;
+typedef uint32_t              sys_evflag_ptn_t;
+typedef uint32_t              sys_evflag_mode_t;
+typedef timer_t               sys_timer_t;
+typedef pthread_cond_t        sys_thread_cond_t;
+typedef pthread_condattr_t    sys_thread_condattr_t;
+
+#endif /* __MODULES_LTE_ALTCOM_TEST_HOST_INCLUDE_OSAL_OPT_H */
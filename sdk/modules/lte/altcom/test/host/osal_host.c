@@ -0,0 +1,424 @@
+/****************************************************************************
+ * modules/lte/altcom/test/host/osal_host.c
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host port of the OS abstraction layer on POSIX threads.  Only the
+ * functions used by the ALTCOM gateway, the event dispatcher and the
+ * thread pool are implemented.
+ *
+ * The message queue keeps the NuttX mqueue order: the highest priority
+ * first, and first in first out among messages of the same priority.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "osal.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct host_task_s
+{
+  CODE void (*function)(FAR void *arg);
+  FAR void  *arg;
+};
+
+struct host_msg_s
+{
+  uint32_t prio;
+  uint32_t seq;
+};
+
+struct host_mq_s
+{
+  pthread_mutex_t lock;
+  pthread_cond_t  notempty;
+  pthread_cond_t  notfull;
+  int32_t         maxnum;
+  int32_t         size;
+  int32_t         num;
+  uint32_t        seq;
+  FAR struct host_msg_s *msgs;  /* maxnum entries */
+  FAR uint8_t     *data;        /* maxnum * size bytes */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static FAR void *host_task_entry(FAR void *arg)
+{
+  struct host_task_s task = *(FAR struct host_task_s *)arg;
+
+  free(arg);
+  task.function(task.arg);
+
+  return NULL;
+}
+
+static void host_abstime(int32_t timeout_ms, FAR struct timespec *abs_time)
+{
+  clock_gettime(CLOCK_REALTIME, abs_time);
+
+  abs_time->tv_sec  += timeout_ms / 1000;
+  abs_time->tv_nsec += (timeout_ms % 1000) * 1000 * 1000;
+  if (abs_time->tv_nsec >= 1000 * 1000 * 1000)
+    {
+      abs_time->tv_sec  += 1;
+      abs_time->tv_nsec -= 1000 * 1000 * 1000;
+    }
+}
+
+static int host_cond_wait(FAR pthread_cond_t *cond,
+                          FAR pthread_mutex_t *mutex,
+                          FAR const struct timespec *abs_time)
+{
+  if (abs_time)
+    {
+      return pthread_cond_timedwait(cond, mutex, abs_time);
+    }
+
+  return pthread_cond_wait(cond, mutex);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int32_t sys_create_task(FAR sys_task_t *task,
+                        FAR const sys_cretask_s *params)
+{
+  FAR struct host_task_s *param;
+  pthread_attr_t         attr;
+  int                    ret;
+
+  param = (FAR struct host_task_s *)malloc(sizeof(*param));
+  if (!param)
+    {
+      return -ENOMEM;
+    }
+
+  param->function = params->function;
+  param->arg      = params->arg;
+
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  ret = pthread_create(task, &attr, host_task_entry, param);
+  pthread_attr_destroy(&attr);
+  if (ret != 0)
+    {
+      free(param);
+      return -ret;
+    }
+
+  return 0;
+}
+
+int32_t sys_delete_task(FAR sys_task_t *task)
+{
+  if (task == SYS_OWN_TASK)
+    {
+      pthread_exit(NULL);
+    }
+
+  return -pthread_cancel(*task);
+}
+
+int32_t sys_sleep_task(int32_t timeout_ms)
+{
+  usleep(timeout_ms * 1000);
+
+  return 0;
+}
+
+int32_t sys_create_semaphore(FAR sys_sem_t *sem,
+                             FAR const sys_cresem_s *params)
+{
+  return sem_init(sem, 0, params->initial_count) < 0 ? -errno : 0;
+}
+
+int32_t sys_delete_semaphore(FAR sys_sem_t *sem)
+{
+  return sem_destroy(sem) < 0 ? -errno : 0;
+}
+
+int32_t sys_wait_semaphore(FAR sys_sem_t *sem, int32_t timeout_ms)
+{
+  struct timespec abs_time;
+  int             ret;
+
+  if (timeout_ms == SYS_TIMEO_FEVR)
+    {
+      while ((ret = sem_wait(sem)) < 0 && errno == EINTR);
+    }
+  else
+    {
+      host_abstime(timeout_ms, &abs_time);
+      while ((ret = sem_timedwait(sem, &abs_time)) < 0 && errno == EINTR);
+    }
+
+  return ret < 0 ? -errno : 0;
+}
+
+int32_t sys_post_semaphore(FAR sys_sem_t *sem)
+{
+  return sem_post(sem) < 0 ? -errno : 0;
+}
+
+int32_t sys_create_mutex(FAR sys_mutex_t *mutex,
+                         FAR const sys_cremtx_s *params)
+{
+  return -pthread_mutex_init(mutex, NULL);
+}
+
+int32_t sys_delete_mutex(FAR sys_mutex_t *mutex)
+{
+  return -pthread_mutex_destroy(mutex);
+}
+
+int32_t sys_lock_mutex(FAR sys_mutex_t *mutex)
+{
+  return -pthread_mutex_lock(mutex);
+}
+
+int32_t sys_unlock_mutex(FAR sys_mutex_t *mutex)
+{
+  return -pthread_mutex_unlock(mutex);
+}
+
+int32_t sys_create_mqueue(FAR sys_mq_t *mq, FAR const sys_cremq_s *params)
+{
+  FAR struct host_mq_s *q;
+
+  q = (FAR struct host_mq_s *)calloc(1, sizeof(*q));
+  if (!q)
+    {
+      return -ENOMEM;
+    }
+
+  q->maxnum = params->numof_queue;
+  q->size   = params->queue_size;
+  q->msgs   = (FAR struct host_msg_s *)calloc(q->maxnum, sizeof(*q->msgs));
+  q->data   = (FAR uint8_t *)calloc(q->maxnum, q->size);
+  if (!q->msgs || !q->data)
+    {
+      free(q->msgs);
+      free(q->data);
+      free(q);
+      return -ENOMEM;
+    }
+
+  pthread_mutex_init(&q->lock, NULL);
+  pthread_cond_init(&q->notempty, NULL);
+  pthread_cond_init(&q->notfull, NULL);
+
+  *mq = q;
+  return 0;
+}
+
+int32_t sys_delete_mqueue(FAR sys_mq_t *mq)
+{
+  FAR struct host_mq_s *q = *mq;
+
+  pthread_cond_destroy(&q->notfull);
+  pthread_cond_destroy(&q->notempty);
+  pthread_mutex_destroy(&q->lock);
+  free(q->data);
+  free(q->msgs);
+  free(q);
+
+  *mq = NULL;
+  return 0;
+}
+
+int32_t sys_send_mqueue_prio(FAR sys_mq_t *mq, FAR int8_t *message,
+                             size_t len, uint8_t prio, int32_t timeout_ms)
+{
+  FAR struct host_mq_s *q = *mq;
+  struct timespec      abs_time;
+  int                  ret = 0;
+
+  if (len > (size_t)q->size)
+    {
+      return -EMSGSIZE;
+    }
+
+  if (timeout_ms != SYS_TIMEO_FEVR)
+    {
+      host_abstime(timeout_ms, &abs_time);
+    }
+
+  pthread_mutex_lock(&q->lock);
+
+  while (q->num == q->maxnum && ret == 0)
+    {
+      ret = host_cond_wait(&q->notfull, &q->lock,
+                           timeout_ms == SYS_TIMEO_FEVR ? NULL : &abs_time);
+    }
+
+  if (ret == 0)
+    {
+      q->msgs[q->num].prio = prio;
+      q->msgs[q->num].seq  = q->seq++;
+      memcpy(&q->data[q->num * q->size], message, len);
+      q->num++;
+      pthread_cond_signal(&q->notempty);
+    }
+
+  pthread_mutex_unlock(&q->lock);
+
+  return -ret;
+}
+
+int32_t sys_send_mqueue(FAR sys_mq_t *mq, FAR int8_t *message, size_t len,
+                        int32_t timeout_ms)
+{
+  return sys_send_mqueue_prio(mq, message, len, 0, timeout_ms);
+}
+
+int32_t sys_recv_mqueue(FAR sys_mq_t *mq, FAR int8_t *message, size_t len,
+                        int32_t timeout_ms)
+{
+  FAR struct host_mq_s *q = *mq;
+  struct timespec      abs_time;
+  int32_t              best;
+  int32_t              i;
+  int                  ret = 0;
+
+  if (len < (size_t)q->size)
+    {
+      return -EMSGSIZE;
+    }
+
+  if (timeout_ms != SYS_TIMEO_FEVR)
+    {
+      host_abstime(timeout_ms, &abs_time);
+    }
+
+  pthread_mutex_lock(&q->lock);
+
+  while (q->num == 0 && ret == 0)
+    {
+      ret = host_cond_wait(&q->notempty, &q->lock,
+                           timeout_ms == SYS_TIMEO_FEVR ? NULL : &abs_time);
+    }
+
+  if (ret == 0)
+    {
+      /* The highest priority, and the oldest of them. */
+
+      best = 0;
+      for (i = 1; i < q->num; i++)
+        {
+          if (q->msgs[i].prio > q->msgs[best].prio ||
+              (q->msgs[i].prio == q->msgs[best].prio &&
+               (int32_t)(q->msgs[i].seq - q->msgs[best].seq) < 0))
+            {
+              best = i;
+            }
+        }
+
+      memcpy(message, &q->data[best * q->size], q->size);
+
+      /* Fill the hole with the last message. */
+
+      q->num--;
+      if (best != q->num)
+        {
+          q->msgs[best] = q->msgs[q->num];
+          memcpy(&q->data[best * q->size], &q->data[q->num * q->size],
+                 q->size);
+        }
+
+      pthread_cond_signal(&q->notfull);
+    }
+
+  pthread_mutex_unlock(&q->lock);
+
+  return ret ? -ret : q->size;
+}
+
+int32_t sys_thread_cond_init(FAR sys_thread_cond_t *cond,
+                             FAR sys_thread_condattr_t *cond_attr)
+{
+  return -pthread_cond_init(cond, cond_attr);
+}
+
+int32_t sys_thread_cond_destroy(FAR sys_thread_cond_t *cond)
+{
+  return -pthread_cond_destroy(cond);
+}
+
+int32_t sys_thread_cond_wait(FAR sys_thread_cond_t *cond,
+                             FAR sys_mutex_t *mutex)
+{
+  return -pthread_cond_wait(cond, mutex);
+}
+
+int32_t sys_thread_cond_timedwait(FAR sys_thread_cond_t *cond,
+                                  FAR sys_mutex_t *mutex,
+                                  int32_t timeout_ms)
+{
+  struct timespec abs_time;
+
+  if (timeout_ms == SYS_TIMEO_FEVR)
+    {
+      return -pthread_cond_wait(cond, mutex);
+    }
+
+  host_abstime(timeout_ms, &abs_time);
+  return -pthread_cond_timedwait(cond, mutex, &abs_time);
+}
+
+int32_t sys_thread_cond_signal(FAR sys_thread_cond_t *cond)
+{
+  return -pthread_cond_signal(cond);
+}
+
+uint32_t sys_get_systime_us(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint32_t)ts.tv_sec * 1000000 + (uint32_t)ts.tv_nsec / 1000;
+}
@@ -0,0 +1,271 @@
+/****************************************************************************
+ * modules/lte/altcom/test/test_chksum.c
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of the ALTCOM checksum.  apicmdgw_createchksum() is fuzzed
+ * with random lengths, alignments and data against the previous halfword
+ * loop, which defines the checksum on the wire.  With -b, both are timed
+ * on typical command sizes.
+ *
+ * Usage: test_chksum [-b] [count]
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+
+/* The checksum is private to the gateway. */
+
+#include "../gw/apicmdgw.c"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define FUZZ_MAXLEN   (4096)
+#define FUZZ_MAXALIGN (8)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static uint8_t g_buf[UINT16_MAX + FUZZ_MAXALIGN];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ref_chksum
+ *
+ * Description:
+ *   The previous implementation, one ntohs() per halfword.  The halfword
+ *   is copied, so that the reference also runs on odd addresses.
+ *
+ ****************************************************************************/
+
+static uint16_t ref_chksum(FAR uint8_t *ptr, uint16_t len)
+{
+  uint32_t ret     = 0x00;
+  uint16_t calctmp = 0x00;
+  uint16_t i;
+  int      is_odd  = len & 0x01;
+
+  for (i = 0; i < (len & 0xFFFE); i += sizeof(uint16_t))
+    {
+      memcpy(&calctmp, ptr + i, sizeof(uint16_t));
+      ret += ntohs(calctmp);
+    }
+
+  if (is_odd)
+    {
+      ret += *(ptr + i) << 8;
+    }
+
+  ret = ~((ret & 0xFFFF) + (ret >> 16));
+
+  return (uint16_t)ret;
+}
+
+static void fill_random(FAR uint8_t *buf, size_t len)
+{
+  size_t i;
+
+  for (i = 0; i < len; i++)
+    {
+      buf[i] = (uint8_t)rand();
+    }
+}
+
+/****************************************************************************
+ * Name: test_edges
+ *
+ * Description:
+ *   Lengths around the 8 and 4 byte loops at every alignment, and the
+ *   largest sums, where the single carry fold matters.
+ *
+ ****************************************************************************/
+
+static void test_edges(void)
+{
+  uint16_t len;
+  int      align;
+
+  fill_random(g_buf, sizeof(g_buf));
+
+  for (align = 0; align < FUZZ_MAXALIGN; align++)
+    {
+      for (len = 0; len <= 64; len++)
+        {
+          TEST_CHECK_EQ(apicmdgw_createchksum(g_buf + align, len),
+                        ref_chksum(g_buf + align, len));
+        }
+    }
+
+  memset(g_buf, 0xff, sizeof(g_buf));
+
+  for (align = 0; align < FUZZ_MAXALIGN; align++)
+    {
+      TEST_CHECK_EQ(apicmdgw_createchksum(g_buf + align, UINT16_MAX),
+                    ref_chksum(g_buf + align, UINT16_MAX));
+      TEST_CHECK_EQ(apicmdgw_createchksum(g_buf + align, UINT16_MAX - 1),
+                    ref_chksum(g_buf + align, UINT16_MAX - 1));
+    }
+}
+
+/****************************************************************************
+ * Name: test_fuzz
+ ****************************************************************************/
+
+static void test_fuzz(uint32_t count)
+{
+  uint32_t i;
+  uint16_t len;
+  int      align;
+  uint16_t expect;
+  uint16_t actual;
+
+  for (i = 0; i < count; i++)
+    {
+      len   = (uint16_t)(rand() % (FUZZ_MAXLEN + 1));
+      align = rand() % FUZZ_MAXALIGN;
+
+      /* Sometimes a buffer of the maximum length. */
+
+      if ((i & 0x3ff) == 0)
+        {
+          len = (uint16_t)(UINT16_MAX - (rand() % 16));
+        }
+
+      fill_random(g_buf + align, len);
+
+      expect = ref_chksum(g_buf + align, len);
+      actual = apicmdgw_createchksum(g_buf + align, len);
+      if (expect != actual)
+        {
+          printf("len %u align %d: %04x != %04x\n", len, align, actual,
+                 expect);
+          g_test_failed++;
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: bench
+ ****************************************************************************/
+
+static void bench(uint32_t count)
+{
+  static const uint16_t lens[] =
+  {
+    APICMDGW_HDR_CHKSUM_LEN, 64, 1500, 3000
+  };
+
+  volatile uint16_t sink = 0;
+  uint64_t          start;
+  uint64_t          newns;
+  uint64_t          refns;
+  uint32_t          i;
+  uint32_t          n;
+  size_t            j;
+
+  fill_random(g_buf, sizeof(g_buf));
+
+  for (j = 0; j < sizeof(lens) / sizeof(lens[0]); j++)
+    {
+      n = (uint32_t)(count * 16ull / (lens[j] + 16));
+
+      start = test_now_ns();
+      for (i = 0; i < n; i++)
+        {
+          sink += ref_chksum(g_buf, lens[j]);
+        }
+
+      refns = test_now_ns() - start;
+
+      start = test_now_ns();
+      for (i = 0; i < n; i++)
+        {
+          sink += apicmdgw_createchksum(g_buf, lens[j]);
+        }
+
+      newns = test_now_ns() - start;
+
+      printf("len %5u: halfword %7.1f ns, word %7.1f ns (x%.2f)\n",
+             lens[j], (double)refns / n, (double)newns / n,
+             newns ? (double)refns / newns : 0.0);
+    }
+
+  (void)sink;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  uint32_t count = 100000;
+  bool     dobench = false;
+  int      i;
+
+  for (i = 1; i < argc; i++)
+    {
+      if (strcmp(argv[i], "-b") == 0)
+        {
+          dobench = true;
+        }
+      else
+        {
+          count = (uint32_t)strtoul(argv[i], NULL, 0);
+        }
+    }
+
+  srand(1);
+
+  test_edges();
+  test_fuzz(count);
+
+  if (dobench)
+    {
+      bench(count);
+    }
+
+  return TEST_RESULT("test_chksum");
+}
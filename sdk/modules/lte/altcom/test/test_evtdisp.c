@@ -0,0 +1,461 @@
+/****************************************************************************
+ * modules/lte/altcom/test/test_evtdisp.c
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of the event dispatcher.  The command ids of the LTE API
+ * responses are dispatched through the legacy handler list, where each
+ * handler compares the id in turn, and through the table registered with
+ * addcmdhdlr().  Both must reach the same handler.  With -b, the cost per
+ * event of both ways is timed.
+ *
+ * Usage: test_evtdisp [-b] [count]
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <arpa/inet.h>
+#include "host_test.h"
+#include "evtdisp.h"
+#include "apicmdgw.h"
+#include "apicmd.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define EVT_DATALEN   (16)
+#define EVT_UNKNOWNID (0x7ffe)
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+/* One handler per command id, in the order of the LTE API list. */
+
+#define TEST_HDLR(n) \
+  static enum evthdlrc_e hdlr_##n(FAR uint8_t *evt, uint32_t evlen) \
+  { \
+    return handle(n, evt); \
+  }
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct test_evt_s
+{
+  struct apicmd_cmdhdr_s hdr;
+  uint8_t                data[EVT_DATALEN];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Command ids of the LTE API handlers, as listed in ltebuilder.c. */
+
+static const uint16_t g_cmdids[] =
+{
+  APICMDID_CONVERT_RES(APICMDID_POWER_ON),
+  APICMDID_CONVERT_RES(APICMDID_GET_VERSION),
+  APICMDID_CONVERT_RES(APICMDID_GET_IMEI),
+  APICMDID_CONVERT_RES(APICMDID_GET_LTIME),
+  APICMDID_REPORT_CELLINFO,
+  APICMDID_REPORT_QUALITY,
+  APICMDID_CONVERT_RES(APICMDID_ENTER_PIN),
+  APICMDID_ERRIND,
+  APICMDID_CONVERT_RES(APICMDID_GET_PINSET),
+  APICMDID_CONVERT_RES(APICMDID_GET_IMSI),
+  APICMDID_CONVERT_RES(APICMDID_GET_OPERATOR),
+  APICMDID_CONVERT_RES(APICMDID_GET_PHONENO),
+  APICMDID_CONVERT_RES(APICMDID_SET_PIN_LOCK),
+  APICMDID_CONVERT_RES(APICMDID_SET_PIN_CODE),
+  APICMDID_REPORT_EVT,
+  APICMDID_CONVERT_RES(APICMDID_GET_EDRX),
+  APICMDID_CONVERT_RES(APICMDID_SET_EDRX),
+  APICMDID_CONVERT_RES(APICMDID_GET_PSM),
+  APICMDID_CONVERT_RES(APICMDID_SET_PSM),
+  APICMDID_CONVERT_RES(APICMDID_GET_CE),
+  APICMDID_CONVERT_RES(APICMDID_SET_CE),
+  APICMDID_CONVERT_RES(APICMDID_RADIO_ON),
+  APICMDID_CONVERT_RES(APICMDID_RADIO_OFF),
+  APICMDID_CONVERT_RES(APICMDID_ACTIVATE_PDN),
+  APICMDID_CONVERT_RES(APICMDID_DEACTIVATE_PDN),
+  APICMDID_CONVERT_RES(APICMDID_DATA_ALLOW),
+  APICMDID_REPORT_NETINFO,
+  APICMDID_CONVERT_RES(APICMDID_GET_NETINFO),
+  APICMDID_CONVERT_RES(APICMDID_GET_IMS_CAP),
+  APICMDID_CONVERT_RES(APICMDID_GET_SIMINFO),
+  APICMDID_CONVERT_RES(APICMDID_GET_DYNAMICEDRX),
+  APICMDID_CONVERT_RES(APICMDID_GET_DYNAMICPSM),
+  APICMDID_ERRINFO,
+  APICMDID_CONVERT_RES(APICMDID_SOCK_SELECT),
+  APICMDID_CONVERT_RES(APICMDID_GET_QUALITY),
+};
+
+#define TEST_NCMDIDS ARRAY_SIZE(g_cmdids)
+
+static uint32_t g_handled[TEST_NCMDIDS];
+static int      g_lasthdlr;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static enum evthdlrc_e handle(int n, FAR uint8_t *evt)
+{
+  /* Same as the API handlers: check the id before starting. */
+
+  if (!apicmdgw_cmdid_compare(evt, g_cmdids[n]))
+    {
+      return EVTHDLRC_UNSUPPORTEDEVENT;
+    }
+
+  g_handled[n]++;
+  g_lasthdlr = n;
+
+  return EVTHDLRC_STARTHANDLE;
+}
+
+TEST_HDLR(0)  TEST_HDLR(1)  TEST_HDLR(2)  TEST_HDLR(3)  TEST_HDLR(4)
+TEST_HDLR(5)  TEST_HDLR(6)  TEST_HDLR(7)  TEST_HDLR(8)  TEST_HDLR(9)
+TEST_HDLR(10) TEST_HDLR(11) TEST_HDLR(12) TEST_HDLR(13) TEST_HDLR(14)
+TEST_HDLR(15) TEST_HDLR(16) TEST_HDLR(17) TEST_HDLR(18) TEST_HDLR(19)
+TEST_HDLR(20) TEST_HDLR(21) TEST_HDLR(22) TEST_HDLR(23) TEST_HDLR(24)
+TEST_HDLR(25) TEST_HDLR(26) TEST_HDLR(27) TEST_HDLR(28) TEST_HDLR(29)
+TEST_HDLR(30) TEST_HDLR(31) TEST_HDLR(32) TEST_HDLR(33) TEST_HDLR(34)
+
+static evthdl_if_t g_hdlrlist[] =
+{
+  hdlr_0,  hdlr_1,  hdlr_2,  hdlr_3,  hdlr_4,
+  hdlr_5,  hdlr_6,  hdlr_7,  hdlr_8,  hdlr_9,
+  hdlr_10, hdlr_11, hdlr_12, hdlr_13, hdlr_14,
+  hdlr_15, hdlr_16, hdlr_17, hdlr_18, hdlr_19,
+  hdlr_20, hdlr_21, hdlr_22, hdlr_23, hdlr_24,
+  hdlr_25, hdlr_26, hdlr_27, hdlr_28, hdlr_29,
+  hdlr_30, hdlr_31, hdlr_32, hdlr_33, hdlr_34,
+  EVTDISP_EVTHDLLIST_TERMINATION
+};
+
+static evthdl_if_t g_emptylist[] =
+{
+  EVTDISP_EVTHDLLIST_TERMINATION
+};
+
+static struct test_evt_s g_evts[TEST_NCMDIDS];
+
+/****************************************************************************
+ * Name: make_evt
+ *
+ * Description:
+ *   Build a received event.  Handlers get the payload, the header with
+ *   the command id in network order is in front of it.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *make_evt(FAR struct test_evt_s *evt, uint16_t cmdid)
+{
+  memset(evt, 0, sizeof(*evt));
+  evt->hdr.cmdid = htons(cmdid);
+  evt->hdr.dtlen = htons(EVT_DATALEN);
+
+  return evt->data;
+}
+
+/****************************************************************************
+ * Name: create_tbldisp
+ *
+ * Description:
+ *   Dispatcher with all handlers registered by command id.
+ *
+ ****************************************************************************/
+
+static FAR struct evtdisp_s *create_tbldisp(void)
+{
+  FAR struct evtdisp_s *disp;
+  size_t               i;
+
+  disp = evtdisp_create(g_emptylist);
+  TEST_CHECK(disp != NULL);
+  if (!disp)
+    {
+      return NULL;
+    }
+
+  for (i = 0; i < TEST_NCMDIDS; i++)
+    {
+      TEST_CHECK_EQ(disp->addcmdhdlr(disp, g_cmdids[i], g_hdlrlist[i]), 0);
+    }
+
+  return disp;
+}
+
+/****************************************************************************
+ * Name: check_dispatch
+ *
+ * Description:
+ *   Every command id reaches its own handler, once.  Unknown ids are
+ *   rejected.
+ *
+ ****************************************************************************/
+
+static void check_dispatch(FAR struct evtdisp_s *disp)
+{
+  struct test_evt_s evt;
+  FAR uint8_t       *data;
+  size_t            i;
+
+  memset(g_handled, 0, sizeof(g_handled));
+
+  for (i = 0; i < TEST_NCMDIDS; i++)
+    {
+      data = make_evt(&evt, g_cmdids[i]);
+      g_lasthdlr = -1;
+      TEST_CHECK_EQ(disp->dispatch(disp, data, EVT_DATALEN), 0);
+      TEST_CHECK_EQ(g_lasthdlr, i);
+    }
+
+  for (i = 0; i < TEST_NCMDIDS; i++)
+    {
+      TEST_CHECK_EQ(g_handled[i], 1);
+    }
+
+  data = make_evt(&evt, EVT_UNKNOWNID);
+  TEST_CHECK_EQ(disp->dispatch(disp, data, EVT_DATALEN), -EINVAL);
+}
+
+/****************************************************************************
+ * Name: test_list
+ ****************************************************************************/
+
+static void test_list(void)
+{
+  FAR struct evtdisp_s *disp = evtdisp_create(g_hdlrlist);
+
+  TEST_CHECK(disp != NULL);
+  if (disp)
+    {
+      check_dispatch(disp);
+      evtdisp_delete(disp);
+    }
+}
+
+/****************************************************************************
+ * Name: test_table
+ ****************************************************************************/
+
+static void test_table(void)
+{
+  FAR struct evtdisp_s *disp = create_tbldisp();
+
+  if (disp)
+    {
+      /* The same id can not be registered twice. */
+
+      TEST_CHECK_EQ(disp->addcmdhdlr(disp, g_cmdids[0], g_hdlrlist[1]),
+                    -EEXIST);
+      TEST_CHECK_EQ(disp->addcmdhdlr(disp, g_cmdids[0], NULL), -EINVAL);
+
+      check_dispatch(disp);
+      evtdisp_delete(disp);
+    }
+}
+
+/****************************************************************************
+ * Name: test_mixed
+ *
+ * Description:
+ *   Handlers only in the list are still reached when the table is used,
+ *   and a table handler refusing the event falls back to the list.
+ *
+ ****************************************************************************/
+
+static void test_mixed(void)
+{
+  FAR struct evtdisp_s *disp = evtdisp_create(g_hdlrlist);
+  size_t               i;
+
+  TEST_CHECK(disp != NULL);
+  if (!disp)
+    {
+      return;
+    }
+
+  for (i = 0; i < TEST_NCMDIDS; i += 2)
+    {
+      TEST_CHECK_EQ(disp->addcmdhdlr(disp, g_cmdids[i], g_hdlrlist[i]), 0);
+    }
+
+  /* Registered with the handler of another id, refuses the event. */
+
+  TEST_CHECK_EQ(disp->addcmdhdlr(disp, g_cmdids[1], g_hdlrlist[0]), 0);
+
+  check_dispatch(disp);
+  evtdisp_delete(disp);
+}
+
+/****************************************************************************
+ * Name: test_full
+ *
+ * Description:
+ *   Colliding ids are probed to the next entry until the table is full.
+ *
+ ****************************************************************************/
+
+static void test_full(void)
+{
+  FAR struct evtdisp_s *disp = evtdisp_create(g_emptylist);
+  uint16_t             i;
+
+  TEST_CHECK(disp != NULL);
+  if (!disp)
+    {
+      return;
+    }
+
+  /* All ids have the same index. */
+
+  for (i = 0; i < EVTDISP_CMDHDL_MAX; i++)
+    {
+      TEST_CHECK_EQ(disp->addcmdhdlr(disp, i * EVTDISP_CMDHDL_MAX,
+                                     g_hdlrlist[0]), 0);
+    }
+
+  TEST_CHECK_EQ(disp->addcmdhdlr(disp, EVT_UNKNOWNID, g_hdlrlist[0]),
+                -ENOSPC);
+  evtdisp_delete(disp);
+}
+
+/****************************************************************************
+ * Name: bench_disp
+ ****************************************************************************/
+
+static double bench_disp(FAR struct evtdisp_s *disp, uint32_t count,
+                         size_t first, size_t num)
+{
+  FAR uint8_t *data[TEST_NCMDIDS];
+  uint64_t    start;
+  uint32_t    i;
+  size_t      j;
+
+  for (j = 0; j < num; j++)
+    {
+      data[j] = make_evt(&g_evts[j], g_cmdids[first + j]);
+    }
+
+  start = test_now_ns();
+  for (i = 0; i < count; i++)
+    {
+      for (j = 0; j < num; j++)
+        {
+          (void)disp->dispatch(disp, data[j], EVT_DATALEN);
+        }
+    }
+
+  return (double)(test_now_ns() - start) / ((double)count * num);
+}
+
+/****************************************************************************
+ * Name: bench
+ *
+ * Description:
+ *   Time per dispatched event, with all ids in turn, and with the id at
+ *   the end of the list, which is the worst case of the list walk.
+ *
+ ****************************************************************************/
+
+static void bench(uint32_t count)
+{
+  FAR struct evtdisp_s *list = evtdisp_create(g_hdlrlist);
+  FAR struct evtdisp_s *tbl  = create_tbldisp();
+  double               listns;
+  double               tblns;
+
+  if (!list || !tbl)
+    {
+      g_test_failed++;
+      return;
+    }
+
+  listns = bench_disp(list, count, 0, TEST_NCMDIDS);
+  tblns  = bench_disp(tbl, count, 0, TEST_NCMDIDS);
+  printf("%zu ids:  list %6.1f ns, table %6.1f ns (x%.2f)\n",
+         TEST_NCMDIDS, listns, tblns, tblns ? listns / tblns : 0.0);
+
+  listns = bench_disp(list, count * 4, TEST_NCMDIDS - 1, 1);
+  tblns  = bench_disp(tbl, count * 4, TEST_NCMDIDS - 1, 1);
+  printf("last id: list %6.1f ns, table %6.1f ns (x%.2f)\n",
+         listns, tblns, tblns ? listns / tblns : 0.0);
+
+  evtdisp_delete(list);
+  evtdisp_delete(tbl);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  uint32_t count = 100000;
+  bool     dobench = false;
+  int      i;
+
+  for (i = 1; i < argc; i++)
+    {
+      if (strcmp(argv[i], "-b") == 0)
+        {
+          dobench = true;
+        }
+      else
+        {
+          count = (uint32_t)strtoul(argv[i], NULL, 0);
+        }
+    }
+
+  test_list();
+  test_table();
+  test_mixed();
+  test_full();
+
+  if (dobench)
+    {
+      bench(count);
+    }
+
+  return TEST_RESULT("test_evtdisp");
+}
@@ -0,0 +1,404 @@
+/****************************************************************************
+ * modules/lte/altcom/test/test_thrdpool.c
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of the thread pool priority lane.  A pool set up like the API
+ * callback thread, one thread and 16 queue entries, runs a stream of bulk
+ * callbacks.  Control jobs are queued with runjob(), as before the lane,
+ * and with runjob_prio(THRDPOOL_PRIO_HIGH), and the time until they start
+ * is compared.  The order of the queue and the statistics are checked
+ * without load.
+ *
+ * Usage: test_thrdpool [-b] [count]
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "host_test.h"
+#include "thrdpool.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define POOL_QUENUM    (16)  /* APICALLBACK_THRD_QNUM */
+#define ORDER_JOBNUM   (8)
+#define BULK_DEPTH     (POOL_QUENUM - 4)
+#define BULK_US        (100)
+#define CONTROL_GAP_US (500)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct order_s
+{
+  pthread_mutex_t lock;
+  int             order[ORDER_JOBNUM + 2];
+  int             num;
+};
+
+struct control_s
+{
+  uint64_t enqns;
+  uint64_t waitns;
+  sys_sem_t done;
+};
+
+struct latency_s
+{
+  uint64_t total;
+  uint64_t max;
+  uint32_t num;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct order_s  g_order;
+static sys_sem_t       g_gate;
+static volatile int    g_bulkpending;
+static volatile bool   g_bulkstop;
+static pthread_mutex_t g_bulklock = PTHREAD_MUTEX_INITIALIZER;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static FAR struct thrdpool_s *create_pool(void)
+{
+  struct thrdpool_set_s set;
+
+  set.thrdstacksize = 2048;
+  set.thrdpriority  = SYS_TASK_PRIO_NORMAL;
+  set.maxthrdnum    = 1;
+  set.maxquenum     = POOL_QUENUM;
+
+  return thrdpool_create(&set);
+}
+
+static void spin_us(uint32_t us)
+{
+  uint64_t end = test_now_ns() + us * 1000ull;
+
+  while (test_now_ns() < end);
+}
+
+/****************************************************************************
+ * Name: order_job
+ ****************************************************************************/
+
+static void order_job(FAR void *arg)
+{
+  pthread_mutex_lock(&g_order.lock);
+  g_order.order[g_order.num++] = (int)(intptr_t)arg;
+  pthread_mutex_unlock(&g_order.lock);
+}
+
+static void gate_job(FAR void *arg)
+{
+  sys_wait_semaphore(&g_gate, SYS_TIMEO_FEVR);
+}
+
+static void done_job(FAR void *arg)
+{
+  sys_post_semaphore((FAR sys_sem_t *)arg);
+}
+
+/****************************************************************************
+ * Name: test_order
+ *
+ * Description:
+ *   While the thread is held, normal jobs are queued and then high ones.
+ *   The high jobs run first, each priority in the order queued.
+ *
+ ****************************************************************************/
+
+static void test_order(void)
+{
+  FAR struct thrdpool_s  *pool = create_pool();
+  struct thrdpool_stat_s stat;
+  sys_cresem_s           semparam;
+  sys_sem_t              done;
+  int                    i;
+
+  TEST_CHECK(pool != NULL);
+  if (!pool)
+    {
+      return;
+    }
+
+  semparam.initial_count = 0;
+  semparam.max_count     = 1;
+  sys_create_semaphore(&g_gate, &semparam);
+  sys_create_semaphore(&done, &semparam);
+  pthread_mutex_init(&g_order.lock, NULL);
+  g_order.num = 0;
+
+  TEST_CHECK_EQ(pool->runjob(pool, gate_job, NULL), 0);
+
+  for (i = 0; i < ORDER_JOBNUM; i++)
+    {
+      TEST_CHECK_EQ(pool->runjob(pool, order_job, (FAR void *)(intptr_t)i),
+                    0);
+    }
+
+  TEST_CHECK_EQ(pool->runjob_prio(pool, order_job,
+                                  (FAR void *)(intptr_t)100,
+                                  THRDPOOL_PRIO_HIGH), 0);
+  TEST_CHECK_EQ(pool->runjob_prio(pool, order_job,
+                                  (FAR void *)(intptr_t)101,
+                                  THRDPOOL_PRIO_HIGH), 0);
+  TEST_CHECK_EQ(pool->runjob_prio(pool, order_job, NULL, THRDPOOL_PRIO_NUM),
+                -EINVAL);
+  TEST_CHECK_EQ(pool->runjob(pool, done_job, &done), 0);
+
+  sys_post_semaphore(&g_gate);
+  sys_wait_semaphore(&done, SYS_TIMEO_FEVR);
+
+  TEST_CHECK_EQ(g_order.num, ORDER_JOBNUM + 2);
+  TEST_CHECK_EQ(g_order.order[0], 100);
+  TEST_CHECK_EQ(g_order.order[1], 101);
+  for (i = 0; i < ORDER_JOBNUM; i++)
+    {
+      TEST_CHECK_EQ(g_order.order[i + 2], i);
+    }
+
+  TEST_CHECK_EQ(pool->getstat(pool, &stat), 0);
+  TEST_CHECK_EQ(stat.jobnum[THRDPOOL_PRIO_NORMAL], ORDER_JOBNUM + 2);
+  TEST_CHECK_EQ(stat.jobnum[THRDPOOL_PRIO_HIGH], 2);
+  TEST_CHECK(stat.waitmax[THRDPOOL_PRIO_HIGH] <=
+             stat.waitmax[THRDPOOL_PRIO_NORMAL]);
+
+  TEST_CHECK_EQ(thrdpool_delete(pool), 0);
+  sys_delete_semaphore(&done);
+  sys_delete_semaphore(&g_gate);
+  pthread_mutex_destroy(&g_order.lock);
+}
+
+/****************************************************************************
+ * Name: bulk_job
+ *
+ * Description:
+ *   A callback to the application, e.g. a quality or cell report.
+ *
+ ****************************************************************************/
+
+static void bulk_job(FAR void *arg)
+{
+  spin_us(BULK_US);
+
+  pthread_mutex_lock(&g_bulklock);
+  g_bulkpending--;
+  pthread_mutex_unlock(&g_bulklock);
+}
+
+/****************************************************************************
+ * Name: bulk_main
+ *
+ * Description:
+ *   Keep BULK_DEPTH callbacks queued, so that control jobs are queued
+ *   behind a backlog but never block on a full queue.
+ *
+ ****************************************************************************/
+
+static FAR void *bulk_main(FAR void *arg)
+{
+  FAR struct thrdpool_s *pool = (FAR struct thrdpool_s *)arg;
+  bool                   queue;
+
+  while (!g_bulkstop)
+    {
+      pthread_mutex_lock(&g_bulklock);
+      queue = g_bulkpending < BULK_DEPTH;
+      if (queue)
+        {
+          g_bulkpending++;
+        }
+
+      pthread_mutex_unlock(&g_bulklock);
+
+      if (queue)
+        {
+          pool->runjob(pool, bulk_job, NULL);
+        }
+      else
+        {
+          usleep(BULK_US / 4);
+        }
+    }
+
+  return NULL;
+}
+
+static void control_job(FAR void *arg)
+{
+  FAR struct control_s *ctrl = (FAR struct control_s *)arg;
+
+  ctrl->waitns = test_now_ns() - ctrl->enqns;
+  sys_post_semaphore(&ctrl->done);
+}
+
+/****************************************************************************
+ * Name: measure
+ *
+ * Description:
+ *   Time from queueing a control job until it starts, under bulk load.
+ *
+ ****************************************************************************/
+
+static void measure(uint32_t count, bool useprio,
+                    FAR struct latency_s *lat)
+{
+  FAR struct thrdpool_s  *pool = create_pool();
+  struct control_s       ctrl;
+  sys_cresem_s           semparam;
+  pthread_t              bulk;
+  uint32_t               i;
+
+  memset(lat, 0, sizeof(*lat));
+
+  TEST_CHECK(pool != NULL);
+  if (!pool)
+    {
+      return;
+    }
+
+  semparam.initial_count = 0;
+  semparam.max_count     = 1;
+  sys_create_semaphore(&ctrl.done, &semparam);
+
+  g_bulkpending = 0;
+  g_bulkstop    = false;
+  pthread_create(&bulk, NULL, bulk_main, pool);
+
+  /* Let the backlog build up. */
+
+  usleep(BULK_DEPTH * BULK_US * 2);
+
+  for (i = 0; i < count; i++)
+    {
+      ctrl.enqns = test_now_ns();
+      if (useprio)
+        {
+          TEST_CHECK_EQ(pool->runjob_prio(pool, control_job, &ctrl,
+                                          THRDPOOL_PRIO_HIGH), 0);
+        }
+      else
+        {
+          TEST_CHECK_EQ(pool->runjob(pool, control_job, &ctrl), 0);
+        }
+
+      sys_wait_semaphore(&ctrl.done, SYS_TIMEO_FEVR);
+
+      lat->total += ctrl.waitns;
+      lat->num++;
+      if (lat->max < ctrl.waitns)
+        {
+          lat->max = ctrl.waitns;
+        }
+
+      usleep(CONTROL_GAP_US);
+    }
+
+  g_bulkstop = true;
+  pthread_join(bulk, NULL);
+
+  TEST_CHECK_EQ(thrdpool_delete(pool), 0);
+  sys_delete_semaphore(&ctrl.done);
+}
+
+/****************************************************************************
+ * Name: bench
+ ****************************************************************************/
+
+static void bench(uint32_t count)
+{
+  struct latency_s oldlat;
+  struct latency_s newlat;
+
+  measure(count, false, &oldlat);
+  measure(count, true, &newlat);
+
+  if (!oldlat.num || !newlat.num)
+    {
+      return;
+    }
+
+  printf("bulk %d x %d us queued, control job wait:\n", BULK_DEPTH,
+         BULK_US);
+  printf("  runjob            avg %7.1f us, max %7.1f us\n",
+         oldlat.total / 1000.0 / oldlat.num, oldlat.max / 1000.0);
+  printf("  runjob_prio(HIGH) avg %7.1f us, max %7.1f us\n",
+         newlat.total / 1000.0 / newlat.num, newlat.max / 1000.0);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  uint32_t count = 1000;
+  bool     dobench = false;
+  int      i;
+
+  for (i = 1; i < argc; i++)
+    {
+      if (strcmp(argv[i], "-b") == 0)
+        {
+          dobench = true;
+        }
+      else
+        {
+          count = (uint32_t)strtoul(argv[i], NULL, 0);
+        }
+    }
+
+  test_order();
+
+  if (dobench)
+    {
+      bench(count);
+    }
+
+  return TEST_RESULT("test_thrdpool");
+}
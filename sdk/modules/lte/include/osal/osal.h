@@ -412,6 +412,31 @@ int32_t sys_delete_mqueue(FAR sys_mq_t *mq);
 int32_t sys_send_mqueue(FAR sys_mq_t *mq, FAR int8_t *message, size_t len,
                         int32_t timeout_ms);
 
+/****************************************************************************
+ * Name: sys_send_mqueue_prio
+ *
+ * Description:
+ *   Send message with priority by a message queue.
+ *
+ * Input Parameters:
+ *   mq         The handle of the message queue to be send.
+ *   message    The message to be send.
+ *   len        The length of the message.
+ *   prio       The priority of the message. Messages with higher priority
+ *              are received first.
+ *   timeout_ms The time in milliseconds to block until send timeout occurs.
+ *              If timeout_ms set to SYS_TIMEO_FEVR then wait until
+ *              the message queue to become available.
+ *
+ * Returned Value:
+ *   If the message queue was sent successfully then 0 is returned.
+ *   Otherwise negative value is returned.
+ *
+ ****************************************************************************/
+
+int32_t sys_send_mqueue_prio(FAR sys_mq_t *mq, FAR int8_t *message,
+                             size_t len, uint8_t prio, int32_t timeout_ms);
+
 /****************************************************************************
  * Name: sys_recv_mqueue
  *
@@ -701,6 +726,22 @@ int32_t sys_thread_cond_timedwait(FAR sys_thread_cond_t *cond,
 
 int32_t sys_thread_cond_signal(FAR sys_thread_cond_t *cond);
 
+/****************************************************************************
+ * Name: sys_get_systime_us
+ *
+ * Description:
+ *   Get the monotonic system time.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   The system time in microseconds. The value wraps around.
+ *
+ ****************************************************************************/
+
+uint32_t sys_get_systime_us(void);
+
 
 /****************************************************************************
  * Inline Functions
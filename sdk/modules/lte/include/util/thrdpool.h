@@ -40,6 +40,7 @@
  * Included Files
  ****************************************************************************/
 
+#include <sdk/config.h>
 #include <errno.h>
 #include "osal.h"
 
@@ -49,6 +50,26 @@
 
 typedef CODE void (*thrdpool_jobif_t)(FAR void *arg);
 
+/* Priority of the job. Jobs with higher priority are run first. */
+
+enum thrdpool_prio_e
+{
+  THRDPOOL_PRIO_NORMAL = 0,
+  THRDPOOL_PRIO_HIGH,
+  THRDPOOL_PRIO_NUM
+};
+
+/* Statistics of the queue for each priority.
+ * Time values are in microseconds.
+ */
+
+struct thrdpool_stat_s
+{
+  uint32_t jobnum[THRDPOOL_PRIO_NUM];
+  uint32_t waitmax[THRDPOOL_PRIO_NUM];
+  uint64_t waittotal[THRDPOOL_PRIO_NUM];
+};
+
 struct thrdpool_set_s
 {
   uint32_t thrdstacksize;
@@ -62,6 +83,11 @@ struct thrdpool_s
   CODE int32_t (*runjob)(
     FAR struct thrdpool_s *thiz, CODE thrdpool_jobif_t job, FAR void *arg);
   CODE uint32_t (*getfreethrds)(FAR struct thrdpool_s *thiz);
+  CODE int32_t (*runjob_prio)(
+    FAR struct thrdpool_s *thiz, CODE thrdpool_jobif_t job, FAR void *arg,
+    enum thrdpool_prio_e prio);
+  CODE int32_t (*getstat)(
+    FAR struct thrdpool_s *thiz, FAR struct thrdpool_stat_s *stat);
 };
 
 /****************************************************************************
@@ -63,7 +63,8 @@
 #include <nuttx/arch.h>
 #include <nuttx/sched.h>
 
-#ifdef CONFIG_LTE_DAEMON_SYNC_TIME
+#if defined(CONFIG_LTE_DAEMON_SYNC_TIME) || \
+    defined(CONFIG_LTE_DAEMON_SOCKET_STATISTICS)
 #  include <sys/time.h>
 #endif
 
@@ -98,6 +99,10 @@
 #  define CONFIG_LTE_DAEMON_TASK_PRIORITY (110)
 #endif
 
+#ifndef CONFIG_LTE_DAEMON_SOCKET_BUFSIZE
+#  define CONFIG_LTE_DAEMON_SOCKET_BUFSIZE (1500)
+#endif
+
 #ifndef MIN
 #  define MIN(a,b)  (((a) < (b)) ? (a) : (b))
 #endif
@@ -119,6 +124,8 @@
 #endif
 
 #define SELECT_ASYNC_RETRY_MAX      1
+#define SELECT_EVENTS               (USRSOCK_EVENT_RECVFROM_AVAIL | \
+                                     USRSOCK_EVENT_SENDTO_READY)
 #define DAEMON_TASK_STACKSIZE       4096
 
 /****************************************************************************
@@ -141,15 +148,25 @@ struct usock_s
   int16_t           domain;
   int               flags;
   uint8_t           xid;
+  int               armed;
+  FAR uint8_t       *buf;
+  size_t            buflen;
+#ifdef CONFIG_LTE_DAEMON_SOCKET_STATISTICS
+  struct lte_daemon_sockstat_s stat;
+#endif
 };
 
 struct daemon_s
 {
   int                  selectid;
+  volatile bool        select_armed;
   int                  event_outfd;
   int                  poweron_result;
   bool                 poweron_inprogress;
   sem_t                sync_sem;
+#ifdef CONFIG_LTE_DAEMON_SOCKET_STATISTICS
+  sem_t                stat_sem; /* Protects sockets[].stat */
+#endif
   lte_apn_setting_t    apn;
   struct usock_s       sockets[SOCKET_COUNT];
   struct net_driver_s  net_dev;
@@ -417,6 +434,37 @@ static int _send_ack_common(int fd,
   return _write_to_usock(fd, resp, sizeof(*resp));
 }
 
+#ifdef CONFIG_LTE_DAEMON_SOCKET_STATISTICS
+/****************************************************************************
+ * Name: daemon_stat_lock
+ ****************************************************************************/
+
+static void daemon_stat_lock(FAR struct daemon_s *priv)
+{
+  /* The 64-bit counters are read by lte_daemon_get_sockstat() in another
+   * task and can not be accessed atomically on this target.
+   */
+
+  while (sem_wait(&priv->stat_sem) < 0)
+    {
+      DEBUGASSERT(errno == EINTR);
+    }
+}
+
+/****************************************************************************
+ * Name: daemon_stat_unlock
+ ****************************************************************************/
+
+static void daemon_stat_unlock(FAR struct daemon_s *priv)
+{
+  sem_post(&priv->stat_sem);
+}
+
+#else
+#  define daemon_stat_lock(p)
+#  define daemon_stat_unlock(p)
+#endif
+
 /****************************************************************************
  * Name: daemon_socket_new
  ****************************************************************************/
@@ -431,7 +479,9 @@ static FAR struct usock_s *daemon_socket_new(FAR struct daemon_s *priv)
       if (CLOSED == priv->sockets[i].state)
         {
           usock = &priv->sockets[i];
+          daemon_stat_lock(priv);
           memset(usock, 0, sizeof(struct usock_s));
+          daemon_stat_unlock(priv);
           usock->usockid = -1;
           usock->index = i;
           usock->state = OPENED;
@@ -453,9 +503,148 @@ static void daemon_socket_delete(FAR struct daemon_s *priv,
     {
       usock->usockid = -1;
       usock->state = CLOSED;
+
+      if (usock->buf)
+        {
+          free(usock->buf);
+          usock->buf = NULL;
+        }
+
+      usock->buflen = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: daemon_socket_getbuf
+ ****************************************************************************/
+
+static FAR uint8_t *daemon_socket_getbuf(FAR struct daemon_s *priv,
+                                         FAR struct usock_s *usock,
+                                         size_t len)
+{
+  FAR uint8_t *buf;
+
+  /* The staging buffer is allocated zeroed at the first use and kept
+   * until the socket is closed. It is not cleared per request:
+   * sendto_request() fails unless read() fills all of req->buflen, and
+   * recvfrom_request() forwards only the bytes altcom_recvfrom() stored.
+   * The buffer belongs to one socket, so no data of another socket is
+   * exposed either.
+   *
+   * A request larger than the buffer grows it once to that size, so an
+   * application looping on large recvfrom() calls does not allocate and
+   * free per request.
+   */
+
+  if (len <= usock->buflen)
+    {
+      return usock->buf;
+    }
+
+  if (len < CONFIG_LTE_DAEMON_SOCKET_BUFSIZE)
+    {
+      len = CONFIG_LTE_DAEMON_SOCKET_BUFSIZE;
+    }
+
+  buf = calloc(1, len);
+  if (!buf)
+    {
+      return NULL;
     }
+
+  if (usock->buf)
+    {
+      free(usock->buf);
+
+#ifdef CONFIG_LTE_DAEMON_SOCKET_STATISTICS
+      daemon_stat_lock(priv);
+      usock->stat.buf_grows++;
+      daemon_stat_unlock(priv);
+#endif
+    }
+
+  usock->buf    = buf;
+  usock->buflen = len;
+
+  return usock->buf;
+}
+
+/****************************************************************************
+ * Name: daemon_socket_putbuf
+ ****************************************************************************/
+
+static void daemon_socket_putbuf(FAR struct usock_s *usock,
+                                 FAR uint8_t *buf)
+{
+  if (buf && buf != usock->buf)
+    {
+      free(buf);
+    }
+}
+
+#ifdef CONFIG_LTE_DAEMON_SOCKET_STATISTICS
+/****************************************************************************
+ * Name: daemon_gettime_us
+ ****************************************************************************/
+
+static uint32_t daemon_gettime_us(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)ts.tv_sec * 1000000 + (uint32_t)ts.tv_nsec / 1000;
 }
 
+/****************************************************************************
+ * Name: daemon_socket_addstat
+ ****************************************************************************/
+
+static void daemon_socket_addstat(FAR struct daemon_s *priv,
+                                  FAR uint32_t *count,
+                                  FAR uint32_t *errors,
+                                  FAR uint64_t *bytes,
+                                  FAR uint64_t *time_total,
+                                  FAR uint32_t *time_max,
+                                  uint32_t start, int result)
+{
+  uint32_t elapsed = daemon_gettime_us() - start;
+
+  daemon_stat_lock(priv);
+
+  (*count)++;
+  if (0 > result)
+    {
+      (*errors)++;
+    }
+  else
+    {
+      *bytes += result;
+    }
+
+  *time_total += elapsed;
+  if (*time_max < elapsed)
+    {
+      *time_max = elapsed;
+    }
+
+  daemon_stat_unlock(priv);
+}
+
+#  define daemon_stat_start(t)      ((t) = daemon_gettime_us())
+#  define daemon_stat_send(p, u, t, r) \
+  daemon_socket_addstat((p), &(u)->stat.send_count, &(u)->stat.send_errors, \
+                        &(u)->stat.send_bytes, &(u)->stat.send_time_total, \
+                        &(u)->stat.send_time_max, (t), (r))
+#  define daemon_stat_recv(p, u, t, r) \
+  daemon_socket_addstat((p), &(u)->stat.recv_count, &(u)->stat.recv_errors, \
+                        &(u)->stat.recv_bytes, &(u)->stat.recv_time_total, \
+                        &(u)->stat.recv_time_max, (t), (r))
+#else
+#  define daemon_stat_start(t)
+#  define daemon_stat_send(p, u, t, r)
+#  define daemon_stat_recv(p, u, t, r)
+#endif
+
 /****************************************************************************
  * Name: daemon_socket_send_abort
  ****************************************************************************/
@@ -995,6 +1184,41 @@ static int convflags_local(int from_flags, int *to_flags)
   return 0;
 }
 
+/****************************************************************************
+ * Name: select_interest
+ ****************************************************************************/
+
+static int select_interest(FAR struct usock_s *usock)
+{
+  if (CLOSED == usock->state)
+    {
+      return 0;
+    }
+
+  /* Wait only for the events that have not been notified yet. */
+
+  return ~usock->flags & SELECT_EVENTS;
+}
+
+/****************************************************************************
+ * Name: select_interest_changed
+ ****************************************************************************/
+
+static bool select_interest_changed(FAR struct daemon_s *priv)
+{
+  int i;
+
+  for (i = 0; i < SOCKET_COUNT; i++)
+    {
+      if (select_interest(&priv->sockets[i]) != priv->sockets[i].armed)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
 /****************************************************************************
  * Name: set_select_socket
  ****************************************************************************/
@@ -1011,25 +1235,22 @@ static int set_select_socket(struct daemon_s* priv)
   int i     = 0;
   int maxfd = -1;
   int ret = 0;
+  int interest;
 
   for (i = 0; i < SOCKET_COUNT; i++)
     {
-      if (CLOSED == priv->sockets[i].state)
-        {
-          continue;
-        }
-      if ((priv->sockets[i].flags & USRSOCK_EVENT_RECVFROM_AVAIL) &&
-          (priv->sockets[i].flags & USRSOCK_EVENT_SENDTO_READY))
+      interest = select_interest(&priv->sockets[i]);
+      if (!interest)
         {
           continue;
         }
 
-      if ( !(priv->sockets[i].flags & USRSOCK_EVENT_RECVFROM_AVAIL) )
+      if (interest & USRSOCK_EVENT_RECVFROM_AVAIL)
         {
           ALTCOM_FD_SET(priv->sockets[i].usockid, &local_readset);
           preadset = &local_readset;
         }
-      if ( !(priv->sockets[i].flags & USRSOCK_EVENT_SENDTO_READY) )
+      if (interest & USRSOCK_EVENT_SENDTO_READY)
         {
           ALTCOM_FD_SET(priv->sockets[i].usockid, &local_writeset);
           pwriteset = &local_writeset;
@@ -1049,14 +1270,23 @@ static int set_select_socket(struct daemon_s* priv)
         {
           daemon_error_printf("altcom_select_async() fail:%d\n",
                               altcom_errno());
+          return ret;
         }
       else
         {
           priv->selectid = ret;
+          priv->select_armed = true;
           daemon_debug_printf("altcom_select_async() succeed: %d\n", ret);
         }
     }
 
+  /* Remember the interest of the select that is in flight. */
+
+  for (i = 0; i < SOCKET_COUNT; i++)
+    {
+      priv->sockets[i].armed = select_interest(&priv->sockets[i]);
+    }
+
   return ret;
 }
 
@@ -1076,6 +1306,12 @@ static void select_async_callback(int32_t ret_code, int32_t err_code,
 
   info = (FAR struct daemon_s *)priv;
 
+  /* The select has completed. Clear the flag before notifying events
+   * so that the main loop woken up by them arms a new one.
+   */
+
+  info->select_armed = false;
+
   if (0 > ret_code)
     {
       return;
@@ -1126,6 +1362,14 @@ static int setup_event(struct daemon_s *priv)
 {
   int ret = 0;
 
+  /* Keep the select in flight if it still waits for the same events. */
+
+  if (priv->selectid != -1 && priv->select_armed &&
+      !select_interest_changed(priv))
+    {
+      return OK;
+    }
+
   if (priv->selectid != -1)
     {
       altcom_select_async_cancel(priv->selectid, true);
@@ -1461,6 +1705,9 @@ static int sendto_request(int fd, struct daemon_s *priv, FAR void *hdrbuf)
   int                                  ret        = 0;
   altcom_socklen_t                     addr_len   = 0;
   int                                  flags      = 0;
+#ifdef CONFIG_LTE_DAEMON_SOCKET_STATISTICS
+  uint32_t                             start;
+#endif
 
   DEBUGASSERT(priv);
   DEBUGASSERT(req);
@@ -1519,7 +1766,7 @@ static int sendto_request(int fd, struct daemon_s *priv, FAR void *hdrbuf)
     /* Check if the request has data. */
     if (req->buflen > 0)
       {
-        sendbuf = calloc(1, req->buflen);
+        sendbuf = daemon_socket_getbuf(priv, usock, req->buflen);
         if (!sendbuf)
           {
             ret = -ENOBUFS;
@@ -1550,8 +1797,10 @@ static int sendto_request(int fd, struct daemon_s *priv, FAR void *hdrbuf)
       goto send_resp;
     }
 
+  daemon_stat_start(start);
   ret = altcom_sendto(usock->usockid, sendbuf, req->buflen, flags,
                       pto, addr_len);
+  daemon_stat_send(priv, usock, start, ret);
   usock->flags &= ~USRSOCK_EVENT_SENDTO_READY;
   if (0 > ret)
     {
@@ -1570,7 +1819,7 @@ send_resp:
 
   if (sendbuf)
     {
-      free(sendbuf);
+      daemon_socket_putbuf(usock, sendbuf);
       sendbuf = NULL;
     }
 
@@ -1603,6 +1852,9 @@ static int recvfrom_request(int fd, struct daemon_s *priv, FAR void *hdrbuf)
   altcom_socklen_t                      altcom_fromlen = 0;
   socklen_t                             output_fromlen = 0;
   int                                   flags          = 0;
+#ifdef CONFIG_LTE_DAEMON_SOCKET_STATISTICS
+  uint32_t                              start;
+#endif
 
   DEBUGASSERT(priv);
   DEBUGASSERT(req);
@@ -1643,7 +1895,7 @@ static int recvfrom_request(int fd, struct daemon_s *priv, FAR void *hdrbuf)
   /* Check if the request has data. */
   if (req->max_buflen > 0)
     {
-      buf = calloc(1, req->max_buflen);
+      buf = daemon_socket_getbuf(priv, usock, req->max_buflen);
       if (!buf)
         {
           ret = -ENOBUFS;
@@ -1659,11 +1911,13 @@ static int recvfrom_request(int fd, struct daemon_s *priv, FAR void *hdrbuf)
       goto send_resp;
     }
 
+  daemon_stat_start(start);
   ret = altcom_recvfrom(usock->usockid,
                         (buf != NULL) ? buf : (FAR void *)&dummy_buf,
                         req->max_buflen, flags,
                         (FAR struct altcom_sockaddr *)&storage,
                         &altcom_fromlen);
+  daemon_stat_recv(priv, usock, start, ret);
   usock->flags &= ~USRSOCK_EVENT_RECVFROM_AVAIL;
   if (0 > ret)
     {
@@ -1731,7 +1985,7 @@ send_resp:
 
   if (buf)
     {
-      free(buf);
+      daemon_socket_putbuf(usock, buf);
       buf = NULL;
     }
   daemon_debug_printf("%s: end \n", __func__);
@@ -3112,6 +3366,10 @@ int32_t lte_daemon_init(lte_apn_setting_t *apn)
 
       ret = sem_init(&g_daemon->sync_sem, 0, 0);
       ASSERT(ret >= 0);
+#ifdef CONFIG_LTE_DAEMON_SOCKET_STATISTICS
+      ret = sem_init(&g_daemon->stat_sem, 0, 1);
+      ASSERT(ret >= 0);
+#endif
 
       g_daemonisrunnning = true;
       pid = task_create("lte_daemon", CONFIG_LTE_DAEMON_TASK_PRIORITY,
@@ -3123,6 +3381,9 @@ int32_t lte_daemon_init(lte_apn_setting_t *apn)
           remove(APIREQ_PIPE);
           g_daemonisrunnning = false;
           sem_destroy(&g_daemon->sync_sem);
+#ifdef CONFIG_LTE_DAEMON_SOCKET_STATISTICS
+          sem_destroy(&g_daemon->stat_sem);
+#endif
           free(g_daemon);
           g_daemon = NULL;
 
@@ -3142,6 +3403,9 @@ int32_t lte_daemon_init(lte_apn_setting_t *apn)
           remove(APIREQ_PIPE);
           g_daemonisrunnning = false;
           sem_destroy(&g_daemon->sync_sem);
+#ifdef CONFIG_LTE_DAEMON_SOCKET_STATISTICS
+          sem_destroy(&g_daemon->stat_sem);
+#endif
           free(g_daemon);
           g_daemon = NULL;
           task_delete(pid);
@@ -3289,6 +3553,9 @@ int32_t lte_daemon_fin(void)
       close(apireq_fd);
       remove(APIREQ_PIPE);
       sem_destroy(&g_daemon->sync_sem);
+#ifdef CONFIG_LTE_DAEMON_SOCKET_STATISTICS
+      sem_destroy(&g_daemon->stat_sem);
+#endif
 
       if (g_daemon)
         {
@@ -3305,3 +3572,52 @@ int32_t lte_daemon_fin(void)
 
   return ret;
 }
+
+#ifdef CONFIG_LTE_DAEMON_SOCKET_STATISTICS
+/****************************************************************************
+ * Name: lte_daemon_get_sockstat
+ ****************************************************************************/
+
+int32_t lte_daemon_get_sockstat(int usockid,
+                                FAR struct lte_daemon_sockstat_s *stat)
+{
+  if (!stat || usockid < 0 || usockid >= SOCKET_COUNT)
+    {
+      return -EINVAL;
+    }
+
+  if (!g_daemonisrunnning || !g_daemon)
+    {
+      daemon_error_printf("lte_daemon is not running\n");
+      return -ENETDOWN;
+    }
+
+  /* Take a snapshot under the lock, since the 64-bit counters can tear
+   * while the daemon task updates them.
+   */
+
+  daemon_stat_lock(g_daemon);
+  memcpy(stat, &g_daemon->sockets[usockid].stat, sizeof(*stat));
+  daemon_stat_unlock(g_daemon);
+
+  return 0;
+}
+#endif
+
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+/****************************************************************************
+ * Name: lte_daemon_get_cbqstat
+ ****************************************************************************/
+
+int32_t lte_daemon_get_cbqstat(uint8_t queue,
+                               FAR struct altcom_cbqstat_s *stat)
+{
+  if (!g_daemonisrunnning || !g_daemon)
+    {
+      daemon_error_printf("lte_daemon is not running\n");
+      return -ENETDOWN;
+    }
+
+  return altcom_get_cbqstat(queue, stat);
+}
+#endif
@@ -0,0 +1,243 @@
+/****************************************************************************
+ * modules/lte/net/test/host/include/nuttx/net/usrsock.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __MODULES_LTE_NET_TEST_HOST_INCLUDE_NUTTX_NET_USRSOCK_H
+#define __MODULES_LTE_NET_TEST_HOST_INCLUDE_NUTTX_NET_USRSOCK_H
+
+/* Host stand-in of the NuttX usrsock protocol, the requests of the
+ * network stack and the responses and events of the daemon.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define USRSOCK_MESSAGE_FLAG_REQ_IN_PROGRESS (1 << 0)
+#define USRSOCK_MESSAGE_FLAG_EVENT           (1 << 1)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+enum usrsock_request_types_e
+{
+  USRSOCK_REQUEST_SOCKET = 0,
+  USRSOCK_REQUEST_CLOSE,
+  USRSOCK_REQUEST_CONNECT,
+  USRSOCK_REQUEST_SENDTO,
+  USRSOCK_REQUEST_RECVFROM,
+  USRSOCK_REQUEST_SETSOCKOPT,
+  USRSOCK_REQUEST_GETSOCKOPT,
+  USRSOCK_REQUEST_GETSOCKNAME,
+  USRSOCK_REQUEST_GETPEERNAME,
+  USRSOCK_REQUEST_BIND,
+  USRSOCK_REQUEST_LISTEN,
+  USRSOCK_REQUEST_ACCEPT,
+  USRSOCK_REQUEST_IOCTL,
+  USRSOCK_REQUEST__MAX
+};
+
+enum usrsock_message_types_e
+{
+  USRSOCK_MESSAGE_RESPONSE_ACK = 0,
+  USRSOCK_MESSAGE_RESPONSE_DATA_ACK,
+  USRSOCK_MESSAGE_SOCKET_EVENT,
+};
+
+enum usrsock_events_e
+{
+  USRSOCK_EVENT_ABORT          = (1 << 1),
+  USRSOCK_EVENT_SENDTO_READY   = (1 << 2),
+  USRSOCK_EVENT_RECVFROM_AVAIL = (1 << 3),
+  USRSOCK_EVENT_REMOTE_CLOSED  = (1 << 4),
+};
+
+begin_packed_struct struct usrsock_request_common_s
+{
+  int8_t  reqid;
+  uint8_t xid;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_request_socket_s
+{
+  struct usrsock_request_common_s head;
+
+  int16_t domain;
+  int16_t type;
+  int16_t protocol;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_request_close_s
+{
+  struct usrsock_request_common_s head;
+
+  int16_t usockid;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_request_bind_s
+{
+  struct usrsock_request_common_s head;
+
+  int16_t  usockid;
+  uint16_t addrlen;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_request_connect_s
+{
+  struct usrsock_request_common_s head;
+
+  int16_t  usockid;
+  uint16_t addrlen;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_request_listen_s
+{
+  struct usrsock_request_common_s head;
+
+  int16_t  usockid;
+  uint16_t backlog;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_request_accept_s
+{
+  struct usrsock_request_common_s head;
+
+  int16_t  usockid;
+  uint16_t max_addrlen;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_request_sendto_s
+{
+  struct usrsock_request_common_s head;
+
+  int16_t  usockid;
+  uint16_t addrlen;
+  int32_t  flags;
+  uint16_t buflen;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_request_recvfrom_s
+{
+  struct usrsock_request_common_s head;
+
+  int16_t  usockid;
+  int32_t  flags;
+  uint16_t max_buflen;
+  uint16_t max_addrlen;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_request_setsockopt_s
+{
+  struct usrsock_request_common_s head;
+
+  int16_t  usockid;
+  int16_t  level;
+  int16_t  option;
+  uint16_t valuelen;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_request_getsockopt_s
+{
+  struct usrsock_request_common_s head;
+
+  int16_t  usockid;
+  int16_t  level;
+  int16_t  option;
+  uint16_t max_valuelen;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_request_getsockname_s
+{
+  struct usrsock_request_common_s head;
+
+  int16_t  usockid;
+  uint16_t max_addrlen;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_request_getpeername_s
+{
+  struct usrsock_request_common_s head;
+
+  int16_t  usockid;
+  uint16_t max_addrlen;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_request_ioctl_s
+{
+  struct usrsock_request_common_s head;
+
+  int16_t  usockid;
+  int32_t  cmd;
+  uint16_t arglen;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_message_common_s
+{
+  int8_t msgid;
+  int8_t flags;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_message_req_ack_s
+{
+  struct usrsock_message_common_s head;
+
+  uint8_t xid;
+  int32_t result;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_message_datareq_ack_s
+{
+  struct usrsock_message_req_ack_s reqack;
+
+  uint16_t valuelen;
+  uint16_t valuelen_nontrunc;
+} end_packed_struct;
+
+begin_packed_struct struct usrsock_message_socket_event_s
+{
+  struct usrsock_message_common_s head;
+
+  int16_t  usockid;
+  uint16_t events;
+} end_packed_struct;
+
+#endif /* __MODULES_LTE_NET_TEST_HOST_INCLUDE_NUTTX_NET_USRSOCK_H */
@@ -0,0 +1,443 @@
+/****************************************************************************
+ * modules/lte/net/test/test_select.c
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of the select bookkeeping of the LTE daemon.  altcom_select_async()
+ * is replaced by a stub that records each select, and the socket requests
+ * are reduced to the event flags they clear.  setup_event() must keep a
+ * select in flight while the sockets wait for the same events, and arm a
+ * new one when the interest changed or the select completed.  With -b, a
+ * random mix of requests and events counts the selects armed against
+ * re-arming on every wakeup of the main loop.
+ *
+ * Usage: test_select [-b] [count]
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+
+/* The select bookkeeping is private to the daemon. */
+
+#include "../daemon/daemon.c"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define RECV USRSOCK_EVENT_RECVFROM_AVAIL
+#define SEND USRSOCK_EVENT_SENDTO_READY
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct select_stub_s
+{
+  int           ret;         /* Next return value, -1 to fail */
+  int           nextid;
+  int           armnum;
+  int           cancelnum;
+  int           cancelid;
+  int           maxfdp1;
+  altcom_fd_set readset;
+  altcom_fd_set writeset;
+  bool          hasread;
+  bool          haswrite;
+  FAR void      *priv;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct select_stub_s g_stub;
+static struct daemon_s      g_priv;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/* Stubs of the ALTCOM select. */
+
+int altcom_select_async(int maxfdp1, altcom_fd_set *readset,
+                        altcom_fd_set *writeset, altcom_fd_set *exceptset,
+                        altcom_select_async_cb_t callback, void *priv)
+{
+  if (g_stub.ret < 0)
+    {
+      return g_stub.ret;
+    }
+
+  g_stub.armnum++;
+  g_stub.maxfdp1  = maxfdp1;
+  g_stub.hasread  = readset != NULL;
+  g_stub.haswrite = writeset != NULL;
+  g_stub.priv     = priv;
+  ALTCOM_FD_ZERO(&g_stub.readset);
+  ALTCOM_FD_ZERO(&g_stub.writeset);
+  if (readset)
+    {
+      g_stub.readset = *readset;
+    }
+
+  if (writeset)
+    {
+      g_stub.writeset = *writeset;
+    }
+
+  return g_stub.nextid++;
+}
+
+int altcom_select_async_cancel(int id, bool is_send)
+{
+  g_stub.cancelnum++;
+  g_stub.cancelid = id;
+
+  return 0;
+}
+
+int altcom_errno(void)
+{
+  return 0;
+}
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void init_daemon(void)
+{
+  int i;
+
+  memset(&g_priv, 0, sizeof(g_priv));
+  memset(&g_stub, 0, sizeof(g_stub));
+
+  g_priv.selectid    = -1;
+  g_priv.event_outfd = open("/dev/null", O_WRONLY);
+  for (i = 0; i < SOCKET_COUNT; i++)
+    {
+      g_priv.sockets[i].state = CLOSED;
+    }
+
+  g_stub.nextid = 1;
+}
+
+static void fin_daemon(void)
+{
+  close(g_priv.event_outfd);
+}
+
+static void open_socket(int i)
+{
+  g_priv.sockets[i].state   = OPENED;
+  g_priv.sockets[i].usockid = i;
+  g_priv.sockets[i].flags   = 0;
+}
+
+/* The modem reports events of one socket. */
+
+static void complete(int i, int events)
+{
+  altcom_fd_set readset;
+  altcom_fd_set writeset;
+
+  ALTCOM_FD_ZERO(&readset);
+  ALTCOM_FD_ZERO(&writeset);
+  if (events & RECV)
+    {
+      ALTCOM_FD_SET(i, &readset);
+    }
+
+  if (events & SEND)
+    {
+      ALTCOM_FD_SET(i, &writeset);
+    }
+
+  select_async_callback(1, 0, g_priv.selectid, &readset, &writeset, NULL,
+                        &g_priv);
+}
+
+/****************************************************************************
+ * Name: test_keep
+ *
+ * Description:
+ *   A select waiting for the same events is kept, and a completed one is
+ *   replaced.
+ *
+ ****************************************************************************/
+
+static void test_keep(void)
+{
+  init_daemon();
+
+  /* No socket, no select. */
+
+  TEST_CHECK_EQ(setup_event(&g_priv), 0);
+  TEST_CHECK_EQ(g_stub.armnum, 0);
+
+  open_socket(3);
+  TEST_CHECK(setup_event(&g_priv) > 0);
+  TEST_CHECK_EQ(g_stub.armnum, 1);
+  TEST_CHECK_EQ(g_stub.maxfdp1, 4);
+  TEST_CHECK(ALTCOM_FD_ISSET(3, &g_stub.readset));
+  TEST_CHECK(ALTCOM_FD_ISSET(3, &g_stub.writeset));
+  TEST_CHECK(g_stub.priv == &g_priv);
+  TEST_CHECK_EQ(g_priv.sockets[3].armed, RECV | SEND);
+  TEST_CHECK(g_priv.select_armed);
+
+  /* Woken up by a request that does not change the interest. */
+
+  TEST_CHECK_EQ(setup_event(&g_priv), OK);
+  TEST_CHECK_EQ(setup_event(&g_priv), OK);
+  TEST_CHECK_EQ(g_stub.armnum, 1);
+  TEST_CHECK_EQ(g_stub.cancelnum, 0);
+
+  /* Sendable: the next select waits only for data. */
+
+  complete(3, SEND);
+  TEST_CHECK(!g_priv.select_armed);
+  TEST_CHECK_EQ(g_priv.sockets[3].flags, SEND);
+
+  setup_event(&g_priv);
+  TEST_CHECK_EQ(g_stub.armnum, 2);
+  TEST_CHECK_EQ(g_stub.cancelnum, 1);
+  TEST_CHECK(g_stub.hasread);
+  TEST_CHECK(!g_stub.haswrite);
+  TEST_CHECK_EQ(g_priv.sockets[3].armed, RECV);
+
+  setup_event(&g_priv);
+  TEST_CHECK_EQ(g_stub.armnum, 2);
+
+  fin_daemon();
+}
+
+/****************************************************************************
+ * Name: test_change
+ *
+ * Description:
+ *   A select in flight is cancelled and armed again when a socket is
+ *   opened or closed, or a request clears a notified event.
+ *
+ ****************************************************************************/
+
+static void test_change(void)
+{
+  int id;
+
+  init_daemon();
+
+  open_socket(1);
+  setup_event(&g_priv);
+  id = g_priv.selectid;
+
+  open_socket(5);
+  setup_event(&g_priv);
+  TEST_CHECK_EQ(g_stub.armnum, 2);
+  TEST_CHECK_EQ(g_stub.cancelnum, 1);
+  TEST_CHECK_EQ(g_stub.cancelid, id);
+  TEST_CHECK_EQ(g_stub.maxfdp1, 6);
+  TEST_CHECK(ALTCOM_FD_ISSET(1, &g_stub.readset));
+  TEST_CHECK(ALTCOM_FD_ISSET(5, &g_stub.readset));
+
+  /* Data on 5, as recvfrom_request() the daemon clears the flag once the
+   * data is read.
+   */
+
+  complete(5, RECV);
+  setup_event(&g_priv);
+  TEST_CHECK_EQ(g_stub.armnum, 3);
+  TEST_CHECK(!ALTCOM_FD_ISSET(5, &g_stub.readset));
+  TEST_CHECK(ALTCOM_FD_ISSET(5, &g_stub.writeset));
+
+  g_priv.sockets[5].flags &= ~RECV;
+  setup_event(&g_priv);
+  TEST_CHECK_EQ(g_stub.armnum, 4);
+  TEST_CHECK(ALTCOM_FD_ISSET(5, &g_stub.readset));
+
+  /* Closing 1. */
+
+  g_priv.sockets[1].state = CLOSED;
+  setup_event(&g_priv);
+  TEST_CHECK_EQ(g_stub.armnum, 5);
+  TEST_CHECK(!ALTCOM_FD_ISSET(1, &g_stub.readset));
+  TEST_CHECK_EQ(g_priv.sockets[1].armed, 0);
+
+  /* Closing the last one cancels the select. */
+
+  g_priv.sockets[5].state = CLOSED;
+  id = g_stub.cancelnum;
+  setup_event(&g_priv);
+  TEST_CHECK_EQ(g_stub.armnum, 5);
+  TEST_CHECK_EQ(g_stub.cancelnum, id + 1);
+  TEST_CHECK_EQ(g_priv.selectid, -1);
+
+  setup_event(&g_priv);
+  TEST_CHECK_EQ(g_stub.armnum, 5);
+
+  fin_daemon();
+}
+
+/****************************************************************************
+ * Name: test_fail
+ *
+ * Description:
+ *   A select that could not be armed is retried on the next wakeup.
+ *
+ ****************************************************************************/
+
+static void test_fail(void)
+{
+  init_daemon();
+
+  open_socket(0);
+  g_stub.ret = -1;
+  TEST_CHECK_EQ(setup_event(&g_priv), -1);
+  TEST_CHECK(!g_priv.select_armed);
+  TEST_CHECK_EQ(g_priv.sockets[0].armed, 0);
+
+  g_stub.ret = 0;
+  TEST_CHECK(setup_event(&g_priv) > 0);
+  TEST_CHECK_EQ(g_stub.armnum, 1);
+  TEST_CHECK(g_priv.select_armed);
+
+  /* A failed select is not armed. */
+
+  select_async_callback(-1, 0, g_priv.selectid, NULL, NULL, NULL, &g_priv);
+  TEST_CHECK(!g_priv.select_armed);
+  setup_event(&g_priv);
+  TEST_CHECK_EQ(g_stub.armnum, 2);
+
+  fin_daemon();
+}
+
+/****************************************************************************
+ * Name: bench
+ *
+ * Description:
+ *   Wakeups of the main loop by requests, mostly not changing the
+ *   interest, and by events.  Before the bookkeeping every wakeup armed a
+ *   new select.
+ *
+ ****************************************************************************/
+
+static void bench(uint32_t count)
+{
+  uint32_t wakeups = 0;
+  uint32_t i;
+  int      s;
+  int      r;
+
+  init_daemon();
+
+  for (s = 0; s < 4; s++)
+    {
+      open_socket(s);
+    }
+
+  setup_event(&g_priv);
+
+  for (i = 0; i < count; i++)
+    {
+      s = rand() % 4;
+      r = rand() % 100;
+
+      if (r < 10)
+        {
+          complete(s, RECV);
+        }
+      else if (r < 20)
+        {
+          complete(s, SEND);
+        }
+      else if (r < 35)
+        {
+          g_priv.sockets[s].flags &= ~RECV;  /* recvfrom */
+        }
+      else if (r < 50)
+        {
+          g_priv.sockets[s].flags &= ~SEND;  /* sendto */
+        }
+
+      /* Otherwise e.g. getsockopt, no change. */
+
+      setup_event(&g_priv);
+      wakeups++;
+    }
+
+  printf("%u wakeups: %d selects armed, %d cancelled (was %u)\n",
+         wakeups, g_stub.armnum, g_stub.cancelnum, wakeups);
+
+  fin_daemon();
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  uint32_t count = 100000;
+  bool     dobench = false;
+  int      i;
+
+  for (i = 1; i < argc; i++)
+    {
+      if (strcmp(argv[i], "-b") == 0)
+        {
+          dobench = true;
+        }
+      else
+        {
+          count = (uint32_t)strtoul(argv[i], NULL, 0);
+        }
+    }
+
+  srand(1);
+
+  test_keep();
+  test_change();
+  test_fail();
+
+  if (dobench)
+    {
+      bench(count);
+    }
+
+  return TEST_RESULT("test_select");
+}
@@ -745,7 +745,7 @@ int32_t sys_delete_mqueue(FAR sys_mq_t *mq)
 }
 
 /****************************************************************************
- * Name: sys_send_mqueue
+ * Name: sys_send_mqueue_prio
  *
  * Description:
  *   Send message by a message queue.
@@ -754,6 +754,8 @@ int32_t sys_delete_mqueue(FAR sys_mq_t *mq)
  *   mq         The handle of the message queue to be send.
  *   message    The message to be send.
  *   len        The length of the message.
+ *   prio       The priority of the message. Messages with higher priority
+ *              are received first.
  *   timeout_ms The time in milliseconds to block until send timeout occurs.
  *              If timeout_ms set to LTE_SYS_TIMEO_FEVR then wait until
  *              the message queue to become available.
@@ -764,8 +766,8 @@ int32_t sys_delete_mqueue(FAR sys_mq_t *mq)
  *
  ****************************************************************************/
 
-int32_t sys_send_mqueue(FAR sys_mq_t *mq, FAR int8_t *message, size_t len,
-                        int32_t timeout_ms)
+int32_t sys_send_mqueue_prio(FAR sys_mq_t *mq, FAR int8_t *message,
+                             size_t len, uint8_t prio, int32_t timeout_ms)
 {
   int32_t         ret;
   int32_t         l_errno;
@@ -790,7 +792,8 @@ int32_t sys_send_mqueue(FAR sys_mq_t *mq, FAR int8_t *message, size_t len,
     {
       for (;;)
         {
-          ret = mq_send(mqd, (const char*)message, len, MQ_PRIO);
+          ret = mq_send(mqd, (const char*)message, len,
+                        MQ_PRIO + prio);
           if (ret < 0)
             {
               l_errno = errno;
@@ -833,7 +836,7 @@ int32_t sys_send_mqueue(FAR sys_mq_t *mq, FAR int8_t *message, size_t len,
           abs_time.tv_nsec -= (1000 * 1000 * 1000);
         }
 
-      ret = mq_timedsend(mqd, (const char*)message, len, MQ_PRIO,
+      ret = mq_timedsend(mqd, (const char*)message, len, MQ_PRIO + prio,
                          &abs_time);
       if (ret < 0)
         {
@@ -849,6 +852,32 @@ int32_t sys_send_mqueue(FAR sys_mq_t *mq, FAR int8_t *message, size_t len,
   return 0;
 }
 
+/****************************************************************************
+ * Name: sys_send_mqueue
+ *
+ * Description:
+ *   Send message by a message queue.
+ *
+ * Input Parameters:
+ *   mq         The handle of the message queue to be send.
+ *   message    The message to be send.
+ *   len        The length of the message.
+ *   timeout_ms The time in milliseconds to block until send timeout occurs.
+ *              If timeout_ms set to LTE_SYS_TIMEO_FEVR then wait until
+ *              the message queue to become available.
+ *
+ * Returned Value:
+ *   If the message queue was sent successfully then 0 is returned.
+ *   Otherwise negative value is returned.
+ *
+ ****************************************************************************/
+
+int32_t sys_send_mqueue(FAR sys_mq_t *mq, FAR int8_t *message, size_t len,
+                        int32_t timeout_ms)
+{
+  return sys_send_mqueue_prio(mq, message, len, 0, timeout_ms);
+}
+
 /****************************************************************************
  * Name: sys_recv_mqueue
  *
@@ -1339,3 +1368,26 @@ int32_t sys_thread_cond_signal(FAR sys_thread_cond_t *cond)
 
   return 0;
 }
+
+/****************************************************************************
+ * Name: sys_get_systime_us
+ *
+ * Description:
+ *   Get the monotonic system time.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   The system time in microseconds. The value wraps around.
+ *
+ ****************************************************************************/
+
+uint32_t sys_get_systime_us(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint32_t)ts.tv_sec * 1000000 + (uint32_t)ts.tv_nsec / 1000;
+}
@@ -71,6 +71,10 @@ struct thrdpool_queelements_s
 {
   CODE thrdpool_jobif_t job;
   FAR void              *arg;
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+  uint8_t               prio;
+  uint32_t              enqtime;
+#endif
 };
 
 struct thrdpool_share_s
@@ -78,6 +82,10 @@ struct thrdpool_share_s
   sys_mq_t          quehandle;
   sys_thread_cond_t delwaitcond;
   sys_mutex_t       delwaitcondmtx;
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+  sys_mutex_t       statmtx;
+  struct thrdpool_stat_s stat;
+#endif
 };
 
 struct thrdpool_info_s
@@ -103,6 +111,11 @@ struct thrdpool_datatable_s
 static int32_t thrdpool_runjob(
   FAR struct thrdpool_s *thiz, CODE thrdpool_jobif_t job, FAR void *arg);
 static uint32_t thrdpool_getfreethrds(FAR struct thrdpool_s *thiz);
+static int32_t thrdpool_runjob_prio(
+  FAR struct thrdpool_s *thiz, CODE thrdpool_jobif_t job, FAR void *arg,
+  enum thrdpool_prio_e prio);
+static int32_t thrdpool_getstat(
+  FAR struct thrdpool_s *thiz, FAR struct thrdpool_stat_s *stat);
 static void thrdpool_thrdmain(FAR void *arg);
 
 /****************************************************************************
@@ -128,12 +141,38 @@ static void thrdpool_thrdmain(FAR void *arg);
 
 static int32_t thrdpool_runjob(
   FAR struct thrdpool_s *thiz, CODE thrdpool_jobif_t job, FAR void *arg)
+{
+  return thrdpool_runjob_prio(thiz, job, arg, THRDPOOL_PRIO_NORMAL);
+}
+
+/****************************************************************************
+ * Name: thrdpool_runjob_prio
+ *
+ * Description:
+ *   Enqueues the processing that the thread does with priority.
+ *   The job is dequeued before any job of lower priority.
+ *
+ * Input Parameters:
+ *   thiz  struct thrdpool_s pointer(i.e. instance of threadpool).
+ *   job   Pointer to the processing function conforming to the job_if.
+ *   arg   argument of @job.
+ *   prio  Priority of @job.
+ *
+ * Returned Value:
+ *   If the process succeeds, it returns 0.
+ *   Otherwise errno is returned.
+ *
+ ****************************************************************************/
+
+static int32_t thrdpool_runjob_prio(
+  FAR struct thrdpool_s *thiz, CODE thrdpool_jobif_t job, FAR void *arg,
+  enum thrdpool_prio_e prio)
 {
   FAR struct thrdpool_datatable_s *table = NULL;
   int32_t                         ret    = 0;
   struct thrdpool_queelements_s   element;
 
-  if (!thiz || !job)
+  if (!thiz || !job || THRDPOOL_PRIO_NUM <= prio)
     {
       DBGIF_LOG_ERROR("Incorrect argument.\n");
       return -EINVAL;
@@ -142,9 +181,14 @@ static int32_t thrdpool_runjob(
   table = (FAR struct thrdpool_datatable_s*)thiz;
   element.job = job;
   element.arg = arg;
-
-  ret = sys_send_mqueue(&table->share.quehandle, (FAR int8_t *)&element,
-    sizeof(struct thrdpool_queelements_s), SYS_TIMEO_FEVR);
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+  element.prio    = (uint8_t)prio;
+  element.enqtime = sys_get_systime_us();
+#endif
+
+  ret = sys_send_mqueue_prio(&table->share.quehandle,
+    (FAR int8_t *)&element, sizeof(struct thrdpool_queelements_s),
+    (uint8_t)prio, SYS_TIMEO_FEVR);
   DBGIF_ASSERT(0 == ret, "Queue send failed.\n");
 
   return 0;
@@ -188,6 +232,81 @@ static uint32_t thrdpool_getfreethrds(FAR struct thrdpool_s *thiz)
   return count;
 }
 
+/****************************************************************************
+ * Name: thrdpool_getstat
+ *
+ * Description:
+ *   Get statistics of the queue.
+ *
+ * Input Parameters:
+ *   thiz  struct thrdpool_s pointer(i.e. instance of threadpool).
+ *   stat  Buffer to store the statistics.
+ *
+ * Returned Value:
+ *   If the process succeeds, it returns 0.
+ *   Otherwise errno is returned.
+ *
+ ****************************************************************************/
+
+static int32_t thrdpool_getstat(
+  FAR struct thrdpool_s *thiz, FAR struct thrdpool_stat_s *stat)
+{
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+  FAR struct thrdpool_datatable_s *table = NULL;
+
+  if (!thiz || !stat)
+    {
+      DBGIF_LOG_ERROR("Incorrect argument.\n");
+      return -EINVAL;
+    }
+
+  table = (FAR struct thrdpool_datatable_s*)thiz;
+
+  sys_lock_mutex(&table->share.statmtx);
+  memcpy(stat, &table->share.stat, sizeof(struct thrdpool_stat_s));
+  sys_unlock_mutex(&table->share.statmtx);
+
+  return 0;
+#else
+  return -ENOTSUP;
+#endif
+}
+
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+/****************************************************************************
+ * Name: thrdpool_addstat
+ *
+ * Description:
+ *   Account the time the job waited in the queue.
+ *
+ * Input Parameters:
+ *   share    Information shared by the threads.
+ *   element  The dequeued job.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+static void thrdpool_addstat(FAR struct thrdpool_share_s *share,
+  FAR struct thrdpool_queelements_s *element)
+{
+  uint32_t waittime = sys_get_systime_us() - element->enqtime;
+  uint8_t  prio     = element->prio;
+
+  sys_lock_mutex(&share->statmtx);
+
+  share->stat.jobnum[prio]++;
+  share->stat.waittotal[prio] += waittime;
+  if (share->stat.waitmax[prio] < waittime)
+    {
+      share->stat.waitmax[prio] = waittime;
+    }
+
+  sys_unlock_mutex(&share->statmtx);
+}
+#endif
+
 /****************************************************************************
  * Name: thrdpool_thrdmain
  *
@@ -226,6 +345,10 @@ static void thrdpool_thrdmain(FAR void *arg)
           break;
         }
 
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+      thrdpool_addstat(info->share, &recvbuf);
+#endif
+
       info->state = THRDPOOL_RUNNABLE;
 
       /* Perform actual processing. */
@@ -265,6 +388,9 @@ FAR struct thrdpool_s *thrdpool_create(FAR struct thrdpool_set_s *set)
   uint16_t                        num         = 0;
   sys_cretask_s                   thread_param;
   sys_cremq_s                     que_param;
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+  sys_cremtx_s                    mtx_param = {0};
+#endif
   char                            thrdname[THRDPOOL_THRDNAME_MAX_LEN];
 
   if (!set || set->maxthrdnum <= 0 || set->maxquenum <= 0)
@@ -292,6 +418,8 @@ FAR struct thrdpool_s *thrdpool_create(FAR struct thrdpool_set_s *set)
 
   table->thrdpoolif.runjob       = thrdpool_runjob;
   table->thrdpoolif.getfreethrds = thrdpool_getfreethrds;
+  table->thrdpoolif.runjob_prio  = thrdpool_runjob_prio;
+  table->thrdpoolif.getstat      = thrdpool_getstat;
 
   /* Create queue. */
 
@@ -310,6 +438,14 @@ FAR struct thrdpool_s *thrdpool_create(FAR struct thrdpool_set_s *set)
       goto errout_with_quedelete;
     }
 
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+  if (sys_create_mutex(&table->share.statmtx, &mtx_param) < 0)
+    {
+      DBGIF_LOG_ERROR("sys_create_mutex failed.\n");
+      goto errout_with_conddelete;
+    }
+#endif
+
   /* Create threads data. */
   
   thread_param.function   = thrdpool_thrdmain;
@@ -321,7 +457,7 @@ FAR struct thrdpool_s *thrdpool_create(FAR struct thrdpool_set_s *set)
   if (!table->thrdinfolist)
     {
       DBGIF_LOG_ERROR("thrdinfolist create failed.\n");
-      goto errout_with_semdelete;
+      goto errout_with_mtxdelete;
     }
 
   /* Create threads */
@@ -350,7 +486,11 @@ errout_with_thrddelete:
     }
 
   SYS_FREE(table->thrdinfolist);
-errout_with_semdelete:
+errout_with_mtxdelete:
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+  sys_delete_mutex(&table->share.statmtx);
+errout_with_conddelete:
+#endif
   sys_delete_thread_cond_mutex(&table->share.delwaitcond,
                                &table->share.delwaitcondmtx);
 errout_with_quedelete:
@@ -413,6 +553,9 @@ int32_t thrdpool_delete(FAR struct thrdpool_s *thiz)
   sys_delete_thread_cond_mutex(&table->share.delwaitcond,
                                &table->share.delwaitcondmtx);
   sys_delete_mqueue(&table->share.quehandle);
+#ifdef CONFIG_LTE_THRDPOOL_STATISTICS
+  sys_delete_mutex(&table->share.statmtx);
+#endif
   SYS_FREE(table->thrdinfolist);
   SYS_FREE(table);
   return 0;
@@ -0,0 +1,655 @@
+/****************************************************************************
+ * modules/ringbuffer/ringbuffer_lockfree.c
+ *
+ *   Copyright 2020 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <string.h>
+#include <errno.h>
+#include "ringbuffer/ringbuffer_lockfree.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef MIN
+#  define MIN(a,b)  (((a) < (b)) ? (a) : (b))
+#endif
+
+/* Indices run freely and are masked on access. Stores which publish data
+ * to the other side are release, loads of the index of the other side are
+ * acquire.
+ */
+
+#define LOAD_RELAXED(p)     __atomic_load_n((p), __ATOMIC_RELAXED)
+#define LOAD_ACQUIRE(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STORE_RELAXED(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+/* Each MPSC record has a header word of length and flags. Free space is
+ * kept zero, so a reserved but not committed header reads as not ready.
+ */
+
+#define MPSC_HDR_SIZE       sizeof(uint32_t)
+#define MPSC_COMMITTED      0x80000000u
+#define MPSC_PADDING        0x40000000u
+#define MPSC_LEN_MASK       0x3fffffffu
+#define MPSC_ALIGN(n)       (((n) + 3) & ~3u)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: is_pow2
+ ****************************************************************************/
+
+static inline bool is_pow2(size_t size)
+{
+  return (size != 0) && ((size & (size - 1)) == 0);
+}
+
+/****************************************************************************
+ * Name: is_aligned
+ ****************************************************************************/
+
+static inline bool is_aligned(FAR const void *rb)
+{
+  return ((uintptr_t)rb & (RINGBUF_CACHELINE - 1)) == 0;
+}
+
+/****************************************************************************
+ * Name: mpsc_header
+ ****************************************************************************/
+
+static inline FAR uint32_t *mpsc_header(FAR struct ringbuf_mpsc_s *rb,
+                                        uint32_t pos)
+{
+  return (FAR uint32_t *)(rb->buf + (pos & rb->mask));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ringbuf_spsc_init
+ *
+ * Description:
+ *   Initialize a SPSC Ring Buffer on given memory.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer to initialize, aligned to
+ *       RINGBUF_CACHELINE.
+ *   buf  Memory area of the buffer.
+ *   size  Size of the buffer, power of two.
+ *
+ * Returned Value:
+ *   On success, 0 is returned.
+ *   On failure, negative value is returned according to <errno.h>.
+ *
+ ****************************************************************************/
+
+int ringbuf_spsc_init(FAR struct ringbuf_spsc_s *rb,
+                      FAR void *buf, size_t size)
+{
+  if (!rb || !is_aligned(rb) || !buf ||
+      !is_pow2(size) || (size > 0x80000000u))
+    {
+      return -EINVAL;
+    }
+
+  rb->buf  = (FAR uint8_t *)buf;
+  rb->mask = size - 1;
+
+  STORE_RELAXED(&rb->head, 0);
+  STORE_RELEASE(&rb->tail, 0);
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: ringbuf_spsc_reserve
+ *
+ * Description:
+ *   Reserve contiguous free space to write directly.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer.
+ *   ptr  Head of the free space.
+ *
+ * Returned Value:
+ *   Contiguous free bytes.
+ *
+ ****************************************************************************/
+
+size_t ringbuf_spsc_reserve(FAR struct ringbuf_spsc_s *rb, FAR void **ptr)
+{
+  uint32_t tail = LOAD_RELAXED(&rb->tail);
+  uint32_t head = LOAD_ACQUIRE(&rb->head);
+  uint32_t size = rb->mask + 1;
+  uint32_t off  = tail & rb->mask;
+
+  *ptr = rb->buf + off;
+
+  return MIN(size - (tail - head), size - off);
+}
+
+/****************************************************************************
+ * Name: ringbuf_spsc_commit
+ *
+ * Description:
+ *   Publish bytes written into reserved space.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer.
+ *   count  Bytes written.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ringbuf_spsc_commit(FAR struct ringbuf_spsc_s *rb, size_t count)
+{
+  STORE_RELEASE(&rb->tail, LOAD_RELAXED(&rb->tail) + count);
+}
+
+/****************************************************************************
+ * Name: ringbuf_spsc_peek
+ *
+ * Description:
+ *   Get contiguous data to read directly.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer.
+ *   ptr  Head of the data.
+ *
+ * Returned Value:
+ *   Contiguous data bytes.
+ *
+ ****************************************************************************/
+
+size_t ringbuf_spsc_peek(FAR struct ringbuf_spsc_s *rb, FAR void **ptr)
+{
+  uint32_t head = LOAD_RELAXED(&rb->head);
+  uint32_t tail = LOAD_ACQUIRE(&rb->tail);
+  uint32_t off  = head & rb->mask;
+
+  *ptr = rb->buf + off;
+
+  return MIN(tail - head, rb->mask + 1 - off);
+}
+
+/****************************************************************************
+ * Name: ringbuf_spsc_consume
+ *
+ * Description:
+ *   Release bytes read by peek.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer.
+ *   count  Bytes read.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ringbuf_spsc_consume(FAR struct ringbuf_spsc_s *rb, size_t count)
+{
+  STORE_RELEASE(&rb->head, LOAD_RELAXED(&rb->head) + count);
+}
+
+/****************************************************************************
+ * Name: ringbuf_spsc_write
+ *
+ * Description:
+ *   Write to a SPSC Ring Buffer.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer to write.
+ *   buf  Pointer to data to write.
+ *   count  Bytes to write.
+ *
+ * Returned Value:
+ *   On success, The number of bytes written.
+ *   If there is no space for all of them, -ENOSPC is returned.
+ *
+ ****************************************************************************/
+
+ssize_t ringbuf_spsc_write(FAR struct ringbuf_spsc_s *rb,
+                           FAR const void *buf, size_t count)
+{
+  FAR void *ptr;
+  size_t    contig;
+
+  if (!rb || (ringbuf_spsc_bytesavail(rb) < count))
+    {
+      return -ENOSPC;
+    }
+
+  /* Free space may wrap around, then the rest is at the beginning. */
+
+  contig = ringbuf_spsc_reserve(rb, &ptr);
+  contig = MIN(contig, count);
+  memcpy(ptr, buf, contig);
+
+  if (contig < count)
+    {
+      memcpy(rb->buf, (FAR const uint8_t *)buf + contig, count - contig);
+    }
+
+  ringbuf_spsc_commit(rb, count);
+
+  return count;
+}
+
+/****************************************************************************
+ * Name: ringbuf_spsc_read
+ *
+ * Description:
+ *   Read from a SPSC Ring Buffer.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer to read.
+ *   buf  Pointer to buffer to store read data.
+ *   count  Max bytes to read.
+ *
+ * Returned Value:
+ *   The number of bytes read.
+ *
+ ****************************************************************************/
+
+ssize_t ringbuf_spsc_read(FAR struct ringbuf_spsc_s *rb,
+                          FAR void *buf, size_t count)
+{
+  FAR void *ptr;
+  size_t    used;
+  size_t    contig;
+
+  if (!rb)
+    {
+      return -EINVAL;
+    }
+
+  /* Take a snapshot once, the producer may add data meanwhile. */
+
+  used   = ringbuf_spsc_bytesused(rb);
+  count  = MIN(used, count);
+  contig = ringbuf_spsc_peek(rb, &ptr);
+  contig = MIN(contig, count);
+  memcpy(buf, ptr, contig);
+
+  if (contig < count)
+    {
+      memcpy((FAR uint8_t *)buf + contig, rb->buf, count - contig);
+    }
+
+  ringbuf_spsc_consume(rb, count);
+
+  return count;
+}
+
+/****************************************************************************
+ * Name: ringbuf_spsc_bytesused
+ *
+ * Description:
+ *   Gets the number of bytes used.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer.
+ *
+ * Returned Value:
+ *   The number of bytes used.
+ *
+ ****************************************************************************/
+
+size_t ringbuf_spsc_bytesused(FAR struct ringbuf_spsc_s *rb)
+{
+  if (!rb)
+    {
+      return 0;
+    }
+
+  uint32_t head = LOAD_ACQUIRE(&rb->head);
+  uint32_t tail = LOAD_ACQUIRE(&rb->tail);
+
+  return tail - head;
+}
+
+/****************************************************************************
+ * Name: ringbuf_spsc_bytesavail
+ *
+ * Description:
+ *   Gets the number of bytes free.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer.
+ *
+ * Returned Value:
+ *   The number of bytes free.
+ *
+ ****************************************************************************/
+
+size_t ringbuf_spsc_bytesavail(FAR struct ringbuf_spsc_s *rb)
+{
+  if (!rb)
+    {
+      return 0;
+    }
+
+  return rb->mask + 1 - ringbuf_spsc_bytesused(rb);
+}
+
+/****************************************************************************
+ * Name: ringbuf_mpsc_init
+ *
+ * Description:
+ *   Initialize a MPSC Ring Buffer on given memory.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer to initialize, aligned to
+ *       RINGBUF_CACHELINE.
+ *   buf  Memory area of the buffer, 4 bytes aligned.
+ *   size  Size of the buffer, power of two and 8 or more.
+ *
+ * Returned Value:
+ *   On success, 0 is returned.
+ *   On failure, negative value is returned according to <errno.h>.
+ *
+ ****************************************************************************/
+
+int ringbuf_mpsc_init(FAR struct ringbuf_mpsc_s *rb,
+                      FAR void *buf, size_t size)
+{
+  if (!rb || !is_aligned(rb) || !buf || ((uintptr_t)buf & 3) ||
+      !is_pow2(size) || (size < 8) || (size > MPSC_LEN_MASK))
+    {
+      return -EINVAL;
+    }
+
+  memset(buf, 0, size);
+
+  rb->buf  = (FAR uint8_t *)buf;
+  rb->mask = size - 1;
+
+  STORE_RELAXED(&rb->head, 0);
+  STORE_RELEASE(&rb->reserve, 0);
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: ringbuf_mpsc_reserve
+ *
+ * Description:
+ *   Reserve space for one record.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer.
+ *   len  Bytes of the record.
+ *
+ * Returned Value:
+ *   On success, pointer to write the record is returned.
+ *   If there is no space, NULL is returned.
+ *
+ ****************************************************************************/
+
+FAR void *ringbuf_mpsc_reserve(FAR struct ringbuf_mpsc_s *rb, size_t len)
+{
+  uint32_t size = rb->mask + 1;
+  uint32_t need = MPSC_HDR_SIZE + MPSC_ALIGN(len);
+  uint32_t pos;
+  uint32_t pad;
+
+  if ((len > MPSC_LEN_MASK) || (need > size))
+    {
+      return NULL;
+    }
+
+  pos = LOAD_RELAXED(&rb->reserve);
+
+  do
+    {
+      uint32_t head = LOAD_ACQUIRE(&rb->head);
+      uint32_t off  = pos & rb->mask;
+
+      /* A record does not wrap around. If it does not fit before the end,
+       * the rest of the buffer is filled with a padding record.
+       */
+
+      pad = (size - off < need) ? (size - off) : 0;
+
+      if (pad + need > size - (pos - head))
+        {
+          return NULL;
+        }
+    }
+  while (!__atomic_compare_exchange_n(&rb->reserve, &pos, pos + pad + need,
+                                      false, __ATOMIC_ACQ_REL,
+                                      __ATOMIC_RELAXED));
+
+  if (pad)
+    {
+      STORE_RELEASE(mpsc_header(rb, pos),
+                    MPSC_COMMITTED | MPSC_PADDING | (pad - MPSC_HDR_SIZE));
+      pos += pad;
+    }
+
+  FAR uint32_t *hdr = mpsc_header(rb, pos);
+
+  STORE_RELAXED(hdr, (uint32_t)len);
+
+  return hdr + 1;
+}
+
+/****************************************************************************
+ * Name: ringbuf_mpsc_commit
+ *
+ * Description:
+ *   Publish a reserved record.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer.
+ *   ptr  Pointer returned by ringbuf_mpsc_reserve.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ringbuf_mpsc_commit(FAR struct ringbuf_mpsc_s *rb, FAR void *ptr)
+{
+  FAR uint32_t *hdr = (FAR uint32_t *)ptr - 1;
+
+  STORE_RELEASE(hdr, LOAD_RELAXED(hdr) | MPSC_COMMITTED);
+}
+
+/****************************************************************************
+ * Name: ringbuf_mpsc_write
+ *
+ * Description:
+ *   Write one record to a MPSC Ring Buffer.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer.
+ *   buf  Pointer to data of the record.
+ *   len  Bytes of the record.
+ *
+ * Returned Value:
+ *   On success, The number of bytes written.
+ *   If there is no space, -ENOSPC is returned.
+ *
+ ****************************************************************************/
+
+ssize_t ringbuf_mpsc_write(FAR struct ringbuf_mpsc_s *rb,
+                           FAR const void *buf, size_t len)
+{
+  FAR void *ptr;
+
+  if (!rb)
+    {
+      return -EINVAL;
+    }
+
+  ptr = ringbuf_mpsc_reserve(rb, len);
+  if (!ptr)
+    {
+      return -ENOSPC;
+    }
+
+  memcpy(ptr, buf, len);
+  ringbuf_mpsc_commit(rb, ptr);
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: ringbuf_mpsc_peek
+ *
+ * Description:
+ *   Get the oldest record to read directly.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer.
+ *   ptr  Head of the record.
+ *
+ * Returned Value:
+ *   Bytes of the record.
+ *   If there is no committed record, -EAGAIN is returned.
+ *
+ ****************************************************************************/
+
+ssize_t ringbuf_mpsc_peek(FAR struct ringbuf_mpsc_s *rb, FAR void **ptr)
+{
+  for (; ; )
+    {
+      FAR uint32_t *hdr = mpsc_header(rb, LOAD_RELAXED(&rb->head));
+      uint32_t      val = LOAD_ACQUIRE(hdr);
+
+      if (!(val & MPSC_COMMITTED))
+        {
+          return -EAGAIN;
+        }
+
+      if (val & MPSC_PADDING)
+        {
+          ringbuf_mpsc_consume(rb);
+          continue;
+        }
+
+      *ptr = hdr + 1;
+      return val & MPSC_LEN_MASK;
+    }
+}
+
+/****************************************************************************
+ * Name: ringbuf_mpsc_consume
+ *
+ * Description:
+ *   Release the record got by peek.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ringbuf_mpsc_consume(FAR struct ringbuf_mpsc_s *rb)
+{
+  uint32_t      head = LOAD_RELAXED(&rb->head);
+  FAR uint32_t *hdr  = mpsc_header(rb, head);
+  uint32_t      len  = MPSC_HDR_SIZE +
+                       MPSC_ALIGN(LOAD_RELAXED(hdr) & MPSC_LEN_MASK);
+
+  /* Clear the record before release, so that a header reserved here
+   * next time reads as not committed.
+   */
+
+  memset(hdr, 0, len);
+
+  STORE_RELEASE(&rb->head, head + len);
+}
+
+/****************************************************************************
+ * Name: ringbuf_mpsc_read
+ *
+ * Description:
+ *   Read one record from a MPSC Ring Buffer.
+ *
+ * Input Parameters:
+ *   rb  Pointer to a Ring Buffer.
+ *   buf  Pointer to buffer to store the record.
+ *   count  Size of the buffer.
+ *
+ * Returned Value:
+ *   On success, bytes of the record.
+ *   If there is no record, -EAGAIN is returned.
+ *   If the buffer is smaller than the record, -EMSGSIZE is returned.
+ *
+ ****************************************************************************/
+
+ssize_t ringbuf_mpsc_read(FAR struct ringbuf_mpsc_s *rb,
+                          FAR void *buf, size_t count)
+{
+  FAR void *ptr;
+  ssize_t   len;
+
+  if (!rb)
+    {
+      return -EINVAL;
+    }
+
+  len = ringbuf_mpsc_peek(rb, &ptr);
+  if (len < 0)
+    {
+      return len;
+    }
+
+  if ((size_t)len > count)
+    {
+      return -EMSGSIZE;
+    }
+
+  memcpy(buf, ptr, len);
+  ringbuf_mpsc_consume(rb);
+
+  return len;
+}
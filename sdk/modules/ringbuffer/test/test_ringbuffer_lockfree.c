@@ -0,0 +1,470 @@
+/****************************************************************************
+ * modules/ringbuffer/test/test_ringbuffer_lockfree.c
+ *
+ *   Copyright 2020 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/* Host test of the lock-free Ring Buffer. Basic checks run in a single
+ * thread, then producer and consumer threads stress SPSC and MPSC buffers
+ * and check order and payload of every transfer. Throughput of the
+ * stress is printed, so that it also serves as a benchmark.
+ *
+ * Usage: test_ringbuffer_lockfree [count]
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "ringbuffer/ringbuffer_lockfree.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CHECK(cond) \
+  do \
+    { \
+      if (!(cond)) \
+        { \
+          printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+          g_failed++; \
+        } \
+    } \
+  while (0)
+
+#define MPSC_PRODUCERS  4
+#define SPIN_LIMIT      10000000
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static int g_failed;
+static uint32_t g_count = 400000;
+
+static struct ringbuf_spsc_s g_spsc;
+static uint8_t g_spsc_buf[4096];
+
+static struct ringbuf_mpsc_s g_mpsc;
+static uint32_t g_mpsc_buf[1024];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static double elapsed_ms(FAR const struct timespec *start)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (now.tv_sec - start->tv_sec) * 1e3 +
+         (now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+/****************************************************************************
+ * Name: test_init
+ ****************************************************************************/
+
+static void test_init(void)
+{
+  static uint8_t raw[sizeof(struct ringbuf_mpsc_s) + RINGBUF_CACHELINE];
+  FAR struct ringbuf_spsc_s *spsc;
+  FAR struct ringbuf_mpsc_s *mpsc;
+  uint8_t buf[64];
+
+  CHECK(ringbuf_spsc_init(&g_spsc, g_spsc_buf, 100) == -EINVAL);
+  CHECK(ringbuf_spsc_init(&g_spsc, NULL, 64) == -EINVAL);
+  CHECK(ringbuf_mpsc_init(&g_mpsc, g_mpsc_buf, 4) == -EINVAL);
+  CHECK(ringbuf_mpsc_init(&g_mpsc, (uint8_t *)g_mpsc_buf + 2, 64) ==
+        -EINVAL);
+
+  /* Control structure which is not aligned, as from malloc(). */
+
+  spsc = (FAR struct ringbuf_spsc_s *)(raw + 8);
+  mpsc = (FAR struct ringbuf_mpsc_s *)(raw + 8);
+
+  if (((uintptr_t)spsc & (RINGBUF_CACHELINE - 1)) == 0)
+    {
+      spsc = (FAR struct ringbuf_spsc_s *)(raw + 16);
+      mpsc = (FAR struct ringbuf_mpsc_s *)(raw + 16);
+    }
+
+  CHECK(ringbuf_spsc_init(spsc, buf, sizeof(buf)) == -EINVAL);
+  CHECK(ringbuf_mpsc_init(mpsc, buf, sizeof(buf)) == -EINVAL);
+}
+
+/****************************************************************************
+ * Name: test_spsc_zero_copy
+ ****************************************************************************/
+
+static void test_spsc_zero_copy(void)
+{
+  FAR void *ptr;
+  uint8_t data[48];
+  size_t len;
+  int i;
+
+  CHECK(ringbuf_spsc_init(&g_spsc, g_spsc_buf, 64) == 0);
+
+  for (i = 0; i < (int)sizeof(data); i++)
+    {
+      data[i] = (uint8_t)i;
+    }
+
+  /* Move indices near the end, then reserve must stop at the end. */
+
+  CHECK(ringbuf_spsc_write(&g_spsc, data, 48) == 48);
+  CHECK(ringbuf_spsc_read(&g_spsc, data, 48) == 48);
+
+  len = ringbuf_spsc_reserve(&g_spsc, &ptr);
+  CHECK(len == 16);
+  CHECK(ptr == &g_spsc_buf[48]);
+
+  memset(ptr, 0xa5, len);
+  ringbuf_spsc_commit(&g_spsc, len);
+
+  len = ringbuf_spsc_reserve(&g_spsc, &ptr);
+  CHECK(len == 48);
+  CHECK(ptr == &g_spsc_buf[0]);
+  ringbuf_spsc_commit(&g_spsc, 8);
+
+  CHECK(ringbuf_spsc_bytesused(&g_spsc) == 24);
+  CHECK(ringbuf_spsc_bytesavail(&g_spsc) == 40);
+
+  len = ringbuf_spsc_peek(&g_spsc, &ptr);
+  CHECK(len == 16);
+  CHECK(((FAR uint8_t *)ptr)[15] == 0xa5);
+  ringbuf_spsc_consume(&g_spsc, len);
+
+  CHECK(ringbuf_spsc_peek(&g_spsc, &ptr) == 8);
+  CHECK(ringbuf_spsc_read(&g_spsc, data, sizeof(data)) == 8);
+  CHECK(ringbuf_spsc_bytesused(&g_spsc) == 0);
+}
+
+/****************************************************************************
+ * Name: test_mpsc_records
+ ****************************************************************************/
+
+static void test_mpsc_records(void)
+{
+  FAR void *first;
+  FAR void *second;
+  FAR void *ptr;
+  uint32_t val;
+  int i;
+
+  CHECK(ringbuf_mpsc_init(&g_mpsc, g_mpsc_buf, 64) == 0);
+  CHECK(ringbuf_mpsc_read(&g_mpsc, &val, sizeof(val)) == -EAGAIN);
+
+  first  = ringbuf_mpsc_reserve(&g_mpsc, 4);
+  second = ringbuf_mpsc_reserve(&g_mpsc, 4);
+  CHECK((first != NULL) && (second != NULL));
+
+  /* The second record is committed first, but not delivered before the
+   * first one.
+   */
+
+  *(FAR uint32_t *)second = 2;
+  ringbuf_mpsc_commit(&g_mpsc, second);
+  CHECK(ringbuf_mpsc_peek(&g_mpsc, &ptr) == -EAGAIN);
+
+  *(FAR uint32_t *)first = 1;
+  ringbuf_mpsc_commit(&g_mpsc, first);
+
+  CHECK(ringbuf_mpsc_read(&g_mpsc, &val, sizeof(val)) == 4);
+  CHECK(val == 1);
+  CHECK(ringbuf_mpsc_read(&g_mpsc, &val, 2) == -EMSGSIZE);
+  CHECK(ringbuf_mpsc_read(&g_mpsc, &val, sizeof(val)) == 4);
+  CHECK(val == 2);
+
+  /* Records of various sizes go around the end of the buffer. */
+
+  for (i = 0; i < 100; i++)
+    {
+      uint32_t rec[5];
+      uint32_t out[5];
+      uint32_t len = ((i % 5) + 1) * 4;
+
+      memset(rec, i, sizeof(rec));
+      memset(out, 0, sizeof(out));
+
+      CHECK(ringbuf_mpsc_write(&g_mpsc, rec, len) == len);
+      CHECK(ringbuf_mpsc_read(&g_mpsc, out, sizeof(out)) == len);
+      CHECK(memcmp(rec, out, len) == 0);
+    }
+
+  /* A record larger than the buffer never fits. */
+
+  CHECK(ringbuf_mpsc_write(&g_mpsc, g_mpsc_buf, 128) == -ENOSPC);
+}
+
+/****************************************************************************
+ * Name: spsc_producer
+ ****************************************************************************/
+
+static FAR void *spsc_producer(FAR void *arg)
+{
+  uint32_t i = 0;
+
+  /* Write 1 to 3 words at once, so that writes wrap at any position. */
+
+  while (i < g_count)
+    {
+      uint32_t val[3];
+      uint32_t num = (i % 3) + 1;
+      uint32_t k;
+
+      num = (i + num > g_count) ? g_count - i : num;
+
+      for (k = 0; k < num; k++)
+        {
+          val[k] = i + k;
+        }
+
+      if (ringbuf_spsc_write(&g_spsc, val, num * 4) > 0)
+        {
+          i += num;
+        }
+      else
+        {
+          sched_yield();
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: test_spsc_stress
+ ****************************************************************************/
+
+static void test_spsc_stress(void)
+{
+  struct timespec start;
+  pthread_t thread;
+  uint32_t i = 0;
+
+  CHECK(ringbuf_spsc_init(&g_spsc, g_spsc_buf, sizeof(g_spsc_buf)) == 0);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  pthread_create(&thread, NULL, spsc_producer, NULL);
+
+  while (i < g_count)
+    {
+      uint32_t val[5];
+      ssize_t  len = ringbuf_spsc_read(&g_spsc, val, ((i % 5) + 1) * 4);
+      ssize_t  k;
+
+      if (len <= 0)
+        {
+          sched_yield();
+          continue;
+        }
+
+      for (k = 0; k < len / 4; k++, i++)
+        {
+          if (val[k] != i)
+            {
+              printf("spsc: got %u, expected %u\n", val[k], i);
+              g_failed++;
+              i = g_count;
+              break;
+            }
+        }
+    }
+
+  pthread_join(thread, NULL);
+
+  double ms = elapsed_ms(&start);
+
+  printf("spsc: %u words in %.0f ms, %.1f MB/s\n",
+         g_count, ms, g_count * 4 / ms / 1e3);
+}
+
+/****************************************************************************
+ * Name: mpsc_producer
+ ****************************************************************************/
+
+static FAR void *mpsc_producer(FAR void *arg)
+{
+  uint32_t id = (uint32_t)(uintptr_t)arg;
+  uint32_t i;
+
+  /* Record is id, sequence number and 0 to 6 words of payload. */
+
+  for (i = 0; i < g_count / MPSC_PRODUCERS; )
+    {
+      uint32_t val[8];
+      uint32_t len = (i % 7) + 2;
+      uint32_t k;
+
+      val[0] = id;
+      val[1] = i;
+
+      for (k = 2; k < len; k++)
+        {
+          val[k] = i * k + id;
+        }
+
+      if (ringbuf_mpsc_write(&g_mpsc, val, len * 4) > 0)
+        {
+          i++;
+        }
+      else
+        {
+          sched_yield();
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: test_mpsc_stress
+ ****************************************************************************/
+
+static void test_mpsc_stress(void)
+{
+  struct timespec start;
+  pthread_t thread[MPSC_PRODUCERS];
+  uint32_t  next[MPSC_PRODUCERS];
+  uint32_t  total = 0;
+  uint32_t  spins = 0;
+  uintptr_t id;
+
+  CHECK(ringbuf_mpsc_init(&g_mpsc, g_mpsc_buf, sizeof(g_mpsc_buf)) == 0);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (id = 0; id < MPSC_PRODUCERS; id++)
+    {
+      next[id] = 0;
+      pthread_create(&thread[id], NULL, mpsc_producer, (FAR void *)id);
+    }
+
+  while (total < (g_count / MPSC_PRODUCERS) * MPSC_PRODUCERS)
+    {
+      uint32_t val[8];
+      ssize_t  len = ringbuf_mpsc_read(&g_mpsc, val, sizeof(val));
+      uint32_t seq;
+      ssize_t  k;
+
+      if (len == -EAGAIN)
+        {
+          if (++spins > SPIN_LIMIT)
+            {
+              printf("mpsc: no progress at head %u, reserve %u\n",
+                     g_mpsc.head, g_mpsc.reserve);
+              g_failed++;
+              exit(1);
+            }
+
+          sched_yield();
+          continue;
+        }
+
+      spins = 0;
+      id    = val[0];
+      seq   = val[1];
+
+      if ((len < 8) || (id >= MPSC_PRODUCERS) || (seq != next[id]) ||
+          (len != ((seq % 7) + 2) * 4))
+        {
+          printf("mpsc: bad record, len %zd id %lu seq %u\n",
+                 len, (unsigned long)id, seq);
+          g_failed++;
+          break;
+        }
+
+      for (k = 2; k < len / 4; k++)
+        {
+          if (val[k] != seq * k + id)
+            {
+              printf("mpsc: bad payload of id %lu seq %u\n",
+                     (unsigned long)id, seq);
+              g_failed++;
+              break;
+            }
+        }
+
+      next[id]++;
+      total++;
+    }
+
+  for (id = 0; id < MPSC_PRODUCERS; id++)
+    {
+      pthread_join(thread[id], NULL);
+    }
+
+  double ms = elapsed_ms(&start);
+
+  CHECK(ringbuf_mpsc_read(&g_mpsc, g_mpsc_buf, 8) == -EAGAIN);
+
+  printf("mpsc: %u records from %d producers in %.0f ms, %.2f M/s\n",
+         total, MPSC_PRODUCERS, ms, total / ms / 1e3);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, FAR char *argv[])
+{
+  if (argc > 1)
+    {
+      g_count = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+  test_init();
+  test_spsc_zero_copy();
+  test_mpsc_records();
+
+  if (g_failed == 0)
+    {
+      test_spsc_stress();
+      test_mpsc_stress();
+    }
+
+  printf("test_ringbuffer_lockfree: %s\n", g_failed ? "FAILED" : "passed");
+
+  return g_failed ? 1 : 0;
+}
@@ -0,0 +1,343 @@
+/****************************************************************************
+ * modules/sensing/manager/sensor_delivery.cpp
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sdk/config.h>
+#include <sdk/debug.h>
+
+#include <string.h>
+#include <time.h>
+
+#include "sensor_delivery.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_SENSING_MANAGER_DELIVERY_PRIORITY
+#  define CONFIG_SENSING_MANAGER_DELIVERY_PRIORITY 110
+#endif
+
+#ifndef CONFIG_SENSING_MANAGER_DELIVERY_STACK_SIZE
+#  define CONFIG_SENSING_MANAGER_DELIVERY_STACK_SIZE 2048
+#endif
+
+#define QUEUE_DEPTH CONFIG_SENSING_MANAGER_DELIVERY_QUEUE_DEPTH
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+SensorDelivery::SensorDelivery(unsigned int id,
+                               sensor_data_callback_t callback,
+                               sensor_data_mh_callback_t callback_mh)
+  : m_id(id)
+  , m_callback(callback)
+  , m_callback_mh(callback_mh)
+  , m_head(0)
+  , m_count(0)
+  , m_started(false)
+  , m_stop(false)
+  , m_detached(false)
+  , m_total_latency(0)
+{
+  memset(&m_stats, 0, sizeof(m_stats));
+  pthread_mutex_init(&m_lock, NULL);
+  pthread_cond_init(&m_cond, NULL);
+}
+
+/*--------------------------------------------------------------------*/
+SensorDelivery::~SensorDelivery()
+{
+  if (m_started && !m_detached)
+    {
+      pthread_mutex_lock(&m_lock);
+      m_stop = true;
+      pthread_cond_signal(&m_cond);
+      pthread_mutex_unlock(&m_lock);
+
+      pthread_join(m_pid, NULL);
+    }
+
+  /* Release MemHandles left in the queue. */
+
+  for (int i = 0; i < QUEUE_DEPTH; i++)
+    {
+      m_que[i].data_mh.mh = MemMgrLite::MemHandle();
+    }
+
+  pthread_cond_destroy(&m_cond);
+  pthread_mutex_destroy(&m_lock);
+}
+
+/*--------------------------------------------------------------------*/
+bool SensorDelivery::start(void)
+{
+  pthread_attr_t     attr;
+  struct sched_param sch_param;
+  int                ret;
+
+  pthread_attr_init(&attr);
+  sch_param.sched_priority = CONFIG_SENSING_MANAGER_DELIVERY_PRIORITY;
+  attr.stacksize           = CONFIG_SENSING_MANAGER_DELIVERY_STACK_SIZE;
+  pthread_attr_setschedparam(&attr, &sch_param);
+
+  ret = pthread_create(&m_pid,
+                       &attr,
+                       (pthread_startroutine_t)SensorDelivery::entry,
+                       (pthread_addr_t)this);
+  if (ret != 0)
+    {
+      return false;
+    }
+
+  m_started = true;
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+/* Stop delivery without waiting for the task.  A callback in progress is
+ * not waited for, the task deletes this object when it returns.  Data not
+ * delivered yet are released.
+ */
+
+void SensorDelivery::release(void)
+{
+  pthread_t pid = m_pid;
+
+  if (!m_started)
+    {
+      delete this;
+      return;
+    }
+
+  /* This object may be deleted as soon as m_lock is released. */
+
+  pthread_mutex_lock(&m_lock);
+  m_stop     = true;
+  m_detached = true;
+  pthread_cond_signal(&m_cond);
+  pthread_mutex_unlock(&m_lock);
+
+  pthread_detach(pid);
+}
+
+/*--------------------------------------------------------------------*/
+uint32_t SensorDelivery::now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/*--------------------------------------------------------------------*/
+/* Get a free entry at the tail of queue, with m_lock held.  If the queue
+ * is full, the oldest data is dropped to keep the latency bounded.
+ */
+
+FAR SensorDelivery::entry_t *SensorDelivery::reserve(void)
+{
+  if (m_count == QUEUE_DEPTH)
+    {
+      m_que[m_head].data_mh.mh = MemMgrLite::MemHandle();
+      m_head = (m_head + 1) % QUEUE_DEPTH;
+      m_count--;
+      m_stats.dropped++;
+    }
+
+  return &m_que[(m_head + m_count) % QUEUE_DEPTH];
+}
+
+/*--------------------------------------------------------------------*/
+void SensorDelivery::commit(void)
+{
+  m_count++;
+  if (m_count > m_stats.max_depth)
+    {
+      m_stats.max_depth = m_count;
+    }
+
+  pthread_cond_signal(&m_cond);
+}
+
+/*--------------------------------------------------------------------*/
+bool SensorDelivery::post(sensor_command_data_t& data)
+{
+  FAR entry_t *ent;
+
+  if (!m_callback)
+    {
+      return false;
+    }
+
+  pthread_mutex_lock(&m_lock);
+
+  ent = reserve();
+  ent->is_mh = false;
+  ent->stamp = now();
+  ent->data  = data;
+
+  commit();
+
+  pthread_mutex_unlock(&m_lock);
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+bool SensorDelivery::post(sensor_command_data_mh_t& data)
+{
+  FAR entry_t *ent;
+
+  if (!m_callback_mh)
+    {
+      return false;
+    }
+
+  pthread_mutex_lock(&m_lock);
+
+  /* Copy of MemHandle only increments the reference count. */
+
+  ent = reserve();
+  ent->is_mh   = true;
+  ent->stamp   = now();
+  ent->data_mh = data;
+
+  commit();
+
+  pthread_mutex_unlock(&m_lock);
+  return true;
+}
+
+/*--------------------------------------------------------------------*/
+void SensorDelivery::get_stats(FAR sensor_delivery_stats_t *stats)
+{
+  pthread_mutex_lock(&m_lock);
+
+  *stats = m_stats;
+  stats->avg_latency = m_stats.delivered ?
+                         m_total_latency / m_stats.delivered : 0;
+
+  pthread_mutex_unlock(&m_lock);
+}
+
+/*--------------------------------------------------------------------*/
+FAR void *SensorDelivery::entry(FAR void *arg)
+{
+  FAR SensorDelivery *self = static_cast<SensorDelivery *>(arg);
+
+  self->run();
+
+  /* m_detached is set before m_stop under m_lock, so it is stable here. */
+
+  if (self->m_detached)
+    {
+      delete self;
+    }
+
+  return NULL;
+}
+
+/*--------------------------------------------------------------------*/
+void SensorDelivery::run(void)
+{
+  sensor_command_data_t    data;
+  sensor_command_data_mh_t data_mh;
+  bool                     is_mh;
+  uint32_t                 latency;
+
+  pthread_mutex_lock(&m_lock);
+
+  while (1)
+    {
+      while (m_count == 0 && !m_stop)
+        {
+          pthread_cond_wait(&m_cond, &m_lock);
+        }
+
+      if (m_stop)
+        {
+          break;
+        }
+
+      /* Take the oldest data and release the slot before callback, the
+       * manager can post next data during callback.
+       */
+
+      FAR entry_t *ent = &m_que[m_head];
+
+      is_mh = ent->is_mh;
+      if (is_mh)
+        {
+          data_mh = ent->data_mh;
+          ent->data_mh.mh = MemMgrLite::MemHandle();
+        }
+      else
+        {
+          data = ent->data;
+        }
+
+      latency = now() - ent->stamp;
+
+      m_head = (m_head + 1) % QUEUE_DEPTH;
+      m_count--;
+
+      m_stats.delivered++;
+      m_total_latency += latency;
+      if (latency > m_stats.max_latency)
+        {
+          m_stats.max_latency = latency;
+        }
+
+      pthread_mutex_unlock(&m_lock);
+
+      if (is_mh)
+        {
+          m_callback_mh(data_mh);
+          data_mh.mh = MemMgrLite::MemHandle();
+        }
+      else
+        {
+          m_callback(data);
+        }
+
+      pthread_mutex_lock(&m_lock);
+    }
+
+  pthread_mutex_unlock(&m_lock);
+}
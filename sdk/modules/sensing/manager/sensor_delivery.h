@@ -0,0 +1,115 @@
+/****************************************************************************
+ * modules/sensing/manager/sensor_delivery.h
+ *
+ *   Copyright 2018 Sony Semiconductor Solutions Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name of Sony Semiconductor Solutions Corporation nor
+ *    the names of its contributors may be used to endorse or promote
+ *    products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __SENSING_MANAGER_SENSOR_DELIVERY_H
+#define __SENSING_MANAGER_SENSOR_DELIVERY_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sdk/config.h>
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include "sensing/sensor_api.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_SENSING_MANAGER_DELIVERY_QUEUE_DEPTH
+#  define CONFIG_SENSING_MANAGER_DELIVERY_QUEUE_DEPTH 8
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Deliver sensor data to one subscriber on its own task.  The manager task
+ * only puts data into the bounded queue, so a slow subscriber doesn't block
+ * the delivery to the other subscribers.  Data with MemHandle is shared by
+ * reference count, it is not copied for each subscriber.
+ */
+
+class SensorDelivery
+{
+public:
+  SensorDelivery(unsigned int id,
+                 sensor_data_callback_t callback,
+                 sensor_data_mh_callback_t callback_mh);
+  ~SensorDelivery();
+
+  bool start(void);
+  void release(void);
+  bool post(sensor_command_data_t& data);
+  bool post(sensor_command_data_mh_t& data);
+  void get_stats(FAR sensor_delivery_stats_t *stats);
+
+private:
+  typedef struct
+  {
+    bool                     is_mh;
+    uint32_t                 stamp;    /* Time posted in us */
+    sensor_command_data_t    data;
+    sensor_command_data_mh_t data_mh;
+  } entry_t;
+
+  static FAR void *entry(FAR void *arg);
+  void     run(void);
+  FAR entry_t *reserve(void);
+  void     commit(void);
+  uint32_t now(void);
+
+  unsigned int              m_id;
+  sensor_data_callback_t    m_callback;
+  sensor_data_mh_callback_t m_callback_mh;
+
+  entry_t         m_que[CONFIG_SENSING_MANAGER_DELIVERY_QUEUE_DEPTH];
+  int             m_head;
+  int             m_count;
+  bool            m_started;
+  bool            m_stop;
+  bool            m_detached;
+  pthread_t       m_pid;
+  pthread_mutex_t m_lock;
+  pthread_cond_t  m_cond;
+
+  sensor_delivery_stats_t m_stats;
+  uint64_t        m_total_latency;
+};
+
+#endif /* __SENSING_MANAGER_SENSOR_DELIVERY_H */
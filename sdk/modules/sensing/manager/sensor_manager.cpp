@@ -153,6 +153,12 @@ void SensorManager::register_client(MsgPacket* packet)
 {
   sensor_command_register_t reg = packet->moveParam<sensor_command_register_t>();
 
+  if (!is_valid_id(reg.get_self()))
+    {
+      response(reg.header.code, SS_ECODE_PARAM_ERROR, reg.get_self());
+      return;
+    }
+
   client_table[reg.get_self()].status = 0x01;
   client_table[reg.get_self()].callback = reg.callback;
   client_table[reg.get_self()].callback_mh = reg.callback_mh;
@@ -160,28 +166,51 @@ void SensorManager::register_client(MsgPacket* packet)
   power_table[reg.get_self()].callback = reg.callback_pw;
 #endif /* CONFIG_SENSING_MANAGER_POWERCTRL */
 
-  /* Regist as a subscriptors of required SensorID. */
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  /* Create delivery task of this client, if it receives any data. */
 
-  for (int i = 0, j = reg.get_subscriptions(); (j != 0) || (i < 24); i++)
+  if ((client_table[reg.get_self()].delivery == NULL) &&
+      (reg.callback || reg.callback_mh))
     {
-      if (j & (0x01<<i))
+      FAR SensorDelivery *delivery =
+        new SensorDelivery(reg.get_self(), reg.callback, reg.callback_mh);
+
+      if (!delivery->start())
         {
-          /* If required SensorID is not active, take as a error. */
+          delete delivery;
+          client_table[reg.get_self()].status = 0x00;
+          response(reg.header.code,
+                   SS_ECODE_TASK_CREATE_ERROR,
+                   reg.get_self());
+          return;
+        }
 
-          if (client_table[i].status == 0)
-            {
-              response(reg.header.code,
-                       SS_ECODE_REQUIRED_SENSOR_NOT_ACTIVE,
-                       reg.get_self());
-              return;
-            }
+      pthread_mutex_lock(&m_delivery_lock);
+      client_table[reg.get_self()].delivery = delivery;
+      pthread_mutex_unlock(&m_delivery_lock);
+    }
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+
+  /* Regist as a subscriptors of required SensorID. */
 
-          client_table[i].subscribers |= (0x01 << reg.get_self());
-          j &= ~(0x01 << i);
-              
-          _info("sesor id : %2d >> %08x\n", i, client_table[i].subscribers);
+  for (uint64_t j = reg.get_subscriptions(); j != 0; j &= j - 1)
+    {
+      int i = __builtin_ctzll(j);
+
+      /* If required SensorID is not active, take as a error. */
+
+      if (client_table[i].status == 0)
+        {
+          response(reg.header.code,
+                   SS_ECODE_REQUIRED_SENSOR_NOT_ACTIVE,
+                   reg.get_self());
+          return;
         }
 
+      client_table[i].subscribers |= SS_CLIENT_BIT(reg.get_self());
+
+      _info("sesor id : %2d >> %016llx\n",
+            i, (unsigned long long)client_table[i].subscribers);
     }
 
   response(reg.header.code, SS_ECODE_OK, reg.get_self());
@@ -192,6 +221,12 @@ void SensorManager::release_client(MsgPacket* packet)
 {
   sensor_command_release_t rel = packet->moveParam<sensor_command_release_t>();
 
+  if (!is_valid_id(rel.get_self()))
+    {
+      response(rel.header.code, SS_ECODE_PARAM_ERROR, rel.get_self());
+      return;
+    }
+
   /* If required SensorID has any subscribers, take as error. */
 
   if (client_table[rel.get_self()].subscribers != 0)
@@ -204,14 +239,31 @@ void SensorManager::release_client(MsgPacket* packet)
 
   /* Delete from subscribers of every SensorID. */
 
-  for (int i = 0; i < 24; i++)
+  for (int i = 0; i < SS_MAX_CLIENTS; i++)
     {
-      client_table[i].subscribers &= ~(0x01 << rel.get_self());
+      client_table[i].subscribers &= ~SS_CLIENT_BIT(rel.get_self());
 #ifdef CONFIG_SENSING_MANAGER_POWERCTRL
-      power_table[i].subscribers &= ~(0x01 << rel.get_self());
+      power_table[i].subscribers &= ~SS_CLIENT_BIT(rel.get_self());
 #endif /* CONFIG_SENSING_MANAGER_POWERCTRL */
     }
 
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  /* Stop delivery task, the data not delivered yet are released.  The
+   * task is not joined here, a callback in progress must not stall the
+   * manager task.
+   */
+
+  pthread_mutex_lock(&m_delivery_lock);
+
+  if (client_table[rel.get_self()].delivery)
+    {
+      client_table[rel.get_self()].delivery->release();
+      client_table[rel.get_self()].delivery = NULL;
+    }
+
+  pthread_mutex_unlock(&m_delivery_lock);
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+
   client_table[rel.get_self()].status      = 0x00;
   client_table[rel.get_self()].subscribers = 0x00;
   client_table[rel.get_self()].callback    = 0x00;
@@ -231,35 +283,39 @@ void SensorManager::change_subscription(MsgPacket* packet)
   sensor_command_change_subscription_t chg =
     packet->moveParam<sensor_command_change_subscription_t>();
 
-  for (int i = 0, j = chg.get_subscriptions(); (j != 0) || (i < 24); i++)
+  if (!is_valid_id(chg.get_self()))
     {
-      if (j & (0x01<<i))
-        {
-          /* If required SensorID is not active, take as a error. */
+      response(chg.header.code, SS_ECODE_PARAM_ERROR, chg.get_self());
+      return;
+    }
 
-          if (client_table[i].status == 0)
-            {
-              response(chg.header.code,
-                       SS_ECODE_REQUIRED_SENSOR_NOT_ACTIVE,
-                       chg.get_self());
-              return;
-            }
+  for (uint64_t j = chg.get_subscriptions(); j != 0; j &= j - 1)
+    {
+      int i = __builtin_ctzll(j);
 
-          /* Regist/delete subscribers accoding to "add" parameter. */
+      /* If required SensorID is not active, take as a error. */
 
-          if (chg.add)
-            {
-              client_table[i].subscribers |= (0x01 << chg.get_self());
-            }
-          else
-            {
-              client_table[i].subscribers &= ~(0x01 << chg.get_self());
-            }
+      if (client_table[i].status == 0)
+        {
+          response(chg.header.code,
+                   SS_ECODE_REQUIRED_SENSOR_NOT_ACTIVE,
+                   chg.get_self());
+          return;
+        }
 
-          j &= ~(0x01 << i);
+      /* Regist/delete subscribers accoding to "add" parameter. */
 
-          _info("sesor id : %2d >> %08x\n", i, client_table[i].subscribers);
+      if (chg.add)
+        {
+          client_table[i].subscribers |= SS_CLIENT_BIT(chg.get_self());
+        }
+      else
+        {
+          client_table[i].subscribers &= ~SS_CLIENT_BIT(chg.get_self());
         }
+
+      _info("sesor id : %2d >> %016llx\n",
+            i, (unsigned long long)client_table[i].subscribers);
     }
 
   response(chg.header.code, SS_ECODE_OK, chg.get_self());
@@ -270,7 +326,8 @@ void SensorManager::send_data(MsgPacket* packet)
 {
   sensor_command_data_t data = packet->moveParam<sensor_command_data_t>();
 
-  if (client_table[data.get_self()].status == 0x00)
+  if (!is_valid_id(data.get_self()) ||
+      client_table[data.get_self()].status == 0x00)
     {
       response(data.header.code,
                SS_ECODE_REQUIRED_SENSOR_NOT_ACTIVE,
@@ -278,22 +335,28 @@ void SensorManager::send_data(MsgPacket* packet)
       return;
     }
 
-  for (int i = 0, j = client_table[data.get_self()].subscribers;
-        (j != 0) || (i < 24); i++)
+  for (uint64_t j = client_table[data.get_self()].subscribers;
+       j != 0; j &= j - 1)
     {
-      if (j & (0x01 << i))
+      int i = __builtin_ctzll(j);
+
+      if (!client_table[i].callback)
         {
-          if (!client_table[i].callback)
-            {
-              response(data.header.code,
-                       SS_ECODE_NOTIFICATION_DST_UNDEFINED,
-                       data.get_self());
-              return;
-            }
+          response(data.header.code,
+                   SS_ECODE_NOTIFICATION_DST_UNDEFINED,
+                   data.get_self());
+          return;
+        }
 
-          client_table[i].callback(data);/* callback */
-          j &= ~(0x01 << i);
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+      if (client_table[i].delivery)
+        {
+          client_table[i].delivery->post(data);
+          continue;
         }
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+
+      client_table[i].callback(data);/* callback */
     }
 
   response(data.header.code, SS_ECODE_OK, data.get_self());
@@ -305,7 +368,8 @@ void SensorManager::send_data_mh(MsgPacket* packet)
 {
   sensor_command_data_mh_t data = packet->moveParam<sensor_command_data_mh_t>();
 
-  if (client_table[data.get_self()].status == 0x00)
+  if (!is_valid_id(data.get_self()) ||
+      client_table[data.get_self()].status == 0x00)
     {
       response(data.header.code,
                SS_ECODE_REQUIRED_SENSOR_NOT_ACTIVE,
@@ -313,22 +377,30 @@ void SensorManager::send_data_mh(MsgPacket* packet)
       return;
     }
 
-  for (int i = 0, j = client_table[data.get_self()].subscribers;
-        (j != 0) || (i < 24); i++)
+  for (uint64_t j = client_table[data.get_self()].subscribers;
+       j != 0; j &= j - 1)
     {
-      if (j & (0x01 << i))
+      int i = __builtin_ctzll(j);
+
+      if (!client_table[i].callback_mh)
         {
-          if (!client_table[i].callback_mh)
-            {
-              response(data.header.code,
-                       SS_ECODE_NOTIFICATION_DST_UNDEFINED,
-                       data.get_self());
-              return;
-            }
+          response(data.header.code,
+                   SS_ECODE_NOTIFICATION_DST_UNDEFINED,
+                   data.get_self());
+          return;
+        }
 
-          client_table[i].callback_mh(data);/* callback */
-          j &= ~(0x01 << i);
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+      /* Each queued entry holds a reference of the same MemHandle. */
+
+      if (client_table[i].delivery)
+        {
+          client_table[i].delivery->post(data);
+          continue;
         }
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+
+      client_table[i].callback_mh(data);/* callback */
     }
 
   response(data.header.code, SS_ECODE_OK, data.get_self());
@@ -340,7 +412,8 @@ void SensorManager::send_result(MsgPacket* packet)
 {
   sensor_command_result_t res = packet->moveParam<sensor_command_result_t>();
 
-  if (client_table[res.get_self()].status == 0x00)
+  if (!is_valid_id(res.get_self()) ||
+      client_table[res.get_self()].status == 0x00)
     {
       response(res.header.code,
                SS_ECODE_REQUIRED_SENSOR_NOT_ACTIVE,
@@ -348,15 +421,6 @@ void SensorManager::send_result(MsgPacket* packet)
       return;
     }
 
-  for (int i = 0, j=client_table[res.get_self()].subscribers;
-        (j != 0)||(i < 24); i++)
-    {
-      if (j & (0x01 << i))
-        {
-          j &= ~(0x01 << i);
-        }
-    }
-
   response(res.header.code, SS_ECODE_OK, res.get_self());
 }
 
@@ -366,10 +430,16 @@ void SensorManager::set_power(MsgPacket* packet)
 {
   sensor_command_power_t pow = packet->moveParam<sensor_command_power_t>();
 
-  for (int i = 0; i < 24; i++)
+  if (!is_valid_id(pow.get_self()))
+    {
+      response(pow.header.code, SS_ECODE_PARAM_ERROR, pow.get_self());
+      return;
+    }
+
+  for (int i = 0; i < SS_MAX_CLIENTS; i++)
     {
-      int j = 0x01 << pow.get_self();
-      int k = 0x01 << i;
+      uint64_t j = SS_CLIENT_BIT(pow.get_self());
+      uint64_t k = SS_CLIENT_BIT(i);
 
       if (client_table[i].subscribers & j)
         {
@@ -403,10 +473,16 @@ void SensorManager::clear_power(MsgPacket* packet)
 {
   sensor_command_power_t pow = packet->moveParam<sensor_command_power_t>();
 
-  for (int i = 0; i < 24; i++)
+  if (!is_valid_id(pow.get_self()))
     {
-      int j = 0x01 << pow.get_self();
-      int k = 0x01 << i;
+      response(pow.header.code, SS_ECODE_PARAM_ERROR, pow.get_self());
+      return;
+    }
+
+  for (int i = 0; i < SS_MAX_CLIENTS; i++)
+    {
+      uint64_t j = SS_CLIENT_BIT(pow.get_self());
+      uint64_t k = SS_CLIENT_BIT(i);
 
       if (client_table[i].subscribers & j)
         {
@@ -439,6 +515,36 @@ void SensorManager::clear_power(MsgPacket* packet)
 }
 #endif /* CONFIG_SENSING_MANAGER_POWERCTRL */
 
+/*--------------------------------------------------------------------*/
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+bool SensorManager::get_delivery_stats(unsigned int id,
+                                       FAR sensor_delivery_stats_t *stats)
+{
+  bool ret = false;
+
+  if (!is_valid_id(id))
+    {
+      return false;
+    }
+
+  /* Hold the lock over get_stats(), release_client() on the manager task
+   * must not hand the object over to the delivery task meanwhile.
+   */
+
+  pthread_mutex_lock(&m_delivery_lock);
+
+  if (client_table[id].delivery != NULL)
+    {
+      client_table[id].delivery->get_stats(stats);
+      ret = true;
+    }
+
+  pthread_mutex_unlock(&m_delivery_lock);
+
+  return ret;
+}
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+
 /*--------------------------------------------------------------------*/
 void SensorManager::ignore(MsgPacket* packet)
 {
@@ -606,6 +712,21 @@ void SS_SendSensorClearPower(FAR sensor_command_power_t *packet)
 }
 #endif /* CONFIG_SENSING_MANAGER_POWERCTRL */
 
+/*--------------------------------------------------------------------*/
+bool SS_GetDeliveryStats(unsigned int id, FAR sensor_delivery_stats_t *stats)
+{
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  if ((TheSensorManager == NULL) || (stats == NULL))
+    {
+      return false;
+    }
+
+  return TheSensorManager->get_delivery_stats(id, stats);
+#else
+  return false;
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+}
+
 }/* extern "C"  */
 
 #ifdef __cplusplus
@@ -47,6 +47,18 @@
 #include "sensing/sensor_id.h"
 #include "sensing/sensor_api.h"
 #include "sensing/sensor_ecode.h"
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+#include "sensor_delivery.h"
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Maximum number of sensor clients, subscribers are managed by 64 bit set. */
+
+#define SS_MAX_CLIENTS    64
+#define SS_CLIENT_BIT(id) ((uint64_t)1 << (id))
 
 /****************************************************************************
  * Public Types
@@ -58,24 +70,42 @@ class SensorManager
 public:
   static void create(MsgQueId selfMId, api_response_callback_t callback);
 
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  bool get_delivery_stats(unsigned int id,
+                          FAR sensor_delivery_stats_t *stats);
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+
   MsgQueId get_mid()
   {
     return m_selfMId;
   }
 
-  ~SensorManager(){};
+  ~SensorManager()
+  {
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+    for (int i = 0; i < SS_MAX_CLIENTS; i++)
+      {
+        delete client_table[i].delivery;
+      }
+
+    pthread_mutex_destroy(&m_delivery_lock);
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
+  };
 
 private:
   SensorManager(MsgQueId selfMId, api_response_callback_t callback)
       : m_selfMId(selfMId)
       , m_api_response_callback(callback)
   {
-    for (int i = 0; i < 24; i++)
+    for (int i = 0; i < SS_MAX_CLIENTS; i++)
       {
         client_table[i].status      = 0;
         client_table[i].subscribers = 0;
         client_table[i].callback    = NULL;
         client_table[i].callback_mh = NULL;
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+        client_table[i].delivery    = NULL;
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
 
 #ifdef CONFIG_SENSING_MANAGER_POWERCTRL
         power_table[i].status       = 0;
@@ -83,6 +113,10 @@ private:
         power_table[i].callback     = NULL;
 #endif /* CONFIG_SENSING_MANAGER_POWERCTRL */ 
       }
+
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+    pthread_mutex_init(&m_delivery_lock, NULL);
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
   };
 
   /*** private members ***/
@@ -92,14 +126,26 @@ private:
   /** subscriber information */
   typedef struct
   {
-    unsigned int status : 8;       /** status itself */
-    unsigned int subscribers : 24; /** subscribers */
+    uint8_t  status;               /** status itself */
+    uint64_t subscribers;          /** subscribers */
     sensor_data_callback_t    callback;
     sensor_data_mh_callback_t callback_mh;
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+    FAR SensorDelivery       *delivery; /** delivery task */
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
   } client_info_t;
 
   /** subscriber database*/
-  client_info_t client_table[24]; /* 24 must be config.*/
+  client_info_t client_table[SS_MAX_CLIENTS];
+
+#ifdef CONFIG_SENSING_MANAGER_ASYNC_DELIVERY
+  /** Guards client_table[].delivery against get_delivery_stats(), which
+   *  runs on the application task.  Once release() is called the delivery
+   *  task may delete the object at any time.
+   */
+
+  pthread_mutex_t m_delivery_lock;
+#endif /* CONFIG_SENSING_MANAGER_ASYNC_DELIVERY */
 
   /*** private mathods ***/
   void    run(void);
@@ -116,6 +162,11 @@ private:
   void    send_data_mh(MsgPacket*);
   void    send_result(MsgPacket*);
 
+  bool    is_valid_id(unsigned int id)
+  {
+    return id < SS_MAX_CLIENTS;
+  }
+
   void    ignore(MsgPacket*);
   void    response(unsigned int code, unsigned int ercd, unsigned int id);
 
@@ -123,13 +174,13 @@ private:
   /** poweroff information */
   typedef struct
   {
-    unsigned int status : 8;       /** reserve */
-    unsigned int subscribers : 24; /** poweron subscribers */
+    uint8_t  status;               /** reserve */
+    uint64_t subscribers;          /** poweron subscribers */
     sensor_power_callback_t callback;
   } power_info_t;
 
   /** subscriber database*/
-  power_info_t power_table[24]; /* 24 must be config.*/
+  power_info_t power_table[SS_MAX_CLIENTS];
 
   void    set_power(MsgPacket*);
   void    clear_power(MsgPacket*);
@@ -39,6 +39,8 @@
 
 #include <sdk/config.h>
 #include <sdk/debug.h>
+#include <errno.h>
+#include <stdlib.h>
 #include <sys/time.h>
 
 #include "sensing/logical_sensor/step_counter.h"
@@ -116,6 +118,12 @@ int StepCounterClass::open(void)
   int id;
   uint32_t msgdata = 0;
 
+#if CONFIG_SENSING_STEPCOUNTER_BATCH_COUNT > 1
+  /* Batches may be armed again after a previous close(). */
+
+  m_batch_closing = false;
+#endif
+
   /* Initalize Worker as task. */
 
   ret = mptask_init_secure(&m_mptask, "AESM");
@@ -210,6 +218,41 @@ sc_errout_with_mptask_destroy:
 int StepCounterClass::close(void)
 {
   int wret = -1;
+
+#if CONFIG_SENSING_STEPCOUNTER_BATCH_COUNT > 1
+  /* Stop the deadline work, and drop samples DSP will not process. */
+
+  while (sem_wait(&m_batch_sem) != 0)
+    {
+      DEBUGASSERT(errno == EINTR);
+    }
+
+  m_acc_batch.clear();
+  m_batch_closing = true;
+
+  if (work_cancel(LPWORK, &m_batch_work) == OK)
+    {
+      m_batch_pending--;
+    }
+
+  bool running = (m_batch_pending > 0);
+
+  sem_post(&m_batch_sem);
+
+  /* work_cancel() does not wait for a batch_timeout() already taken off
+   * the queue, it may be blocked on m_batch_sem just released.  Wait for
+   * it so that it does not touch this instance after close().
+   */
+
+  if (running)
+    {
+      while (sem_wait(&m_batch_done) != 0)
+        {
+          DEBUGASSERT(errno == EINTR);
+        }
+    }
+#endif
+
   int ret = mptask_destroy(&m_mptask, false, &wret);
   if (ret < 0)
     {
@@ -301,14 +344,64 @@ int StepCounterClass::sendInit(void)
   return SS_ECODE_OK;
 }
 
+/*--------------------------------------------------------------------------*/
+int StepCounterClass::send_exec(struct exe_mh_s &exe_mh)
+{
+  if (!m_exe_que.push(exe_mh))
+    {
+      sc_err("m_exe_que.push() failure.¥n");
+      free(exe_mh.batch);
+      return SS_ECODE_QUEUE_PUSH_ERROR;
+    }
+
+  /* Send sensored data.
+   * (Data which sent to DSP is physical address of command msg.)
+   */
+
+  int ret = mpmq_send(&m_mq,
+                      (StepCounterMode << 4) + (ExecEvent << 1),
+                      reinterpret_cast<int32_t>(exe_mh.cmd.getPa()));
+  if (ret < 0)
+    {
+      free(exe_mh.batch);
+      m_exe_que.pop();
+      sc_err("mpmq_send() failure. %d\n", ret);
+      return SS_ECODE_DSP_EXEC_ERROR;
+    }
+
+  return SS_ECODE_OK;
+}
+
 /*--------------------------------------------------------------------------*/
 int StepCounterClass::write(FAR sensor_command_data_mh_t *command)
+{
+#if CONFIG_SENSING_STEPCOUNTER_BATCH_COUNT > 1
+  /* The batch is also flushed by batch_timeout() on the work thread. */
+
+  while (sem_wait(&m_batch_sem) != 0)
+    {
+      DEBUGASSERT(errno == EINTR);
+    }
+
+  int ret = write_batch(command);
+
+  sem_post(&m_batch_sem);
+
+  return ret;
+#else
+  return write_exec(command);
+#endif
+}
+
+/*--------------------------------------------------------------------------*/
+int StepCounterClass::write_exec(FAR sensor_command_data_mh_t *command)
 {
   struct exe_mh_s exe_mh;
 
   /* copy memhandle of data */
 
-  exe_mh.data = command->mh;
+  exe_mh.data  = command->mh;
+  exe_mh.batch = NULL;
 
   /* allocate segment of command */
 
@@ -357,29 +450,178 @@ int StepCounterClass::write(FAR sensor_command_data_mh_t *command)
         break;
     }
 
-  if (!m_exe_que.push(exe_mh))
+  return send_exec(exe_mh);
+}
+
+#if CONFIG_SENSING_STEPCOUNTER_BATCH_COUNT > 1
+/*--------------------------------------------------------------------------*/
+int StepCounterClass::write_batch(FAR sensor_command_data_mh_t *command)
+{
+  bool rearm = m_acc_batch.empty();
+  int ret = SS_ECODE_OK;
+
+  if (command->self != accelID)
     {
-      sc_err("m_exe_que.push() failure.¥n");
-      return SS_ECODE_QUEUE_PUSH_ERROR;
+      /* Keep the order of accel and GPS data. */
+
+      ret = flush_batch();
+      arm_batch_timer();
+      if (ret != SS_ECODE_OK)
+        {
+          return ret;
+        }
+
+      return write_exec(command);
     }
 
-  /* Send sensored data.
-   * (Data which sent to DSP is physical address of command msg.)
+  /* Send previous samples first if this packet cannot be appended. */
+
+  if (!m_acc_batch.fits(command, sizeof(ThreeAxisSample)))
+    {
+      ret = flush_batch();
+      rearm = true;
+      if (ret != SS_ECODE_OK)
+        {
+          goto errout;
+        }
+    }
+
+  if (!m_acc_batch.append(command, sizeof(ThreeAxisSample),
+                          CONFIG_SENSING_STEPCOUNTER_BATCH_COUNT))
+    {
+      sc_err("batch buffer allocation failure.\n");
+      ret = SS_ECODE_MEMHANDLE_ALLOC_ERROR;
+      goto errout;
+    }
+
+  if (m_acc_batch.ready(CONFIG_SENSING_STEPCOUNTER_BATCH_COUNT,
+                        CONFIG_SENSING_STEPCOUNTER_BATCH_LATENCY))
+    {
+      ret = flush_batch();
+      rearm = true;
+    }
+
+errout:
+  if (rearm)
+    {
+      arm_batch_timer();
+    }
+
+  return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+void StepCounterClass::arm_batch_timer(void)
+{
+  long ms;
+
+  /* Schedule a flush for the deadline of the first packet, so that the
+   * samples are not held beyond the latency when accel data stops.
    */
 
-  int ret = mpmq_send(&m_mq,
-                      (StepCounterMode << 4) + (ExecEvent << 1),
-                      reinterpret_cast<int32_t>(exe_mh.cmd.getPa()));
-  if (ret < 0)
+  if (work_cancel(LPWORK, &m_batch_work) == OK)
     {
-      m_exe_que.pop();
-      sc_err("mpmq_send() failure. %d\n", ret);
-      return SS_ECODE_DSP_EXEC_ERROR;
+      m_batch_pending--;
     }
 
-  return SS_ECODE_OK;
+  if (m_batch_closing)
+    {
+      return;
+    }
+
+  if (!m_acc_batch.empty())
+    {
+      ms = m_acc_batch.remaining(CONFIG_SENSING_STEPCOUNTER_BATCH_LATENCY);
+      work_queue(LPWORK, &m_batch_work, batch_timeout, this,
+                 (ms > 0) ? MSEC2TICK(ms) + 1 : 0);
+      m_batch_pending++;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+void StepCounterClass::batch_timeout(FAR void *arg)
+{
+  FAR StepCounterClass *self = static_cast<FAR StepCounterClass *>(arg);
+
+  while (sem_wait(&self->m_batch_sem) != 0)
+    {
+      DEBUGASSERT(errno == EINTR);
+    }
+
+  self->m_batch_pending--;
+
+  if (self->m_batch_closing)
+    {
+      bool last = (self->m_batch_pending == 0);
+
+      sem_post(&self->m_batch_sem);
+
+      /* close() is waiting, this must be the last access to self. */
+
+      if (last)
+        {
+          sem_post(&self->m_batch_done);
+        }
+
+      return;
+    }
+
+  /* The batch may have been flushed or restarted by write() meanwhile. */
+
+  if (self->m_acc_batch.ready(CONFIG_SENSING_STEPCOUNTER_BATCH_COUNT,
+                              CONFIG_SENSING_STEPCOUNTER_BATCH_LATENCY))
+    {
+      self->flush_batch();
+    }
+
+  self->arm_batch_timer();
+
+  sem_post(&self->m_batch_sem);
 }
 
+/*--------------------------------------------------------------------------*/
+int StepCounterClass::flush_batch(void)
+{
+  struct exe_mh_s exe_mh;
+  uint32_t time;
+  uint32_t fs;
+  uint32_t num;
+
+  if (m_acc_batch.empty())
+    {
+      return SS_ECODE_OK;
+    }
+
+  /* allocate segment of command */
+
+  if (exe_mh.cmd.allocSeg(m_cmd_pool_id, sizeof(SensorCmdStepCounter))
+      != ERR_OK)
+    {
+      sc_err("allocSeg() failure.¥n");
+      return SS_ECODE_MEMHANDLE_ALLOC_ERROR;
+    }
+
+  FAR SensorCmdStepCounter *dsp_cmd  =
+    (FAR SensorCmdStepCounter *)exe_mh.cmd.getPa();
+  FAR SensorExecStepCounter *exec_prm = &dsp_cmd->exec_cmd;
+
+  dsp_cmd->header.sensor_type = StepCounter;
+  dsp_cmd->header.event_type  = ExecEvent;
+
+  exe_mh.batch = m_acc_batch.detach(&time, &fs, &num);
+
+  exec_prm->cmd_type                 = STEP_COUNTER_CMD_UPDATE_ACCELERATION;
+  exec_prm->update_acc.time_stamp    = time;
+  exec_prm->update_acc.sampling_rate = fs;
+  exec_prm->update_acc.sample_num    = num;
+  exec_prm->update_acc.p_data        =
+    reinterpret_cast<FAR ThreeAxisSample *>
+      (MemMgrLite::translateVaToPa(exe_mh.batch));
+
+  return send_exec(exe_mh);
+}
+#endif
+
 /*--------------------------------------------------------------------------*/
 void StepCounterClass::set_callback(void)
 {
@@ -422,6 +664,7 @@ void StepCounterClass::set_callback(void)
 
   /* Pop exec queue (Free segment). */
 
+  free(exe_mh.batch);
   m_exe_que.pop();
 }
 
@@ -456,6 +699,8 @@ int StepCounterClass::set(FAR StepCounterSetting *set_param)
 {
   struct exe_mh_s exe_mh;
 
+  exe_mh.batch = NULL;
+
   /* allocate segment of command */
 
   int result = exe_mh.cmd.allocSeg(m_cmd_pool_id,
@@ -477,28 +722,7 @@ int StepCounterClass::set(FAR StepCounterSetting *set_param)
   dsp_cmd->exec_cmd.cmd_type = STEP_COUNTER_CMD_STEP_SET;
   dsp_cmd->exec_cmd.setting  = *set_param;
 
-  if (!m_exe_que.push(exe_mh))
-    {
-      sc_err("m_exe_que.push() failure.¥n");
-      return SS_ECODE_QUEUE_PUSH_ERROR;
-    }
-
-  /* Send sensored data.
-   * Data sent to DSP is physical address of command msg.
-   */
-
-  int ret = mpmq_send(&m_mq,
-                      (StepCounterMode << 4) + (ExecEvent << 1),
-                      reinterpret_cast<int32_t>(exe_mh.cmd.getPa()));
-
-  if (ret < 0)
-    {
-      m_exe_que.pop();
-      sc_err("mpmq_send() failure. %d\n", ret);
-      return SS_ECODE_DSP_EXEC_ERROR;
-    }
-
-  return SS_ECODE_OK;
+  return send_exec(exe_mh);
 }
 
 /****************************************************************************
@@ -39,7 +39,9 @@
 
 #include <sdk/config.h>
 #include <sdk/debug.h>
+#include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <sys/time.h>
 #include <arch/chip/pm.h>
 #include <arch/chip/scu.h>
@@ -157,6 +159,43 @@ static struct pm_cpu_freqlock_s g_tram_freqlock;
  * Private Functions
  ****************************************************************************/
 
+static void set_exec_data(FAR SensorExecTram *exec, TramSensorType type,
+                          uint32_t time, uint32_t fs, uint32_t num,
+                          FAR void *data)
+{
+  exec->type = type;
+
+  switch (type)
+    {
+      case TramSensorAcc:
+        exec->acc_data.time_stamp    = time;
+        exec->acc_data.sampling_rate = fs;
+        exec->acc_data.sample_num    = num;
+        exec->acc_data.p_data        =
+          reinterpret_cast<ThreeAxisSample*>(data);
+        break;
+
+      case TramSensorMag:
+        exec->mag_data.time_stamp    = time;
+        exec->mag_data.sampling_rate = fs;
+        exec->mag_data.sample_num    = num;
+        exec->mag_data.p_data        =
+          reinterpret_cast<ThreeAxisSample*>(data);
+        break;
+
+      case TramSensorBar:
+        exec->bar_data.time_stamp    = time;
+        exec->bar_data.sampling_rate = fs;
+        exec->bar_data.sample_num    = num;
+        exec->bar_data.p_data        = reinterpret_cast<uint32_t*>(data);
+        break;
+
+      default:
+        break;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
 static void *receiver_thread_entry(FAR void *p_instance)
 {
   do
@@ -198,6 +237,12 @@ int TramClass::open(FAR float *likelihood)
   acquire_freq_lock();
 #endif
 
+#if CONFIG_SENSING_TRAM_BATCH_COUNT > 1
+  /* Batches may be armed again after a previous close(). */
+
+  m_batch_closing = false;
+#endif
+
   /* Initalize Worker as task. */
 
   ret = mptask_init_secure(&m_mptask, "TRAM");
@@ -305,6 +350,45 @@ transport_mode_errout_with_mptask_destroy:
 int TramClass::close(void)
 {
   int wret = -1;
+
+#if CONFIG_SENSING_TRAM_BATCH_COUNT > 1
+  /* Stop the deadline work, and drop samples DSP will not process. */
+
+  while (sem_wait(&m_batch_sem) != 0)
+    {
+      DEBUGASSERT(errno == EINTR);
+    }
+
+  for (int type = TramSensorAcc; type <= TramSensorBar; type++)
+    {
+      m_batch[type].clear();
+    }
+
+  m_batch_closing = true;
+
+  if (work_cancel(LPWORK, &m_batch_work) == OK)
+    {
+      m_batch_pending--;
+    }
+
+  bool running = (m_batch_pending > 0);
+
+  sem_post(&m_batch_sem);
+
+  /* work_cancel() does not wait for a batch_timeout() already taken off
+   * the queue, it may be blocked on m_batch_sem just released.  Wait for
+   * it so that it does not touch this instance after close().
+   */
+
+  if (running)
+    {
+      while (sem_wait(&m_batch_done) != 0)
+        {
+          DEBUGASSERT(errno == EINTR);
+        }
+    }
+#endif
+
   int ret = mptask_destroy(&m_mptask, false, &wret);
   if (ret < 0)
     {
@@ -400,14 +484,84 @@ int TramClass::sendInit(float* likelihood)
   return SS_ECODE_OK;
 }
 
+/*--------------------------------------------------------------------------*/
+int TramClass::send_exec(struct exe_mh_s &exe_mh)
+{
+  if (!m_exe_que.push(exe_mh))
+    {
+      /* Cannot save MHandle due to system error. */
+
+      free(exe_mh.batch);
+      return SS_ECODE_QUEUE_PUSH_ERROR;
+    }
+
+  /* Send sensored data.
+   * (Data which sent to DSP is physical address of command msg.)
+   */
+
+  int ret = mpmq_send(&m_mq,
+                      (TramProcMode << 4) + (ExecEvent << 1),
+                      reinterpret_cast<int32_t>(exe_mh.cmd.getPa()));
+  if (ret < 0)
+    {
+      free(exe_mh.batch);
+      m_exe_que.pop();
+      tram_err("mpmq_send() failure. %d¥n", ret);
+      return SS_ECODE_DSP_EXEC_ERROR;
+    }
+
+  return SS_ECODE_OK;
+}
+
 /*--------------------------------------------------------------------------*/
 int TramClass::write(sensor_command_data_mh_t* command)
+{
+#if CONFIG_SENSING_TRAM_BATCH_COUNT > 1
+  int ret;
+
+  /* Batches are also flushed by batch_timeout() on the work thread. */
+
+  while (sem_wait(&m_batch_sem) != 0)
+    {
+      DEBUGASSERT(errno == EINTR);
+    }
+
+  switch (command->self)
+    {
+      case accelID:
+        ret = write_batch(TramSensorAcc, command);
+        break;
+
+      case magID:
+        ret = write_batch(TramSensorMag, command);
+        break;
+
+      case barometerID:
+        ret = write_batch(TramSensorBar, command);
+        break;
+
+      default:
+        ret = write_exec(command);
+        break;
+    }
+
+  sem_post(&m_batch_sem);
+
+  return ret;
+#else
+  return write_exec(command);
+#endif
+}
+
+/*--------------------------------------------------------------------------*/
+int TramClass::write_exec(sensor_command_data_mh_t* command)
 {
   struct exe_mh_s exe_mh;
 
   /* Copy memhandle of data. */
 
-  exe_mh.data = command->mh;
+  exe_mh.data  = command->mh;
+  exe_mh.batch = NULL;
 
   /* Allocate segment of command. */
 
@@ -427,34 +581,22 @@ int TramClass::write(sensor_command_data_mh_t* command)
     {
       case accelID:
         {
-          dsp_cmd->exec_cmd.type                   = TramSensorAcc;
-          dsp_cmd->exec_cmd.acc_data.time_stamp    = command->time;
-          dsp_cmd->exec_cmd.acc_data.sampling_rate = command->fs;
-          dsp_cmd->exec_cmd.acc_data.sample_num    = command->size;
-          dsp_cmd->exec_cmd.acc_data.p_data        =
-            reinterpret_cast<ThreeAxisSample*>(exe_mh.data.getPa());
+          set_exec_data(&dsp_cmd->exec_cmd, TramSensorAcc, command->time,
+                        command->fs, command->size, exe_mh.data.getPa());
         }
         break;
 
       case magID:
         {
-          dsp_cmd->exec_cmd.type                   = TramSensorMag;
-          dsp_cmd->exec_cmd.mag_data.time_stamp    = command->time;
-          dsp_cmd->exec_cmd.mag_data.sampling_rate = command->fs;
-          dsp_cmd->exec_cmd.mag_data.sample_num    = command->size;
-          dsp_cmd->exec_cmd.mag_data.p_data        =
-            reinterpret_cast<ThreeAxisSample*>(exe_mh.data.getPa());
+          set_exec_data(&dsp_cmd->exec_cmd, TramSensorMag, command->time,
+                        command->fs, command->size, exe_mh.data.getPa());
         }
         break;
 
       case barometerID:
         {
-          dsp_cmd->exec_cmd.type                   = TramSensorBar;
-          dsp_cmd->exec_cmd.bar_data.time_stamp    = command->time;
-          dsp_cmd->exec_cmd.bar_data.sampling_rate = command->fs;;
-          dsp_cmd->exec_cmd.bar_data.sample_num    = command->size;
-          dsp_cmd->exec_cmd.bar_data.p_data        =
-            reinterpret_cast<uint32_t*>(exe_mh.data.getPa());
+          set_exec_data(&dsp_cmd->exec_cmd, TramSensorBar, command->time,
+                        command->fs, command->size, exe_mh.data.getPa());
         }
         break;
 
@@ -465,29 +607,178 @@ int TramClass::write(sensor_command_data_mh_t* command)
         break;
     }
 
-  if (!m_exe_que.push(exe_mh))
+  return send_exec(exe_mh);
+}
+
+#if CONFIG_SENSING_TRAM_BATCH_COUNT > 1
+/*--------------------------------------------------------------------------*/
+int TramClass::write_batch(TramSensorType type,
+                           FAR sensor_command_data_mh_t *command)
+{
+  FAR SensorBatch *batch = &m_batch[type];
+  size_t sample_size = (type == TramSensorBar) ?
+                         sizeof(uint32_t) : sizeof(ThreeAxisSample);
+  bool rearm = batch->empty();
+  int ret = SS_ECODE_OK;
+
+  /* Send previous samples first if this packet cannot be appended,
+   * e.g. sampling rate was changed by state transition.
+   */
+
+  if (!batch->fits(command, sample_size))
     {
-      /* Cannot save MHandle due to system error. */
+      ret = flush_batch(type);
+      rearm = true;
+      if (ret != SS_ECODE_OK)
+        {
+          goto errout;
+        }
+    }
 
-      return SS_ECODE_QUEUE_PUSH_ERROR;
+  if (!batch->append(command, sample_size, CONFIG_SENSING_TRAM_BATCH_COUNT))
+    {
+      tram_err("batch buffer allocation failure.\n");
+      ret = SS_ECODE_MEMHANDLE_ALLOC_ERROR;
+      goto errout;
     }
 
-  /* Send sensored data.
-   * (Data which sent to DSP is physical address of command msg.)
+  if (batch->ready(CONFIG_SENSING_TRAM_BATCH_COUNT,
+                   CONFIG_SENSING_TRAM_BATCH_LATENCY))
+    {
+      ret = flush_batch(type);
+      rearm = true;
+    }
+
+errout:
+  if (rearm)
+    {
+      arm_batch_timer();
+    }
+
+  return ret;
+}
+
+/*--------------------------------------------------------------------------*/
+void TramClass::arm_batch_timer(void)
+{
+  bool pending = false;
+  long next = 0;
+  long ms;
+  int type;
+
+  /* Schedule a flush for the earliest deadline among the sensors, so that
+   * samples are not held beyond the latency when a sensor stops.
    */
 
-  int ret = mpmq_send(&m_mq,
-                      (TramProcMode << 4) + (ExecEvent << 1),
-                      reinterpret_cast<int32_t>(exe_mh.cmd.getPa()));
-  if (ret < 0)
+  if (work_cancel(LPWORK, &m_batch_work) == OK)
     {
-      tram_err("mpmq_send() failure. %d¥n", ret);
-      return SS_ECODE_DSP_EXEC_ERROR;
+      m_batch_pending--;
     }
 
-  return SS_ECODE_OK;
+  if (m_batch_closing)
+    {
+      return;
+    }
+
+  for (type = TramSensorAcc; type <= TramSensorBar; type++)
+    {
+      if (!m_batch[type].empty())
+        {
+          ms = m_batch[type].remaining(CONFIG_SENSING_TRAM_BATCH_LATENCY);
+          if (!pending || ms < next)
+            {
+              next = ms;
+            }
+
+          pending = true;
+        }
+    }
+
+  if (pending)
+    {
+      work_queue(LPWORK, &m_batch_work, batch_timeout, this,
+                 (next > 0) ? MSEC2TICK(next) + 1 : 0);
+      m_batch_pending++;
+    }
 }
 
+/*--------------------------------------------------------------------------*/
+void TramClass::batch_timeout(FAR void *arg)
+{
+  FAR TramClass *self = static_cast<FAR TramClass *>(arg);
+  int type;
+
+  while (sem_wait(&self->m_batch_sem) != 0)
+    {
+      DEBUGASSERT(errno == EINTR);
+    }
+
+  self->m_batch_pending--;
+
+  if (self->m_batch_closing)
+    {
+      bool last = (self->m_batch_pending == 0);
+
+      sem_post(&self->m_batch_sem);
+
+      /* close() is waiting, this must be the last access to self. */
+
+      if (last)
+        {
+          sem_post(&self->m_batch_done);
+        }
+
+      return;
+    }
+
+  for (type = TramSensorAcc; type <= TramSensorBar; type++)
+    {
+      if (self->m_batch[type].ready(CONFIG_SENSING_TRAM_BATCH_COUNT,
+                                    CONFIG_SENSING_TRAM_BATCH_LATENCY))
+        {
+          self->flush_batch(static_cast<TramSensorType>(type));
+        }
+    }
+
+  self->arm_batch_timer();
+
+  sem_post(&self->m_batch_sem);
+}
+
+/*--------------------------------------------------------------------------*/
+int TramClass::flush_batch(TramSensorType type)
+{
+  struct exe_mh_s exe_mh;
+  uint32_t time;
+  uint32_t fs;
+  uint32_t num;
+
+  if (m_batch[type].empty())
+    {
+      return SS_ECODE_OK;
+    }
+
+  /* Allocate segment of command. */
+
+  if (exe_mh.cmd.allocSeg(m_cmd_pool_id, sizeof(SensorCmdTram)) != ERR_OK)
+    {
+      return SS_ECODE_MEMHANDLE_ALLOC_ERROR;
+    }
+
+  FAR SensorCmdTram *dsp_cmd = (FAR SensorCmdTram *)exe_mh.cmd.getVa();
+
+  dsp_cmd->header.sensor_type = TransportationMode;
+  dsp_cmd->header.event_type  = ExecEvent;
+
+  exe_mh.batch = m_batch[type].detach(&time, &fs, &num);
+
+  set_exec_data(&dsp_cmd->exec_cmd, type, time, fs, num,
+                MemMgrLite::translateVaToPa(exe_mh.batch));
+
+  return send_exec(exe_mh);
+}
+#endif
+
 /*--------------------------------------------------------------------------*/
 void TramClass::send_detection_result(uint32_t pred)
 {
@@ -530,7 +821,7 @@ void TramClass::send_notification(TramNotification notification)
 }
 
 /*--------------------------------------------------------------------------*/
-void TramClass::set_power(uint32_t subscriptions)
+void TramClass::set_power(uint64_t subscriptions)
 {
   sensor_command_power_t packet;
 
@@ -545,7 +836,7 @@ void TramClass::set_power(uint32_t subscriptions)
 }
 
 /*--------------------------------------------------------------------------*/
-void TramClass::clear_power(uint32_t subscriptions)
+void TramClass::clear_power(uint64_t subscriptions)
 {
   sensor_command_power_t packet;
 
@@ -619,6 +910,7 @@ void TramClass::receive_sync_msg(void)
 
   /* Pop exec queue (Free segment). */
 
+  free(exe_mh.batch);
   m_exe_que.pop();
 }
 